@@ -0,0 +1,77 @@
+/**
+ * @file BufferPool.cpp
+ * @brief 进程内共享接收缓冲池实现
+ */
+#include "MB_DDF/DDS/BufferPool.h"
+
+namespace MB_DDF {
+namespace DDS {
+
+namespace {
+constexpr size_t kMinBlock = 256;
+constexpr size_t kPow2Limit = 64 * 1024;
+constexpr size_t kPage = 4096;
+}
+
+void BufferPool::Lease::release() {
+    if (pool_ && buf_) pool_->put(std::move(buf_), cap_);
+    buf_.reset();
+    cap_ = 0;
+}
+
+BufferPool& BufferPool::instance() {
+    static BufferPool pool;
+    return pool;
+}
+
+size_t BufferPool::roundUp(size_t size) {
+    if (size <= kMinBlock) return kMinBlock;
+    if (size > kPow2Limit) return (size + kPage - 1) & ~(kPage - 1);
+    size_t c = kMinBlock;
+    while (c < size) c <<= 1;
+    return c;
+}
+
+BufferPool::Lease BufferPool::acquire(size_t size) {
+    if (size == 0) return Lease();
+    const size_t cap = roundUp(size);
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        ++acquired_;
+        auto it = free_.find(cap);
+        if (it != free_.end() && !it->second.empty()) {
+            auto buf = std::move(it->second.back());
+            it->second.pop_back();
+            ++reused_;
+            return Lease(this, std::move(buf), cap);
+        }
+    }
+    // 分配在锁外进行；不清零，调用方只读取 receive 实际写入的部分
+    return Lease(this, std::unique_ptr<uint8_t[]>(new uint8_t[cap]), cap);
+}
+
+void BufferPool::put(std::unique_ptr<uint8_t[]> buf, size_t cap) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto& list = free_[cap];
+    if (list.size() < kMaxCachedPerClass) list.push_back(std::move(buf));
+}
+
+BufferPool::Stats BufferPool::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    Stats s;
+    s.acquired = acquired_;
+    s.reused = reused_;
+    for (const auto& kv : free_) {
+        s.cached_blocks += kv.second.size();
+        s.cached_bytes += kv.first * kv.second.size();
+    }
+    return s;
+}
+
+void BufferPool::trim() {
+    std::lock_guard<std::mutex> lk(mu_);
+    free_.clear();
+}
+
+} // namespace DDS
+} // namespace MB_DDF
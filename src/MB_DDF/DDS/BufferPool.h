@@ -0,0 +1,88 @@
+/**
+ * @file BufferPool.h
+ * @brief 进程内共享的接收缓冲池
+ *
+ * 设备句柄订阅者只在排空设备的瞬间借用缓冲，回调返回后归还；空闲订阅者不持有任何缓冲。
+ * 容量按规格取整（64 KB 以下取 2 的幂，以上按 4 KB 取整），同规格缓冲复用，
+ * 每个规格最多缓存 kMaxCachedPerClass 块，超出的直接释放。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MB_DDF {
+namespace DDS {
+
+class BufferPool {
+public:
+    static constexpr size_t kMaxCachedPerClass = 8;
+
+    struct Stats {
+        uint64_t acquired = 0;      // 借出次数
+        uint64_t reused = 0;        // 其中命中缓存的次数
+        size_t cached_blocks = 0;   // 当前缓存的空闲块数
+        size_t cached_bytes = 0;    // 当前缓存的空闲字节数
+    };
+
+    // 借用的缓冲：析构时归还缓冲池，仅可移动
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease() { release(); }
+        Lease(Lease&& o) noexcept : pool_(o.pool_), buf_(std::move(o.buf_)), cap_(o.cap_) { o.cap_ = 0; }
+        Lease& operator=(Lease&& o) noexcept {
+            if (this != &o) {
+                release();
+                pool_ = o.pool_;
+                buf_ = std::move(o.buf_);
+                cap_ = o.cap_;
+                o.cap_ = 0;
+            }
+            return *this;
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        uint8_t* data() const { return buf_.get(); }
+        size_t capacity() const { return cap_; }
+        explicit operator bool() const { return buf_ != nullptr; }
+
+    private:
+        friend class BufferPool;
+        Lease(BufferPool* pool, std::unique_ptr<uint8_t[]> buf, size_t cap)
+            : pool_(pool), buf_(std::move(buf)), cap_(cap) {}
+        void release();
+
+        BufferPool* pool_ = nullptr;
+        std::unique_ptr<uint8_t[]> buf_;
+        size_t cap_ = 0;
+    };
+
+    static BufferPool& instance();
+
+    // 借用至少 size 字节的缓冲；size 为 0 时返回空租约
+    Lease acquire(size_t size);
+    Stats stats() const;
+    // 释放全部缓存的空闲块
+    void trim();
+
+    // 规格取整规则（供测试与调用方估算内存）
+    static size_t roundUp(size_t size);
+
+private:
+    BufferPool() = default;
+    void put(std::unique_ptr<uint8_t[]> buf, size_t cap);
+
+    mutable std::mutex mu_;
+    std::map<size_t, std::vector<std::unique_ptr<uint8_t[]>>> free_;
+    uint64_t acquired_ = 0;
+    uint64_t reused_ = 0;
+};
+
+} // namespace DDS
+} // namespace MB_DDF
@@ -80,7 +80,7 @@ std::shared_ptr<Subscriber> DDSCore::create_subscriber(const std::string& topic_
     return subscriber;
 }
 
-std::shared_ptr<Subscriber> DDSCore::create_subscriber(const std::string& topic_name, bool enable_checksum, const MessageCallback& callback) {
+std::shared_ptr<Subscriber> DDSCore::create_subscriber(const std::string& topic_name, bool enable_checksum, const MessageCallback& callback, bool deliver_all) {
     // 使用RAII守护对象保护共享内存访问
     RingBuffer* buffer = nullptr;
     buffer = create_or_get_topic_buffer(topic_name, enable_checksum);
@@ -98,7 +98,7 @@ std::shared_ptr<Subscriber> DDSCore::create_subscriber(const std::string& topic_
     
     LOG_INFO << "created subscriber, topic name: " << topic_name;
     std::shared_ptr<Subscriber> subscriber = std::make_shared<Subscriber>(metadata, buffer, process_name_);
-    subscriber->subscribe(callback);
+    subscriber->subscribe(callback, deliver_all);
     return subscriber;
 }
 
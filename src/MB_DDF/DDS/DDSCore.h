@@ -88,9 +88,10 @@ public:
      * @param topic_name Topic名称
      * @param enable_checksum 是否启用校验和，默认true
      * @param callback 消息接收回调函数，默认空函数
+     * @param deliver_all 回调按序投递每条消息（默认只投递最新消息），见 Subscriber::subscribe
      * @return 订阅者智能指针，失败时返回nullptr
      */
-    std::shared_ptr<Subscriber> create_subscriber(const std::string& topic_name, bool enable_checksum = true, const MessageCallback& callback = nullptr);
+    std::shared_ptr<Subscriber> create_subscriber(const std::string& topic_name, bool enable_checksum = true, const MessageCallback& callback = nullptr, bool deliver_all = false);
 
     /**
      * @brief 创建指定Topic的订阅者，并绑定DDS句柄
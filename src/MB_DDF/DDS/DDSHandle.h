@@ -11,6 +11,12 @@ public:
     virtual int32_t receive(uint8_t* buf, uint32_t buf_size) = 0;
     virtual int32_t receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us) = 0;
     virtual uint32_t getMTU() const = 0;
+    // 事件驱动接入：可 epoll 的就绪 fd（<0 表示不支持，调用方退化为轮询）
+    virtual int getEventFd() const { return -1; }
+    // 就绪 fd 可读后调用，消费事件通知；随后以非阻塞 receive 取数据
+    virtual void ackEvent() {}
+    // 每次就绪事件最多排空的帧数；DDR 等"每次读取即一帧"的设备应返回 1
+    virtual uint32_t framesPerEvent() const { return 64; }
 };
 
 } // namespace DDS
@@ -35,6 +35,23 @@ Publisher::~Publisher() {
 Publisher::WritableMessage::WritableMessage(RingBuffer* rb, TopicMetadata* metadata, const RingBuffer::ReserveToken& token)
     : rb_(rb), metadata_(metadata), token_(token), committed_(false) {}
 
+Publisher::WritableMessage::WritableMessage(WritableMessage&& other) noexcept
+    : rb_(other.rb_), metadata_(other.metadata_), token_(other.token_), committed_(other.committed_) {
+    other.token_ = RingBuffer::ReserveToken();
+}
+
+Publisher::WritableMessage& Publisher::WritableMessage::operator=(WritableMessage&& other) noexcept {
+    if (this != &other) {
+        cancel();
+        rb_ = other.rb_;
+        metadata_ = other.metadata_;
+        token_ = other.token_;
+        committed_ = other.committed_;
+        other.token_ = RingBuffer::ReserveToken();
+    }
+    return *this;
+}
+
 Publisher::WritableMessage::~WritableMessage() {
     if (!committed_ && token_.valid && rb_) {
         rb_->abort(token_);
@@ -46,10 +46,15 @@ public:
 
     /**
      * @brief 零拷贝写槽句柄（RAII）。在析构未提交时自动取消。
+     * 仅可移动：写槽可在发起异步 DMA 后转交给完成回调再提交。
      */
     class WritableMessage {
     public:
         WritableMessage(RingBuffer* rb, TopicMetadata* metadata, const RingBuffer::ReserveToken& token);
+        WritableMessage(WritableMessage&& other) noexcept;
+        WritableMessage& operator=(WritableMessage&& other) noexcept;
+        WritableMessage(const WritableMessage&) = delete;
+        WritableMessage& operator=(const WritableMessage&) = delete;
         ~WritableMessage();
         void* data();
         size_t capacity() const;
@@ -0,0 +1,55 @@
+/**
+ * @file ReadyWaiter.cpp
+ * @brief 设备工作线程等待原语实现
+ */
+#include "MB_DDF/DDS/ReadyWaiter.h"
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace MB_DDF {
+namespace DDS {
+
+bool ReadyWaiter::open(int ready_fd) {
+    close();
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) return false;
+    ready_fd_ = ready_fd;
+    return true;
+}
+
+void ReadyWaiter::close() {
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    ready_fd_ = -1;
+}
+
+void ReadyWaiter::wake() {
+    uint64_t one = 1;
+    ssize_t ret = ::write(wake_fd_, &one, sizeof(one));
+    (void)ret;
+}
+
+ReadyWaiter::Result ReadyWaiter::wait(int timeout_ms) {
+    pollfd fds[2] = {{wake_fd_, POLLIN, 0}, {ready_fd_, POLLIN, 0}};
+    const nfds_t nfds = ready_fd_ >= 0 ? 2 : 1;
+    int ret = ::poll(fds, nfds, timeout_ms);
+    if (ret < 0) return errno == EINTR ? Result::Timeout : Result::Error;
+    if (ret == 0) return Result::Timeout;
+
+    const bool woken = fds[0].revents & POLLIN;
+    if (woken) {
+        uint64_t cnt = 0;
+        ssize_t r = ::read(wake_fd_, &cnt, sizeof(cnt));
+        (void)r;
+    }
+    if (nfds > 1 && (fds[1].revents & POLLIN)) return Result::Ready;
+    return woken ? Result::Woken : Result::Timeout;
+}
+
+} // namespace DDS
+} // namespace MB_DDF
@@ -0,0 +1,52 @@
+/**
+ * @file ReadyWaiter.h
+ * @brief 设备工作线程的公共等待原语：阻塞于设备就绪 fd 与内部唤醒 eventfd
+ *
+ * 设计要点：
+ * - 工作线程空闲时阻塞在 poll 上，由设备就绪 fd 或 wake()（停止、新任务）唤醒，不轮询。
+ * - 就绪 fd <0（后端不支持事件通知）时，wait() 按 kFallbackPollMs 周期返回 Timeout，调用方据此周期排空。
+ * - 就绪 fd 只通知此后到来的数据：调用方须在第一次 wait() 前排空一次，以取走启动前已就绪的数据。
+ * - 只负责等待：消费事件通知（waitEvent / ackEvent）与排空由调用方完成。
+ * - wake() 可在任意线程调用；wait() 只能由单个工作线程调用。
+ */
+#pragma once
+
+namespace MB_DDF {
+namespace DDS {
+
+class ReadyWaiter {
+public:
+    static constexpr int kFallbackPollMs = 1;       // 无就绪 fd 时的周期
+
+    enum class Result {
+        Ready,      // 设备就绪 fd 可读（同时到来的唤醒一并消费）
+        Woken,      // 仅被 wake() 唤醒
+        Timeout,    // 超时或被信号打断
+        Error       // poll 失败，errno 保留
+    };
+
+    ReadyWaiter() = default;
+    ~ReadyWaiter() { close(); }
+
+    ReadyWaiter(const ReadyWaiter&) = delete;
+    ReadyWaiter& operator=(const ReadyWaiter&) = delete;
+
+    // 创建唤醒 eventfd 并记录设备就绪 fd（可为 -1）；失败返回 false，errno 保留
+    bool open(int ready_fd);
+    void close();
+    bool isOpen() const { return wake_fd_ >= 0; }
+    bool hasReadyFd() const { return ready_fd_ >= 0; }
+
+    void wake();
+    // 等待到设备就绪或被唤醒；无就绪 fd 时最长等待 kFallbackPollMs
+    Result wait() { return wait(ready_fd_ >= 0 ? -1 : kFallbackPollMs); }
+    // 指定超时（毫秒，-1 不限）
+    Result wait(int timeout_ms);
+
+private:
+    int wake_fd_ = -1;
+    int ready_fd_ = -1;
+};
+
+} // namespace DDS
+} // namespace MB_DDF
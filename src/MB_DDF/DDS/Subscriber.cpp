@@ -9,12 +9,14 @@
 #include "MB_DDF/DDS/Subscriber.h"
 #include "MB_DDF/DDS/RingBuffer.h"
 #include "MB_DDF/DDS/Message.h"
+#include "MB_DDF/DDS/BufferPool.h"
 #include "MB_DDF/Debug/Logger.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <random>
 #include <pthread.h>
-#include <signal.h>
 #include <sched.h>
-#include <unistd.h>
 
 namespace MB_DDF {
 namespace DDS {
@@ -32,18 +34,13 @@ Subscriber::Subscriber(TopicMetadata* metadata, RingBuffer* ring_buffer, const s
     if (subscriber_name_.empty()) {
         subscriber_name_ = "subscriber_" + std::to_string(subscriber_id_);
     }
-
-    // 如果提供了句柄，初始化接收缓存
-    if (handle_) {
-        receive_buffer_.resize(handle_->getMTU());
-    }
 }
 
 Subscriber::~Subscriber() {
     unsubscribe();
 }
 
-bool Subscriber::subscribe(MessageCallback callback) {
+bool Subscriber::subscribe(MessageCallback callback, bool deliver_all) {
     if (subscribed_.load()) {
         LOG_DEBUG << "Subscriber " << subscriber_id_ << " " << subscriber_name_ << " already subscribed";
         return false; // 已经订阅
@@ -56,16 +53,34 @@ bool Subscriber::subscribe(MessageCallback callback) {
             LOG_DEBUG << "Failed to register subscriber " << subscriber_id_ << " " << subscriber_name_;
             return false;
         }
+        // 按序投递从订阅时刻开始：同名订阅者复用的槽位可能残留旧的已读序号
+        if (deliver_all) {
+            Message* msg = nullptr;
+            ring_buffer_->read_latest(subscriber_state_, msg);
+        }
     }
     
+    // 句柄工作线程经 eventfd 唤醒退出，须在启动线程前创建
+    if (handle_ && callback) {
+        if (!waiter_.open(handle_->getEventFd())) {
+            LOG_ERROR << "Subscriber " << subscriber_name_ << " eventfd failed: " << strerror(errno);
+            return false;
+        }
+    }
+
     callback_ = callback;
+    deliver_all_ = deliver_all;
     subscribed_.store(true);
     running_.store(true);
     
     // 如需实时检测，则设置回调函数，启动工作线程
     if (callback_) {
         LOG_DEBUG << "Subscriber " << subscriber_id_ << " " << subscriber_name_ << " subscribed with callback";
-        worker_thread_ = std::thread(&Subscriber::worker_loop, this);
+        if (handle_) {
+            worker_thread_ = std::thread(&Subscriber::handle_worker_loop, this);
+        } else {
+            worker_thread_ = std::thread(&Subscriber::worker_loop, this);
+        }
     }
     
     LOG_DEBUG << "Subscriber " << subscriber_id_ << " " << subscriber_name_ << " subscribed successfully";
@@ -91,39 +106,70 @@ void Subscriber::unsubscribe() {
     // 标记为未订阅
     subscribed_.store(false);
     
-    if (handle_ && worker_thread_.joinable()) {
-        pthread_kill(worker_thread_.native_handle(), SIGUSR1);
-    }
+    // 句柄工作线程阻塞在 poll 上，唤醒使其立即返回
+    if (waiter_.isOpen()) waiter_.wake();
     
     if (worker_thread_.joinable()) {
         worker_thread_.join();
         LOG_DEBUG << "Subscriber " << subscriber_id_ << " " << subscriber_name_ << " worker thread joined";
     }
+
+    waiter_.close();
     
     // 从RingBuffer中注销订阅者
     if (ring_buffer_ && subscriber_state_) ring_buffer_->unregister_subscriber(subscriber_state_);
     LOG_DEBUG << "Subscriber " << subscriber_id_ << " " << subscriber_name_ << " unregistered from ring buffer";
 }
 
-void Subscriber::worker_loop() { 
-    size_t received_size = 0;   
+void Subscriber::handle_worker_loop() {
+    const uint32_t mtu = handle_->getMTU();
+    const uint32_t burst = handle_->framesPerEvent() ? handle_->framesPerEvent() : 1;
+    bool backlog = true;
+
     while (running_.load()) {
-        received_size = 0;
-        if (handle_ != nullptr) {
-            received_size = handle_->receive(receive_buffer_.data(), receive_buffer_.size(), 10000); 
-            // 调用回调函数
-            if (callback_ && received_size > 0) { 
-                callback_(receive_buffer_.data(), received_size, 0);
+        auto res = backlog ? waiter_.wait(0) : waiter_.wait();
+        if (res == ReadyWaiter::Result::Error) {
+            LOG_ERROR << "Subscriber " << subscriber_name_ << " poll failed: " << strerror(errno);
+            break;
+        }
+        if (res == ReadyWaiter::Result::Woken) break;  // 取消订阅
+        if (res == ReadyWaiter::Result::Ready) handle_->ackEvent();
+
+        // 缓冲仅在排空期间借用，回调返回后归还缓冲池。按 MTU 借用而非按帧长：设备不提供无副作用的
+        // 待收帧长查询（RS422 帧长在 CMD_RX 之后才出现在接收缓冲首字，CAN/CAN-FD 读帧即出队，
+        // DDR 每次读取即一整个 MTU），且一次借用覆盖整批帧，按帧长借用需每帧一次借还
+        uint32_t n = 0;
+        {
+            auto buf = BufferPool::instance().acquire(mtu);
+            for (; n < burst && running_.load(); ++n) {
+                int32_t got = handle_->receive(buf.data(), mtu);
+                if (got <= 0) break;
+                uint64_t ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+                callback_(buf.data(), static_cast<size_t>(got), ts);
             }
-            continue;
         }
+        backlog = n == burst;
+    }
+}
 
+void Subscriber::worker_loop() { 
+    size_t received_size = 0;   
+    while (running_.load()) {
+        received_size = 0;
         if (ring_buffer_->get_unread_count(subscriber_state_) > 0) {
             Message* msg = nullptr;
-            bool read_ok = ring_buffer_->read_latest(subscriber_state_, msg);
+            bool read_ok = false;
+            if (deliver_all_) {
+                // 下一条已被覆盖（落后超过一圈）时无法按序读取，退回最新消息重新同步
+                read_ok = ring_buffer_->read_next(subscriber_state_, msg) ||
+                          ring_buffer_->read_latest(subscriber_state_, msg);
+            } else {
+                read_ok = ring_buffer_->read_latest(subscriber_state_, msg);
+            }
             if (read_ok) {
                 received_size = msg->msg_size();
-                LOG_DEBUG << "Subscriber " << subscriber_name_ << " received latest message of total size: " << received_size;
+                LOG_DEBUG << "Subscriber " << subscriber_name_ << " received message of total size: " << received_size;
                 if (received_size >= sizeof(MessageHeader)) {
                     if (msg->is_valid(ring_buffer_->is_checksum_enabled())) {
                         if (callback_) {
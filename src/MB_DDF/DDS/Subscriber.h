@@ -6,6 +6,8 @@
  * 
  * 提供消息订阅功能，支持从指定Topic的环形缓冲区中接收消息。
  * 采用异步回调机制，在独立线程中处理消息接收和分发。
+ * 绑定设备句柄的订阅者由设备就绪 fd 与内部唤醒 eventfd 驱动：空闲时阻塞在 poll 上，
+ * 取消订阅经 eventfd 立即唤醒；接收缓冲仅在排空设备时从 BufferPool 借用（按 MTU，每批一次）。
  */
 
 #pragma once
@@ -13,6 +15,7 @@
 #include "MB_DDF/DDS/RingBuffer.h"
 #include "MB_DDF/DDS/TopicRegistry.h"
 #include "MB_DDF/DDS/DDSHandle.h"
+#include "MB_DDF/DDS/ReadyWaiter.h"
 #include <cstddef>
 #include <string>
 #include <functional>
@@ -60,9 +63,10 @@ public:
     /**
      * @brief 开始订阅消息
      * @param callback 消息接收回调函数
+     * @param deliver_all true 时从订阅时刻起按序回调每条消息（跳过订阅前积压）；默认只回调最新消息
      * @return 订阅成功返回true，失败返回false
      */
-    bool subscribe(MessageCallback callback = nullptr);
+    bool subscribe(MessageCallback callback = nullptr, bool deliver_all = false);
     
     /**
      * @brief 取消订阅，停止接收消息
@@ -109,9 +113,10 @@ private:
     MessageCallback callback_;      ///< 消息回调函数
     std::atomic<bool> subscribed_;  ///< 订阅状态标志
     std::atomic<bool> running_;     ///< 工作线程运行状态标志
+    bool deliver_all_{false};       ///< 回调按序投递全部消息
     std::thread worker_thread_;     ///< 消息接收工作线程
     std::shared_ptr<Handle> handle_{}; ///< 外部接收者句柄
-    std::vector<uint8_t> receive_buffer_{}; ///< 接收消息缓存
+    ReadyWaiter waiter_;            ///< 句柄工作线程的就绪/唤醒等待（取消订阅时唤醒）
 
     // 自身信息
     uint64_t subscriber_id_;        ///< 唯一的订阅者ID
@@ -124,6 +129,13 @@ private:
      */
     void worker_loop();
 
+    /**
+     * @brief 设备句柄工作线程主循环
+     * 阻塞等待设备就绪 fd 或唤醒 fd；设备就绪后以非阻塞 receive 排空并回调。
+     * 句柄无就绪 fd 时退化为 1ms 周期轮询
+     */
+    void handle_worker_loop();
+
     /**
      * @brief 从环形缓冲区读取下一条消息
      * @param data 接收消息数据的指针
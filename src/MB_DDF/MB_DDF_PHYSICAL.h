@@ -26,4 +26,5 @@
 
 #include "MB_DDF/PhysicalLayer/EventMultiplexer.h"
 #include "MB_DDF/PhysicalLayer/Factory/HardwareFactory.h"
+#include "MB_DDF/PhysicalLayer/TopicRouter.h"
 
@@ -0,0 +1,189 @@
+/**
+ * @file DmaStreamReader.cpp
+ */
+#include "MB_DDF/PhysicalLayer/ControlPlane/DmaStreamReader.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <poll.h>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+bool DmaStreamReader::start(const DmaStreamConfig& cfg, FrameHandler handler) {
+    if (running_) return false;
+    if (cfg.depth == 0 || cfg.frame_size == 0) {
+        LOGE("dma_stream", "start", EINVAL, "depth=%u frame=%zu", cfg.depth, cfg.frame_size);
+        return false;
+    }
+    cfg_ = cfg;
+    if (cfg_.device_slots == 0) cfg_.device_slots = 1;
+    handler_ = std::move(handler);
+
+    mem_bytes_ = cfg_.frame_size * cfg_.depth;
+    void* mem = nullptr;
+    if (::posix_memalign(&mem, 4096, mem_bytes_) != 0) {
+        LOGE("dma_stream", "alloc", ENOMEM, "bytes=%zu", mem_bytes_);
+        mem_bytes_ = 0;
+        return false;
+    }
+    mem_ = static_cast<uint8_t*>(mem);
+    slots_.reset(new Slot[cfg_.depth]);
+    batch_.reset(new AsyncRequest[cfg_.depth]);
+    submit_seq_ = read_seq_ = 0;
+    inflight_ = 0;
+    stalled_ = false;
+    stats_ = Stats{};
+
+    tp_.setOnAsyncComplete([this](void* token, bool is_write, ssize_t res) {
+        (void)is_write;
+        on_complete(token, res);
+    });
+    running_ = true;
+    refill();
+    if (inflight_ == 0) {
+        LOGE("dma_stream", "start", EIO, "initial submit failed");
+        stop(0);
+        return false;
+    }
+    LOGI("dma_stream", "start", 0, "channel=%d frame=%zu depth=%u", cfg_.channel, cfg_.frame_size, cfg_.depth);
+    return true;
+}
+
+void DmaStreamReader::stop(int timeout_ms) {
+    if (!mem_) return;
+    running_ = false;
+    // 等待在途请求完成，避免 DMA 写入已释放的缓冲
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (inflight_ > 0 && std::chrono::steady_clock::now() < deadline) {
+        struct pollfd pfd{ getEventFd(), POLLIN, 0 };
+        if (pfd.fd >= 0) (void)::poll(&pfd, 1, 10);
+        (void)tp_.drainAioCompletions(64);
+    }
+    tp_.setOnAsyncComplete(nullptr);
+    if (inflight_ > 0) {
+        // 仍有请求未完成：保留缓冲（泄漏）而不是释放后被 DMA 覆写
+        LOGW("dma_stream", "stop", ETIMEDOUT, "inflight=%u, buffers leaked", inflight_);
+    } else {
+        ::free(mem_);
+    }
+    mem_ = nullptr;
+    mem_bytes_ = 0;
+    slots_.reset();
+    batch_.reset();
+    inflight_ = 0;
+}
+
+int DmaStreamReader::poll(int max_events) {
+    if (!mem_) return 0;
+    int n = tp_.drainAioCompletions(max_events);
+    deliver();
+    refill();
+    return n;
+}
+
+const DmaStreamReader::Frame* DmaStreamReader::acquire() {
+    if (!mem_) return nullptr;
+    uint32_t idx = static_cast<uint32_t>(read_seq_ % cfg_.depth);
+    Slot& slot = slots_[idx];
+    if (slot.state == State::Held) return &current_;
+    if (slot.state != State::Ready || slot.seq != read_seq_) return nullptr;
+    slot.state = State::Held;
+    current_.data = mem_ + static_cast<size_t>(idx) * cfg_.frame_size;
+    current_.len = slot.res > 0 ? static_cast<size_t>(slot.res) : 0;
+    current_.seq = slot.seq;
+    current_.status = slot.res;
+    return &current_;
+}
+
+void DmaStreamReader::release() {
+    if (!mem_) return;
+    Slot& slot = slots_[read_seq_ % cfg_.depth];
+    if (slot.state != State::Held) return;
+    slot.state = State::Free;
+    ++read_seq_;
+    refill();
+}
+
+void DmaStreamReader::on_complete(void* token, ssize_t res) {
+    Slot* base = slots_.get();
+    Slot* slot = static_cast<Slot*>(token);
+    if (!base || slot < base || slot >= base + cfg_.depth || slot->state != State::InFlight) {
+        LOGW("dma_stream", "complete", EINVAL, "unknown token");
+        return;
+    }
+    slot->res = res;
+    slot->state = State::Ready;
+    --inflight_;
+    ++stats_.completed;
+    if (res != static_cast<ssize_t>(cfg_.frame_size)) ++stats_.errors;
+}
+
+void DmaStreamReader::deliver() {
+    if (!handler_) return;
+    for (;;) {
+        uint32_t idx = static_cast<uint32_t>(read_seq_ % cfg_.depth);
+        Slot& slot = slots_[idx];
+        if (slot.state != State::Ready || slot.seq != read_seq_) break;
+        Frame f;
+        f.data = mem_ + static_cast<size_t>(idx) * cfg_.frame_size;
+        f.len = slot.res > 0 ? static_cast<size_t>(slot.res) : 0;
+        f.seq = slot.seq;
+        f.status = slot.res;
+        handler_(f);
+        slot.state = State::Free;
+        ++read_seq_;
+    }
+}
+
+void DmaStreamReader::refill() {
+    if (!running_) return;
+    uint32_t count = 0;
+    while (count < cfg_.depth) {
+        uint32_t idx = static_cast<uint32_t>(submit_seq_ % cfg_.depth);
+        Slot& slot = slots_[idx];
+        if (slot.state == State::Ready && cfg_.drop_oldest && slot.seq == read_seq_) {
+            // 消费者落后：丢弃最旧未消费帧，保持采集不断流
+            slot.state = State::Free;
+            ++read_seq_;
+            ++stats_.dropped;
+        }
+        if (slot.state != State::Free) {
+            if (slot.state != State::InFlight && !stalled_) {
+                ++stats_.stalls;
+                stalled_ = true;
+            }
+            break;
+        }
+        AsyncRequest& req = batch_[count++];
+        req.is_write = false;
+        req.channel = cfg_.channel;
+        req.buf = mem_ + static_cast<size_t>(idx) * cfg_.frame_size;
+        req.len = cfg_.frame_size;
+        req.device_offset = cfg_.device_offset + (submit_seq_ % cfg_.device_slots) * cfg_.device_stride;
+        req.token = &slot;
+        slot.state = State::InFlight;
+        slot.seq = submit_seq_++;
+    }
+    if (count == 0) return;
+
+    int rc = tp_.submitAsyncBatch(batch_.get(), count);
+    uint32_t accepted = rc > 0 ? static_cast<uint32_t>(rc) : 0;
+    // 未被接受的请求位于批尾，回退序号与状态，下次 poll 重试
+    for (uint32_t i = accepted; i < count; ++i) {
+        static_cast<Slot*>(batch_[i].token)->state = State::Free;
+    }
+    submit_seq_ -= (count - accepted);
+    if (accepted < count) {
+        LOGW("dma_stream", "submit", rc < 0 ? -rc : EAGAIN, "accepted=%u/%u", accepted, count);
+    }
+    if (accepted > 0) stalled_ = false;
+    inflight_ += accepted;
+    stats_.submitted += accepted;
+}
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,112 @@
+/**
+ * @file DmaStreamReader.h
+ * @brief 流式 C2H 读取：N 个缓冲轮转在途，完成即按序交付并自动重新提交
+ *
+ * 设计要点：
+ * - 建立在 IDeviceTransport 带标记异步接口之上，缓冲在 start 时一次性分配并批量提交。
+ * - 完成通知经传输层的完成 eventfd（getEventFd）交给上层 event loop，poll() 收割并交付。
+ * - 帧按序号顺序交付；消费者未归还缓冲时暂停提交（反压），或按配置丢弃最旧未消费帧。
+ * - 非线程安全：poll/acquire/release 须在同一线程调用（通常为 event loop 线程）。
+ * - 独占传输层的带标记完成回调。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+struct DmaStreamConfig {
+    int      channel = 0;
+    size_t   frame_size = 64 * 1024;
+    uint32_t depth = 4;             // 缓冲总数（在途 + 待消费）
+    uint64_t device_offset = 0;     // 首帧设备偏移
+    uint64_t device_stride = 0;     // 相邻帧设备偏移增量；0 表示每帧读同一地址
+    uint32_t device_slots = 1;      // 设备侧帧槽数量，偏移按 seq % device_slots 回绕
+    bool     drop_oldest = false;   // 消费者落后时：true 丢弃最旧未消费帧继续采集；false 暂停提交
+};
+
+class DmaStreamReader {
+public:
+    struct Frame {
+        const uint8_t* data = nullptr;
+        size_t   len = 0;
+        uint64_t seq = 0;
+        ssize_t  status = 0;        // 传输结果：字节数或 -errno
+    };
+    // 推模式回调：返回后缓冲即被回收并重新提交
+    using FrameHandler = std::function<void(const Frame&)>;
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t errors = 0;        // 传输失败或短读
+        uint64_t stalls = 0;        // 因消费者未归还缓冲而暂停提交的次数
+        uint64_t dropped = 0;       // drop_oldest 模式下丢弃的帧
+    };
+
+    explicit DmaStreamReader(IDeviceTransport& tp) : tp_(tp) {}
+    ~DmaStreamReader() { stop(); }
+
+    DmaStreamReader(const DmaStreamReader&) = delete;
+    DmaStreamReader& operator=(const DmaStreamReader&) = delete;
+
+    // 分配缓冲并提交首批请求；handler 为空时使用 acquire/release 拉取
+    bool start(const DmaStreamConfig& cfg, FrameHandler handler = nullptr);
+    // 停止提交并等待在途请求完成（最长 timeout_ms）
+    void stop(int timeout_ms = 1000);
+    bool running() const { return running_; }
+
+    // 完成通知 fd：可读时调用 poll()
+    int getEventFd() const { return tp_.getAioEventFd(); }
+    // 收割完成、交付帧（推模式）并重新提交空闲缓冲；返回本次完成的请求数
+    int poll(int max_events = 64);
+
+    // 拉模式：取最旧的已完成帧（未归还前不会再次取到下一帧）
+    const Frame* acquire();
+    void release();
+
+    // 缓冲区域，可用于 XdmaTransport::registerDmaBuffers
+    void*  bufferBase() const { return mem_; }
+    size_t bufferBytes() const { return mem_bytes_; }
+
+    const Stats& stats() const { return stats_; }
+    uint32_t inFlight() const { return inflight_; }
+
+private:
+    enum class State : uint8_t { Free, InFlight, Ready, Held };
+    struct Slot {
+        State    state = State::Free;
+        uint64_t seq = 0;
+        ssize_t  res = 0;
+    };
+
+    void on_complete(void* token, ssize_t res);
+    void deliver();
+    void refill();
+
+    IDeviceTransport& tp_;
+    DmaStreamConfig cfg_{};
+    FrameHandler handler_ = nullptr;
+    bool running_ = false;
+
+    uint8_t* mem_ = nullptr;
+    size_t mem_bytes_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<AsyncRequest[]> batch_;
+    uint64_t submit_seq_ = 0;   // 下一个待提交的帧序号
+    uint64_t read_seq_ = 0;     // 下一个待交付的帧序号
+    uint32_t inflight_ = 0;
+    bool stalled_ = false;
+    Frame current_{};
+    Stats stats_{};
+};
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
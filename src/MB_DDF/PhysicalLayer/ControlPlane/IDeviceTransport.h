@@ -10,14 +10,30 @@
 #pragma once
 
 #include "MB_DDF/PhysicalLayer/Types.h"
+#include <cerrno>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <span>
 
 namespace MB_DDF {
 namespace PhysicalLayer {
 namespace ControlPlane {
 
+// 带用户标记的异步大块读写请求（用于批量提交）
+struct AsyncRequest {
+    bool     is_write{false};   // true: H2C 写；false: C2H 读
+    int      channel{0};
+    void*    buf{nullptr};      // 写请求时仅读取该缓冲
+    size_t   len{0};
+    uint64_t device_offset{0};
+    void*    token{nullptr};    // 用户标记，完成时原样回传
+};
+
+// 带标记的异步完成回调：token 为提交时的用户标记，res 为传输字节数或 -errno
+using AsyncCompletion = std::function<void(void* token, bool is_write, ssize_t res)>;
+
 class IDeviceTransport {
 public:
     virtual ~IDeviceTransport() = default;
@@ -37,6 +53,15 @@ public:
     virtual bool   readReg32(uint64_t offset, uint32_t& val) const = 0;
     virtual bool   writeReg32(uint64_t offset, uint32_t val) = 0;
 
+    // 突发寄存器访问：offset 起连续 N 个 32 位字，一次边界检查后顺序访问（访问顺序与下标一致）
+    // 默认逐字回退到 readReg32/writeReg32；MMIO/SPI 后端覆写为批量实现
+    virtual bool   readRegs32(uint64_t offset, std::span<uint32_t> out) const;
+    virtual bool   writeRegs32(uint64_t offset, std::span<const uint32_t> in);
+    // 字节块拷贝（设备字节序为小端，offset 需 4 字节对齐）：按整字访问，
+    // 写入时尾部不足一字的部分补零写整字，读取时仅拷出 len 字节
+    virtual bool   copyToDevice(uint64_t offset, const void* src, size_t len);
+    virtual bool   copyFromDevice(uint64_t offset, void* dst, size_t len) const;
+
     // 原始半双工传输接口（SPI 类），tx/rx 至少一个非空，len>0
     // 非 SPI 的实现可直接返回 false 表示不支持
     virtual bool   xfer(const uint8_t* tx, uint8_t* rx, size_t len) = 0;
@@ -58,6 +83,16 @@ public:
     // 异步大块读写发起，不再逐次传入回调
     virtual bool   continuousWriteAsync(int channel, const void* buf, size_t len, uint64_t device_offset) = 0;
     virtual bool   continuousReadAsync(int channel, void* buf, size_t len, uint64_t device_offset) = 0;
+
+    // 带标记的异步接口（可选）：多个请求一次提交，完成时按 token 回调
+    // submitAsyncBatch 返回成功入队的请求数（可能小于 count），<0 表示错误（-errno）
+    virtual void   setOnAsyncComplete(AsyncCompletion cb) { (void)cb; }
+    virtual int    submitAsyncBatch(const AsyncRequest* reqs, size_t count) { (void)reqs; (void)count; return -ENOSYS; }
+    bool           submitAsync(const AsyncRequest& req) { return submitAsyncBatch(&req, 1) == 1; }
+
+    // 异步完成通知 fd 与收割（未实现异步的后端返回 -1 / 0）
+    virtual int    getAioEventFd() const { return -1; }
+    virtual int    drainAioCompletions(int max_events) { (void)max_events; return 0; }
 };
 
 // 统一大小端转换（以小端为设备字节序）
@@ -90,6 +125,45 @@ inline uint32_t ltoh_u32(uint32_t x) {
 #endif
 }
 
+inline bool IDeviceTransport::readRegs32(uint64_t offset, std::span<uint32_t> out) const {
+    for (size_t i = 0; i < out.size(); ++i) {
+        if (!readReg32(offset + i * sizeof(uint32_t), out[i])) return false;
+    }
+    return true;
+}
+
+inline bool IDeviceTransport::writeRegs32(uint64_t offset, std::span<const uint32_t> in) {
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (!writeReg32(offset + i * sizeof(uint32_t), in[i])) return false;
+    }
+    return true;
+}
+
+inline bool IDeviceTransport::copyToDevice(uint64_t offset, const void* src, size_t len) {
+    if (offset % sizeof(uint32_t) != 0 || (!src && len > 0)) return false;
+    const uint8_t* p = static_cast<const uint8_t*>(src);
+    for (size_t done = 0; done < len; done += sizeof(uint32_t)) {
+        uint8_t bytes[4] = {0, 0, 0, 0};
+        std::memcpy(bytes, p + done, len - done < 4 ? len - done : 4);
+        uint32_t w = 0;
+        std::memcpy(&w, bytes, sizeof(w));
+        if (!writeReg32(offset + done, ltoh_u32(w))) return false;
+    }
+    return true;
+}
+
+inline bool IDeviceTransport::copyFromDevice(uint64_t offset, void* dst, size_t len) const {
+    if (offset % sizeof(uint32_t) != 0 || (!dst && len > 0)) return false;
+    uint8_t* p = static_cast<uint8_t*>(dst);
+    for (size_t done = 0; done < len; done += sizeof(uint32_t)) {
+        uint32_t w = 0;
+        if (!readReg32(offset + done, w)) return false;
+        w = htol_u32(w);
+        std::memcpy(p + done, &w, len - done < 4 ? len - done : 4);
+    }
+    return true;
+}
+
 } // namespace ControlPlane
 } // namespace PhysicalLayer
 } // namespace MB_DDF
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * @file SharedDmaTransport.h
+ * @brief 设备视图：寄存器/事件走本设备独占的传输层，DMA 与异步接口转发到按通道共享的传输层
+ *
+ * 设计要点：
+ * - 同一 xdma 节点上的设备寄存器偏移、窗口与事件号各不相同，但 DMA 通道与异步后端（io_uring/libaio）
+ *   只需打开一次；本类把二者组合成一个 IDeviceTransport 交给设备对象。
+ * - 寄存器部分由 open() 打开（忽略 cfg 中的 DMA 通道）；DMA 部分由调用方传入已打开的共享实例，
+ *   close() 只关闭寄存器部分。
+ * - 共用 DMA 通道的设备共用异步完成回调：后设置者覆盖先设置者，与直接共享传输层时一致。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
+#include <memory>
+#include <utility>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+class SharedDmaTransport : public IDeviceTransport {
+public:
+    SharedDmaTransport(std::unique_ptr<IDeviceTransport> regs, std::shared_ptr<IDeviceTransport> dma)
+        : regs_(std::move(regs)), dma_(std::move(dma)) {}
+    ~SharedDmaTransport() override { close(); }
+
+    bool open(const TransportConfig& cfg) override {
+        TransportConfig rc = cfg;
+        rc.dma_h2c_channel = -1;
+        rc.dma_c2h_channel = -1;
+        return regs_->open(rc);
+    }
+    void close() override { regs_->close(); }
+
+    // 寄存器与事件：本设备的偏移/窗口/事件号
+    void*  getMappedBase() const override { return regs_->getMappedBase(); }
+    size_t getMappedLength() const override { return regs_->getMappedLength(); }
+    bool   readReg8(uint64_t offset, uint8_t& val) const override { return regs_->readReg8(offset, val); }
+    bool   writeReg8(uint64_t offset, uint8_t val) override { return regs_->writeReg8(offset, val); }
+    bool   readReg16(uint64_t offset, uint16_t& val) const override { return regs_->readReg16(offset, val); }
+    bool   writeReg16(uint64_t offset, uint16_t val) override { return regs_->writeReg16(offset, val); }
+    bool   readReg32(uint64_t offset, uint32_t& val) const override { return regs_->readReg32(offset, val); }
+    bool   writeReg32(uint64_t offset, uint32_t val) override { return regs_->writeReg32(offset, val); }
+    bool   readRegs32(uint64_t offset, std::span<uint32_t> out) const override { return regs_->readRegs32(offset, out); }
+    bool   writeRegs32(uint64_t offset, std::span<const uint32_t> in) override { return regs_->writeRegs32(offset, in); }
+    bool   copyToDevice(uint64_t offset, const void* src, size_t len) override { return regs_->copyToDevice(offset, src, len); }
+    bool   copyFromDevice(uint64_t offset, void* dst, size_t len) const override { return regs_->copyFromDevice(offset, dst, len); }
+    bool   xfer(const uint8_t* tx, uint8_t* rx, size_t len) override { return regs_->xfer(tx, rx, len); }
+
+    int    waitEvent(uint32_t* bitmap, uint32_t timeout_ms) override { return regs_->waitEvent(bitmap, timeout_ms); }
+    int    getEventFd() const override { return regs_->getEventFd(); }
+
+    // DMA 与异步：共享实例
+    bool   continuousWrite(int channel, const void* buf, size_t len) override { return dma_->continuousWrite(channel, buf, len); }
+    bool   continuousRead(int channel, void* buf, size_t len) override { return dma_->continuousRead(channel, buf, len); }
+    bool   continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) override {
+        return dma_->continuousWriteAt(channel, buf, len, device_offset);
+    }
+    bool   continuousReadAt(int channel, void* buf, size_t len, uint64_t device_offset) override {
+        return dma_->continuousReadAt(channel, buf, len, device_offset);
+    }
+
+    void   setOnContinuousWriteComplete(std::function<void(ssize_t)> cb) override { dma_->setOnContinuousWriteComplete(std::move(cb)); }
+    void   setOnContinuousReadComplete(std::function<void(ssize_t)> cb) override { dma_->setOnContinuousReadComplete(std::move(cb)); }
+
+    bool   continuousWriteAsync(int channel, const void* buf, size_t len, uint64_t device_offset) override {
+        return dma_->continuousWriteAsync(channel, buf, len, device_offset);
+    }
+    bool   continuousReadAsync(int channel, void* buf, size_t len, uint64_t device_offset) override {
+        return dma_->continuousReadAsync(channel, buf, len, device_offset);
+    }
+
+    void   setOnAsyncComplete(AsyncCompletion cb) override { dma_->setOnAsyncComplete(std::move(cb)); }
+    int    submitAsyncBatch(const AsyncRequest* reqs, size_t count) override { return dma_->submitAsyncBatch(reqs, count); }
+    int    getAioEventFd() const override { return dma_->getAioEventFd(); }
+    int    drainAioCompletions(int max_events) override { return dma_->drainAioCompletions(max_events); }
+
+private:
+    std::unique_ptr<IDeviceTransport> regs_;
+    std::shared_ptr<IDeviceTransport> dma_;
+};
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
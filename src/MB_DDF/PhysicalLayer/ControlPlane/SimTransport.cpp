@@ -0,0 +1,438 @@
+/**
+ * @file SimTransport.cpp
+ */
+#include "MB_DDF/PhysicalLayer/ControlPlane/SimTransport.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+namespace {
+void notify_eventfd(int fd) {
+    if (fd < 0) return;
+    uint64_t one = 1;
+    ssize_t n = ::write(fd, &one, sizeof(one));
+    (void)n;
+}
+} // namespace
+
+void SimScriptModel::onWrite(SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) {
+    (void)width;
+    auto it = writes_.find(offset);
+    if (it != writes_.end()) it->second(tp, offset, value);
+}
+
+void SimScriptModel::onRead(SimTransport& tp, uint64_t offset, unsigned width) {
+    (void)width;
+    auto it = reads_.find(offset);
+    if (it != reads_.end()) it->second(tp, offset);
+}
+
+uint64_t SimTransport::now_ns() {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void SimTransport::setModel(std::shared_ptr<SimDeviceModel> model) {
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    model_ = std::move(model);
+    if (model_ && regs_) model_->reset(*this);
+}
+
+bool SimTransport::open(const TransportConfig& cfg) {
+    if (regs_) return true;
+    cfg_ = cfg;
+
+    // 寄存器文件：memfd 映射，页对齐
+    long ps = ::sysconf(_SC_PAGESIZE);
+    size_t page = ps > 0 ? static_cast<size_t>(ps) : 4096;
+    size_t want = cfg_.register_window ? cfg_.register_window : opt_.register_size;
+    regs_len_ = (want + page - 1) / page * page;
+    regs_fd_ = ::memfd_create("mb_ddf_sim_regs", MFD_CLOEXEC);
+    if (regs_fd_ < 0 || ::ftruncate(regs_fd_, static_cast<off_t>(regs_len_)) != 0) {
+        LOGE("sim", "memfd_regs", errno, "len=%zu", regs_len_);
+        close();
+        return false;
+    }
+    void* base = ::mmap(nullptr, regs_len_, PROT_READ | PROT_WRITE, MAP_SHARED, regs_fd_, 0);
+    if (base == MAP_FAILED) {
+        LOGE("sim", "mmap_regs", errno, "len=%zu", regs_len_);
+        close();
+        return false;
+    }
+    regs_ = static_cast<uint8_t*>(base);
+
+    event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    aio_event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0 || aio_event_fd_ < 0) {
+        LOGE("sim", "eventfd", errno, "");
+        close();
+        return false;
+    }
+
+    // DMA 后备：指定文件或 memfd
+    if (!opt_.dma_backing.empty()) {
+        dma_fd_ = ::open(opt_.dma_backing.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    } else {
+        dma_fd_ = ::memfd_create("mb_ddf_sim_dma", MFD_CLOEXEC);
+        if (dma_fd_ >= 0 && ::ftruncate(dma_fd_, static_cast<off_t>(opt_.dma_size)) != 0) {
+            ::close(dma_fd_);
+            dma_fd_ = -1;
+        }
+    }
+    if (dma_fd_ < 0) {
+        LOGW("sim", "dma_backing", errno, "path=%s, DMA disabled", opt_.dma_backing.c_str());
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(reg_mu_);
+        if (model_) model_->reset(*this);
+    }
+
+    stop_ = false;
+    worker_ = std::thread([this]() { worker_loop(); });
+    LOGI("sim", "open", 0, "regs=%zu dma_fd=%d tick_us=%u", regs_len_, dma_fd_, opt_.tick_us);
+    return true;
+}
+
+void SimTransport::close() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk(io_mu_);
+            stop_ = true;
+        }
+        io_cv_.notify_all();
+        worker_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lk(io_mu_);
+        pending_io_.clear();
+        done_io_.clear();
+    }
+    if (regs_) { ::munmap(regs_, regs_len_); regs_ = nullptr; }
+    regs_len_ = 0;
+    if (regs_fd_ >= 0) { ::close(regs_fd_); regs_fd_ = -1; }
+    if (event_fd_ >= 0) { ::close(event_fd_); event_fd_ = -1; }
+    if (aio_event_fd_ >= 0) { ::close(aio_event_fd_); aio_event_fd_ = -1; }
+    if (dma_fd_ >= 0) { ::close(dma_fd_); dma_fd_ = -1; }
+    pending_events_.store(0, std::memory_order_relaxed);
+}
+
+bool SimTransport::in_range(const char* op, uint64_t offset, size_t bytes, size_t align) const {
+    if (!regs_) {
+        LOGW("sim", op, ENODEV, "not open");
+        return false;
+    }
+    if (offset % align != 0 || offset > regs_len_ || bytes > regs_len_ - offset) {
+        LOGE("sim", op, EINVAL, "offset=%llu bytes=%zu len=%zu", (unsigned long long)offset, bytes, regs_len_);
+        return false;
+    }
+    return true;
+}
+
+// ---- 模型侧原始访问（小端设备字节序） ----
+
+uint8_t SimTransport::peek8(uint64_t offset) const { return regs_[offset]; }
+
+uint16_t SimTransport::peek16(uint64_t offset) const {
+    uint16_t v;
+    std::memcpy(&v, regs_ + offset, sizeof(v));
+    return ltoh_u16(v);
+}
+
+uint32_t SimTransport::peek32(uint64_t offset) const {
+    uint32_t v;
+    std::memcpy(&v, regs_ + offset, sizeof(v));
+    return ltoh_u32(v);
+}
+
+void SimTransport::poke8(uint64_t offset, uint8_t val) { regs_[offset] = val; }
+
+void SimTransport::poke16(uint64_t offset, uint16_t val) {
+    uint16_t v = htol_u16(val);
+    std::memcpy(regs_ + offset, &v, sizeof(v));
+}
+
+void SimTransport::poke32(uint64_t offset, uint32_t val) {
+    uint32_t v = htol_u32(val);
+    std::memcpy(regs_ + offset, &v, sizeof(v));
+}
+
+void SimTransport::raiseEvent(uint32_t bitmap) {
+    pending_events_.fetch_or(bitmap, std::memory_order_acq_rel);
+    notify_eventfd(event_fd_);
+}
+
+void SimTransport::withLock(const std::function<void()>& fn) {
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    fn();
+}
+
+// ---- 驱动侧寄存器访问：锁内访问并回调模型 ----
+// 读访问在仿真中带副作用（读后回调），故 const 接口内部转为可变引用
+
+bool SimTransport::readReg8(uint64_t offset, uint8_t& val) const {
+    if (!in_range("readReg8", offset, 1, 1)) return false;
+    auto& self = const_cast<SimTransport&>(*this);
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    val = peek8(offset);
+    if (model_) model_->onRead(self, offset, 1);
+    return true;
+}
+
+bool SimTransport::writeReg8(uint64_t offset, uint8_t val) {
+    if (!in_range("writeReg8", offset, 1, 1)) return false;
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    poke8(offset, val);
+    if (model_) model_->onWrite(*this, offset, val, 1);
+    return true;
+}
+
+bool SimTransport::readReg16(uint64_t offset, uint16_t& val) const {
+    if (!in_range("readReg16", offset, 2, 2)) return false;
+    auto& self = const_cast<SimTransport&>(*this);
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    val = peek16(offset);
+    if (model_) model_->onRead(self, offset, 2);
+    return true;
+}
+
+bool SimTransport::writeReg16(uint64_t offset, uint16_t val) {
+    if (!in_range("writeReg16", offset, 2, 2)) return false;
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    poke16(offset, val);
+    if (model_) model_->onWrite(*this, offset, val, 2);
+    return true;
+}
+
+bool SimTransport::readReg32(uint64_t offset, uint32_t& val) const {
+    if (!in_range("readReg32", offset, 4, 4)) return false;
+    auto& self = const_cast<SimTransport&>(*this);
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    val = peek32(offset);
+    if (model_) model_->onRead(self, offset, 4);
+    return true;
+}
+
+bool SimTransport::writeReg32(uint64_t offset, uint32_t val) {
+    if (!in_range("writeReg32", offset, 4, 4)) return false;
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    poke32(offset, val);
+    if (model_) model_->onWrite(*this, offset, val, 4);
+    return true;
+}
+
+bool SimTransport::readRegs32(uint64_t offset, std::span<uint32_t> out) const {
+    if (!in_range("readRegs32", offset, out.size_bytes(), 4)) return false;
+    auto& self = const_cast<SimTransport&>(*this);
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    for (size_t i = 0; i < out.size(); ++i) {
+        uint64_t off = offset + i * sizeof(uint32_t);
+        out[i] = peek32(off);
+        if (model_) model_->onRead(self, off, 4);
+    }
+    return true;
+}
+
+bool SimTransport::writeRegs32(uint64_t offset, std::span<const uint32_t> in) {
+    if (!in_range("writeRegs32", offset, in.size_bytes(), 4)) return false;
+    std::lock_guard<std::mutex> lk(reg_mu_);
+    for (size_t i = 0; i < in.size(); ++i) {
+        uint64_t off = offset + i * sizeof(uint32_t);
+        poke32(off, in[i]);
+        if (model_) model_->onWrite(*this, off, in[i], 4);
+    }
+    return true;
+}
+
+// ---- 事件 ----
+
+int SimTransport::waitEvent(uint32_t* bitmap, uint32_t timeout_ms) {
+    if (event_fd_ < 0) return -1;
+    uint64_t cnt = 0;
+    if (::read(event_fd_, &cnt, sizeof(cnt)) != sizeof(cnt)) {
+        struct pollfd pfd{ event_fd_, POLLIN, 0 };
+        int ret = ::poll(&pfd, 1, timeout_ms == UINT32_MAX ? -1 : static_cast<int>(timeout_ms));
+        if (ret < 0) {
+            LOGE("sim", "waitEvent", errno, "poll error fd=%d", event_fd_);
+            return -1;
+        }
+        if (ret == 0 || ::read(event_fd_, &cnt, sizeof(cnt)) != sizeof(cnt)) return 0;
+    }
+    uint32_t bits = pending_events_.exchange(0, std::memory_order_acq_rel);
+    if (bitmap) *bitmap = bits;
+    return 1;
+}
+
+// ---- DMA ----
+
+ssize_t SimTransport::dma_rw(bool is_write, void* buf, size_t len, uint64_t off) {
+    if (dma_fd_ < 0) return -ENODEV;
+    size_t done = 0;
+    while (done < len) {
+        ssize_t n = is_write
+            ? ::pwrite(dma_fd_, static_cast<const uint8_t*>(buf) + done, len - done, static_cast<off_t>(off + done))
+            : ::pread(dma_fd_, static_cast<uint8_t*>(buf) + done, len - done, static_cast<off_t>(off + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -errno;
+        }
+        if (n == 0) break;
+        done += static_cast<size_t>(n);
+    }
+    return static_cast<ssize_t>(done);
+}
+
+bool SimTransport::continuousWrite(int channel, const void* buf, size_t len) {
+    return continuousWriteAt(channel, buf, len, default_offset_);
+}
+
+bool SimTransport::continuousRead(int channel, void* buf, size_t len) {
+    return continuousReadAt(channel, buf, len, default_offset_);
+}
+
+bool SimTransport::continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) {
+    (void)channel;
+    if (!buf || len == 0) return false;
+    return dma_rw(true, const_cast<void*>(buf), len, device_offset) == static_cast<ssize_t>(len);
+}
+
+bool SimTransport::continuousReadAt(int channel, void* buf, size_t len, uint64_t device_offset) {
+    (void)channel;
+    if (!buf || len == 0) return false;
+    return dma_rw(false, buf, len, device_offset) == static_cast<ssize_t>(len);
+}
+
+bool SimTransport::enqueue(const AsyncRequest& req, bool tagged) {
+    if (!worker_.joinable() || dma_fd_ < 0) return false;
+    {
+        std::lock_guard<std::mutex> lk(io_mu_);
+        pending_io_.push_back(PendingIo{req, tagged});
+    }
+    io_cv_.notify_one();
+    return true;
+}
+
+bool SimTransport::continuousWriteAsync(int channel, const void* buf, size_t len, uint64_t device_offset) {
+    AsyncRequest req;
+    req.is_write = true;
+    req.channel = channel;
+    req.buf = const_cast<void*>(buf);
+    req.len = len;
+    req.device_offset = device_offset;
+    return buf && len > 0 && enqueue(req, false);
+}
+
+bool SimTransport::continuousReadAsync(int channel, void* buf, size_t len, uint64_t device_offset) {
+    AsyncRequest req;
+    req.is_write = false;
+    req.channel = channel;
+    req.buf = buf;
+    req.len = len;
+    req.device_offset = device_offset;
+    return buf && len > 0 && enqueue(req, false);
+}
+
+int SimTransport::submitAsyncBatch(const AsyncRequest* reqs, size_t count) {
+    if (!reqs) return -EINVAL;
+    if (!worker_.joinable() || dma_fd_ < 0) return -ENODEV;
+    size_t accepted = 0;
+    {
+        std::lock_guard<std::mutex> lk(io_mu_);
+        for (; accepted < count; ++accepted) {
+            const AsyncRequest& r = reqs[accepted];
+            if (!r.buf || r.len == 0) break;
+            pending_io_.push_back(PendingIo{r, true});
+        }
+    }
+    if (accepted > 0) io_cv_.notify_one();
+    return accepted > 0 ? static_cast<int>(accepted) : -EINVAL;
+}
+
+int SimTransport::drainAioCompletions(int max_events) {
+    if (aio_event_fd_ >= 0) {
+        uint64_t cnt = 0;
+        ssize_t n = ::read(aio_event_fd_, &cnt, sizeof(cnt));
+        (void)n;
+    }
+    int handled = 0;
+    while (max_events <= 0 || handled < max_events) {
+        DoneIo d;
+        {
+            std::lock_guard<std::mutex> lk(io_mu_);
+            if (done_io_.empty()) break;
+            d = done_io_.front();
+            done_io_.pop_front();
+        }
+        if (d.tagged) {
+            if (on_async_complete_) on_async_complete_(d.token, d.is_write, d.res);
+        } else if (d.is_write) {
+            if (on_write_complete_) on_write_complete_(d.res);
+        } else {
+            if (on_read_complete_) on_read_complete_(d.res);
+        }
+        ++handled;
+    }
+    // 未收割完：补发通知，避免边沿触发的上层 loop 丢失剩余完成
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lk(io_mu_);
+        more = !done_io_.empty();
+    }
+    if (more) notify_eventfd(aio_event_fd_);
+    return handled;
+}
+
+// ---- 后台线程：执行异步 DMA 并周期驱动模型 ----
+
+void SimTransport::worker_loop() {
+    const auto period = std::chrono::microseconds(opt_.tick_us ? opt_.tick_us : 100000);
+    auto next_tick = std::chrono::steady_clock::now() + period;
+    std::unique_lock<std::mutex> lk(io_mu_);
+    while (!stop_) {
+        io_cv_.wait_until(lk, next_tick, [this]() { return stop_ || !pending_io_.empty(); });
+        if (stop_) break;
+
+        bool completed = false;
+        while (!pending_io_.empty()) {
+            PendingIo io = pending_io_.front();
+            pending_io_.pop_front();
+            lk.unlock();
+            if (opt_.dma_delay_us) std::this_thread::sleep_for(std::chrono::microseconds(opt_.dma_delay_us));
+            ssize_t res = dma_rw(io.req.is_write, io.req.buf, io.req.len, io.req.device_offset);
+            lk.lock();
+            done_io_.push_back(DoneIo{io.req.token, io.req.is_write, io.tagged, res});
+            completed = true;
+        }
+        if (completed) notify_eventfd(aio_event_fd_);
+
+        if (opt_.tick_us && std::chrono::steady_clock::now() >= next_tick) {
+            lk.unlock();
+            {
+                std::lock_guard<std::mutex> rlk(reg_mu_);
+                if (model_) model_->tick(*this, now_ns());
+            }
+            lk.lock();
+            next_tick += period;
+            auto now = std::chrono::steady_clock::now();
+            if (next_tick < now) next_tick = now + period;  // 落后时不追赶
+        } else if (!opt_.tick_us) {
+            next_tick = std::chrono::steady_clock::now() + period;
+        }
+    }
+}
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,203 @@
+/**
+ * @file SimTransport.h
+ * @brief 内存仿真控制面：memfd 寄存器文件 + eventfd 事件 + 可脚本化设备模型
+ *
+ * 设计要点：
+ * - 寄存器文件为 memfd 映射，getMappedBase 非空，驱动的"已映射"检查照常通过。
+ * - 经 readReg/writeReg 系列接口的访问在锁内串行化，并回调设备模型：写后（onWrite）、读后（onRead，
+ *   用于 FIFO 出队等读副作用）；直接访问映射基址的代码绕过模型。
+ * - 后台线程按 tick 周期驱动模型（延迟、ADC 跟随等），并执行异步 DMA 请求。
+ * - DMA 落在后备文件上（未指定时为 memfd），通道号忽略，设备偏移即文件偏移。
+ * - 事件经 eventfd 暴露：模型调用 raiseEvent(bitmap) 置位，waitEvent 消费并返回累计位图。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+class SimTransport;
+
+// 设备模型接口：回调均在 SimTransport 的寄存器锁内执行，模型通过 peek*/poke* 访问寄存器文件
+class SimDeviceModel {
+public:
+    virtual ~SimDeviceModel() = default;
+
+    // open 成功后调用一次，用于写入寄存器复位值
+    virtual void reset(SimTransport& tp) { (void)tp; }
+    // 寄存器写入寄存器文件之后调用；width 为访问字节数（1/2/4）
+    virtual void onWrite(SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) {
+        (void)tp; (void)offset; (void)value; (void)width;
+    }
+    // 寄存器值被读出之后调用（读副作用）
+    virtual void onRead(SimTransport& tp, uint64_t offset, unsigned width) {
+        (void)tp; (void)offset; (void)width;
+    }
+    // 后台线程周期调用；now_ns 为 CLOCK_MONOTONIC 时间
+    virtual void tick(SimTransport& tp, uint64_t now_ns) { (void)tp; (void)now_ns; }
+};
+
+// 脚本模型：按寄存器偏移挂接 lambda，便于测试中快速描述简单设备行为
+class SimScriptModel : public SimDeviceModel {
+public:
+    using WriteHook = std::function<void(SimTransport&, uint64_t offset, uint32_t value)>;
+    using ReadHook  = std::function<void(SimTransport&, uint64_t offset)>;
+    using TickHook  = std::function<void(SimTransport&, uint64_t now_ns)>;
+    using ResetHook = std::function<void(SimTransport&)>;
+
+    SimScriptModel& onReset(ResetHook fn) { reset_ = std::move(fn); return *this; }
+    SimScriptModel& onWrite(uint64_t offset, WriteHook fn) { writes_[offset] = std::move(fn); return *this; }
+    SimScriptModel& onRead(uint64_t offset, ReadHook fn) { reads_[offset] = std::move(fn); return *this; }
+    SimScriptModel& onTick(TickHook fn) { tick_ = std::move(fn); return *this; }
+
+    void reset(SimTransport& tp) override { if (reset_) reset_(tp); }
+    void onWrite(SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) override;
+    void onRead(SimTransport& tp, uint64_t offset, unsigned width) override;
+    void tick(SimTransport& tp, uint64_t now_ns) override { if (tick_) tick_(tp, now_ns); }
+
+private:
+    ResetHook reset_;
+    std::unordered_map<uint64_t, WriteHook> writes_;
+    std::unordered_map<uint64_t, ReadHook> reads_;
+    TickHook tick_;
+};
+
+// 仿真参数（需在 open 之前设置）
+struct SimOptions {
+    size_t      register_size = 64 * 1024;      // 寄存器文件大小；TransportConfig::register_window 非 0 时优先
+    std::string dma_backing;                    // DMA 后备文件路径；空则使用 memfd
+    size_t      dma_size = 16 * 1024 * 1024;    // memfd 后备大小
+    uint32_t    tick_us = 100;                  // 模型 tick 周期；0 关闭周期 tick（异步 DMA 仍由后台线程执行）
+    uint32_t    dma_delay_us = 0;               // 每个异步 DMA 请求执行前的附加延迟（模拟传输耗时）
+};
+
+class SimTransport : public IDeviceTransport {
+public:
+    SimTransport() = default;
+    explicit SimTransport(std::shared_ptr<SimDeviceModel> model) : model_(std::move(model)) {}
+    ~SimTransport() override { close(); }
+
+    SimTransport(const SimTransport&) = delete;
+    SimTransport& operator=(const SimTransport&) = delete;
+
+    void setOptions(const SimOptions& opt) { opt_ = opt; }
+    const SimOptions& options() const { return opt_; }
+    // 更换模型：open 之前设置；open 之后设置会立即调用 reset
+    void setModel(std::shared_ptr<SimDeviceModel> model);
+    SimDeviceModel* model() const { return model_.get(); }
+
+    bool open(const TransportConfig& cfg) override;
+    void close() override;
+
+    void*  getMappedBase() const override { return regs_; }
+    size_t getMappedLength() const override { return regs_len_; }
+    bool readReg8(uint64_t offset, uint8_t& val) const override;
+    bool writeReg8(uint64_t offset, uint8_t val) override;
+    bool readReg16(uint64_t offset, uint16_t& val) const override;
+    bool writeReg16(uint64_t offset, uint16_t val) override;
+    bool readReg32(uint64_t offset, uint32_t& val) const override;
+    bool writeReg32(uint64_t offset, uint32_t val) override;
+    // 突发访问：整段只加锁一次，逐字回调模型（保持与硬件一致的访问顺序）
+    bool readRegs32(uint64_t offset, std::span<uint32_t> out) const override;
+    bool writeRegs32(uint64_t offset, std::span<const uint32_t> in) override;
+
+    bool xfer(const uint8_t* /*tx*/, uint8_t* /*rx*/, size_t /*len*/) override { return false; }
+
+    int waitEvent(uint32_t* bitmap, uint32_t timeout_ms) override;
+    int getEventFd() const override { return event_fd_; }
+
+    // 同步 DMA：直接读写后备文件
+    bool continuousWrite(int channel, const void* buf, size_t len) override;
+    bool continuousRead(int channel, void* buf, size_t len) override;
+    bool continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) override;
+    bool continuousReadAt(int channel, void* buf, size_t len, uint64_t device_offset) override;
+
+    // 异步 DMA：后台线程执行，完成经 getAioEventFd 通知，drainAioCompletions 在调用线程回调
+    void setOnContinuousWriteComplete(std::function<void(ssize_t)> cb) override { on_write_complete_ = std::move(cb); }
+    void setOnContinuousReadComplete(std::function<void(ssize_t)> cb) override { on_read_complete_ = std::move(cb); }
+    bool continuousWriteAsync(int channel, const void* buf, size_t len, uint64_t device_offset) override;
+    bool continuousReadAsync(int channel, void* buf, size_t len, uint64_t device_offset) override;
+    void setOnAsyncComplete(AsyncCompletion cb) override { on_async_complete_ = std::move(cb); }
+    int  submitAsyncBatch(const AsyncRequest* reqs, size_t count) override;
+    int  getAioEventFd() const override { return aio_event_fd_; }
+    int  drainAioCompletions(int max_events) override;
+
+    // 模型侧接口：不加锁、不回调模型（仅在模型回调内或无并发时使用）
+    uint8_t  peek8(uint64_t offset) const;
+    uint16_t peek16(uint64_t offset) const;
+    uint32_t peek32(uint64_t offset) const;
+    void     poke8(uint64_t offset, uint8_t val);
+    void     poke16(uint64_t offset, uint16_t val);
+    void     poke32(uint64_t offset, uint32_t val);
+    // 触发事件：bitmap 累计到下一次 waitEvent
+    void     raiseEvent(uint32_t bitmap);
+
+    // 测试侧接口：在寄存器锁内执行 fn（可安全地与后台 tick 并发操作模型状态）
+    void     withLock(const std::function<void()>& fn);
+    // DMA 后备 fd（测试可直接预置/校验数据）
+    int      dmaFd() const { return dma_fd_; }
+
+    static uint64_t now_ns();
+
+private:
+    struct PendingIo {
+        AsyncRequest req;
+        bool tagged = true;
+    };
+    struct DoneIo {
+        void*   token = nullptr;
+        bool    is_write = false;
+        bool    tagged = true;
+        ssize_t res = 0;
+    };
+
+    bool in_range(const char* op, uint64_t offset, size_t bytes, size_t align) const;
+    ssize_t dma_rw(bool is_write, void* buf, size_t len, uint64_t off);
+    bool enqueue(const AsyncRequest& req, bool tagged);
+    void worker_loop();
+
+    TransportConfig cfg_{};
+    SimOptions opt_{};
+    std::shared_ptr<SimDeviceModel> model_;
+
+    int      regs_fd_ = -1;
+    uint8_t* regs_ = nullptr;
+    size_t   regs_len_ = 0;
+    mutable std::mutex reg_mu_;
+
+    int event_fd_ = -1;
+    std::atomic<uint32_t> pending_events_{0};
+
+    int dma_fd_ = -1;
+    uint64_t default_offset_ = 0;
+
+    // 异步 DMA：提交队列由后台线程消费，完成队列由调用线程收割
+    int aio_event_fd_ = -1;
+    std::mutex io_mu_;
+    std::condition_variable io_cv_;
+    std::deque<PendingIo> pending_io_;
+    std::deque<DoneIo> done_io_;
+    std::function<void(ssize_t)> on_write_complete_ = nullptr;
+    std::function<void(ssize_t)> on_read_complete_ = nullptr;
+    AsyncCompletion on_async_complete_ = nullptr;
+
+    std::thread worker_;
+    bool stop_ = false;
+};
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -9,9 +9,12 @@
 #include <cerrno>
 #include <cstring>
 #include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <ctime>
 #include <cstdlib>
+#include <algorithm>
+#include <vector>
 
 namespace MB_DDF {
 namespace PhysicalLayer {
@@ -25,6 +28,23 @@ static int parse_int_env(const char* name, int defval) {
     if (v <= 0) return defval;
     return static_cast<int>(v);
 }
+// 读取 spidev 单条消息的字节上限；不可读时沿用内核默认值 4096
+static size_t read_spidev_bufsiz() {
+    size_t val = 4096;
+    int fd = ::open("/sys/module/spidev/parameters/bufsiz", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return val;
+    char buf[32] = {0};
+    ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+    ::close(fd);
+    if (n > 0) {
+        long v = std::strtol(buf, nullptr, 10);
+        if (v > 0) val = static_cast<size_t>(v);
+    }
+    return val;
+}
+static constexpr size_t kRegHeaderLen = 5; // cmd(1) + offset(4 LE)
+// 单条 SPI_IOC_MESSAGE 的传输段上限：ioctl 尺寸字段 14 位（16383 / 32 字节），取偶数便于成对
+static constexpr size_t kMaxTransfers = 510;
 static const char* parse_str_env(const char* name, const char* defval) {
     const char* s = ::getenv(name);
     return (s && *s) ? s : defval;
@@ -45,6 +65,10 @@ bool SpiTransport::open(const TransportConfig& cfg) {
     spi_speed_ = static_cast<uint32_t>(parse_int_env("MB_SPI_SPEED_HZ", static_cast<int>(spi_speed_)));
     spi_mode_  = static_cast<uint8_t>(parse_int_env("MB_SPI_MODE", spi_mode_));
     spi_bits_  = static_cast<uint8_t>(parse_int_env("MB_SPI_BITS", spi_bits_));
+    cmd_read_  = static_cast<uint8_t>(parse_int_env("MB_SPI_CMD_READ", cmd_read_));
+    cmd_write_ = static_cast<uint8_t>(parse_int_env("MB_SPI_CMD_WRITE", cmd_write_));
+    spi_bufsiz_ = read_spidev_bufsiz();
+    message_count_ = 0;
 
     // 打开 spidev 设备
     if (!cfg_.device_path.empty()) {
@@ -103,10 +127,14 @@ bool SpiTransport::open(const TransportConfig& cfg) {
         close();
         return false;
     }
+    if (spi_fd_ >= 0 && !start_async()) {
+        LOGW("spi", "async_engine", errno, "async transfers disabled");
+    }
     return true;
 }
 
 void SpiTransport::close() {
+    stop_async();
 #if MB_DDF_HAS_GPIOD
     if (line_) { ::gpiod_line_release(line_); line_ = nullptr; }
     if (chip_) { ::gpiod_chip_close(chip_); chip_ = nullptr; }
@@ -115,90 +143,425 @@ void SpiTransport::close() {
     if (spi_fd_ >= 0) { ::close(spi_fd_); spi_fd_ = -1; }
 }
 
+bool SpiTransport::spi_message(struct spi_ioc_transfer* tr, size_t n, const char* op) const {
+    if (spi_fd_ < 0 || n == 0 || n > kMaxTransfers) return false;
+    for (size_t i = 0; i < n; ++i) {
+        tr[i].speed_hz = spi_speed_;
+        tr[i].bits_per_word = spi_bits_;
+    }
+    // 等价于 SPI_IOC_MESSAGE(n)，n 为运行期值
+    unsigned long req = _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, n * sizeof(struct spi_ioc_transfer));
+    ++message_count_;
+    if (::ioctl(spi_fd_, req, tr) < 0) {
+        LOGE("spi", op, errno, "transfers=%zu", n);
+        return false;
+    }
+    return true;
+}
+
 bool SpiTransport::spi_transfer(const uint8_t* tx, uint8_t* rx, size_t len) const {
     if (spi_fd_ < 0 || (!tx && !rx) || len == 0) return false;
     struct spi_ioc_transfer tr{};
     tr.tx_buf = reinterpret_cast<__u64>(tx);
     tr.rx_buf = reinterpret_cast<__u64>(rx);
     tr.len = static_cast<__u32>(len);
-    tr.speed_hz = spi_speed_;
-    tr.bits_per_word = spi_bits_;
     tr.delay_usecs = 0;
     tr.cs_change = 0;
-    int rc = ::ioctl(spi_fd_, SPI_IOC_MESSAGE(1), &tr);
-    if (rc < 0) {
-        LOGE("spi", "SPI_IOC_MESSAGE", errno, "len=%zu", len);
-        return false;
-    }
-    return true;
+    return spi_message(&tr, 1, "SPI_IOC_MESSAGE");
 }
 
 bool SpiTransport::reg_read(uint64_t offset, void* out, size_t len) const {
-    LOGW("spi", "reg_read", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)out; (void)len;
-    return false;
+    if (spi_fd_ < 0 || !out || len == 0 || offset > 0xFFFFFFFFull) return false;
+    // 前导与数据段共用一次消息；数据段超过 bufsiz 时按块拆分为多条消息
+    const size_t max_payload = spi_bufsiz_ > kRegHeaderLen ? spi_bufsiz_ - kRegHeaderLen : 1;
+    uint8_t* dst = static_cast<uint8_t*>(out);
+    for (size_t done = 0; done < len;) {
+        size_t n = std::min(len - done, max_payload);
+        uint32_t addr = htol_u32(static_cast<uint32_t>(offset + done));
+        uint8_t hdr[kRegHeaderLen];
+        hdr[0] = cmd_read_;
+        std::memcpy(hdr + 1, &addr, sizeof(addr));
+
+        struct spi_ioc_transfer tr[2]{};
+        tr[0].tx_buf = reinterpret_cast<__u64>(hdr);
+        tr[0].len = kRegHeaderLen;
+        tr[1].rx_buf = reinterpret_cast<__u64>(dst + done);
+        tr[1].len = static_cast<__u32>(n);
+        if (!spi_message(tr, 2, "reg_read")) return false;
+        done += n;
+    }
+    return true;
 }
 
 bool SpiTransport::reg_write(uint64_t offset, const void* in, size_t len) {
-    LOGW("spi", "reg_write", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)in; (void)len;
-    return false;
+    if (spi_fd_ < 0 || !in || len == 0 || offset > 0xFFFFFFFFull) return false;
+    const size_t max_payload = spi_bufsiz_ > kRegHeaderLen ? spi_bufsiz_ - kRegHeaderLen : 1;
+    const uint8_t* src = static_cast<const uint8_t*>(in);
+    for (size_t done = 0; done < len;) {
+        size_t n = std::min(len - done, max_payload);
+        uint32_t addr = htol_u32(static_cast<uint32_t>(offset + done));
+        uint8_t hdr[kRegHeaderLen];
+        hdr[0] = cmd_write_;
+        std::memcpy(hdr + 1, &addr, sizeof(addr));
+
+        struct spi_ioc_transfer tr[2]{};
+        tr[0].tx_buf = reinterpret_cast<__u64>(hdr);
+        tr[0].len = kRegHeaderLen;
+        tr[1].tx_buf = reinterpret_cast<__u64>(src + done);
+        tr[1].len = static_cast<__u32>(n);
+        if (!spi_message(tr, 2, "reg_write")) return false;
+        done += n;
+    }
+    return true;
 }
 
 bool SpiTransport::readReg8(uint64_t offset, uint8_t& val) const {
-    LOGW("spi", "readReg8", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)val; return false;
+    return reg_read(offset, &val, sizeof(val));
 }
 bool SpiTransport::writeReg8(uint64_t offset, uint8_t val) {
-    LOGW("spi", "writeReg8", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)val; return false;
+    return reg_write(offset, &val, sizeof(val));
 }
 
 bool SpiTransport::readReg16(uint64_t offset, uint16_t& val) const {
-    LOGW("spi", "readReg16", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)val; return false;
+    uint16_t tmp = 0;
+    if (!reg_read(offset, &tmp, sizeof(tmp))) return false;
+    val = ltoh_u16(tmp);
+    return true;
 }
 bool SpiTransport::writeReg16(uint64_t offset, uint16_t val) {
-    LOGW("spi", "writeReg16", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)val; return false;
+    uint16_t tmp = htol_u16(val);
+    return reg_write(offset, &tmp, sizeof(tmp));
 }
 
 bool SpiTransport::readReg32(uint64_t offset, uint32_t& val) const {
-    LOGW("spi", "readReg32", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)val; return false;
+    uint32_t tmp = 0;
+    if (!reg_read(offset, &tmp, sizeof(tmp))) return false;
+    val = ltoh_u32(tmp);
+    return true;
 }
 bool SpiTransport::writeReg32(uint64_t offset, uint32_t val) {
-    LOGW("spi", "writeReg32", ENOSYS, "not supported; use xfer");
-    (void)offset; (void)val; return false;
+    uint32_t tmp = htol_u32(val);
+    return reg_write(offset, &tmp, sizeof(tmp));
+}
+
+bool SpiTransport::readRegs32(uint64_t offset, std::span<uint32_t> out) const {
+    if (out.empty()) return true;
+    if (!reg_read(offset, out.data(), out.size_bytes())) return false;
+    for (auto& w : out) w = ltoh_u32(w);
+    return true;
+}
+
+bool SpiTransport::writeRegs32(uint64_t offset, std::span<const uint32_t> in) {
+    if (in.empty()) return true;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    std::vector<uint32_t> tmp(in.begin(), in.end());
+    for (auto& w : tmp) w = htol_u32(w);
+    return reg_write(offset, tmp.data(), tmp.size() * sizeof(uint32_t));
+#else
+    return reg_write(offset, in.data(), in.size_bytes());
+#endif
+}
+
+bool SpiTransport::copyToDevice(uint64_t offset, const void* src, size_t len) {
+    if (len == 0) return true;
+    if (!src || offset % sizeof(uint32_t) != 0) return false;
+    // 整字部分一条消息；尾部不足一字补零后单独写出，与 MMIO 后端语义一致
+    size_t body = len & ~(sizeof(uint32_t) - 1);
+    if (body > 0 && !reg_write(offset, src, body)) return false;
+    if (body < len) {
+        uint8_t tail[4] = {0, 0, 0, 0};
+        std::memcpy(tail, static_cast<const uint8_t*>(src) + body, len - body);
+        return reg_write(offset + body, tail, sizeof(tail));
+    }
+    return true;
+}
+
+bool SpiTransport::copyFromDevice(uint64_t offset, void* dst, size_t len) const {
+    if (len == 0) return true;
+    if (!dst || offset % sizeof(uint32_t) != 0) return false;
+    size_t body = len & ~(sizeof(uint32_t) - 1);
+    if (body > 0 && !reg_read(offset, dst, body)) return false;
+    if (body < len) {
+        uint8_t tail[4];
+        if (!reg_read(offset + body, tail, sizeof(tail))) return false;
+        std::memcpy(static_cast<uint8_t*>(dst) + body, tail, len - body);
+    }
+    return true;
+}
+
+// ---- Transaction ----
+
+SpiTransport::Transaction& SpiTransport::Transaction::add(bool is_read, uint64_t offset, uint8_t* dst,
+                                                          const void* src, size_t len, uint8_t width) {
+    if (len == 0) return *this;
+    if ((is_read ? dst == nullptr : src == nullptr) || offset + len - 1 > 0xFFFFFFFFull) {
+        LOGE("spi", "transaction", -EINVAL, "offset=0x%llx len=%zu", (unsigned long long)offset, len);
+        ok_ = false;
+        return *this;
+    }
+    // 单个操作的数据段须与前导共存于一条消息内，超出部分拆为多个操作
+    const size_t max_payload = tp_->spi_bufsiz_ > kRegHeaderLen ? tp_->spi_bufsiz_ - kRegHeaderLen : 1;
+    for (size_t done = 0; done < len;) {
+        size_t n = std::min(len - done, max_payload);
+        Op op{is_read, static_cast<uint32_t>(offset + done), nullptr, n, 0, width};
+        if (is_read) {
+            op.dst = dst + done;
+        } else {
+            op.wpos = wdata_.size();
+            const uint8_t* p = static_cast<const uint8_t*>(src) + done;
+            wdata_.insert(wdata_.end(), p, p + n);
+        }
+        ops_.push_back(op);
+        done += n;
+    }
+    return *this;
+}
+
+SpiTransport::Transaction& SpiTransport::Transaction::read8(uint64_t offset, uint8_t* out) {
+    return add(true, offset, out, nullptr, sizeof(uint8_t), 1);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::read16(uint64_t offset, uint16_t* out) {
+    return add(true, offset, reinterpret_cast<uint8_t*>(out), nullptr, sizeof(uint16_t), 2);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::read32(uint64_t offset, uint32_t* out) {
+    return add(true, offset, reinterpret_cast<uint8_t*>(out), nullptr, sizeof(uint32_t), 4);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::readBlock(uint64_t offset, void* out, size_t len) {
+    return add(true, offset, static_cast<uint8_t*>(out), nullptr, len, 0);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::write8(uint64_t offset, uint8_t val) {
+    return add(false, offset, nullptr, &val, sizeof(val), 1);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::write16(uint64_t offset, uint16_t val) {
+    uint16_t tmp = htol_u16(val);
+    return add(false, offset, nullptr, &tmp, sizeof(tmp), 2);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::write32(uint64_t offset, uint32_t val) {
+    uint32_t tmp = htol_u32(val);
+    return add(false, offset, nullptr, &tmp, sizeof(tmp), 4);
+}
+SpiTransport::Transaction& SpiTransport::Transaction::writeBlock(uint64_t offset, const void* in, size_t len) {
+    return add(false, offset, nullptr, in, len, 0);
+}
+
+void SpiTransport::Transaction::clear() {
+    ops_.clear();
+    wdata_.clear();
+    ok_ = true;
+    messages_ = 0;
+}
+
+bool SpiTransport::Transaction::submit() {
+    messages_ = 0;
+    if (!ok_ || tp_->spi_fd_ < 0) return false;
+    if (ops_.empty()) return true;
+
+    const size_t bufsiz = tp_->spi_bufsiz_;
+    // 前导与传输段缓冲随事务复用：传输段容量首次提交时一次预留，此后重复提交不再分配
+    if (tr_.capacity() < kMaxTransfers) tr_.reserve(kMaxTransfers);
+    hdrs_.resize(ops_.size() * kRegHeaderLen);
+
+    for (size_t i = 0; i < ops_.size();) {
+        // 按 spidev 约束装填一条消息：tx/rx 总字节各不超过 bufsiz，传输段不超过 kMaxTransfers
+        const size_t first = i;
+        size_t tx_total = 0, rx_total = 0;
+        tr_.clear();
+        for (; i < ops_.size(); ++i) {
+            const Op& op = ops_[i];
+            size_t tx_add = kRegHeaderLen + (op.is_read ? 0 : op.len);
+            size_t rx_add = op.is_read ? op.len : 0;
+            if (i > first && (tr_.size() + 2 > kMaxTransfers || tx_total + tx_add > bufsiz || rx_total + rx_add > bufsiz)) break;
+
+            uint8_t* hdr = hdrs_.data() + i * kRegHeaderLen;
+            uint32_t addr = htol_u32(op.offset);
+            hdr[0] = op.is_read ? tp_->cmd_read_ : tp_->cmd_write_;
+            std::memcpy(hdr + 1, &addr, sizeof(addr));
+
+            struct spi_ioc_transfer t[2]{};
+            t[0].tx_buf = reinterpret_cast<__u64>(hdr);
+            t[0].len = kRegHeaderLen;
+            if (op.is_read) t[1].rx_buf = reinterpret_cast<__u64>(op.dst);
+            else            t[1].tx_buf = reinterpret_cast<__u64>(wdata_.data() + op.wpos);
+            t[1].len = static_cast<__u32>(op.len);
+            t[1].cs_change = cs_change_ ? 1 : 0;   // 数据段结束后释放片选，分隔下一条命令
+            tr_.push_back(t[0]);
+            tr_.push_back(t[1]);
+            tx_total += tx_add;
+            rx_total += rx_add;
+        }
+        tr_.back().cs_change = 0;    // 消息末段置位会使片选在消息结束后保持有效
+        if (!tp_->spi_message(tr_.data(), tr_.size(), "transaction")) return false;
+        ++messages_;
+
+        // 回填：多字节寄存器按小端转换为主机序
+        for (size_t k = first; k < i; ++k) {
+            const Op& op = ops_[k];
+            if (!op.is_read) continue;
+            if (op.width == 2) {
+                uint16_t v;
+                std::memcpy(&v, op.dst, sizeof(v));
+                v = ltoh_u16(v);
+                std::memcpy(op.dst, &v, sizeof(v));
+            } else if (op.width == 4) {
+                uint32_t v;
+                std::memcpy(&v, op.dst, sizeof(v));
+                v = ltoh_u32(v);
+                std::memcpy(op.dst, &v, sizeof(v));
+            }
+        }
+    }
+    return true;
 }
 
 bool SpiTransport::continuousWrite(int /*channel*/, const void* /*buf*/, size_t /*len*/) {
-    LOGW("spi", "continuousWrite", ENOSYS, "not supported; use xfer");
+    LOGW("spi", "continuousWrite", ENOSYS, "not supported; use continuousWriteAt or xfer");
     return false;
 }
 bool SpiTransport::continuousRead(int /*channel*/, void* /*buf*/, size_t /*len*/) {
-    LOGW("spi", "continuousRead", ENOSYS, "not supported; use xfer");
+    LOGW("spi", "continuousRead", ENOSYS, "not supported; use continuousReadAt or xfer");
     return false;
 }
 
-bool SpiTransport::continuousWriteAt(int /*channel*/, const void* /*buf*/, size_t /*len*/, uint64_t /*device_offset*/) {
-    LOGW("spi", "continuousWriteAt", ENOSYS, "not supported; use xfer");
-    return false;
+bool SpiTransport::continuousWriteAt(int /*channel*/, const void* buf, size_t len, uint64_t device_offset) {
+    return reg_write(device_offset, buf, len);
 }
-bool SpiTransport::continuousReadAt(int /*channel*/, void* /*buf*/, size_t /*len*/, uint64_t /*device_offset*/) {
-    LOGW("spi", "continuousReadAt", ENOSYS, "not supported; use xfer");
-    return false;
+bool SpiTransport::continuousReadAt(int /*channel*/, void* buf, size_t len, uint64_t device_offset) {
+    return reg_read(device_offset, buf, len);
 }
 
-bool SpiTransport::continuousWriteAsync(int /*channel*/, const void* /*buf*/, size_t /*len*/, uint64_t /*device_offset*/) {
-    LOGW("spi", "continuousWriteAsync", ENOSYS, "not supported; use xfer");
-    if (on_write_complete_) on_write_complete_(-1);
-    return false;
+// ---- 异步引擎 ----
+
+bool SpiTransport::start_async() {
+    wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+    aio_event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0 || aio_event_fd_ < 0) {
+        stop_async();
+        return false;
+    }
+    submit_q_ = std::make_unique<Support::MpscQueue<PendingIo>>(kAsyncDepth);
+    done_q_ = std::make_unique<Support::MpscQueue<DoneIo>>(kAsyncDepth);
+    inflight_.store(0, std::memory_order_relaxed);
+    stop_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread([this]() { worker_loop(); });
+    LOGI("spi", "async_engine", 0, "depth=%zu bufsiz=%zu aio_fd=%d", kAsyncDepth, spi_bufsiz_, aio_event_fd_);
+    return true;
 }
-bool SpiTransport::continuousReadAsync(int /*channel*/, void* /*buf*/, size_t /*len*/, uint64_t /*device_offset*/) {
-    LOGW("spi", "continuousReadAsync", ENOSYS, "not supported; use xfer");
-    if (on_read_complete_) on_read_complete_(-1);
-    return false;
+
+void SpiTransport::stop_async() {
+    if (worker_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        uint64_t one = 1;
+        ssize_t ret = ::write(wake_fd_, &one, sizeof(one));
+        (void)ret;
+        worker_.join();
+    }
+    // 未执行/未收割的请求随队列一并丢弃
+    submit_q_.reset();
+    done_q_.reset();
+    inflight_.store(0, std::memory_order_relaxed);
+    if (wake_fd_ >= 0) { ::close(wake_fd_); wake_fd_ = -1; }
+    if (aio_event_fd_ >= 0) { ::close(aio_event_fd_); aio_event_fd_ = -1; }
+}
+
+bool SpiTransport::enqueue(const AsyncRequest& req, bool tagged) {
+    if (!submit_q_ || !req.buf || req.len == 0 || req.device_offset + req.len - 1 > 0xFFFFFFFFull) return false;
+    // 在途数先占位：完成队列容量与提交队列相同，占位成功即保证完成结果有处可放
+    if (inflight_.fetch_add(1, std::memory_order_acq_rel) >= kAsyncDepth) {
+        inflight_.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+    if (!submit_q_->push(PendingIo{req, tagged})) {
+        inflight_.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+    uint64_t one = 1;
+    ssize_t ret = ::write(wake_fd_, &one, sizeof(one));
+    (void)ret;
+    return true;
+}
+
+void SpiTransport::worker_loop() {
+    PendingIo io;
+    while (!stop_.load(std::memory_order_acquire)) {
+        uint64_t cnt = 0;
+        if (::read(wake_fd_, &cnt, sizeof(cnt)) < 0 && errno != EINTR) break;
+        bool any = false;
+        while (!stop_.load(std::memory_order_acquire) && submit_q_->pop(io)) {
+            // reg_read/reg_write 已按 bufsiz 分块；块间其他线程的寄存器访问可穿插（各自带地址前导）
+            bool ok = io.req.is_write ? reg_write(io.req.device_offset, io.req.buf, io.req.len)
+                                      : reg_read(io.req.device_offset, io.req.buf, io.req.len);
+            DoneIo done{io.req.token, io.req.is_write, io.tagged,
+                        ok ? static_cast<ssize_t>(io.req.len) : static_cast<ssize_t>(-EIO)};
+            (void)done_q_->push(done);  // 容量由 inflight_ 保证
+            any = true;
+        }
+        if (any) {
+            uint64_t one = 1;
+            ssize_t ret = ::write(aio_event_fd_, &one, sizeof(one));
+            (void)ret;
+        }
+    }
+}
+
+bool SpiTransport::continuousWriteAsync(int channel, const void* buf, size_t len, uint64_t device_offset) {
+    AsyncRequest req;
+    req.is_write = true;
+    req.channel = channel;
+    req.buf = const_cast<void*>(buf);
+    req.len = len;
+    req.device_offset = device_offset;
+    if (!submit_q_) return continuousWriteAt(channel, buf, len, device_offset);
+    return enqueue(req, false);
+}
+
+bool SpiTransport::continuousReadAsync(int channel, void* buf, size_t len, uint64_t device_offset) {
+    AsyncRequest req;
+    req.is_write = false;
+    req.channel = channel;
+    req.buf = buf;
+    req.len = len;
+    req.device_offset = device_offset;
+    if (!submit_q_) return continuousReadAt(channel, buf, len, device_offset);
+    return enqueue(req, false);
+}
+
+int SpiTransport::submitAsyncBatch(const AsyncRequest* reqs, size_t count) {
+    if (!submit_q_) return -ENOSYS;
+    if (!reqs) return -EINVAL;
+    int n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!enqueue(reqs[i], true)) break;
+        ++n;
+    }
+    return n;
+}
+
+int SpiTransport::drainAioCompletions(int max_events) {
+    if (max_events <= 0 || !done_q_) return 0;
+    uint64_t cnt = 0;
+    ssize_t ret = ::read(aio_event_fd_, &cnt, sizeof(cnt));
+    (void)ret;
+
+    int total = 0;
+    DoneIo d;
+    while (total < max_events && done_q_->pop(d)) {
+        inflight_.fetch_sub(1, std::memory_order_acq_rel);
+        if (d.tagged) {
+            if (on_async_complete_) on_async_complete_(d.token, d.is_write, d.res);
+        } else if (d.is_write) {
+            if (on_write_complete_) on_write_complete_(d.res);
+        } else {
+            if (on_read_complete_) on_read_complete_(d.res);
+        }
+        ++total;
+    }
+    // 未收割完时重新置位，保证电平语义下次 poll 仍可读
+    if (done_q_->sizeApprox() > 0) {
+        uint64_t one = 1;
+        ret = ::write(aio_event_fd_, &one, sizeof(one));
+        (void)ret;
+    }
+    return total;
 }
 
 int SpiTransport::waitEvent(uint32_t* bitmap, uint32_t timeout_ms) {
@@ -5,9 +5,14 @@
 #pragma once
 
 #include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
+#include "MB_DDF/PhysicalLayer/Support/MpscQueue.h"
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include <linux/spi/spidev.h>
 
@@ -34,6 +39,58 @@ public:
     SpiTransport() = default;
     ~SpiTransport() override { close(); }
 
+    // 批量事务：多次寄存器读写合并为一次 SPI_IOC_MESSAGE(N) 提交，读结果在 submit 后回填到调用方指针。
+    // 每个操作对应 前导 + 数据段 两个传输段；默认操作之间释放片选（cs_change）以分隔命令，
+    // 超出 spidev bufsiz 或单条消息传输段上限时自动拆分为多条消息。
+    // 读目标指针与事务生命周期无关，但须在 submit 返回前保持有效。
+    class Transaction {
+    public:
+        explicit Transaction(SpiTransport& tp) : tp_(&tp) {}
+
+        Transaction& read8(uint64_t offset, uint8_t* out);
+        Transaction& read16(uint64_t offset, uint16_t* out);
+        Transaction& read32(uint64_t offset, uint32_t* out);
+        Transaction& readBlock(uint64_t offset, void* out, size_t len);
+        Transaction& write8(uint64_t offset, uint8_t val);
+        Transaction& write16(uint64_t offset, uint16_t val);
+        Transaction& write32(uint64_t offset, uint32_t val);
+        Transaction& writeBlock(uint64_t offset, const void* in, size_t len);
+        // 操作之间是否释放片选；false 时同一消息内片选保持有效（需设备支持连续命令流）
+        Transaction& csChange(bool on) { cs_change_ = on; return *this; }
+
+        size_t size() const { return ops_.size(); }
+        bool   empty() const { return ops_.empty(); }
+        void   clear();
+        // 提交全部操作；任一消息失败返回 false（此前已完成消息的读结果已回填）
+        bool   submit();
+        // 最近一次 submit 实际发出的消息条数
+        size_t messages() const { return messages_; }
+
+    private:
+        struct Op {
+            bool     is_read;
+            uint32_t offset;
+            uint8_t* dst;       // 读目标
+            size_t   len;
+            size_t   wpos;      // 写数据在 wdata_ 中的位置
+            uint8_t  width;     // 1/2/4：读完成后按小端转换；0 表示字节块
+        };
+        Transaction& add(bool is_read, uint64_t offset, uint8_t* dst, const void* src, size_t len, uint8_t width);
+
+        SpiTransport* tp_;
+        std::vector<Op> ops_;
+        std::vector<uint8_t> wdata_;
+        std::vector<uint8_t> hdrs_;                 // 各操作的命令前导（submit 时填充）
+        std::vector<struct spi_ioc_transfer> tr_;   // 单条消息的传输段
+        bool   cs_change_{true};
+        bool   ok_{true};       // 入队参数非法时置 false，submit 直接失败
+        size_t messages_{0};
+    };
+    Transaction transaction() { return Transaction(*this); }
+
+    // 自 open 起发出的 SPI_IOC_MESSAGE 条数（系统调用次数）
+    uint64_t messageCount() const { return message_count_.load(std::memory_order_relaxed); }
+
     bool open(const TransportConfig& cfg) override;
     void close() override;
 
@@ -42,14 +99,22 @@ public:
     size_t getMappedLength() const override { return 0; }
 
     // 通过 SPI 进行寄存器读写（设备协议需与硬件一致，当前采用通用 offset+cmd 前导）
+    // 协议：cmd(1) + offset(4 LE) 前导后紧跟数据段，前导与数据段合并为一次 SPI_IOC_MESSAGE(2)，
+    // 期间片选保持有效；读/写命令字默认 0x03/0x02，可由 MB_SPI_CMD_READ/MB_SPI_CMD_WRITE 覆盖
     bool readReg8(uint64_t offset, uint8_t& val) const override;
     bool writeReg8(uint64_t offset, uint8_t val) override;
     bool readReg16(uint64_t offset, uint16_t& val) const override;
     bool writeReg16(uint64_t offset, uint16_t val) override;
     bool readReg32(uint64_t offset, uint32_t& val) const override;
     bool writeReg32(uint64_t offset, uint32_t val) override;
-
-    // 大块读写：SPI 未必支持偏移寻址；此处仅提供流式占位实现，默认返回 false
+    // 突发访问：连续区间只发一条消息（超过 spidev bufsiz 时按块拆分）
+    bool readRegs32(uint64_t offset, std::span<uint32_t> out) const override;
+    bool writeRegs32(uint64_t offset, std::span<const uint32_t> in) override;
+    bool copyToDevice(uint64_t offset, const void* src, size_t len) override;
+    bool copyFromDevice(uint64_t offset, void* dst, size_t len) const override;
+
+    // 大块读写：*At 版本按寄存器协议（cmd + offset 前导）以 bufsiz 分块传输，channel 忽略；
+    // 无偏移版本 SPI 无对应语义，返回 false
     bool continuousWrite(int channel, const void* buf, size_t len) override;
     bool continuousRead(int channel, void* buf, size_t len) override;
     bool continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) override;
@@ -58,11 +123,18 @@ public:
     // SPI 原始半双工传输
     bool xfer(const uint8_t* tx, uint8_t* rx, size_t len) override;
 
-    // 异步接口
+    // 异步接口：请求经无锁队列交给 SPI 工作线程执行，提交方不等待总线；
+    // 完成结果经 getAioEventFd 通知（可直接注册到 EventMultiplexer），drainAioCompletions 在调用线程回调。
+    // 在途请求数上限为 kAsyncDepth，满时提交失败（submitAsyncBatch 返回已入队数）
+    static constexpr size_t kAsyncDepth = 256;
     void setOnContinuousWriteComplete(std::function<void(ssize_t)> cb) override { on_write_complete_ = std::move(cb); }
     void setOnContinuousReadComplete(std::function<void(ssize_t)> cb) override { on_read_complete_ = std::move(cb); }
     bool continuousWriteAsync(int channel, const void* buf, size_t len, uint64_t device_offset) override;
     bool continuousReadAsync(int channel, void* buf, size_t len, uint64_t device_offset) override;
+    void setOnAsyncComplete(AsyncCompletion cb) override { on_async_complete_ = std::move(cb); }
+    int  submitAsyncBatch(const AsyncRequest* reqs, size_t count) override;
+    int  getAioEventFd() const override { return aio_event_fd_; }
+    int  drainAioCompletions(int max_events) override;
 
     // 事件等待 & 事件 FD 暴露（GPIO 中断）
     int waitEvent(uint32_t* bitmap, uint32_t timeout_ms) override;
@@ -73,11 +145,28 @@ private:
 
     // SPI 传输原语（半双工），根据 tx/rx 缓冲区进行一次传输
     bool spi_transfer(const uint8_t* tx, uint8_t* rx, size_t len) const;
+    // 提交一条 SPI_IOC_MESSAGE(n)；补齐各段速率/位宽
+    bool spi_message(struct spi_ioc_transfer* tr, size_t n, const char* op) const;
 
     // 通用寄存器协议：cmd(1) + offset(4 LE) + payload(N)
     bool reg_read(uint64_t offset, void* out, size_t len) const;
     bool reg_write(uint64_t offset, const void* in, size_t len);
 
+    // 异步引擎
+    struct PendingIo {
+        AsyncRequest req{};
+        bool tagged{true};
+    };
+    struct DoneIo {
+        void*   token{nullptr};
+        bool    is_write{false};
+        bool    tagged{true};
+        ssize_t res{0};
+    };
+    bool start_async();
+    void stop_async();
+    bool enqueue(const AsyncRequest& req, bool tagged);
+    void worker_loop();
 
 private:
     TransportConfig cfg_{};
@@ -87,6 +176,10 @@ private:
     uint32_t spi_speed_{1'000'000}; // 默认 1MHz
     uint8_t  spi_mode_{SPI_MODE_0};
     uint8_t  spi_bits_{8};
+    size_t   spi_bufsiz_{4096};     // 单条消息总字节上限（spidev 模块参数 bufsiz）
+    uint8_t  cmd_read_{0x03};
+    uint8_t  cmd_write_{0x02};
+    mutable std::atomic<uint64_t> message_count_{0};
 
     // GPIO 事件资源（在未启用 gpiod 时保持为空指针）
     gpiod_chip* chip_{nullptr};
@@ -96,6 +189,16 @@ private:
     // 异步完成回调
     std::function<void(ssize_t)> on_write_complete_{};
     std::function<void(ssize_t)> on_read_complete_{};
+    AsyncCompletion on_async_complete_{};
+
+    // 异步引擎：提交队列（多生产者）-> 工作线程 -> 完成队列（单生产者）-> drainAioCompletions
+    std::unique_ptr<Support::MpscQueue<PendingIo>> submit_q_;
+    std::unique_ptr<Support::MpscQueue<DoneIo>> done_q_;
+    std::atomic<size_t> inflight_{0};   // 已提交未收割的请求数，保证完成队列不溢出
+    std::atomic<bool> stop_{false};
+    int wake_fd_{-1};                   // 唤醒工作线程（阻塞 eventfd）
+    int aio_event_fd_{-1};              // 完成通知（非阻塞 eventfd）
+    std::thread worker_;
 };
 
 } // namespace ControlPlane
@@ -0,0 +1,144 @@
+/**
+ * @file UserBarMapping.cpp
+ */
+#include "MB_DDF/PhysicalLayer/ControlPlane/UserBarMapping.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+// 设备节点：进程内只打开一次，由其上的全部映射共同持有
+struct UserBarMapping::File {
+    int fd = -1;
+    uint64_t bar_len = 0;   // 0 表示未知
+
+    ~File() {
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+namespace {
+
+struct Node {
+    std::weak_ptr<UserBarMapping::File> file;
+    std::vector<std::weak_ptr<UserBarMapping>> maps;
+};
+
+std::mutex& registry_mutex() {
+    static std::mutex mu;
+    return mu;
+}
+
+std::unordered_map<std::string, Node>& registry() {
+    static std::unordered_map<std::string, Node> map;
+    return map;
+}
+
+uint64_t page_size() {
+    long ps = ::sysconf(_SC_PAGESIZE);
+    return ps > 0 ? static_cast<uint64_t>(ps) : 4096;
+}
+
+// BAR 长度：普通文件（替身）取文件长度；设备节点读 /sys/class/xdma/<node>/device/resource，
+// 取第一个非空 BAR（xdma 的 user BAR 位于 DMA 配置 BAR 之前）；无法确定时返回 0
+uint64_t bar_length(int fd, const std::string& user_path) {
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) return static_cast<uint64_t>(st.st_size);
+
+    std::string node = user_path.substr(user_path.find_last_of('/') + 1);
+    std::string res = "/sys/class/xdma/" + node + "/device/resource";
+    FILE* f = std::fopen(res.c_str(), "re");
+    if (!f) return 0;
+    uint64_t len = 0, start = 0, end = 0, flags = 0;
+    while (std::fscanf(f, "%" SCNx64 " %" SCNx64 " %" SCNx64, &start, &end, &flags) == 3) {
+        if (end > start) {
+            len = end - start + 1;
+            break;
+        }
+    }
+    std::fclose(f);
+    return len;
+}
+
+} // namespace
+
+UserBarMapping::~UserBarMapping() {
+    if (base_) ::munmap(base_, length_);
+}
+
+std::shared_ptr<UserBarMapping> UserBarMapping::acquire(const std::string& user_path, uint64_t offset, size_t len) {
+    std::lock_guard<std::mutex> lk(registry_mutex());
+    Node& node = registry()[user_path];
+
+    // 收集仍存活的映射：被覆盖则直接复用，部分重叠则并入新区间
+    const uint64_t page = page_size();
+    uint64_t start = offset / page * page;
+    uint64_t end = (offset + len + page - 1) / page * page;
+    std::vector<std::shared_ptr<UserBarMapping>> live;
+    for (auto& w : node.maps) {
+        if (auto m = w.lock()) live.push_back(std::move(m));
+    }
+    for (const auto& m : live) {
+        if (m->covers(offset, len)) return m;
+    }
+    for (bool grown = true; grown;) {
+        grown = false;
+        for (const auto& m : live) {
+            const uint64_t ms = m->offset_, me = m->offset_ + m->length_;
+            if (ms < end && start < me && (ms < start || me > end)) {
+                start = std::min(start, ms);
+                end = std::max(end, me);
+                grown = true;
+            }
+        }
+    }
+
+    auto file = node.file.lock();
+    if (!file) {
+        int fd = ::open(user_path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            LOGW("xdma", "open_user", errno, "path=%s", user_path.c_str());
+            return nullptr;
+        }
+        file = std::make_shared<File>();
+        file->fd = fd;
+        file->bar_len = bar_length(fd, user_path);
+        node.file = file;
+    }
+    if (file->bar_len && offset + len > file->bar_len) {
+        LOGE("xdma", "mmap_bar", ERANGE, "path=%s window=[0x%" PRIx64 ", +0x%zx) bar=0x%" PRIx64,
+             user_path.c_str(), offset, len, file->bar_len);
+        return nullptr;
+    }
+
+    const size_t map_len = static_cast<size_t>(end - start);
+    void* base = ::mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, static_cast<off_t>(start));
+    if (base == MAP_FAILED) {
+        LOGW("xdma", "mmap_bar", errno, "path=%s offset=0x%" PRIx64 " len=%zu", user_path.c_str(), start, map_len);
+        return nullptr;
+    }
+    LOGI("xdma", "mmap_bar", 0, "path=%s offset=0x%" PRIx64 " len=%zu", user_path.c_str(), start, map_len);
+
+    std::shared_ptr<UserBarMapping> mapping(
+        new UserBarMapping(user_path, std::move(file), start, static_cast<uint8_t*>(base), map_len));
+    node.maps.clear();
+    for (auto& m : live) node.maps.push_back(m);
+    node.maps.push_back(mapping);
+    return mapping;
+}
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
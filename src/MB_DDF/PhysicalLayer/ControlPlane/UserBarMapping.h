@@ -0,0 +1,57 @@
+/**
+ * @file UserBarMapping.h
+ * @brief 进程级共享的 XDMA user BAR 映射（按区间、引用计数）
+ *
+ * 设计要点：
+ * - 同一 user 设备节点在进程内只打开一次；每个寄存器窗口映射其所在的页对齐子区间，
+ *   不从 BAR 起点映射，高偏移的小窗口只占用自身大小的地址空间。
+ * - 区间重叠的窗口共用一个映射：新窗口被已有映射覆盖时直接复用；与已有映射部分重叠时
+ *   映射二者的并集，旧映射在最后一个持有者释放后解除。互不重叠的窗口各自映射。
+ * - BAR 长度取自 sysfs 的 PCI resource（普通文件替身取文件长度），仅用于拒绝越界窗口；
+ *   无法确定时不检查，由 mmap 报错。
+ * - 最后一个引用释放时 munmap；节点的 fd 在其所有映射释放后关闭。
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace ControlPlane {
+
+class UserBarMapping {
+public:
+    ~UserBarMapping();
+
+    UserBarMapping(const UserBarMapping&) = delete;
+    UserBarMapping& operator=(const UserBarMapping&) = delete;
+
+    // 获取覆盖 BAR 区间 [offset, offset + len) 的共享映射；失败返回 nullptr
+    static std::shared_ptr<UserBarMapping> acquire(const std::string& user_path, uint64_t offset, size_t len);
+
+    // 映射起点在 BAR 内的偏移（页对齐）；BAR 偏移 off 处的地址为 base() + (off - offset())
+    uint64_t offset() const { return offset_; }
+    uint8_t* base() const { return base_; }
+    size_t length() const { return length_; }
+    bool covers(uint64_t off, size_t len) const { return off >= offset_ && off + len <= offset_ + length_; }
+    const std::string& path() const { return path_; }
+
+    struct File;   // 设备节点（实现细节）
+
+private:
+    UserBarMapping(std::string path, std::shared_ptr<File> file, uint64_t offset, uint8_t* base, size_t length)
+        : path_(std::move(path)), file_(std::move(file)), offset_(offset), base_(base), length_(length) {}
+
+    std::string path_;
+    std::shared_ptr<File> file_;
+    uint64_t offset_ = 0;
+    uint8_t* base_ = nullptr;
+    size_t length_ = 0;
+};
+
+} // namespace ControlPlane
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -10,7 +10,11 @@
 #include <poll.h>
 #include <cerrno>
 #include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <sys/eventfd.h>
+#include <time.h>
 
 #if MB_DDF_HAS_IOURING
 #include <liburing.h>
@@ -34,11 +38,88 @@ namespace MB_DDF {
 namespace PhysicalLayer {
 namespace ControlPlane {
 
-// 用于在 io_uring 的 user_data 内编码操作类型（最高位标记写）
+// 异步队列深度（请求池大小与之相同）与单轮提交/收割的批量上限
 #if MB_DDF_HAS_IOURING
-static constexpr uint64_t kAioFlagWrite = (1ull << 63);
+static constexpr uint32_t kAsyncQueueDepth = 256;
+#elif MB_DDF_HAS_LIBAIO
+static constexpr uint32_t kAsyncQueueDepth = 128;
+#else
+static constexpr uint32_t kAsyncQueueDepth = 64;  // 同步回退路径的完成环大小
+#endif
+static constexpr size_t kSubmitBatch = 32;
+static constexpr int kDrainBatch = 32;
+#if MB_DDF_HAS_IOURING
+static constexpr uint64_t kNopUserData = ~0ull;   // 撤回后改为 NOP 的 SQE，收割时跳过
 #endif
 
+namespace {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// fd 暂不可读写时的等待：先消耗自旋预算，再 poll 到截止时间；超时返回 false
+// 驱动未实现 poll 时内核按默认掩码立即报告就绪，重试仍 EAGAIN：连续 kSpuriousPolls 次后改为指数退避休眠
+class DmaWaiter {
+public:
+    explicit DmaWaiter(const XdmaWaitOptions& opt)
+        : spin_left_(opt.spin_budget), use_poll_(opt.use_poll), bounded_(opt.timeout_ms > 0),
+          backoff_us_(std::max<uint32_t>(opt.backoff_min_us, 1)),
+          backoff_max_us_(std::max(opt.backoff_max_us, backoff_us_)),
+          deadline_(std::chrono::steady_clock::now() + std::chrono::milliseconds(opt.timeout_ms)) {}
+
+    bool wait(int fd, short events) {
+        if (spin_left_ > 0) {
+            --spin_left_;
+            cpu_relax();
+            return true;
+        }
+        int64_t left_us = -1;
+        if (bounded_) {
+            left_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline_ - std::chrono::steady_clock::now()).count();
+            if (left_us <= 0) return false;
+        }
+        if (use_poll_) {
+            // 上次 poll 报告就绪而重试仍 EAGAIN：就绪不可信
+            if (polled_ready_ && ++spurious_ >= kSpuriousPolls) use_poll_ = false;
+        }
+        if (use_poll_) {
+            int timeout = left_us < 0 ? -1 : static_cast<int>((left_us + 999) / 1000);
+            struct pollfd pfd{ fd, events, 0 };
+            int rc = ::poll(&pfd, 1, timeout);
+            if (rc < 0 && errno != EINTR) return false;
+            if (rc == 0) return false;
+            polled_ready_ = rc > 0;
+            return true;
+        }
+        uint32_t us = backoff_us_;
+        if (left_us >= 0 && left_us < us) us = static_cast<uint32_t>(left_us);
+        struct timespec ts{ static_cast<time_t>(us / 1000000), static_cast<long>(us % 1000000) * 1000 };
+        (void)::nanosleep(&ts, nullptr);
+        backoff_us_ = std::min(backoff_us_ * 2, backoff_max_us_);
+        return true;
+    }
+
+private:
+    static constexpr uint32_t kSpuriousPolls = 2;
+
+    uint32_t spin_left_;
+    bool use_poll_;
+    bool bounded_;
+    bool polled_ready_ = false;
+    uint32_t spurious_ = 0;
+    uint32_t backoff_us_;
+    uint32_t backoff_max_us_;
+    std::chrono::steady_clock::time_point deadline_;
+};
+
+} // namespace
+
 long XdmaTransport::page_size() {
     static long ps = ::sysconf(_SC_PAGESIZE);
     return ps > 0 ? ps : 4096;
@@ -54,21 +135,22 @@ int XdmaTransport::set_nonblock(int fd) {
 bool XdmaTransport::open(const TransportConfig& cfg) {
     cfg_ = cfg;
 
-    // 打开 user 寄存器映射设备（可选）
+    // 打开 user 寄存器映射设备（可选）：窗口取自进程级共享 BAR 映射（重叠窗口共用）
     if (!cfg_.device_path.empty()) {
         std::string user = make_user_path(cfg_.device_path);
-        user_fd_ = ::open(user.c_str(), O_RDWR | O_CLOEXEC);
-        if (user_fd_ >= 0) {
-            mapped_len_ = static_cast<size_t>(page_size());
-            user_base_ = ::mmap(nullptr, mapped_len_, PROT_READ | PROT_WRITE, MAP_SHARED, user_fd_, cfg_.device_offset);
-            LOGI("xdma", "mmap_user", 0, "path=%s, offset=%ld, len=%ld", user.c_str(), cfg_.device_offset, mapped_len_);
-            if (user_base_ == MAP_FAILED) {
-                LOGE("xdma", "mmap_user", errno, "path=%s, offset=%ld", user.c_str(), cfg_.device_offset);
-                user_base_ = nullptr;
-                mapped_len_ = 0;
-            }
+        size_t window = cfg_.register_window ? cfg_.register_window : static_cast<size_t>(page_size());
+        if (cfg_.device_offset < 0) {
+            LOGE("xdma", "map_user", EINVAL, "path=%s, offset=%ld", user.c_str(), cfg_.device_offset);
         } else {
-            LOGW("xdma", "open_user", errno, "path=%s", user.c_str());
+            // 打开/映射失败由 acquire 记录；寄存器映射可选，失败时继续打开 DMA/事件
+            bar_ = UserBarMapping::acquire(user, static_cast<uint64_t>(cfg_.device_offset), window);
+        }
+        if (bar_) {
+            user_base_ = bar_->base() + (static_cast<uint64_t>(cfg_.device_offset) - bar_->offset());
+            mapped_len_ = window;
+            LOGI("xdma", "map_user", 0, "path=%s, offset=%ld, len=%zu, shared mapping=[0x%llx, +%zu)",
+                 user.c_str(), cfg_.device_offset, mapped_len_,
+                 static_cast<unsigned long long>(bar_->offset()), bar_->length());
         }
     }
 
@@ -108,40 +190,29 @@ bool XdmaTransport::open(const TransportConfig& cfg) {
                 LOGW("xdma", "eventfd", errno, "create failed");
             }
         }
+        const uint32_t depth = async_opt_.queue_depth ? async_opt_.queue_depth : kAsyncQueueDepth;
 #if MB_DDF_HAS_IOURING
-        if (!iouring_inited_) {
-            int rc = ::io_uring_queue_init(256, &ring_, 0);
-            if (rc == 0) {
-                iouring_inited_ = true;
-                // 将 eventfd 注册到 io_uring，用于完成通知
-                if (aio_event_fd_ >= 0) {
-                    rc = ::io_uring_register_eventfd(&ring_, aio_event_fd_);
-                    if (rc < 0) LOGW("xdma", "iouring_register_eventfd", -rc, "");
-                }
-            } else {
-                LOGW("xdma", "iouring_queue_init", rc, "");
-            }
-        }
+        if (!iouring_inited_) (void)init_iouring(depth);
 #elif MB_DDF_HAS_LIBAIO
         if (!aio_ctx_) {
-            const unsigned kQueueDepth = 128;
-            int rc = ::io_setup(kQueueDepth, &aio_ctx_);
+            int rc = ::io_setup(static_cast<int>(depth), &aio_ctx_);
             if (rc < 0) {
-                LOGW("xdma", "io_setup", -rc, "queue=%u", kQueueDepth);
+                LOGW("xdma", "io_setup", -rc, "queue=%u", depth);
                 aio_ctx_ = 0;
             }
         }
 #endif
+        init_async_pool(depth);
     }
 
     // 至少要有一个资源成功打开才视为 open 成功（允许只用 mmap/寄存器，无 DMA）
-    if (user_fd_ < 0 && h2c_fd_ < 0 && c2h_fd_ < 0 && events_fd_ < 0) {
+    if (!bar_ && h2c_fd_ < 0 && c2h_fd_ < 0 && events_fd_ < 0) {
         LOGE("xdma", "open", -1, "no resources available");
         close();
         return false;
     }
-    LOGI("xdma", "open", 0, "user_fd=%d h2c_fd=%d c2h_fd=%d events_fd=%d aio_event_fd=%d",
-         user_fd_, h2c_fd_, c2h_fd_, events_fd_, aio_event_fd_);
+    LOGI("xdma", "open", 0, "user=%s h2c_fd=%d c2h_fd=%d events_fd=%d aio_event_fd=%d",
+         bar_ ? "shared" : "none", h2c_fd_, c2h_fd_, events_fd_, aio_event_fd_);
     return true;
 }
 
@@ -154,7 +225,7 @@ bool XdmaTransport::writeReg8(uint64_t offset, uint8_t val) {
         LOGE("xdma", "writeReg8", EINVAL, "offset=%llu len=%zu", (unsigned long long)offset, mapped_len_);
         return false;
     }
-    std::memcpy(static_cast<uint8_t*>(user_base_) + offset, &val, sizeof(val));
+    *reinterpret_cast<volatile uint8_t*>(static_cast<uint8_t*>(user_base_) + offset) = val;
     return true;
 }
 
@@ -167,7 +238,7 @@ bool XdmaTransport::readReg8(uint64_t offset, uint8_t& val) const {
         LOGE("xdma", "readReg8", EINVAL, "offset=%llu len=%zu", (unsigned long long)offset, mapped_len_);
         return false;
     }
-    val = static_cast<uint8_t>(*static_cast<const uint8_t*>(user_base_) + offset);
+    val = *reinterpret_cast<const volatile uint8_t*>(static_cast<const uint8_t*>(user_base_) + offset);
     return true;
 }
 
@@ -184,8 +255,7 @@ bool XdmaTransport::readReg16(uint64_t offset, uint16_t& val) const {
         LOGE("xdma", "readReg16", EINVAL, "offset=%llu len=%zu", (unsigned long long)offset, mapped_len_);
         return false;
     }
-    uint16_t tmp = 0;
-    std::memcpy(&tmp, static_cast<const uint8_t*>(user_base_) + offset, sizeof(tmp));
+    uint16_t tmp = *reinterpret_cast<const volatile uint16_t*>(static_cast<const uint8_t*>(user_base_) + offset);
     val = ltoh_u16(tmp);
     return true;
 }
@@ -203,8 +273,7 @@ bool XdmaTransport::writeReg16(uint64_t offset, uint16_t val) {
         LOGE("xdma", "writeReg16", EINVAL, "offset=%llu len=%zu", (unsigned long long)offset, mapped_len_);
         return false;
     }
-    uint16_t tmp = htol_u16(val);
-    std::memcpy(static_cast<uint8_t*>(user_base_) + offset, &tmp, sizeof(tmp));
+    *reinterpret_cast<volatile uint16_t*>(static_cast<uint8_t*>(user_base_) + offset) = htol_u16(val);
     return true;
 }
 
@@ -221,8 +290,7 @@ bool XdmaTransport::readReg32(uint64_t offset, uint32_t& val) const {
         LOGE("xdma", "readReg32", EINVAL, "offset=%llu len=%zu", (unsigned long long)offset, mapped_len_);
         return false;
     }
-    uint32_t tmp = 0;
-    std::memcpy(&tmp, static_cast<const uint8_t*>(user_base_) + offset, sizeof(tmp));
+    uint32_t tmp = *reinterpret_cast<const volatile uint32_t*>(static_cast<const uint8_t*>(user_base_) + offset);
     val = ltoh_u32(tmp);
     return true;
 }
@@ -240,18 +308,116 @@ bool XdmaTransport::writeReg32(uint64_t offset, uint32_t val) {
         LOGE("xdma", "writeReg32", EINVAL, "offset=%llu len=%zu", (unsigned long long)offset, mapped_len_);
         return false;
     }
-    uint32_t tmp = htol_u32(val);
-    std::memcpy(static_cast<uint8_t*>(user_base_) + offset, &tmp, sizeof(tmp));
+    *reinterpret_cast<volatile uint32_t*>(static_cast<uint8_t*>(user_base_) + offset) = htol_u32(val);
+    return true;
+}
+
+bool XdmaTransport::check_window(const char* op, uint64_t offset, size_t bytes, size_t align) const {
+    if (offset % align != 0) {
+        LOGE("xdma", op, EINVAL, "offset=%llu must be aligned", (unsigned long long)offset);
+        return false;
+    }
+    if (!user_base_) {
+        LOGW("xdma", op, ENODEV, "unmapped");
+        return false;
+    }
+    if (offset > mapped_len_ || bytes > mapped_len_ - offset) {
+        LOGE("xdma", op, EINVAL, "offset=%llu bytes=%zu len=%zu", (unsigned long long)offset, bytes, mapped_len_);
+        return false;
+    }
+    return true;
+}
+
+bool XdmaTransport::readRegs32(uint64_t offset, std::span<uint32_t> out) const {
+    if (!check_window("readRegs32", offset, out.size_bytes(), sizeof(uint32_t))) return false;
+    const volatile uint32_t* p = reinterpret_cast<const volatile uint32_t*>(static_cast<const uint8_t*>(user_base_) + offset);
+    uint32_t* d = out.data();
+    for (size_t i = 0, n = out.size(); i < n; ++i) d[i] = ltoh_u32(p[i]);
+    return true;
+}
+
+bool XdmaTransport::writeRegs32(uint64_t offset, std::span<const uint32_t> in) {
+    if (!check_window("writeRegs32", offset, in.size_bytes(), sizeof(uint32_t))) return false;
+    volatile uint32_t* p = reinterpret_cast<volatile uint32_t*>(static_cast<uint8_t*>(user_base_) + offset);
+    const uint32_t* s = in.data();
+    for (size_t i = 0, n = in.size(); i < n; ++i) p[i] = htol_u32(s[i]);
+    return true;
+}
+
+bool XdmaTransport::copyToDevice(uint64_t offset, const void* src, size_t len) {
+    if (len == 0) return true;
+    if (!src) return false;
+    size_t words = (len + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    if (!check_window("copyToDevice", offset, words * sizeof(uint32_t), sizeof(uint32_t))) return false;
+    // 源缓冲可能未对齐：经 memcpy 取值后整字写出；设备字节序为小端，字节流按原样落地
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(user_base_) + offset;
+    size_t i = 0;
+    if (wide_mmio_) {
+        if ((offset % sizeof(uint64_t)) != 0 && len >= sizeof(uint32_t)) {
+            uint32_t w;
+            std::memcpy(&w, s, sizeof(w));
+            *reinterpret_cast<volatile uint32_t*>(d) = w;
+            i = sizeof(uint32_t);
+        }
+        for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+            uint64_t w;
+            std::memcpy(&w, s + i, sizeof(w));
+            *reinterpret_cast<volatile uint64_t*>(d + i) = w;
+        }
+    }
+    for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+        uint32_t w;
+        std::memcpy(&w, s + i, sizeof(w));
+        *reinterpret_cast<volatile uint32_t*>(d + i) = w;
+    }
+    if (i < len) {
+        uint32_t w = 0;
+        std::memcpy(&w, s + i, len - i);
+        *reinterpret_cast<volatile uint32_t*>(d + i) = w;
+    }
+    return true;
+}
+
+bool XdmaTransport::copyFromDevice(uint64_t offset, void* dst, size_t len) const {
+    if (len == 0) return true;
+    if (!dst) return false;
+    size_t words = (len + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    if (!check_window("copyFromDevice", offset, words * sizeof(uint32_t), sizeof(uint32_t))) return false;
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    const uint8_t* s = static_cast<const uint8_t*>(user_base_) + offset;
+    size_t i = 0;
+    if (wide_mmio_) {
+        if ((offset % sizeof(uint64_t)) != 0 && len >= sizeof(uint32_t)) {
+            uint32_t w = *reinterpret_cast<const volatile uint32_t*>(s);
+            std::memcpy(d, &w, sizeof(w));
+            i = sizeof(uint32_t);
+        }
+        for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+            uint64_t w = *reinterpret_cast<const volatile uint64_t*>(s + i);
+            std::memcpy(d + i, &w, sizeof(w));
+        }
+    }
+    for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+        uint32_t w = *reinterpret_cast<const volatile uint32_t*>(s + i);
+        std::memcpy(d + i, &w, sizeof(w));
+    }
+    if (i < len) {
+        uint32_t w = *reinterpret_cast<const volatile uint32_t*>(s + i);
+        std::memcpy(d + i, &w, len - i);
+    }
     return true;
 }
 
 void XdmaTransport::close() {
 #if MB_DDF_HAS_IOURING
     if (iouring_inited_) {
-        // 取消 eventfd 注册
+        // 取消 eventfd 注册；queue_exit 会一并释放已注册的文件与缓冲
         (void)::io_uring_unregister_eventfd(&ring_);
         ::io_uring_queue_exit(&ring_);
         iouring_inited_ = false;
+        h2c_file_idx_ = c2h_file_idx_ = -1;
+        reg_buf_count_ = 0;
     }
 #elif MB_DDF_HAS_LIBAIO
     if (aio_ctx_) {
@@ -260,28 +426,32 @@ void XdmaTransport::close() {
     }
 #endif
     if (aio_event_fd_ >= 0) { ::close(aio_event_fd_); aio_event_fd_ = -1; }
+    init_async_pool(0);
 
-    if (user_base_) {
-        ::munmap(user_base_, mapped_len_);
-        user_base_ = nullptr;
-        mapped_len_ = 0;
-    }
-    if (user_fd_ >= 0) { ::close(user_fd_); user_fd_ = -1; }
+    // 共享映射由最后一个持有者释放
+    bar_.reset();
+    user_base_ = nullptr;
+    mapped_len_ = 0;
     if (h2c_fd_ >= 0) { ::close(h2c_fd_); h2c_fd_ = -1; }
     if (c2h_fd_ >= 0) { ::close(c2h_fd_); c2h_fd_ = -1; }
     if (events_fd_ >= 0) { ::close(events_fd_); events_fd_ = -1; }
 }
 
-bool XdmaTransport::continuousWrite(int channel, const void* buf, size_t len) {
-    if (h2c_fd_ < 0 || channel != cfg_.dma_h2c_channel) return false;
+bool XdmaTransport::dma_write_all(const char* op, const void* buf, size_t len, off_t off) {
     const uint8_t* p = static_cast<const uint8_t*>(buf);
     size_t remain = len;
-    off_t off = use_default_device_offset_ ? static_cast<off_t>(default_device_offset_) : -1;
+    DmaWaiter waiter(wait_opt_);
     while (remain > 0) {
         ssize_t n = (off >= 0) ? ::pwrite(h2c_fd_, p, remain, off) : ::write(h2c_fd_, p, remain);
         if (n < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) { continue; }
-            LOGE("xdma", "dmaWrite", errno, "fd=%d", h2c_fd_);
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (waiter.wait(h2c_fd_, POLLOUT)) continue;
+                LOGE("xdma", op, ETIMEDOUT, "fd=%d remain=%zu/%zu", h2c_fd_, remain, len);
+                errno = ETIMEDOUT;
+                return false;
+            }
+            LOGE("xdma", op, errno, "fd=%d off=%lld", h2c_fd_, (long long)off);
             return false;
         }
         remain -= static_cast<size_t>(n);
@@ -291,42 +461,50 @@ bool XdmaTransport::continuousWrite(int channel, const void* buf, size_t len) {
     return true;
 }
 
-bool XdmaTransport::continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) {
-    if (h2c_fd_ < 0 || channel != cfg_.dma_h2c_channel) return false;
-    const uint8_t* p = static_cast<const uint8_t*>(buf);
-    size_t remain = len;
-    off_t off = static_cast<off_t>(device_offset);
-    while (remain > 0) {
-        ssize_t n = ::pwrite(h2c_fd_, p, remain, off);
-        if (n < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) { continue; }
-            LOGE("xdma", "dmaWriteAt", errno, "fd=%d off=%lld", h2c_fd_, (long long)off);
-            return false;
-        }
-        remain -= static_cast<size_t>(n);
-        p += n;
-        off += n;
-    }
-    return true;
-}
-
-bool XdmaTransport::continuousRead(int channel, void* buf, size_t len) {
-    if (c2h_fd_ < 0 || channel != cfg_.dma_c2h_channel) return false;
+bool XdmaTransport::dma_read_all(const char* op, void* buf, size_t len, off_t off) {
     uint8_t* p = static_cast<uint8_t*>(buf);
     size_t got = 0;
-    off_t off = use_default_device_offset_ ? static_cast<off_t>(default_device_offset_) : -1;
+    DmaWaiter waiter(wait_opt_);
     while (got < len) {
         ssize_t n = (off >= 0) ? ::pread(c2h_fd_, p + got, len - got, off) : ::read(c2h_fd_, p + got, len - got);
         if (n < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) { break; }
-            LOGE("xdma", "dmaRead", errno, "fd=%d", c2h_fd_);
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (waiter.wait(c2h_fd_, POLLIN)) continue;
+                LOGE("xdma", op, ETIMEDOUT, "fd=%d got=%zu/%zu", c2h_fd_, got, len);
+                errno = ETIMEDOUT;
+                return false;
+            }
+            LOGE("xdma", op, errno, "fd=%d off=%lld", c2h_fd_, (long long)off);
+            return false;
+        }
+        if (n == 0) {
+            // 设备侧无更多数据：短读视为失败，调用方只会看到完整传输
+            LOGE("xdma", op, EIO, "short read got=%zu/%zu", got, len);
+            errno = EIO;
             return false;
         }
-        if (n == 0) break;
         got += static_cast<size_t>(n);
         if (off >= 0) off += n;
     }
-    return got > 0;
+    return true;
+}
+
+bool XdmaTransport::continuousWrite(int channel, const void* buf, size_t len) {
+    if (h2c_fd_ < 0 || channel != cfg_.dma_h2c_channel) return false;
+    off_t off = use_default_device_offset_ ? static_cast<off_t>(default_device_offset_) : -1;
+    return dma_write_all("dmaWrite", buf, len, off);
+}
+
+bool XdmaTransport::continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) {
+    if (h2c_fd_ < 0 || channel != cfg_.dma_h2c_channel) return false;
+    return dma_write_all("dmaWriteAt", buf, len, static_cast<off_t>(device_offset));
+}
+
+bool XdmaTransport::continuousRead(int channel, void* buf, size_t len) {
+    if (c2h_fd_ < 0 || channel != cfg_.dma_c2h_channel) return false;
+    off_t off = use_default_device_offset_ ? static_cast<off_t>(default_device_offset_) : -1;
+    return dma_read_all("dmaRead", buf, len, off);
 }
 
 void XdmaTransport::setDefaultDeviceOffset(uint64_t off) {
@@ -338,27 +516,12 @@ void XdmaTransport::clearDefaultDeviceOffset() {
     use_default_device_offset_ = false;
 }
 
- bool XdmaTransport::continuousReadAt(int channel, void* buf, size_t len, uint64_t device_offset) {
+bool XdmaTransport::continuousReadAt(int channel, void* buf, size_t len, uint64_t device_offset) {
     if (c2h_fd_ < 0 || channel != cfg_.dma_c2h_channel) return false;
-    uint8_t* p = static_cast<uint8_t*>(buf);
-    size_t got = 0;
-    off_t off = static_cast<off_t>(device_offset);
-    while (got < len) {
-        ssize_t n = ::pread(c2h_fd_, p + got, len - got, off);
-        if (n < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) { break; }
-            LOGE("xdma", "dmaReadAt", errno, "fd=%d off=%lld", c2h_fd_, (long long)off);
-            return false;
-        }
-        if (n == 0) break;
-        got += static_cast<size_t>(n);
-        off += n;
-    }
-    return got > 0;
+    return dma_read_all("dmaReadAt", buf, len, static_cast<off_t>(device_offset));
 }
 
 int XdmaTransport::waitEvent(uint32_t* bitmap, uint32_t timeout_ms) {
-    (void)bitmap;
     if (events_fd_ < 0) return 0;
     struct pollfd pfd{ events_fd_, POLLIN, 0 };
     int ret = ::poll(&pfd, 1, static_cast<int>(timeout_ms));
@@ -368,66 +531,389 @@ int XdmaTransport::waitEvent(uint32_t* bitmap, uint32_t timeout_ms) {
         return -1;
     }
     if (pfd.revents & POLLIN) {
+        // 读出 4 字节事件计数以清除驱动侧就绪标志，否则 fd 持续可读，poll/epoll 使用者会空转
+        uint32_t events = 0;
+        if (::read(events_fd_, &events, sizeof(events)) != static_cast<ssize_t>(sizeof(events))) events = 0;
+        if (bitmap) *bitmap = events;
         return 4;
     }
     return 0;
 }
 
+#if MB_DDF_HAS_IOURING
+bool XdmaTransport::init_iouring(uint32_t depth) {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    if (async_opt_.sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = async_opt_.sqpoll_idle_ms;
+        if (async_opt_.sqpoll_cpu >= 0) {
+            params.flags |= IORING_SETUP_SQ_AFF;
+            params.sq_thread_cpu = static_cast<uint32_t>(async_opt_.sqpoll_cpu);
+        }
+    }
+    int rc = ::io_uring_queue_init_params(depth, &ring_, &params);
+    if (rc < 0 && async_opt_.sqpoll) {
+        // SQPOLL 可能因权限或内核版本不可用，回退为普通提交
+        LOGW("xdma", "iouring_sqpoll", -rc, "fallback to normal submit");
+        std::memset(&params, 0, sizeof(params));
+        rc = ::io_uring_queue_init_params(depth, &ring_, &params);
+    }
+    if (rc < 0) {
+        LOGW("xdma", "iouring_queue_init", -rc, "depth=%u", depth);
+        return false;
+    }
+    iouring_inited_ = true;
+
+    // 将 eventfd 注册到 io_uring，用于完成通知
+    if (aio_event_fd_ >= 0) {
+        rc = ::io_uring_register_eventfd(&ring_, aio_event_fd_);
+        if (rc < 0) LOGW("xdma", "iouring_register_eventfd", -rc, "");
+    }
+
+    // 注册 DMA fd 为固定文件：h2c/c2h 按打开情况依次占用下标
+    if (async_opt_.fixed_files) {
+        int files[2];
+        unsigned nfiles = 0;
+        if (h2c_fd_ >= 0) files[nfiles++] = h2c_fd_;
+        if (c2h_fd_ >= 0) files[nfiles++] = c2h_fd_;
+        rc = ::io_uring_register_files(&ring_, files, nfiles);
+        if (rc == 0) {
+            int next = 0;
+            if (h2c_fd_ >= 0) h2c_file_idx_ = next++;
+            if (c2h_fd_ >= 0) c2h_file_idx_ = next++;
+        } else {
+            LOGW("xdma", "iouring_register_files", -rc, "use plain fds");
+        }
+    }
+    LOGI("xdma", "iouring_init", 0, "depth=%u sqpoll=%d fixed_files=%d",
+         depth, (params.flags & IORING_SETUP_SQPOLL) ? 1 : 0, h2c_file_idx_ >= 0 || c2h_file_idx_ >= 0);
+    return true;
+}
+
+size_t XdmaTransport::withdraw_unsubmitted(unsigned first, const uint32_t* idx, size_t queued) {
+    // SQPOLL：已发布的 SQE 由内核轮询线程取走，全部视为已下发
+    if (ring_.flags & IORING_SETUP_SQPOLL) return queued;
+    // 否则内核只在 io_uring_enter 内按序取 SQE：khead 之前的已下发，其余改为 NOP 并归还槽位，
+    // 调用方据返回值得知这些请求未下发，缓冲可立即复用
+    const unsigned head = io_uring_smp_load_acquire(ring_.sq.khead);
+    size_t issued = 0;
+    for (size_t i = 0; i < queued; ++i) {
+        const unsigned pos = first + static_cast<unsigned>(i);
+        if (static_cast<int>(pos - head) < 0) {
+            ++issued;
+            continue;
+        }
+        auto* sqe = &ring_.sq.sqes[pos & *ring_.sq.kring_mask];
+        ::io_uring_prep_nop(sqe);
+        sqe->user_data = kNopUserData;
+        release_slot(idx[i]);
+    }
+    return issued;
+}
+
+int XdmaTransport::find_registered_buffer(const void* buf, size_t len) const {
+    auto p = reinterpret_cast<uintptr_t>(buf);
+    for (unsigned i = 0; i < reg_buf_count_; ++i) {
+        auto base = reinterpret_cast<uintptr_t>(reg_bufs_[i].iov_base);
+        if (p >= base && p + len <= base + reg_bufs_[i].iov_len) return static_cast<int>(i);
+    }
+    return -1;
+}
+#endif
+
+bool XdmaTransport::registerDmaBuffers(const struct iovec* iov, unsigned count) {
+#if MB_DDF_HAS_IOURING
+    if (!iouring_inited_ || !iov || count == 0) return false;
+    if (count > kMaxRegisteredBuffers) {
+        LOGE("xdma", "register_buffers", EINVAL, "count=%u max=%u", count, kMaxRegisteredBuffers);
+        return false;
+    }
+    std::lock_guard<std::mutex> lk(submit_mu_);
+    if (reg_buf_count_ > 0) {
+        (void)::io_uring_unregister_buffers(&ring_);
+        reg_buf_count_ = 0;
+    }
+    int rc = ::io_uring_register_buffers(&ring_, iov, count);
+    if (rc < 0) {
+        LOGE("xdma", "register_buffers", -rc, "count=%u", count);
+        return false;
+    }
+    for (unsigned i = 0; i < count; ++i) reg_bufs_[i] = iov[i];
+    reg_buf_count_ = count;
+    return true;
+#else
+    (void)iov; (void)count;
+    return false;
+#endif
+}
+
+void XdmaTransport::unregisterDmaBuffers() {
+#if MB_DDF_HAS_IOURING
+    std::lock_guard<std::mutex> lk(submit_mu_);
+    if (iouring_inited_ && reg_buf_count_ > 0) {
+        (void)::io_uring_unregister_buffers(&ring_);
+    }
+    reg_buf_count_ = 0;
+#endif
+}
+
 int XdmaTransport::getAioEventFd() const { return aio_event_fd_; }
 
+bool XdmaTransport::has_async_backend() const {
+#if MB_DDF_HAS_IOURING
+    return iouring_inited_;
+#elif MB_DDF_HAS_LIBAIO
+    return aio_ctx_ != 0;
+#else
+    return false;
+#endif
+}
+
+bool XdmaTransport::valid_async_request(const AsyncRequest& r) const {
+    if (r.len > std::numeric_limits<uint32_t>::max()) return false;   // io_uring 请求长度为 32 位
+    if (r.is_write) return h2c_fd_ >= 0 && r.channel == cfg_.dma_h2c_channel;
+    return c2h_fd_ >= 0 && r.channel == cfg_.dma_c2h_channel;
+}
+
+void XdmaTransport::init_async_pool(uint32_t depth) {
+    std::lock_guard<std::mutex> lk(pool_mu_);
+    async_depth_ = depth;
+    done_head_ = done_tail_ = 0;
+    if (depth == 0) {
+        slots_.reset();
+        free_slots_.reset();
+        done_ring_.reset();
+        free_top_ = 0;
+        return;
+    }
+    slots_.reset(new AsyncSlot[depth]);
+    free_slots_.reset(new uint32_t[depth]);
+    done_ring_.reset(new uint32_t[depth]);
+    for (uint32_t i = 0; i < depth; ++i) free_slots_[i] = depth - 1 - i;
+    free_top_ = depth;
+}
+
+size_t XdmaTransport::acquire_slots(uint32_t* out, size_t n) {
+    std::lock_guard<std::mutex> lk(pool_mu_);
+    size_t got = 0;
+    while (got < n && free_top_ > 0) out[got++] = free_slots_[--free_top_];
+    return got;
+}
+
+void XdmaTransport::release_slot(uint32_t idx) {
+    std::lock_guard<std::mutex> lk(pool_mu_);
+    if (free_top_ < async_depth_) free_slots_[free_top_++] = idx;
+}
+
+void XdmaTransport::finish_slot(uint32_t idx, ssize_t res) {
+    if (idx >= async_depth_) {
+        LOGW("xdma", "async_complete", EINVAL, "bad slot=%u", idx);
+        return;
+    }
+    // 先拷出上下文并归还槽位，回调中可立即重新提交
+    const AsyncSlot& slot = slots_[idx];
+    void* token = slot.token;
+    bool is_write = slot.is_write;
+    bool tagged = slot.tagged;
+    release_slot(idx);
+    if (tagged) {
+        if (on_async_complete_) on_async_complete_(token, is_write, res);
+    } else if (is_write) {
+        if (on_write_complete_) on_write_complete_(res);
+    } else {
+        if (on_read_complete_) on_read_complete_(res);
+    }
+}
+
+int XdmaTransport::submit_requests(const AsyncRequest* reqs, size_t count, bool tagged) {
+    if (!reqs || count == 0) return 0;
+    if (!slots_) return -ENODEV;
+    // 遇到第一个非法请求即截断，之前的请求照常提交
+    size_t valid = 0;
+    while (valid < count && valid_async_request(reqs[valid])) ++valid;
+    if (valid == 0) return -EINVAL;
+
+    std::lock_guard<std::mutex> lk(submit_mu_);
+    size_t done = 0;
+    while (done < valid) {
+        uint32_t idx[kSubmitBatch];
+        size_t n = acquire_slots(idx, std::min(valid - done, kSubmitBatch));
+        if (n == 0) break;
+        for (size_t i = 0; i < n; ++i) {
+            AsyncSlot& slot = slots_[idx[i]];
+            slot.token = reqs[done + i].token;
+            slot.is_write = reqs[done + i].is_write;
+            slot.tagged = tagged;
+            slot.result = 0;
+        }
+#if MB_DDF_HAS_IOURING
+        if (iouring_inited_) {
+            const unsigned first = ring_.sq.sqe_tail;
+            size_t queued = 0;
+            for (; queued < n; ++queued) {
+                const AsyncRequest& r = reqs[done + queued];
+                auto* sqe = ::io_uring_get_sqe(&ring_);
+                if (!sqe) { LOGW("xdma", "iouring_get_sqe", ENOMEM, "queued=%zu", queued); break; }
+                // 固定文件以注册下标代替 fd；缓冲落在注册区间内时使用 *_FIXED 操作
+                int file_idx = r.is_write ? h2c_file_idx_ : c2h_file_idx_;
+                int fd = file_idx >= 0 ? file_idx : (r.is_write ? h2c_fd_ : c2h_fd_);
+                int buf_idx = find_registered_buffer(r.buf, r.len);
+                unsigned nbytes = static_cast<unsigned>(r.len);
+                if (r.is_write) {
+                    if (buf_idx >= 0) ::io_uring_prep_write_fixed(sqe, fd, r.buf, nbytes, r.device_offset, buf_idx);
+                    else ::io_uring_prep_write(sqe, fd, r.buf, nbytes, r.device_offset);
+                } else {
+                    if (buf_idx >= 0) ::io_uring_prep_read_fixed(sqe, fd, r.buf, nbytes, r.device_offset, buf_idx);
+                    else ::io_uring_prep_read(sqe, fd, r.buf, nbytes, r.device_offset);
+                }
+                if (file_idx >= 0) ::io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+                sqe->user_data = idx[queued];
+            }
+            for (size_t i = queued; i < n; ++i) release_slot(idx[i]);
+            if (queued == 0) break;
+            int rc = ::io_uring_submit(&ring_);
+            size_t issued = withdraw_unsubmitted(first, idx, queued);
+            done += issued;
+            if (rc < 0) {
+                LOGE("xdma", "iouring_submit", -rc, "batch=%zu issued=%zu", queued, issued);
+                return done > 0 ? static_cast<int>(done) : rc;
+            }
+            if (issued < n) break;
+            continue;
+        }
+#elif MB_DDF_HAS_LIBAIO
+        if (aio_ctx_) {
+            struct iocb* list[kSubmitBatch];
+            for (size_t i = 0; i < n; ++i) {
+                const AsyncRequest& r = reqs[done + i];
+                AsyncSlot& slot = slots_[idx[i]];
+                if (r.is_write) {
+                    ::io_prep_pwrite(&slot.cb, h2c_fd_, r.buf, r.len, static_cast<long long>(r.device_offset));
+                } else {
+                    ::io_prep_pread(&slot.cb, c2h_fd_, r.buf, r.len, static_cast<long long>(r.device_offset));
+                }
+                slot.cb.data = &slot;
+                if (aio_event_fd_ >= 0) {
+                    slot.cb.u.c.flags |= IOCB_FLAG_RESFD;
+                    slot.cb.u.c.resfd = aio_event_fd_;
+                }
+                list[i] = &slot.cb;
+            }
+            int rc = ::io_submit(aio_ctx_, static_cast<long>(n), list);
+            size_t accepted = rc > 0 ? static_cast<size_t>(rc) : 0;
+            for (size_t i = accepted; i < n; ++i) release_slot(idx[i]);
+            if (rc < 0) {
+                LOGE("xdma", "io_submit", -rc, "batch=%zu", n);
+                return done > 0 ? static_cast<int>(done) : rc;
+            }
+            done += accepted;
+            if (accepted < n) break;
+            continue;
+        }
+#endif
+        // 无异步后端：同步完成传输，结果经完成环与 eventfd 投递，语义与异步路径一致
+        for (size_t i = 0; i < n; ++i) {
+            const AsyncRequest& r = reqs[done + i];
+            bool ok = r.is_write ? continuousWriteAt(r.channel, r.buf, r.len, r.device_offset)
+                                 : continuousReadAt(r.channel, r.buf, r.len, r.device_offset);
+            slots_[idx[i]].result = ok ? static_cast<ssize_t>(r.len) : -EIO;
+            std::lock_guard<std::mutex> plk(pool_mu_);
+            done_ring_[done_tail_++ % async_depth_] = idx[i];
+        }
+        done += n;
+        if (aio_event_fd_ >= 0) {
+            uint64_t one = 1;
+            ssize_t wr = ::write(aio_event_fd_, &one, sizeof(one));
+            (void)wr;
+        }
+    }
+    if (done == 0) {
+        LOGW("xdma", "async_pool", EAGAIN, "exhausted depth=%u", async_depth_);
+        return -EAGAIN;
+    }
+    return static_cast<int>(done);
+}
+
+int XdmaTransport::submitAsyncBatch(const AsyncRequest* reqs, size_t count) {
+    int n = submit_requests(reqs, count, true);
+    if (n == -EAGAIN) {
+        // 请求池耗尽：非阻塞收割一次后重试
+        (void)drainAioCompletions(kDrainBatch);
+        n = submit_requests(reqs, count, true);
+    }
+    return n;
+}
+
 int XdmaTransport::drainAioCompletions(int max_events) {
+    if (max_events <= 0 || !slots_) return 0;
+    bool expected = false;
+    if (!draining_.compare_exchange_strong(expected, true, std::memory_order_acquire)) return 0;
+
     // 清理 aio_event_fd_ 计数（非阻塞）
     if (aio_event_fd_ >= 0) {
-        uint64_t cnt = 0; (void)cnt;
-        int ret = ::read(aio_event_fd_, &cnt, sizeof(cnt));
+        uint64_t cnt = 0;
+        ssize_t ret = ::read(aio_event_fd_, &cnt, sizeof(cnt));
         (void)ret;
     }
+
+    int total = 0;
+    // 同步回退路径投递的完成
+    while (total < max_events) {
+        uint32_t idx = 0;
+        {
+            std::lock_guard<std::mutex> lk(pool_mu_);
+            if (done_head_ == done_tail_) break;
+            idx = done_ring_[done_head_++ % async_depth_];
+        }
+        finish_slot(idx, slots_[idx].result);
+        ++total;
+    }
 #if MB_DDF_HAS_IOURING
     if (iouring_inited_) {
-        std::vector<io_uring_cqe*> cqes(static_cast<size_t>(max_events));
-        int n = ::io_uring_peek_batch_cqe(&ring_, cqes.data(), max_events);
-        for (int i = 0; i < n; ++i) {
-            auto* cqe = cqes[static_cast<size_t>(i)];
-            uint64_t ud = cqe->user_data;
-            bool is_write = (ud & kAioFlagWrite) != 0;
-            ssize_t res = static_cast<ssize_t>(cqe->res);
-            if (is_write) {
-                if (on_write_complete_) on_write_complete_(res);
-            } else {
-                if (on_read_complete_) on_read_complete_(res);
+        io_uring_cqe* cqes[kDrainBatch];
+        uint32_t idx[kDrainBatch];
+        ssize_t res[kDrainBatch];
+        while (total < max_events) {
+            unsigned want = static_cast<unsigned>(std::min(kDrainBatch, max_events - total));
+            unsigned n = ::io_uring_peek_batch_cqe(&ring_, cqes, want);
+            if (n == 0) break;
+            // 先拷出结果再推进 CQ
+            unsigned m = 0;
+            for (unsigned i = 0; i < n; ++i) {
+                if (cqes[i]->user_data == kNopUserData) continue;   // 撤回的 SQE
+                idx[m] = static_cast<uint32_t>(cqes[i]->user_data);
+                res[m] = static_cast<ssize_t>(cqes[i]->res);
+                ++m;
             }
-            ::io_uring_cqe_seen(&ring_, cqe);
+            ::io_uring_cq_advance(&ring_, n);
+            for (unsigned i = 0; i < m; ++i) finish_slot(idx[i], res[i]);
+            total += static_cast<int>(m);
         }
-        return n;
     }
 #elif MB_DDF_HAS_LIBAIO
     if (aio_ctx_) {
-        std::vector<io_event> events(static_cast<size_t>(max_events));
-        timespec ts{0, 0};
-        int n = ::io_getevents(aio_ctx_, 1, max_events, events.data(), &ts);
-        if (n < 0) {
-            LOGE("xdma", "io_getevents", -n, "");
-            return -1;
-        }
-        for (int i = 0; i < n; ++i) {
-            auto* obj = static_cast<struct iocb*>(events[i].obj);
-            ssize_t res = static_cast<ssize_t>(events[i].res);
-            if (obj) {
-                // 路由到读/写的全局回调
-                if (obj->aio_lio_opcode == IOCB_CMD_PWRITE) {
-                    if (on_write_complete_) on_write_complete_(res);
-                } else if (obj->aio_lio_opcode == IOCB_CMD_PREAD) {
-                    if (on_read_complete_) on_read_complete_(res);
-                }
-                // 释放对应的 iocb
-                delete obj;
+        io_event events[kDrainBatch];
+        while (total < max_events) {
+            timespec ts{0, 0};
+            long want = std::min(kDrainBatch, max_events - total);
+            int n = ::io_getevents(aio_ctx_, 0, want, events, &ts);
+            if (n < 0) {
+                LOGE("xdma", "io_getevents", -n, "");
+                break;
+            }
+            if (n == 0) break;
+            for (int i = 0; i < n; ++i) {
+                auto* slot = static_cast<AsyncSlot*>(events[i].data);
+                ssize_t res = static_cast<ssize_t>(static_cast<long>(events[i].res));
+                finish_slot(static_cast<uint32_t>(slot - slots_.get()), res);
             }
+            total += n;
         }
-        return n;
     }
 #endif
-    (void)max_events;
-    return 0;
+    draining_.store(false, std::memory_order_release);
+    return total;
 }
 
 bool XdmaTransport::continuousWriteAsync(int channel,
@@ -435,39 +921,19 @@ bool XdmaTransport::continuousWriteAsync(int channel,
                                   size_t len,
                                   uint64_t device_offset) {
     if (h2c_fd_ < 0 || channel != cfg_.dma_h2c_channel) return false;
-#if MB_DDF_HAS_IOURING
-    if (iouring_inited_) {
-        auto* sqe = ::io_uring_get_sqe(&ring_);
-        if (!sqe) { LOGW("xdma", "iouring_get_sqe", -ENOMEM, ""); return false; }
-        uint64_t key = kAioFlagWrite | (next_aio_id_++ & (~kAioFlagWrite));
-        ::io_uring_prep_write(sqe, h2c_fd_, const_cast<void*>(buf), len, static_cast<off_t>(device_offset));
-        sqe->user_data = key;
-        int rc = ::io_uring_submit(&ring_);
-        if (rc < 0) {
-            LOGE("xdma", "iouring_submit", -rc, "write_async");
-            return false;
-        }
-        return true;
-    }
-#elif MB_DDF_HAS_LIBAIO
-    if (aio_ctx_) {
-        auto* iocb_ptr = new struct iocb();
-        memset(iocb_ptr, 0, sizeof(*iocb_ptr));
-        ::io_prep_pwrite(iocb_ptr, h2c_fd_, const_cast<void*>(buf), len, static_cast<long long>(device_offset));
-        iocb_ptr->u.c.flags |= IOCB_FLAG_RESFD;
-        iocb_ptr->u.c.resfd = aio_event_fd_;
-        struct iocb* list[1] = { iocb_ptr };
-        int rc = ::io_submit(aio_ctx_, 1, list);
-        if (rc != 1) {
-            LOGE("xdma", "io_submit", rc < 0 ? -rc : rc, "write_async");
-            delete iocb_ptr;
-            return false;
-        }
-        // iocb_ptr 由完成后释放
-        return true;
-    }
-#endif
-    return continuousWriteAt(channel, buf, len, device_offset);
+    if (!has_async_backend()) return continuousWriteAt(channel, buf, len, device_offset);
+    AsyncRequest req;
+    req.is_write = true;
+    req.channel = channel;
+    req.buf = const_cast<void*>(buf);
+    req.len = len;
+    req.device_offset = device_offset;
+    int n = submit_requests(&req, 1, false);
+    if (n == -EAGAIN) {
+        (void)drainAioCompletions(kDrainBatch);
+        n = submit_requests(&req, 1, false);
+    }
+    return n == 1;
 }
 
 bool XdmaTransport::continuousReadAsync(int channel,
@@ -475,38 +941,18 @@ bool XdmaTransport::continuousReadAsync(int channel,
                                  size_t len,
                                  uint64_t device_offset) {
     if (c2h_fd_ < 0 || channel != cfg_.dma_c2h_channel) return false;
-#if MB_DDF_HAS_IOURING
-    if (iouring_inited_) {
-        auto* sqe = ::io_uring_get_sqe(&ring_);
-        if (!sqe) { LOGW("xdma", "iouring_get_sqe", -ENOMEM, ""); return false; }
-        uint64_t key = (next_aio_id_++ & (~kAioFlagWrite)); // 最高位为0表示读
-        ::io_uring_prep_read(sqe, c2h_fd_, buf, len, static_cast<off_t>(device_offset));
-        sqe->user_data = key;
-        int rc = ::io_uring_submit(&ring_);
-        if (rc < 0) {
-            LOGE("xdma", "iouring_submit", -rc, "read_async");
-            return false;
-        }
-        return true;
-    }
-#elif MB_DDF_HAS_LIBAIO
-    if (aio_ctx_) {
-        auto* iocb_ptr = new struct iocb();
-        memset(iocb_ptr, 0, sizeof(*iocb_ptr));
-        ::io_prep_pread(iocb_ptr, c2h_fd_, buf, len, static_cast<long long>(device_offset));
-        iocb_ptr->u.c.flags |= IOCB_FLAG_RESFD;
-        iocb_ptr->u.c.resfd = aio_event_fd_;
-        struct iocb* list[1] = { iocb_ptr };
-        int rc = ::io_submit(aio_ctx_, 1, list);
-        if (rc != 1) {
-            LOGE("xdma", "io_submit", rc < 0 ? -rc : rc, "read_async");
-            delete iocb_ptr;
-            return false;
-        }
-        return true;
-    }
-#endif
-    return continuousReadAt(channel, buf, len, device_offset);
+    if (!has_async_backend()) return continuousReadAt(channel, buf, len, device_offset);
+    AsyncRequest req;
+    req.channel = channel;
+    req.buf = buf;
+    req.len = len;
+    req.device_offset = device_offset;
+    int n = submit_requests(&req, 1, false);
+    if (n == -EAGAIN) {
+        (void)drainAioCompletions(kDrainBatch);
+        n = submit_requests(&req, 1, false);
+    }
+    return n == 1;
 }
 
 } // namespace ControlPlane
@@ -1,7 +1,12 @@
 #pragma once
 #include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/UserBarMapping.h"
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <sys/uio.h>
 
 // 可选：io_uring 与 libaio 支持（默认关闭，CMake 自动探测开启）
 #ifndef MB_DDF_HAS_IOURING
@@ -21,6 +26,25 @@ namespace MB_DDF {
 namespace PhysicalLayer {
 namespace ControlPlane {
 
+// 异步后端参数（需在 open 之前设置）
+struct XdmaAsyncOptions {
+    uint32_t queue_depth = 0;       // 队列深度与请求池大小；0 使用后端默认值
+    bool     fixed_files = true;    // io_uring：注册 h2c/c2h fd，提交时免去 fd 查找
+    bool     sqpoll = false;        // io_uring：启用内核 SQ 轮询线程（失败时自动回退）
+    uint32_t sqpoll_idle_ms = 1000; // SQ 轮询线程空闲休眠阈值
+    int      sqpoll_cpu = -1;       // SQ 轮询线程绑定核心，<0 不绑定
+};
+
+// 同步 DMA 等待参数：fd 返回 EAGAIN 时先自旋重试 spin_budget 次，之后 poll 休眠等待；
+// xdma 的 h2c/c2h 字符设备未实现 poll（内核立即报告就绪），检测到就绪后重试仍 EAGAIN 时改为退避休眠
+struct XdmaWaitOptions {
+    uint32_t timeout_ms = 1000;     // 单次 continuous* 调用的总超时；0 表示不限
+    uint32_t spin_budget = 64;      // 进入 poll 前的自旋重试次数；0 表示直接 poll
+    bool     use_poll = true;       // false：跳过 poll，自旋后直接退避休眠
+    uint32_t backoff_min_us = 10;   // 退避休眠初值，此后每次 EAGAIN 翻倍
+    uint32_t backoff_max_us = 1000; // 退避休眠上限
+};
+
 class XdmaTransport : public IDeviceTransport {
 public:
     XdmaTransport() = default;
@@ -29,7 +53,8 @@ public:
     bool open(const TransportConfig& cfg) override;
     void close() override;
 
-    // mmap 寄存器访问
+    // mmap 寄存器访问：窗口为 [device_offset, device_offset + register_window)，
+    // 取自进程级共享 BAR 映射（同一 user 设备节点上区间重叠的窗口共用一个映射）
     void* getMappedBase() const override { return user_base_; }
     size_t getMappedLength() const override { return mapped_len_; }
     bool readReg8(uint64_t offset, uint8_t& val) const override;
@@ -38,6 +63,14 @@ public:
     bool writeReg16(uint64_t offset, uint16_t val) override;
     bool readReg32(uint64_t offset, uint32_t& val) const override;
     bool writeReg32(uint64_t offset, uint32_t val) override;
+    // 突发访问：一次边界/对齐检查后以 volatile 整字顺序访问映射窗口
+    bool readRegs32(uint64_t offset, std::span<uint32_t> out) const override;
+    bool writeRegs32(uint64_t offset, std::span<const uint32_t> in) override;
+    bool copyToDevice(uint64_t offset, const void* src, size_t len) override;
+    bool copyFromDevice(uint64_t offset, void* dst, size_t len) const override;
+    // 块拷贝在 8 字节对齐处使用 64 位访问（需用户逻辑支持 64 位 AXI 访问，默认关闭）
+    void setWideMmio(bool enable) { wide_mmio_ = enable; }
+    bool wideMmio() const { return wide_mmio_; }
 
     // 同步 DMA 接口
     bool continuousWrite(int channel, const void* buf, size_t len) override;
@@ -45,6 +78,9 @@ public:
     // 带设备偏移的同步接口
     bool continuousWriteAt(int channel, const void* buf, size_t len, uint64_t device_offset) override;
     bool continuousReadAt(int channel, void* buf, size_t len, uint64_t device_offset) override;
+    // 同步接口的等待策略：超时后返回 false（errno=ETIMEDOUT），读接口仅在读满时返回 true
+    void setWaitOptions(const XdmaWaitOptions& opt) { wait_opt_ = opt; }
+    const XdmaWaitOptions& waitOptions() const { return wait_opt_; }
     // 可选：设置默认设备偏移
     void setDefaultDeviceOffset(uint64_t off);
     void clearDefaultDeviceOffset();
@@ -64,9 +100,27 @@ public:
     // 非 SPI：原始传输不支持
     bool xfer(const uint8_t* /*tx*/, uint8_t* /*rx*/, size_t /*len*/) override { return false; }
 
+    // 异步后端参数：open 之前设置，open 之后修改不生效
+    void setAsyncOptions(const XdmaAsyncOptions& opt) { async_opt_ = opt; }
+    const XdmaAsyncOptions& asyncOptions() const { return async_opt_; }
+
+    // 注册 DMA 缓冲池（io_uring 后端）：落在已注册区间内的请求改用 READ_FIXED/WRITE_FIXED，
+    // 免去每次提交的页面锁定。须在 open 之后、无在途请求时调用；重复调用会替换旧注册。
+    // 其他后端返回 false，请求照常走普通路径。
+    bool registerDmaBuffers(const struct iovec* iov, unsigned count);
+    void unregisterDmaBuffers();
+
+    // 带标记的异步接口：请求槽在 open 时预分配，批量请求仅触发一次提交系统调用
+    void setOnAsyncComplete(AsyncCompletion cb) override { on_async_complete_ = std::move(cb); }
+    int submitAsyncBatch(const AsyncRequest* reqs, size_t count) override;
+
     // 完成收割 & 事件 FD 暴露（用于与上层 event loop 集成）
-    int getAioEventFd() const;
-    int drainAioCompletions(int max_events);
+    // 收割过程不做堆分配；同一时刻仅允许一个线程收割，并发调用直接返回 0
+    int getAioEventFd() const override;
+    int drainAioCompletions(int max_events) override;
+
+    // 寄存器窗口取自进程级共享映射（见 UserBarMapping）
+    bool usesSharedBar() const { return bar_ != nullptr; }
 
     // 工具函数：构造设备节点路径
     static std::string make_user_path(const std::string& base) { return base + "_user"; }
@@ -75,15 +129,47 @@ public:
     static std::string make_events_path(const std::string& base, int num) { return base + "_events_" + std::to_string(num); }
 
 private:
+    // 预分配的异步请求槽：io_uring 以槽下标作为 user_data，libaio 内嵌 iocb
+    struct AsyncSlot {
+        void*   token = nullptr;
+        ssize_t result = 0;
+        bool    is_write = false;
+        bool    tagged = false;   // false: 旧接口提交，完成时走全局读/写回调
+#if !MB_DDF_HAS_IOURING && MB_DDF_HAS_LIBAIO
+        struct iocb cb{};
+#endif
+    };
+
     static long page_size();
     static int set_nonblock(int fd);
 
+    // 映射窗口检查：已映射、offset 按 align 对齐且 [offset, offset+bytes) 落在窗口内
+    bool check_window(const char* op, uint64_t offset, size_t bytes, size_t align) const;
+
+    bool dma_write_all(const char* op, const void* buf, size_t len, off_t off);
+    bool dma_read_all(const char* op, void* buf, size_t len, off_t off);
+
+    bool has_async_backend() const;
+    bool valid_async_request(const AsyncRequest& r) const;
+    void init_async_pool(uint32_t depth);
+    size_t acquire_slots(uint32_t* out, size_t n);
+    void release_slot(uint32_t idx);
+    void finish_slot(uint32_t idx, ssize_t res);
+    int submit_requests(const AsyncRequest* reqs, size_t count, bool tagged);
+#if MB_DDF_HAS_IOURING
+    bool init_iouring(uint32_t depth);
+    // 提交后核对内核已取走的 SQE：未取走的改为 NOP 并归还槽位，返回已下发数量
+    size_t withdraw_unsubmitted(unsigned first, const uint32_t* idx, size_t queued);
+    int find_registered_buffer(const void* buf, size_t len) const;
+#endif
+
     TransportConfig cfg_{};
 
-    // user 寄存器设备
-    int user_fd_ = -1;
+    // user 寄存器设备：共享映射视图
+    std::shared_ptr<UserBarMapping> bar_;
     void* user_base_ = nullptr;
     size_t mapped_len_ = 0;
+    bool wide_mmio_ = false;
 
     // DMA 设备（可选）
     int h2c_fd_ = -1;
@@ -98,13 +184,33 @@ private:
 
     // AIO/IOURING 资源
     int aio_event_fd_ = -1; // 统一暴露给上层的事件fd
-    uint64_t next_aio_id_ = 1; // 生成唯一 user_data 键
     std::function<void(ssize_t)> on_write_complete_ = nullptr;
     std::function<void(ssize_t)> on_read_complete_ = nullptr;
+    AsyncCompletion on_async_complete_ = nullptr;
+
+    // 请求池：空闲槽栈 + 同步回退路径的完成环（均为定长数组，运行期不分配）
+    uint32_t async_depth_ = 0;
+    std::unique_ptr<AsyncSlot[]> slots_;
+    std::unique_ptr<uint32_t[]> free_slots_;
+    uint32_t free_top_ = 0;
+    std::unique_ptr<uint32_t[]> done_ring_;
+    uint32_t done_head_ = 0;
+    uint32_t done_tail_ = 0;
+    std::mutex pool_mu_;    // 保护空闲栈与完成环
+    std::mutex submit_mu_;  // 串行化提交队列
+    std::atomic<bool> draining_{false};
+
+    XdmaAsyncOptions async_opt_{};
+    XdmaWaitOptions wait_opt_{};
 
 #if MB_DDF_HAS_IOURING
+    static constexpr unsigned kMaxRegisteredBuffers = 16;
     struct io_uring ring_{};
     bool iouring_inited_ = false;
+    int h2c_file_idx_ = -1;   // 固定文件下标，<0 表示未注册
+    int c2h_file_idx_ = -1;
+    struct iovec reg_bufs_[kMaxRegisteredBuffers]{};
+    unsigned reg_buf_count_ = 0;
 #elif MB_DDF_HAS_LIBAIO
     io_context_t aio_ctx_ = 0; // libaio 使用 io_context_t
 #endif
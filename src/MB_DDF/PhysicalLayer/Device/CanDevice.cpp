@@ -67,9 +67,12 @@ bool CanDevice::send(const uint8_t* data, uint32_t len) {
     f.ide = (flags & 0x01) != 0;
     f.rtr = (flags & 0x02) != 0;
     f.dlc = data[5] & 0x0F;
-    uint32_t dlen = f.dlc;
-    f.data.resize(dlen);
-    if (dlen) std::memcpy(f.data.data(), data + 6, dlen);
+    uint8_t dlen = f.dlc > 8 ? 8 : f.dlc;
+    if (len < 6u + dlen) {
+        LOGE("can", "send", -EINVAL, "len=%u < header+data=%u", len, 6u + dlen);
+        return false;
+    }
+    f.setPayload(data + 6, dlen);
     return send(f);
 }
 
@@ -78,12 +81,12 @@ int32_t CanDevice::receive(uint8_t* buf, uint32_t buf_size) {
     CanFrame f;
     int ret = receive(f);
     if (ret <= 0) return ret;
-    uint32_t need = 6 + f.dlc;
+    uint32_t need = 6 + f.len;
     if (buf_size < need) return -EMSGSIZE;
     unpack_le32(f.id, buf);
     buf[4] = (f.ide ? 0x01 : 0) | (f.rtr ? 0x02 : 0);
     buf[5] = f.dlc;
-    if (f.dlc) std::memcpy(buf + 6, f.data.data(), f.dlc);
+    if (f.len) std::memcpy(buf + 6, f.data.data(), f.len);
     return static_cast<int32_t>(need);
 }
 
@@ -110,6 +113,42 @@ int32_t CanDevice::receive(CanFrame& frame, uint32_t timeout_us) {
     return receive(frame);
 }
 
+int32_t CanDevice::send_batch(std::span<const CanFrame> frames) {
+    if (frames.empty()) return 0;
+    (void)wr32(XCAN_ICR_OFFSET, XCAN_ICR_TXOK_MASK | XCAN_ICR_RXOK_MASK);
+    int32_t n = 0;
+    for (const CanFrame& f : frames) {
+        // FIFO 满时停止：写入满 FIFO 的帧被硬件丢弃
+        uint32_t sr = 0;
+        if (!rd32(XCAN_SR_OFFSET, sr)) return n ? n : -EIO;
+        if (sr & XCAN_SR_TXFLL_MASK) break;
+        if (!__push_tx_fifo(f)) return n ? n : -EIO;
+        ++n;
+    }
+    return n;
+}
+
+int32_t CanDevice::receive_batch(std::span<CanFrame> frames) {
+    int32_t n = 0;
+    for (CanFrame& f : frames) {
+        int r = __read_rx_fifo(f);
+        if (r < 0) return n ? n : r;
+        if (r == 0) break;
+        ++n;
+    }
+    return n;
+}
+
+int32_t CanDevice::receive_batch(std::span<CanFrame> frames, uint32_t timeout_us) {
+    // 先尝试排空：事件可能在上次排空后已被消费
+    int32_t n = receive_batch(frames);
+    if (n != 0) return n;
+    uint32_t bm = 0;
+    int ev = transport().waitEvent(&bm, timeout_us / 1000);
+    if (ev <= 0) return ev == 0 ? 0 : -1;
+    return receive_batch(frames);
+}
+
 int CanDevice::ioctl(uint32_t opcode, const void* in, size_t in_len, void* out, size_t out_len) {
     (void)out; (void)out_len;
     switch (opcode) {
@@ -156,20 +195,18 @@ int CanDevice::ioctl(uint32_t opcode, const void* in, size_t in_len, void* out,
 bool CanDevice::__reset() {
     // 写 SRR 的 SRST=1 触发复位
     if (!wr32(XCAN_SRR_OFFSET, XCAN_SRR_SRST_MASK)) return false;
-    usleep(100);
-    uint32_t v = 0;
-    if (!rd32(XCAN_SRR_OFFSET, v)) return false;
     // 复位后 SRST 自动清零
-    return (v & XCAN_SRR_SRST_MASK) == 0;
+    int rc = pollReg32(XCAN_SRR_OFFSET, XCAN_SRR_SRST_MASK, 0);
+    if (rc != 0) LOGE("can", "reset", rc, "SRST not cleared");
+    return rc == 0;
 }
 
 bool CanDevice::__enter_config() {
     // 写 CEN=0 进入配置模式
     if (!wr32(XCAN_SRR_OFFSET, 0)) return false;
-    usleep(100);
-    uint32_t sr = 0;
-    if (!rd32(XCAN_SR_OFFSET, sr)) return false;
-    return (sr & XCAN_SR_CONFIG_MASK) == XCAN_SR_CONFIG_MASK;
+    int rc = pollReg32(XCAN_SR_OFFSET, XCAN_SR_CONFIG_MASK, XCAN_SR_CONFIG_MASK);
+    if (rc != 0) LOGE("can", "enter_config", rc, "SR.CONFIG not set");
+    return rc == 0;
 }
 
 bool CanDevice::__set_loopback(bool on) {
@@ -180,70 +217,74 @@ bool CanDevice::__set_loopback(bool on) {
 bool CanDevice::__set_bit_timing(const BitTiming& bt) {
     // BRPR：BRP 直接写入低8位
     if (!wr32(XCAN_BRPR_OFFSET, bt.prescaler & 0xFF)) return false;
-    usleep(100);
     // BTR：对齐测试用例的寄存器编码（docs/can/can.md 示例值）
     uint32_t btr = (static_cast<uint32_t>(bt.sjw) << 7)
         | (static_cast<uint32_t>(bt.ts2) << 4)
         | (static_cast<uint32_t>(bt.ts1) & 0xFF);
     LOGI("can", "set_bit_timing", 0, "btr=0x%08x", btr);
-    if (!wr32(XCAN_BTR_OFFSET, btr)) return false;
-    usleep(100);
-    return true;
+    return wr32(XCAN_BTR_OFFSET, btr);
 }
 
 bool CanDevice::__config_filter_accept_all() {
     // 禁用滤波器1
     if (!wr32(XCAN_AFR_OFFSET, 0x00000000)) return false;
-    usleep(100);
-    // 等待 ACFBSY 清零
-    uint32_t sr = 0;
-    do { if (!rd32(XCAN_SR_OFFSET, sr)) return false; } while ((sr & XCAN_SR_ACFBSY_MASK) != 0);
+    // 等待 ACFBSY 清零后才能改写掩码/ID 寄存器
+    int rc = pollReg32(XCAN_SR_OFFSET, XCAN_SR_ACFBSY_MASK, 0);
+    if (rc != 0) {
+        LOGE("can", "filter", rc, "SR.ACFBSY stuck");
+        return false;
+    }
     // 写掩码与ID为0（接收所有）
     if (!wr32(XCAN_AFMR1_OFFSET, 0x00000000)) return false;
-    usleep(100);
     if (!wr32(XCAN_AFIR1_OFFSET, 0x00000000)) return false;
-    usleep(100);
     // 启用滤波器1（UAF1=1）
-    if (!wr32(XCAN_AFR_OFFSET, XCAN_AFR_UAF1_MASK)) return false;
-    usleep(100);
-    return true;
+    return wr32(XCAN_AFR_OFFSET, XCAN_AFR_UAF1_MASK);
 }
 
 bool CanDevice::__enable_core() {
     // 写 CEN=1 启用核心
     if (!wr32(XCAN_SRR_OFFSET, XCAN_SRR_CEN_MASK)) return false;
-    usleep(10);
+    // 期望：CONFIG=0（退出配置），LBACK=1（回环）
     uint32_t sr = 0;
-    if (!rd32(XCAN_SR_OFFSET, sr)) return false;
-    // 若未处于回环，则再次显式设置回环位
-    if ((sr & XCAN_SR_LBACK_MASK) == 0) {
+    int rc = pollReg32(XCAN_SR_OFFSET, XCAN_SR_CONFIG_MASK, 0, kRegPollTimeoutUs, &sr);
+    if (rc == 0 && (sr & XCAN_SR_LBACK_MASK) == 0) {
+        // 若未处于回环，则再次显式设置回环位
         (void)wr32(XCAN_MSR_OFFSET, XCAN_MSR_LBACK_MASK);
-        usleep(100);
-        if (!rd32(XCAN_SR_OFFSET, sr)) return false;
+        rc = pollReg32(XCAN_SR_OFFSET, XCAN_SR_LBACK_MASK, XCAN_SR_LBACK_MASK, kRegPollTimeoutUs, &sr);
     }
-    // 期望：CONFIG=0（退出配置），LBACK=1（回环）
-    return ((sr & XCAN_SR_CONFIG_MASK) == 0) && ((sr & XCAN_SR_LBACK_MASK) != 0);
+    if (rc != 0) LOGE("can", "enable", rc, "sr=0x%08x", sr);
+    return rc == 0;
 }
 
+static_assert(XCAN_TX_DW2_OFFSET == XCAN_TX_ID_OFFSET + 12 && XCAN_RX_DW2_OFFSET == XCAN_RX_ID_OFFSET + 12,
+              "TX/RX FIFO ID/DLC/DW1/DW2 registers must be contiguous");
+
 bool CanDevice::__write_tx_fifo(const CanFrame& f) {
     // 仅支持标准帧（IDE=0）；DLC<=8；RTR 支持
     // 清除旧的发送/接收完成标志，避免上一帧残留影响 ISR 轮询判断
     (void)wr32(XCAN_ICR_OFFSET, XCAN_ICR_TXOK_MASK | XCAN_ICR_RXOK_MASK);
+    uint32_t sr = 0;
+    if (!rd32(XCAN_SR_OFFSET, sr) || (sr & XCAN_SR_TXFLL_MASK)) return false;
+    return __push_tx_fifo(f);
+}
 
-    uint32_t id_reg = (f.id & XCAN_ID_STD_MASK) << XCAN_ID_STD_SHIFT;
-    if (!wr32(XCAN_TX_ID_OFFSET, id_reg)) return false;
-    uint32_t dlc_reg = (static_cast<uint32_t>(f.dlc & XCAN_DLC_MASK) << XCAN_DLC_SHIFT);
-    if (!wr32(XCAN_TX_DLC_OFFSET, dlc_reg)) return false;
+bool CanDevice::__push_tx_fifo(const CanFrame& f) {
+    // TX FIFO 的 ID/DLC/DW1/DW2 地址连续，按序一次突发写入（DW2 最后写入触发入队）
+    const int n = f.len < 8 ? f.len : 8;
     uint32_t dw1 = 0, dw2 = 0;
-    for (int i = 0; i < 4 && i < static_cast<int>(f.data.size()); ++i) {
+    for (int i = 0; i < 4 && i < n; ++i) {
         dw1 |= (static_cast<uint32_t>(f.data[i]) << (8 * (3 - i)));
     }
-    for (int i = 4; i < 8 && i < static_cast<int>(f.data.size()); ++i) {
+    for (int i = 4; i < n; ++i) {
         dw2 |= (static_cast<uint32_t>(f.data[i]) << (8 * (7 - i)));
     }
-    if (!wr32(XCAN_TX_DW1_OFFSET, dw1)) return false;
-    if (!wr32(XCAN_TX_DW2_OFFSET, dw2)) return false;
-    return true;
+    const uint32_t regs[4] = {
+        (f.id & XCAN_ID_STD_MASK) << XCAN_ID_STD_SHIFT,
+        static_cast<uint32_t>(f.dlc & XCAN_DLC_MASK) << XCAN_DLC_SHIFT,
+        dw1,
+        dw2,
+    };
+    return wr32n(XCAN_TX_ID_OFFSET, regs);
 }
 
 int CanDevice::__read_rx_fifo(CanFrame& f) {
@@ -252,29 +293,31 @@ int CanDevice::__read_rx_fifo(CanFrame& f) {
     if (!rd32(XCAN_ISR_OFFSET, isr)) return -EIO;
     if ((isr & XCAN_ISR_RXOK_MASK) == 0) return 0;
 
-    uint32_t v = 0;
-    if (!rd32(XCAN_RX_ID_OFFSET, v)) return -EIO;
-    f.id  = (v >> XCAN_ID_STD_SHIFT) & XCAN_ID_STD_MASK;
+    // RX FIFO 的 ID/DLC/DW1/DW2 地址连续，一次突发读出
+    uint32_t regs[4] = {0, 0, 0, 0};
+    if (!rd32n(XCAN_RX_ID_OFFSET, regs)) return -EIO;
+    f.id  = (regs[0] >> XCAN_ID_STD_SHIFT) & XCAN_ID_STD_MASK;
     f.ide = false;
     f.rtr = false;
 
-    if (!rd32(XCAN_RX_DLC_OFFSET, v)) return -EIO;
-    f.dlc = static_cast<uint8_t>((v >> XCAN_DLC_SHIFT) & XCAN_DLC_MASK);
-    f.data.assign(f.dlc, 0);
+    f.fdf = false;
+    f.brs = false;
+    f.esi = false;
+
+    f.dlc = static_cast<uint8_t>((regs[1] >> XCAN_DLC_SHIFT) & XCAN_DLC_MASK);
+    f.len = f.dlc > 8 ? 8 : f.dlc;
 
-    if (!rd32(XCAN_RX_DW1_OFFSET, v)) return -EIO;
-    for (int i = 0; i < 4 && i < f.dlc; ++i) {
-        f.data[i] = static_cast<uint8_t>((v >> (8 * (3 - i))) & 0xFF);
+    for (int i = 0; i < 4 && i < f.len; ++i) {
+        f.data[i] = static_cast<uint8_t>((regs[2] >> (8 * (3 - i))) & 0xFF);
     }
-    if (!rd32(XCAN_RX_DW2_OFFSET, v)) return -EIO;
-    for (int i = 4; i < 8 && i < f.dlc; ++i) {
-        f.data[i] = static_cast<uint8_t>((v >> (8 * (7 - i))) & 0xFF);
+    for (int i = 4; i < f.len; ++i) {
+        f.data[i] = static_cast<uint8_t>((regs[3] >> (8 * (7 - i))) & 0xFF);
     }
     // 清除 RXOK 中断位
     if (!wr32(XCAN_ICR_OFFSET, XCAN_ICR_RXOK_MASK)) {
         LOGW("can", "read_rx_fifo", -1, "clear RXOK failed");
     }
-    return static_cast<int>(6 + f.dlc);
+    return static_cast<int>(6 + f.len);
 }
 
 } // namespace Device
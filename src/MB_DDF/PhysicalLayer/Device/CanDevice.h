@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "MB_DDF/PhysicalLayer/Device/TransportLinkAdapter.h"
 #include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
@@ -35,6 +36,13 @@ public:
     int32_t receive(CanFrame& frame);
     int32_t receive(CanFrame& frame, uint32_t timeout_us);
 
+    // 批量：send_batch 依次写入 TX FIFO（仅清一次中断位），每帧前检查 SR.TXFLL，FIFO 满即停止，
+    // 返回实际入队帧数（可少于 frames.size()，FIFO 已满时为 0）；
+    // receive_batch 一次排空 RX FIFO（至多 frames.size() 帧），返回帧数；带超时版本先等待中断事件
+    int32_t send_batch(std::span<const CanFrame> frames);
+    int32_t receive_batch(std::span<CanFrame> frames);
+    int32_t receive_batch(std::span<CanFrame> frames, uint32_t timeout_us);
+
     // 设备控制：提供基本 ioctl 操作码
     enum : uint32_t {
         IOCTL_RESET            = 0x1001,
@@ -62,6 +70,7 @@ private:
     bool __enable_core();
 
     bool __write_tx_fifo(const CanFrame& f);
+    bool __push_tx_fifo(const CanFrame& f);     // 仅写 TX FIFO，不清中断位
     int  __read_rx_fifo(CanFrame& f);
 };
 
@@ -0,0 +1,335 @@
+/**
+ * @file CanDispatcher.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Device/CanDispatcher.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <algorithm>
+#include <cerrno>
+#include <span>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+namespace {
+constexpr size_t kMaxFilters = CanFDDevice::kMaxAcceptFilters;
+
+bool same_filter(const CanAcceptFilter& a, const CanAcceptFilter& b) {
+    return a.mask == b.mask && a.id == b.id;
+}
+
+bool same_filters(const std::vector<CanAcceptFilter>& a, const std::vector<CanAcceptFilter>& b) {
+    return std::ranges::equal(a, b, same_filter);
+}
+
+// 超出硬件个数时贪心合并，每次选合并后丢失精确位最少的一对；增量追加时只多出一个，仅做一轮
+void merge_filters(std::vector<CanAcceptFilter>& fs) {
+    while (fs.size() > kMaxFilters) {
+        size_t bi = 0, bj = 1;
+        int best = 64;
+        for (size_t i = 0; i < fs.size(); ++i) {
+            for (size_t j = i + 1; j < fs.size(); ++j) {
+                const auto& a = fs[i];
+                const auto& b = fs[j];
+                uint32_t m = a.mask & b.mask & ~(a.id ^ b.id);
+                int lost = __builtin_popcount(a.mask | b.mask) - __builtin_popcount(m);
+                if (lost < best) { best = lost; bi = i; bj = j; }
+            }
+        }
+        auto& a = fs[bi];
+        const auto& b = fs[bj];
+        a.mask = a.mask & b.mask & ~(a.id ^ b.id);
+        a.id &= a.mask;
+        fs.erase(fs.begin() + static_cast<std::ptrdiff_t>(bj));
+    }
+}
+}
+
+CanDispatcher::CanDispatcher(CanFDDevice& dev) : dev_(dev) {
+    std_index_.fill(kNoRoute);
+}
+
+CanDispatcher::~CanDispatcher() {
+    stop();
+}
+
+int CanDispatcher::subscribe(uint32_t id, bool ide, Handler handler) {
+    if (!handler) return -EINVAL;
+    return add(id, ide, Sub{0, std::move(handler), nullptr});
+}
+
+int CanDispatcher::subscribeTopic(uint32_t id, bool ide, std::shared_ptr<DDS::Publisher> pub) {
+    if (!pub) return -EINVAL;
+    return add(id, ide, Sub{0, {}, std::move(pub)});
+}
+
+int CanDispatcher::add(uint32_t id, bool ide, Sub sub) {
+    if (ide ? id > 0x1FFFFFFF : id >= kStdIds) return -EINVAL;
+    int token = 0;
+    bool new_route = false;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        sub.token = token = next_token_++;
+        Route* r = find(id, ide);
+        if (!r) {
+            if (routes_.size() >= kNoRoute) return -ENOSPC;
+            routes_.push_back(Route{id, ide, {}});
+            r = &routes_.back();
+            if (ide) ext_index_[id] = static_cast<uint16_t>(routes_.size() - 1);
+            else std_index_[id] = static_cast<uint16_t>(routes_.size() - 1);
+            new_route = true;
+        }
+        r->subs.push_back(std::move(sub));
+    }
+    if (new_route && running()) program_filters(FilterOp::Add, id, ide);
+    return token;
+}
+
+bool CanDispatcher::unsubscribe(int token) {
+    bool route_removed = false;
+    uint32_t id = 0;
+    bool ide = false;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto ri = routes_.begin();
+        for (; ri != routes_.end(); ++ri) {
+            auto& subs = ri->subs;
+            auto it = std::find_if(subs.begin(), subs.end(), [token](const Sub& s) { return s.token == token; });
+            if (it == subs.end()) continue;
+            subs.erase(it);
+            break;
+        }
+        if (ri == routes_.end()) return false;
+        if (ri->subs.empty()) {
+            id = ri->id;
+            ide = ri->ide;
+            routes_.erase(ri);
+            rebuild_index();
+            route_removed = true;
+        }
+    }
+    if (route_removed && running()) program_filters(FilterOp::Remove, id, ide);
+    return true;
+}
+
+void CanDispatcher::setDefaultHandler(Handler handler) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        default_handler_ = std::move(handler);
+    }
+    if (running()) program_filters();
+}
+
+void CanDispatcher::applyFilters() {
+    program_filters();
+}
+
+CanDispatcher::Route* CanDispatcher::find(uint32_t id, bool ide) {
+    uint16_t idx = kNoRoute;
+    if (!ide) {
+        if (id < kStdIds) idx = std_index_[id];
+    } else {
+        auto it = ext_index_.find(id);
+        if (it != ext_index_.end()) idx = it->second;
+    }
+    return idx == kNoRoute ? nullptr : &routes_[idx];
+}
+
+void CanDispatcher::rebuild_index() {
+    std_index_.fill(kNoRoute);
+    ext_index_.clear();
+    for (size_t i = 0; i < routes_.size(); ++i) {
+        if (routes_[i].ide) ext_index_[routes_[i].id] = static_cast<uint16_t>(i);
+        else std_index_[routes_[i].id] = static_cast<uint16_t>(i);
+    }
+}
+
+// 订阅变更在当前过滤器上增量修改：新 ID 已被放行则不动，有空位则追加精确项，满了则追加后合并一轮；
+// 退订在精确模式下以末项填补空位。全量重建（合并为 O(n^3)）只在 start()、默认处理者变更、
+// 已合并的过滤器可退回精确匹配时进行。计算在快照上完成，只在写硬件与替换 filters_ 时持有 mu_
+void CanDispatcher::program_filters(FilterOp op, uint32_t id, bool ide) {
+    std::lock_guard<std::mutex> plk(program_mu_);
+    std::vector<CanAcceptFilter> next;
+    bool accept_all = false;
+    bool exact = false;
+    bool full = op == FilterOp::Rebuild;
+    size_t ids = 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        accept_all = static_cast<bool>(default_handler_);
+        ids = routes_.size();
+        next = filters_;
+        exact = exact_filters_;
+        const CanAcceptFilter f{CanFDDevice::filter_mask(ide), CanFDDevice::filter_id(id, ide)};
+        const bool rejecting = next.size() == 1 && same_filter(next[0], CanFDDevice::reject_all_filter());
+        if (accept_all) {
+            next.clear();
+            exact = false;
+            full = false;
+        } else if (next.empty()) {
+            full = true;                            // 过滤关闭或尚未编程
+        } else if (!full && op == FilterOp::Add && find(id, ide)) {   // 路由已被并发退订时不再追加（退订同理）
+            const bool covered = std::ranges::any_of(next, [&f](const CanAcceptFilter& m) {
+                return (f.id & m.mask) == (m.id & m.mask);
+            });
+            if (rejecting) {
+                next.assign(1, f);
+                exact = true;
+            } else if (!covered) {
+                next.push_back(f);
+            }
+        } else if (!full && op == FilterOp::Remove && !find(id, ide)) {
+            if (exact) {
+                auto it = std::ranges::find_if(next, [&f](const CanAcceptFilter& m) { return same_filter(m, f); });
+                if (it != next.end()) {
+                    *it = next.back();
+                    next.pop_back();
+                }
+                if (next.empty()) next.push_back(CanFDDevice::reject_all_filter());
+            } else if (ids <= kMaxFilters) {
+                full = true;                        // 合并项可退回精确匹配；否则保留较宽的合并项
+            }
+        }
+        if (full) {
+            next.clear();
+            next.reserve(ids);
+            for (const Route& r : routes_) {
+                next.push_back(CanAcceptFilter{CanFDDevice::filter_mask(r.ide), CanFDDevice::filter_id(r.id, r.ide)});
+            }
+        }
+    }
+    if (full) {
+        exact = true;
+        if (next.empty()) next.push_back(CanFDDevice::reject_all_filter());
+    }
+    if (next.size() > kMaxFilters) {
+        exact = false;
+        merge_filters(next);
+    }
+
+    std::lock_guard<std::mutex> lk(mu_);
+    if (!full && exact == exact_filters_ && same_filters(next, filters_)) return;
+    int32_t rc = dev_.set_accept_filters(next);
+    if (rc < 0) {
+        LOGE("can_disp", "filters", rc, "program %zu filters failed", next.size());
+        filters_.clear();
+        exact_filters_ = false;
+        (void)dev_.set_accept_filters({});
+        return;
+    }
+    filters_.swap(next);
+    exact_filters_ = exact;
+    if (full) {
+        LOGI("can_disp", "filters", 0, "ids=%zu filters=%zu exact=%d", ids, filters_.size(), exact_filters_ ? 1 : 0);
+    }
+}
+
+void CanDispatcher::deliver(const CanFrame& f) {
+    Route* r = find(f.id, f.ide);
+    if (!r) {
+        unmatched_.fetch_add(1, std::memory_order_relaxed);
+        if (default_handler_) default_handler_(f);
+        return;
+    }
+    routed_.fetch_add(1, std::memory_order_relaxed);
+    int32_t wire_len = -1;
+    for (const Sub& s : r->subs) {
+        if (s.handler) {
+            s.handler(f);
+            continue;
+        }
+        if (wire_len < 0) wire_len = CanFDDevice::encode(f, wire_, sizeof(wire_));
+        if (wire_len > 0 && s.pub->publish(wire_, static_cast<size_t>(wire_len))) {
+            published_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            publish_failed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+int CanDispatcher::drain() {
+    std::lock_guard<std::mutex> lk(mu_);
+    int total = 0;
+    for (;;) {
+        int32_t n = dev_.receive_batch(std::span<CanFrame>(batch_, kBatch));
+        if (n <= 0) break;
+        frames_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        for (int32_t i = 0; i < n; ++i) deliver(batch_[i]);
+        total += n;
+    }
+    return total;
+}
+
+int CanDispatcher::onEvent(uint32_t bitmap) {
+    (void)bitmap;   // RX FIFO 状态以 FSR 为准，位图仅用于唤醒
+    events_.fetch_add(1, std::memory_order_relaxed);
+    return drain();
+}
+
+bool CanDispatcher::start(EventHook extra) {
+    if (running()) return true;
+    if (!waiter_.open(dev_.transport().getEventFd())) {
+        LOGE("can_disp", "start", errno, "eventfd failed");
+        return false;
+    }
+    extra_ = std::move(extra);
+    program_filters();
+    stop_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread([this]() { worker_loop(); });
+    LOGI("can_disp", "start", 0, "event_fd=%d", dev_.transport().getEventFd());
+    return true;
+}
+
+void CanDispatcher::stop() {
+    if (worker_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        waiter_.wake();
+        worker_.join();
+    }
+    waiter_.close();
+}
+
+void CanDispatcher::worker_loop() {
+    auto& tp = dev_.transport();
+    (void)drain();
+    while (!stop_.load(std::memory_order_acquire)) {
+        auto res = waiter_.wait();
+        if (res == DDS::ReadyWaiter::Result::Error) {
+            LOGE("can_disp", "poll", errno, "worker exit");
+            break;
+        }
+        if (res == DDS::ReadyWaiter::Result::Ready) {
+            uint32_t bitmap = 0;
+            if (tp.waitEvent(&bitmap, 0) > 0) {
+                (void)onEvent(bitmap);
+                if (extra_) extra_(bitmap);
+            }
+        } else if (res == DDS::ReadyWaiter::Result::Timeout && !waiter_.hasReadyFd()) {
+            (void)drain();
+            if (extra_) extra_(0);
+        }
+    }
+}
+
+std::vector<CanAcceptFilter> CanDispatcher::filters() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return filters_;
+}
+
+CanDispatcher::Stats CanDispatcher::stats() const {
+    Stats s;
+    s.events         = events_.load(std::memory_order_relaxed);
+    s.frames         = frames_.load(std::memory_order_relaxed);
+    s.routed         = routed_.load(std::memory_order_relaxed);
+    s.unmatched      = unmatched_.load(std::memory_order_relaxed);
+    s.published      = published_.load(std::memory_order_relaxed);
+    s.publish_failed = publish_failed_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lk(mu_);
+    s.filters        = static_cast<uint32_t>(filters_.size());
+    s.exact_filters  = exact_filters_;
+    return s;
+}
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
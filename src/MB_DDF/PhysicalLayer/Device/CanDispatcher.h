@@ -0,0 +1,135 @@
+/**
+ * @file CanDispatcher.h
+ * @brief CAN-FD 接收分发：中断驱动排空 RX FIFO，按 ID 查表路由到回调或 DDS Topic，并据订阅编程硬件验收过滤器
+ *
+ * 设计要点：
+ * - 标准帧 ID 以 2048 项直接索引表查找，扩展帧 ID 以哈希表查找，均为 O(1)；热路径不分配内存。
+ * - start() 时以全部已注册 ID 的并集编程验收过滤器：不超过 31 个 ID 时逐个精确匹配，超出时反复合并
+ *   "合并后新增通配位最少"的两个过滤器，放宽为掩码匹配；多放行的帧在软件表中计为 unmatched。
+ * - 运行中的订阅变更增量修改当前过滤器（追加、填补或合并一轮），不再全量合并；退订后合并项保持较宽，
+ *   直到 ID 数回落到可精确匹配时重建。设备侧只重写变化的过滤器，且换入期间有拒收全部的守卫项，不会短暂接收全部帧。
+ * - 过滤器在路由表快照上计算，不持有路由表锁，仅在写入硬件并替换当前过滤器时短暂加锁，不阻塞分发线程排空。
+ * - 设置了默认处理者（接收全部 ID）时禁用硬件过滤；既无订阅也无默认处理者时启用拒收全部的过滤器。
+ * - start() 启动分发线程独占传输层事件 fd；与 CanFdTxQueue 共用设备时，由其中一方持有事件 fd，
+ *   另一方经 EventHook 转发（如 txq.start([&](uint32_t bm){ disp.onEvent(bm); })）。
+ * - 回调在分发线程中、持有路由表锁时执行：回调内不得订阅/退订。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/Device/CanFdDevice.h"
+#include "MB_DDF/DDS/Publisher.h"
+#include "MB_DDF/DDS/ReadyWaiter.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+class CanDispatcher {
+public:
+    using Handler   = std::function<void(const CanFrame&)>;
+    using EventHook = std::function<void(uint32_t bitmap)>;
+
+    struct Stats {
+        uint64_t events = 0;            // 处理的中断事件数
+        uint64_t frames = 0;            // 从 RX FIFO 取出的帧数
+        uint64_t routed = 0;            // 命中路由表的帧数
+        uint64_t unmatched = 0;         // 到达 CPU 但无订阅者的帧数（掩码合并放行或过滤关闭）
+        uint64_t published = 0;         // 写入 DDS Topic 的帧数
+        uint64_t publish_failed = 0;
+        uint32_t filters = 0;           // 当前启用的硬件过滤器数（0 表示未过滤）
+        bool     exact_filters = false; // 过滤器是否均为精确匹配
+    };
+
+    explicit CanDispatcher(CanFDDevice& dev);
+    ~CanDispatcher();
+
+    CanDispatcher(const CanDispatcher&) = delete;
+    CanDispatcher& operator=(const CanDispatcher&) = delete;
+
+    // 订阅：同一 ID 可挂多个处理者；返回订阅号（>0），失败返回 <0
+    // Topic 订阅按 CanFDDevice::encode 线格式发布整帧
+    int subscribe(uint32_t id, bool ide, Handler handler);
+    int subscribeTopic(uint32_t id, bool ide, std::shared_ptr<DDS::Publisher> pub);
+    bool unsubscribe(int token);
+    // 默认处理者：接收所有未注册 ID 的帧；设置后禁用硬件过滤，传空恢复过滤
+    void setDefaultHandler(Handler handler);
+
+    // 分发线程：传输层无事件 fd 时退化为 1ms 周期排空；extra 在每次事件排空后调用（如补充发送队列）
+    bool start(EventHook extra = {});
+    void stop();
+    bool running() const { return worker_.joinable(); }
+
+    // 不启动线程时由外部事件循环调用：排空 RX FIFO 并分发，返回分发帧数
+    int onEvent(uint32_t bitmap = 0);
+    int drain();
+    // 按当前订阅立即重新编程硬件过滤器（不启动线程、由外部事件循环驱动时使用）
+    void applyFilters();
+
+    // 当前硬件过滤器（寄存器编码），便于诊断
+    std::vector<CanAcceptFilter> filters() const;
+    Stats stats() const;
+
+private:
+    struct Sub {
+        int token;
+        Handler handler;
+        std::shared_ptr<DDS::Publisher> pub;
+    };
+    struct Route {
+        uint32_t id;
+        bool ide;
+        std::vector<Sub> subs;
+    };
+    static constexpr size_t kStdIds = 2048;
+    static constexpr uint16_t kNoRoute = 0xFFFF;
+    static constexpr size_t kBatch = 32;
+
+    int add(uint32_t id, bool ide, Sub sub);
+    Route* find(uint32_t id, bool ide);
+    void deliver(const CanFrame& f);
+    void rebuild_index();
+    enum class FilterOp { Rebuild, Add, Remove };
+    void program_filters(FilterOp op = FilterOp::Rebuild, uint32_t id = 0, bool ide = false);   // 调用方不得持有 mu_
+    void worker_loop();
+
+    CanFDDevice& dev_;
+
+    mutable std::mutex mu_;                         // 路由表、过滤器与默认处理者
+    std::mutex program_mu_;                         // 串行化过滤器重建，后到者基于更新的快照
+    std::vector<Route> routes_;
+    std::array<uint16_t, kStdIds> std_index_;       // 标准 ID -> routes_ 下标
+    std::unordered_map<uint32_t, uint16_t> ext_index_;
+    Handler default_handler_;
+    std::vector<CanAcceptFilter> filters_;
+    bool exact_filters_ = false;
+    int next_token_ = 1;
+
+    CanFrame batch_[kBatch];                        // 排空暂存（仅分发方访问，受 mu_ 保护）
+    uint8_t wire_[6 + CanFrame::kMaxData];          // Topic 发布线格式缓冲
+
+    std::thread worker_;
+    EventHook extra_;
+    DDS::ReadyWaiter waiter_;
+    std::atomic<bool> stop_{false};
+
+    std::atomic<uint64_t> events_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> routed_{0};
+    std::atomic<uint64_t> unmatched_{0};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> publish_failed_{0};
+};
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -88,6 +88,31 @@ int32_t CanFDDevice::receive(CanFrame& frame, uint32_t timeout_us) {
     return receive(frame);
 }
 
+int32_t CanFDDevice::send_batch(std::span<const CanFrame> frames) {
+    if (frames.empty()) return 0;
+    return __axiCanfdSendBatch(frames.data(), static_cast<uint32_t>(frames.size()));
+}
+
+int32_t CanFDDevice::send_batch(std::span<const CanFrame> frames, uint32_t buffer_mask) {
+    if (frames.empty()) return 0;
+    return __axiCanfdSendBatch(frames.data(), static_cast<uint32_t>(frames.size()), buffer_mask);
+}
+
+int32_t CanFDDevice::receive_batch(std::span<CanFrame> frames) {
+    if (frames.empty()) return 0;
+    return __axiCanfdRecvFifoBatch(frames.data(), static_cast<uint32_t>(frames.size()));
+}
+
+int32_t CanFDDevice::receive_batch(std::span<CanFrame> frames, uint32_t timeout_us) {
+    // 先尝试排空：事件可能在上次排空后已被消费
+    int32_t n = receive_batch(frames);
+    if (n != 0) return n;
+    uint32_t bm = 0;
+    int ev = transport().waitEvent(&bm, timeout_us / 1000);
+    if (ev <= 0) return ev == 0 ? 0 : -1;
+    return receive_batch(frames);
+}
+
 bool CanFDDevice::send(const uint8_t* data, uint32_t len) {
     if (!data || len < 6) {
         LOGE("canfd", "send", -EINVAL, "payload too short len=%u", len);
@@ -107,7 +132,7 @@ bool CanFDDevice::send(const uint8_t* data, uint32_t len) {
         LOGE("canfd", "send", -EINVAL, "len=%u < header+data=%u", len, 6u + dlen);
         return false;
     }
-    f.data.assign(data + 6, data + 6 + dlen);
+    f.setPayload(data + 6, dlen);
 
     // 使用硬件发送方法
     return send(f);
@@ -120,16 +145,19 @@ int32_t CanFDDevice::receive(uint8_t* buf, uint32_t buf_size) {
     // 使用硬件接收方法
     int frames_received = receive(f);
     if (frames_received <= 0) return frames_received;
+    return encode(f, buf, buf_size);
+}
 
-    uint8_t dlen = dlc_to_len(f.dlc);
+int32_t CanFDDevice::encode(const CanFrame& f, uint8_t* buf, uint32_t buf_size) {
+    uint8_t dlen = f.len;
     uint32_t need = 6u + dlen;
-    if (buf_size < need) return -ENOSPC;
-    
+    if (!buf || buf_size < need) return -ENOSPC;
+
     unpack_le32(f.id, buf);
     uint8_t flags = (f.ide ? 0x01 : 0) | (f.rtr ? 0x02 : 0) | (f.fdf ? 0x04 : 0) | (f.brs ? 0x08 : 0);
     buf[4] = flags;
     buf[5] = f.dlc;
-    if (dlen && !f.data.empty()) {
+    if (dlen) {
         std::memcpy(buf + 6, f.data.data(), dlen);
     }
     return static_cast<int32_t>(need);
@@ -4,9 +4,10 @@
  */
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <span>
 
 #include "MB_DDF/PhysicalLayer/Device/TransportLinkAdapter.h"
 #include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
@@ -16,7 +17,10 @@ namespace PhysicalLayer {
 namespace Device {
 
 // 轻量帧表示：支持 CAN/CANFD，标准与扩展 ID
+// 数据区为定长内联数组，收发热路径无堆分配；有效字节为前 len 个，其后内容未定义
 struct CanFrame {
+    static constexpr uint8_t kMaxData = 64;
+
     uint32_t id{0};      // 标准 11 位或扩展 29 位 ID
     bool     ide{false}; // 扩展帧标志（true=29位）
     bool     rtr{false}; // 远程帧
@@ -25,11 +29,27 @@ struct CanFrame {
     bool     esi{false}; // 错误状态指示（CANFD）
     uint8_t  dlc{0};     // DLC 0..15
     uint8_t  len{0};     // 数据长度 0..64 字节
-    std::vector<uint8_t> data; // 0..64 字节
+    std::array<uint8_t, kMaxData> data{};
+
+    std::span<const uint8_t> payload() const { return {data.data(), len}; }
+    // 拷入数据并设置 len（超出 64 字节截断）
+    void setPayload(const uint8_t* p, uint8_t n) {
+        len = n < kMaxData ? n : kMaxData;
+        for (uint8_t i = 0; i < len; ++i) data[i] = p[i];
+    }
+};
+
+// 验收过滤器（ID 寄存器编码，见 CanFDDevice::filter_id/filter_mask）：(帧 ID 寄存器 & mask) == (id & mask) 即接收
+struct CanAcceptFilter {
+    uint32_t mask{0};
+    uint32_t id{0};
 };
 
 class CanFDDevice : public TransportLinkAdapter {
 public:
+    static constexpr uint32_t TX_BUFFER_ALL = 0xFFFFFFFFu;     // 32 个发送缓冲全部可用
+    static constexpr uint32_t kMaxAcceptFilters = 31;          // 32 个验收过滤器，末个留作守卫
+
     explicit CanFDDevice(MB_DDF::PhysicalLayer::ControlPlane::IDeviceTransport& tp, uint16_t mtu)
         : TransportLinkAdapter(tp, mtu) {}
 
@@ -47,10 +67,34 @@ public:
     int32_t receive(CanFrame& frame);
     int32_t receive(CanFrame& frame, uint32_t timeout_us);
 
+    // 批量：send_batch 按 TRR 填满全部空闲发送缓冲并一次置位启动，返回已启动帧数（<0 错误）；
+    // receive_batch 一次排空 RX FIFO（至多 frames.size() 帧），返回帧数；带超时版本先等待中断事件
+    int32_t send_batch(std::span<const CanFrame> frames);
+    int32_t receive_batch(std::span<CanFrame> frames);
+    int32_t receive_batch(std::span<CanFrame> frames, uint32_t timeout_us);
+    // 仅使用 buffer_mask 中的空闲发送缓冲（按缓冲号升序填充），供软件发送队列控制发送次序
+    int32_t send_batch(std::span<const CanFrame> frames, uint32_t buffer_mask);
+    // 读 TRR：置位的缓冲已请求发送、尚未完成
+    bool tx_pending(uint32_t& mask);
+
+    // 验收过滤：按顺序占用过滤器 1..n 并禁用其余；空集合表示禁用全部过滤器（接收所有帧）。
+    // 最后一个过滤器留作拒收全部的守卫，重编程期间保持启用，不会出现接收全部的窗口；
+    // 仅重写内容变化的过滤器。返回已启用个数，超过 kMaxAcceptFilters 个返回 -EINVAL
+    int32_t set_accept_filters(std::span<const CanAcceptFilter> filters);
+    // 单个 ID 在 ID 寄存器中的编码，以及精确匹配该类 ID（标准/扩展）所需的掩码
+    static uint32_t filter_id(uint32_t id, bool ide);
+    static uint32_t filter_mask(bool ide);
+    // 不匹配任何帧的过滤器：启用它（且仅它）时拒收全部帧
+    static CanAcceptFilter reject_all_filter();
+
     // 设备控制：配置参数、查询状态
     int ioctl(uint32_t opcode, const void* in = nullptr, size_t in_len = 0, void* out = nullptr, size_t out_len = 0) override;
 
 // private:
+    // 单帧线格式（与 send/receive 原始缓冲区一致）：[id:le32][flags][dlc][data...]，
+    // flags bit0=IDE bit1=RTR bit2=FDF bit3=BRS；返回写入字节数，缓冲不足返回 -ENOSPC
+    static int32_t encode(const CanFrame& f, uint8_t* buf, uint32_t buf_size);
+
     // DLC 到字节长度映射（支持 CAN/CANFD 常用编码）
     static uint8_t dlc_to_len(uint8_t dlc);
     static uint8_t len_to_dlc(uint8_t len);
@@ -74,6 +118,8 @@ public:
     uint32_t __axiCanfdSetFilter(uint32_t uiFilterIndex, uint32_t uiMask, uint32_t uiId);
     // 获取CANFD模式
     uint8_t __axiCanfdGetMode(void);
+    // 等待进入指定模式（有界轮询），超时返回 -ETIMEDOUT
+    int __axiCanfdWaitMode(uint8_t ucMode, uint32_t uiTimeoutUs = kRegPollTimeoutUs);
     // CANFD位时间设置
     int __axiCanfdSetBitTiming(uint8_t ucSyncJumpWidth, uint8_t ucTimeSegment2, uint16_t ucTimeSegment1);
     // 设置仲裁域波特率
@@ -88,10 +134,18 @@ public:
     void __axiCanfdSetBitRateSwitchDisableNominal(void);
     // CANFD硬件初始化
     int __axiCanfdHwInit(void);
+    // 将一帧写入指定发送缓冲（不置位 TRR）
+    int __axiCanfdWriteTxBuffer(uint32_t uiTxBuffer, const CanFrame& frame);
     // CANFD发送
     int __axiCanfdSend(CanFrame *pCanFrame);
+    // CANFD批量发送：填充全部空闲缓冲后一次置位 TRR
+    int __axiCanfdSendBatch(const CanFrame* pFrames, uint32_t uiCount, uint32_t uiAllowMask = TX_BUFFER_ALL);
+    // 从 RX FIFO 0 指定槽读出一帧（不推进读索引）
+    void __axiCanfdReadRxFrame(uint32_t uiReadIndex, CanFrame& frame);
     // CANFD接收（FIFO模式）
     int __axiCanfdRecvFifo(CanFrame *pCanFrame);
+    // CANFD批量接收：排空 RX FIFO 0
+    int __axiCanfdRecvFifoBatch(CanFrame* pFrames, uint32_t uiCount);
     // CANFD控制函数
     int __axiCanfdIoctl(int iCmd, void* lArg);
     // 处理CANFD总线离线事件
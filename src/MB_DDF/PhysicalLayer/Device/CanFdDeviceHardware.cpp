@@ -5,6 +5,7 @@
 #include "MB_DDF/PhysicalLayer/Support/Log.h"
 #include "MB_DDF/PhysicalLayer/Device/CanFdDevice.h"
 #include "MB_DDF/PhysicalLayer/Hardware/pl_canfd.h"
+#include <cerrno>
 #include <cstdint>
 #include <cstring>
 #include <unistd.h>
@@ -76,8 +77,8 @@ void CanFDDevice::__axiCanfdAcceptFilterEnable(uint32_t uiFilterIndexMask) {
 int CanFDDevice::__axiCanfdAcceptFilterSet(uint32_t uiFilterIndex, uint32_t uiMaskValue, uint32_t uiIdValue) {
     uint32_t uiEnabledFilters;
 
-    rd32(XCANFD_AFR_OFFSET, uiEnabledFilters);  // 查看过滤器是否启用
-    if ((uiEnabledFilters & uiFilterIndex) == uiFilterIndex) {  // 如果已经被启用了将无法设置
+    rd32(XCANFD_AFR_OFFSET, uiEnabledFilters);  // 查看过滤器是否启用（uiFilterIndex 从 1 开始，对应 AFR 位 index-1）
+    if (uiEnabledFilters & (1u << (uiFilterIndex - 1))) {  // 如果已经被启用了将无法设置
         LOGW("canfd", "accept filter set", -1, "filter is enabled");
         return  -1;
     }
@@ -113,6 +114,71 @@ uint32_t CanFDDevice::__axiCanfdSetFilter(uint32_t uiFilterIndex, uint32_t uiMas
     return 0;
 }
 
+// ID 寄存器编码：与发送缓冲 ID 字一致（扩展帧 ID1 为高 11 位、ID2 为低 18 位，并置 IDE/SRR）
+uint32_t CanFDDevice::filter_id(uint32_t id, bool ide) {
+    if (ide) {
+        return ((id & 0x3FFFF) << XCANFD_IDR_ID2_SHIFT) |
+               (((id & 0x1FFC0000) >> 18) << XCANFD_IDR_ID1_SHIFT) |
+               XCANFD_IDR_IDE_MASK | XCANFD_IDR_SRR_MASK;
+    }
+    return (id << XCANFD_IDR_ID1_SHIFT) & XCANFD_IDR_ID1_MASK;
+}
+
+// 精确匹配掩码：IDE 参与比较，标准帧过滤器不会放行高位相同的扩展帧
+uint32_t CanFDDevice::filter_mask(bool ide) {
+    return ide ? (XCANFD_IDR_ID1_MASK | XCANFD_IDR_ID2_MASK | XCANFD_IDR_IDE_MASK)
+               : (XCANFD_IDR_ID1_MASK | XCANFD_IDR_IDE_MASK);
+}
+
+// 扩展帧的 SRR 位恒为 1：要求 IDE=1 且 SRR=0 的过滤器不会匹配任何帧
+CanAcceptFilter CanFDDevice::reject_all_filter() {
+    return CanAcceptFilter{XCANFD_IDR_IDE_MASK | XCANFD_IDR_SRR_MASK, XCANFD_IDR_IDE_MASK};
+}
+
+// 按顺序写入过滤器 1..n：最后一个过滤器常驻拒收全部的守卫项，换入期间保持启用，AFR 不会落到 0（接收全部）；
+// 内容未变且已启用的过滤器不重写
+int32_t CanFDDevice::set_accept_filters(std::span<const CanAcceptFilter> filters) {
+    static_assert(kMaxAcceptFilters + 1 == MAX_FILTER_INDEX, "last acceptance filter is the guard");
+    if (filters.size() > kMaxAcceptFilters) {
+        LOGE("canfd", "set_accept_filters", -EINVAL, "filters=%zu > %u", filters.size(), kMaxAcceptFilters);
+        return -EINVAL;
+    }
+    constexpr uint32_t kGuardIndex = MAX_FILTER_INDEX - 1;
+    constexpr uint32_t kGuard = 1u << kGuardIndex;
+    uint32_t afr = 0;
+    if (!rd32(XCANFD_AFR_OFFSET, afr)) return -EIO;
+    if (filters.empty()) {
+        return wr32(XCANFD_AFR_OFFSET, 0) ? 0 : -EIO;
+    }
+
+    if (!(afr & kGuard)) {
+        const CanAcceptFilter guard = reject_all_filter();
+        if (!wr32(XCANFD_AFMR_OFFSET(kGuardIndex), guard.mask) || !wr32(XCANFD_AFIDR_OFFSET(kGuardIndex), guard.id)) return -EIO;
+        afr |= kGuard;
+        if (!wr32(XCANFD_AFR_OFFSET, afr)) return -EIO;
+    }
+    for (uint32_t i = 0; i < filters.size(); ++i) {
+        const uint32_t bit = 1u << i;
+        uint32_t mask = 0, id = 0;
+        if ((afr & bit) && rd32(XCANFD_AFMR_OFFSET(i), mask) && rd32(XCANFD_AFIDR_OFFSET(i), id) &&
+            mask == filters[i].mask && id == filters[i].id) {
+            continue;
+        }
+        // 过滤器须在禁用状态下设置
+        afr &= ~bit;
+        if (!wr32(XCANFD_AFR_OFFSET, afr) ||
+            !wr32(XCANFD_AFMR_OFFSET(i), filters[i].mask) || !wr32(XCANFD_AFIDR_OFFSET(i), filters[i].id)) {
+            return -EIO;
+        }
+        afr |= bit;
+        if (!wr32(XCANFD_AFR_OFFSET, afr)) return -EIO;
+    }
+    // 先停用多余的旧过滤器，最后撤下守卫
+    afr &= ((1u << filters.size()) - 1) | kGuard;
+    if (!wr32(XCANFD_AFR_OFFSET, afr) || !wr32(XCANFD_AFR_OFFSET, afr & ~kGuard)) return -EIO;
+    return static_cast<int32_t>(filters.size());
+}
+
 // 获取CANFD模式
 uint8_t CanFDDevice::__axiCanfdGetMode(void) {
     uint8_t   ucModeStatus;
@@ -141,6 +207,19 @@ uint8_t CanFDDevice::__axiCanfdGetMode(void) {
     return ucModeStatus;
 }
 
+// 等待进入指定模式：CONFIG 在数个时钟内生效，NORMAL 需等待总线空闲（11 个隐性位）后生效
+int CanFDDevice::__axiCanfdWaitMode(uint8_t ucMode, uint32_t uiTimeoutUs) {
+    uint8_t ucCurMode = 0;
+    int iRet = pollUntil([&]() -> int {
+        ucCurMode = __axiCanfdGetMode();
+        return ucCurMode == ucMode ? 1 : 0;
+    }, uiTimeoutUs);
+    if (iRet != 0) {
+        LOGE("canfd", "mode", iRet, "wait mode 0x%x timeout after %u us (cur=0x%x)", ucMode, uiTimeoutUs, ucCurMode);
+    }
+    return iRet;
+}
+
 // CANFD位时间设置
 int CanFDDevice::__axiCanfdSetBitTiming(uint8_t ucSyncJumpWidth, uint8_t ucTimeSegment2, uint16_t ucTimeSegment1) {
     uint32_t uiValue;
@@ -296,7 +375,9 @@ int CanFDDevice::__axiCanfdHwInit(void) {
     wr32(XCANFD_SRR_OFFSET, XCANFD_SRR_SRST_MASK);
 
     __axiCanfdEnterMode(XCANFD_MODE_CONFIG);                /* 进入配置模式                 */
-    while (__axiCanfdGetMode() != XCANFD_MODE_CONFIG);
+    if (__axiCanfdWaitMode(XCANFD_MODE_CONFIG) != 0) {
+        return -ETIMEDOUT;
+    }
     // 设置波特率默认配置位仲裁域1M 数据域 4M
     wr32(XCANFD_BRPR_OFFSET, 1);
     __axiCanfdSetBitTiming(3, 3, 14);
@@ -320,9 +401,7 @@ int CanFDDevice::__axiCanfdHwInit(void) {
     __axiCanfdSetBitRateSwitchDisableNominal();               // 配置波特率切换功能
 
     __axiCanfdEnterMode(XCANFD_MODE_NORMAL);                // 进入工作模式
-    while (__axiCanfdGetMode() != XCANFD_MODE_NORMAL);
-
-    return 0;
+    return __axiCanfdWaitMode(XCANFD_MODE_NORMAL);
 }
 
 // 处理CANFD总线离线事件
@@ -332,9 +411,9 @@ void CanFDDevice::__axiCanfdPeeBusOffHandler() {
 
     rd32(XCANFD_TRR_OFFSET, uiRegValue);
     wr32(XCANFD_TCR_OFFSET, uiRegValue);
-    rd32(XCANFD_TRR_OFFSET, uiValue);
-    while (uiValue != 0) {
-        rd32(XCANFD_TRR_OFFSET, uiValue);
+    // 等待取消完成；超时仍重新请求（对仍在等待的缓冲置位无副作用）
+    if (pollReg32(XCANFD_TRR_OFFSET, 0xFFFFFFFFu, 0, kRegPollTimeoutUs, &uiValue) != 0) {
+        LOGW("canfd", "busoff", -ETIMEDOUT, "tx cancel incomplete trr=0x%08x", uiValue);
     }
 
     wr32(XCANFD_TRR_OFFSET, uiRegValue);
@@ -403,48 +482,58 @@ int CanFDDevice::__axiCanfdIrqHandel() {
     return 0;
 }
 
-// CanFD发送
-int CanFDDevice::__axiCanfdSend(CanFrame *pCanFrame) {
-    if (pCanFrame == nullptr) {
-        LOGW("canfd", "send", -1, "pCanFrame is nullptr");
-        return -1;
-    }
-    
+// 将一帧写入指定发送缓冲（不置位 TRR）
+int CanFDDevice::__axiCanfdWriteTxBuffer(uint32_t uiTxBuffer, const CanFrame& frame) {
     uint32_t uiId           = 0;
-    uint32_t uiTrrVal       = 0;
-    uint32_t uiValue        = 0;
     uint32_t uiDlc          = 0;
-    uint32_t uiDwIndex      = 0;
-    uint32_t uiFreeTxBuffer = 0;
-    uint32_t uiTxFrame[16];
+    uint32_t uiTxFrame[2 + 16];     // ID、DLC 与 16 个数据字地址连续，拼好后一次突发写入
     uint32_t uiDw           = 0;
 
-    // 计算实际数据长度
-    // 应由使用者写入pCanFrame->len
-    // pCanFrame->len = dlc_to_len(pCanFrame->dlc);
-    
-    uiDlc = ((pCanFrame->dlc << XCANFD_DLCR_DLC_SHIFT) & XCANFD_DLCR_DLC_MASK);
+    // CANFD 不支持远程帧
+    if (frame.rtr) {
+        LOGW("canfd", "send", -1, "rtr frame not support");
+        return -1;
+    }
+
+    // 实际数据长度由使用者写入 frame.len
+    uiDlc = ((frame.dlc << XCANFD_DLCR_DLC_SHIFT) & XCANFD_DLCR_DLC_MASK);
     uiDlc |= XCANFD_DLCR_EDL_MASK;  // 发送CANFD帧，EDL位必须设置为1
-    if (pCanFrame->brs) {   // CANFD是否进行加速
+    if (frame.brs) {   // CANFD是否进行加速
         uiDlc |= XCANFD_DLCR_BRS_MASK;
     }
 
-    // 计算ID位中的值
-    if (pCanFrame->ide) {   // 扩展帧
-        uiId  = (pCanFrame->id & 0x3FFFF) << XCANFD_IDR_ID2_SHIFT;
-        uiId |= ((pCanFrame->id & 0x1FFC0000) >> 18) << XCANFD_IDR_ID1_SHIFT;
-        uiId |= (XCANFD_IDR_IDE_MASK);
-        uiId |= (XCANFD_IDR_SRR_MASK);
-    } else {    // 标准帧
-        uiId  = (pCanFrame->id << XCANFD_IDR_ID1_SHIFT) & XCANFD_IDR_ID1_MASK;
+    // 计算ID位中的值（标准帧/扩展帧编码与验收过滤器一致）
+    uiId = filter_id(frame.id, frame.ide);
+
+    // 拼接ID、DLC与CANFD数据字，一次突发写入发送缓冲
+    uiTxFrame[0] = uiId;
+    uiTxFrame[1] = uiDlc;
+    const uint32_t uiLen = frame.len < CanFrame::kMaxData ? frame.len : CanFrame::kMaxData;
+    uint32_t uiWords = 0;
+    for (uiDw = 0; uiDw < uiLen; uiDw += 4) {
+        uint32_t txData = 0;
+        for (uint32_t i = 0; i < 4 && (uiDw + i) < uiLen; i++) {
+            txData |= (static_cast<uint32_t>(frame.data[uiDw + i]) << (24 - i * 8));
+        }
+        uiTxFrame[2 + uiWords++] = txData;
     }
+    static_assert(XCANFD_TXFIFO_0_BASE_DLC_OFFSET == XCANFD_TXFIFO_0_BASE_ID_OFFSET + 4 &&
+                  XCANFD_TXFIFO_0_BASE_DW0_OFFSET == XCANFD_TXFIFO_0_BASE_ID_OFFSET + 8,
+                  "TX buffer ID/DLC/DW registers must be contiguous");
+    return wr32n(XCANFD_TXID_OFFSET(uiTxBuffer), std::span<const uint32_t>(uiTxFrame, 2 + uiWords)) ? 0 : -1;
+}
 
-    // CANFD 不支持远程帧
-    if (pCanFrame->rtr) {
-        LOGW("canfd", "send", -1, "rtr frame not support");
+// CanFD发送
+int CanFDDevice::__axiCanfdSend(CanFrame *pCanFrame) {
+    if (pCanFrame == nullptr) {
+        LOGW("canfd", "send", -1, "pCanFrame is nullptr");
         return -1;
     }
-    
+
+    uint32_t uiTrrVal       = 0;
+    uint32_t uiValue        = 0;
+    uint32_t uiFreeTxBuffer = 0;
+
     // 计算空闲FIFO索引
     uiTrrVal = __axiCanfdGetFreeBuffer();
     uiValue  = (~uiTrrVal) & TRR_MASK_INIT_VAL;
@@ -453,102 +542,126 @@ int CanFDDevice::__axiCanfdSend(CanFrame *pCanFrame) {
     if (uiFreeTxBuffer == 33) {
         LOGW("canfd", "send", -1, "tx fifo fill");
         return -1;
-    } else {
-        LOGI("canfd", "send", uiTrrVal, "uiFreeTxBuffer: %d", uiFreeTxBuffer);
     }
 
-    // 将ID值和DLC值写入相应的寄存器
-    wr32(XCANFD_TXID_OFFSET(uiFreeTxBuffer), uiId);
-    wr32(XCANFD_TXDLC_OFFSET(uiFreeTxBuffer), uiDlc);
-
-    // 拼接CANFD数据并写入数据寄存器 - 修复数据拷贝问题
-    for (uiDw = 0; uiDw < pCanFrame->len; uiDw += 4) {
-        uint32_t txData = 0;
-        // 安全地拷贝数据，避免数组越界
-        for (int i = 0; i < 4 && (uiDw + i) < pCanFrame->len && (uiDw + i) < pCanFrame->data.size(); i++) {
-            txData |= (static_cast<uint32_t>(pCanFrame->data[uiDw + i]) << (24 - i * 8));
-        }
-        uiTxFrame[uiDw / 4] = txData;
-        wr32((XCANFD_TXDW_OFFSET(uiFreeTxBuffer) + (uiDwIndex * XCANFD_DW_BYTES)), uiTxFrame[uiDw/4]);
-        uiDwIndex ++;
+    if (__axiCanfdWriteTxBuffer(uiFreeTxBuffer, *pCanFrame) != 0) {
+        return -1;
     }
 
-    rd32(XCANFD_TRR_OFFSET, uiValue);
-    uiValue |= (1 << uiFreeTxBuffer);
-    wr32(XCANFD_TRR_OFFSET, uiValue);   // 置位TRR代表进行发送
+    // TRR 写 1 置位、写 0 无效：只写本缓冲位，避免把读取后刚完成的缓冲再次请求发送
+    wr32(XCANFD_TRR_OFFSET, 1u << uiFreeTxBuffer);   // 置位TRR代表进行发送
     return 0;
 }
 
-// CanFD接收（FIFO模式）
-int CanFDDevice::__axiCanfdRecvFifo(CanFrame *pCanFrame) {
-    if (pCanFrame == nullptr) {
-        LOGE("canfd", "recv", -1, "pCanFrame is nullptr");
+// 读发送请求寄存器：置位的缓冲尚未发送完成
+bool CanFDDevice::tx_pending(uint32_t& mask) {
+    return rd32(XCANFD_TRR_OFFSET, mask);
+}
+
+// 批量发送：按 TRR 一次性找出全部空闲缓冲依次填充，最后一次写 TRR 同时启动
+int CanFDDevice::__axiCanfdSendBatch(const CanFrame* pFrames, uint32_t uiCount, uint32_t uiAllowMask) {
+    uint32_t uiTrrVal = 0;
+    uint32_t uiReady  = 0;
+    int      iSent    = 0;
+
+    if (!rd32(XCANFD_TRR_OFFSET, uiTrrVal)) {
         return -1;
     }
-    uint32_t uiResult    = 0;
-    uint32_t uiReadIndex = 0;
-    uint32_t uiValue     = 0;
-    uint32_t uiDlc       = 0;
-    uint32_t Len         = 0;
-    uint32_t data        = 0;
-    uint32_t uiDwIndex   = 0;
-
-    rd32(XCANFD_FSR_OFFSET, uiResult);// FIFO 0 状态，只用了FIFO 0
-    if (!(uiResult & XCANFD_FSR_FL_MASK)) {    // FIFO 0 没有消息
-        return 0;
+    uint32_t uiFree = ~uiTrrVal & uiAllowMask;
+    while (uiFree != 0 && static_cast<uint32_t>(iSent) < uiCount) {
+        uint32_t uiBuffer = static_cast<uint32_t>(__builtin_ctz(uiFree));
+        uiFree &= uiFree - 1;
+        if (__axiCanfdWriteTxBuffer(uiBuffer, pFrames[iSent]) != 0) {
+            break;
+        }
+        uiReady |= (1u << uiBuffer);
+        ++iSent;
+    }
+    if (uiReady != 0) {
+        wr32(XCANFD_TRR_OFFSET, uiReady);   // 置位TRR代表进行发送（写 0 的位无效）
     }
-    
-    uiReadIndex = uiResult & XCANFD_FSR_RI_MASK;    // FIFO 0 消息索引
-    rd32(XCANFD_RXID_OFFSET(uiReadIndex), uiValue);
-    pCanFrame->ide = (uiValue & XCANFD_IDR_IDE_MASK) >> XCANFD_IDR_IDE_SHIFT;
-    pCanFrame->rtr = (uiValue & XCANFD_IDR_RTR_MASK);
+    return iSent;
+}
+
+// 从 RX FIFO 0 的指定槽读出一帧（不推进读索引）
+void CanFDDevice::__axiCanfdReadRxFrame(uint32_t uiReadIndex, CanFrame& frame) {
+    uint32_t uiHdr[2]  = {0, 0};    // ID / DLC 地址连续
+    uint32_t uiData[16];
+
+    rd32n(XCANFD_RXID_OFFSET(uiReadIndex), std::span<uint32_t>(uiHdr, 2));
+    const uint32_t uiValue = uiHdr[0];
+    const uint32_t uiDlc   = uiHdr[1];
 
+    frame.ide = (uiValue & XCANFD_IDR_IDE_MASK) >> XCANFD_IDR_IDE_SHIFT;
+    frame.rtr = (uiValue & XCANFD_IDR_RTR_MASK);
     if (uiValue & (XCANFD_IDR_IDE_MASK)) {
-        pCanFrame->id  = (uiValue & (0x3FFFF << 1)) >> 1;
-        pCanFrame->id |= ((uiValue & (0x7ff<<21)) >> 3);
+        frame.id  = (uiValue & (0x3FFFF << 1)) >> 1;
+        frame.id |= ((uiValue & (0x7ff<<21)) >> 3);
     } else {
-        pCanFrame->id = (uiValue >> 21);
+        frame.id = (uiValue >> 21);
     }
 
-    rd32(XCANFD_RXFIFO_0_BASE_DLC_OFFSET+(uiReadIndex * XCANFD_MAX_FRAME_SIZE), uiDlc);
-
-    pCanFrame->dlc = (uiDlc & XCANFD_DLCR_DLC_MASK) >> XCANFD_DLCR_DLC_SHIFT;
-    pCanFrame->len = dlc_to_len(pCanFrame->dlc);
-    if (uiDlc & XCANFD_DLCR_EDL_MASK) {
-        pCanFrame->fdf = true;
+    frame.dlc = (uiDlc & XCANFD_DLCR_DLC_MASK) >> XCANFD_DLCR_DLC_SHIFT;
+    frame.len = dlc_to_len(frame.dlc);
+    frame.fdf = (uiDlc & XCANFD_DLCR_EDL_MASK) != 0;
+    frame.brs = (uiDlc & XCANFD_DLCR_BRS_MASK) != 0;
+    frame.esi = (uiDlc & XCANFD_DLCR_ESI_MASK) != 0;
+    if (!frame.fdf && frame.len > 8) {
+        frame.len = 8;     // 经典帧 DLC 9..15 仍表示 8 字节
     }
 
-    if (uiDlc & XCANFD_DLCR_BRS_MASK) {
-        pCanFrame->brs = true;
+    // 数据字连续排布，按实际长度一次突发读出（大端：data[0] 位于字的高字节）
+    uint32_t uiWords = (frame.len + 3) / 4;
+    if (uiWords == 0) {
+        return;
+    }
+    rd32n(XCANFD_RXDW_OFFSET(uiReadIndex), std::span<uint32_t>(uiData, uiWords));
+    for (uint32_t Len = 0; Len < frame.len; ++Len) {
+        frame.data[Len] = static_cast<uint8_t>(uiData[Len / 4] >> (24 - (Len % 4) * 8));
     }
+}
 
-    if (uiDlc & XCANFD_DLCR_ESI_MASK) {
-        pCanFrame->esi = true;
+// CanFD接收（FIFO模式）
+int CanFDDevice::__axiCanfdRecvFifo(CanFrame *pCanFrame) {
+    if (pCanFrame == nullptr) {
+        LOGE("canfd", "recv", -1, "pCanFrame is nullptr");
+        return -1;
     }
+    uint32_t uiResult = 0;
 
-    // 确保data vector有足够的空间
-    pCanFrame->data.resize(pCanFrame->len);
-    
-    if (uiDlc & XCANFD_DLCR_EDL_MASK){
-        for (Len = 0; Len < pCanFrame->len; Len += 4) { 
-            rd32(XCANFD_RXFIFO_0_BASE_DW0_OFFSET+(uiReadIndex * XCANFD_MAX_FRAME_SIZE) + (uiDwIndex * XCANFD_DW_BYTES), data);
-            uiDwIndex++;
-            // 安全地拷贝数据，避免数组越界
-            if (Len < pCanFrame->len) pCanFrame->data[Len]     = (data >> 24) & 0xFF;
-            if (Len + 1 < pCanFrame->len) pCanFrame->data[Len + 1] = (data >> 16) & 0xFF;
-            if (Len + 2 < pCanFrame->len) pCanFrame->data[Len + 2] = (data >> 8)  & 0xFF;
-            if (Len + 3 < pCanFrame->len) pCanFrame->data[Len + 3] = data & 0xFF;
-        }
+    rd32(XCANFD_FSR_OFFSET, uiResult);// FIFO 0 状态，只用了FIFO 0
+    if (!(uiResult & XCANFD_FSR_FL_MASK)) {    // FIFO 0 没有消息
+        return 0;
     }
+    __axiCanfdReadRxFrame(uiResult & XCANFD_FSR_RI_MASK, *pCanFrame);   // FIFO 0 消息索引
 
     // Set the IRI bit causes core to increment RI in FSR Register
     rd32(XCANFD_FSR_OFFSET, uiResult);
     uiResult |= XCANFD_FSR_IRI_MASK;
     wr32(XCANFD_FSR_OFFSET, uiResult);
-    
+
     return 1; // 返回接收到的帧数
 }
 
+// 批量接收：每帧读一次 FSR 取读索引，读出后置位 IRI 推进，直到 FIFO 空或输出满
+int CanFDDevice::__axiCanfdRecvFifoBatch(CanFrame* pFrames, uint32_t uiCount) {
+    uint32_t uiResult = 0;
+    uint32_t uiGot    = 0;
+
+    while (uiGot < uiCount) {
+        if (!rd32(XCANFD_FSR_OFFSET, uiResult)) {
+            return uiGot ? static_cast<int>(uiGot) : -1;
+        }
+        if (!(uiResult & XCANFD_FSR_FL_MASK)) {
+            break;
+        }
+        __axiCanfdReadRxFrame(uiResult & XCANFD_FSR_RI_MASK, pFrames[uiGot]);
+        wr32(XCANFD_FSR_OFFSET, uiResult | XCANFD_FSR_IRI_MASK);
+        ++uiGot;
+    }
+    return static_cast<int>(uiGot);
+}
+
 int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
     uint8_t ucNewBrp = 0;
     uint8_t ucNewFBrp = 0;
@@ -557,8 +670,7 @@ int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
 
     switch (iCmd) {
         case CAN_DEV_OPEN: {  // 打开 CAN 设备
-            __axiCanfdHwInit();
-            break;
+            return __axiCanfdHwInit();
         }
 
         case CAN_DEV_CLOSE: {
@@ -567,13 +679,14 @@ int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
         }
 
         case CAN_DEV_REST_CONTROLLER: {
-            __axiCanfdHwInit();
-            break;
+            return __axiCanfdHwInit();
         }
 
         case CAN_DEV_SET_BAUD: {                                       // 设置仲裁段波特率 
             __axiCanfdEnterMode(XCANFD_MODE_CONFIG);            // 进入配置模式 
-            while (__axiCanfdGetMode() != XCANFD_MODE_CONFIG);
+            if (__axiCanfdWaitMode(XCANFD_MODE_CONFIG) != 0) {
+                return -ETIMEDOUT;
+            }
 
             switch (*(uint32_t*)lArg) {
                 case 125000: {
@@ -598,7 +711,7 @@ int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
                 }
                 default: {
                     __axiCanfdEnterMode(XCANFD_MODE_NORMAL);        // 进入工作模式
-                    while (__axiCanfdGetMode() != XCANFD_MODE_NORMAL);
+                    (void)__axiCanfdWaitMode(XCANFD_MODE_NORMAL);
                     return -ENOSYS;
                 }
             }
@@ -606,13 +719,17 @@ int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
             __axiCanfdSetBaudRatePrescaler(ucNewBrp);
             __axiCanfdSetBitTiming(ucSJW, ucNewTsg2, ucNewTsg1);
             __axiCanfdEnterMode(XCANFD_MODE_NORMAL);            // 进入工作模式
-            while (__axiCanfdGetMode() != XCANFD_MODE_NORMAL);
+            if (__axiCanfdWaitMode(XCANFD_MODE_NORMAL) != 0) {
+                return -ETIMEDOUT;
+            }
             break;
         }
 
         case CAN_DEV_SET_DATA_BAUD: {                                   // 设置数据段波特率
             __axiCanfdEnterMode(XCANFD_MODE_CONFIG);            // 进入配置模式
-            while (__axiCanfdGetMode() != XCANFD_MODE_CONFIG);
+            if (__axiCanfdWaitMode(XCANFD_MODE_CONFIG) != 0) {
+                return -ETIMEDOUT;
+            }
 
             switch (*(uint32_t*)lArg) {
                 case 125000: {
@@ -645,7 +762,7 @@ int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
                 }
                 default: {
                     __axiCanfdEnterMode(XCANFD_MODE_NORMAL);        // 进入工作模式
-                    while (__axiCanfdGetMode() != XCANFD_MODE_NORMAL);
+                    (void)__axiCanfdWaitMode(XCANFD_MODE_NORMAL);
                     return -ENOSYS;
                 }
             }
@@ -653,7 +770,9 @@ int CanFDDevice::__axiCanfdIoctl(int iCmd, void* lArg) {
             __axiCanfdSetFBaudRatePrescaler(ucNewFBrp);
             __axiCanfdSetFBitTiming(ucFSJW, ucNewFTsg2, ucNewFTsg1);
             __axiCanfdEnterMode(XCANFD_MODE_NORMAL);            // 进入工作模式
-            while (__axiCanfdGetMode() != XCANFD_MODE_NORMAL);
+            if (__axiCanfdWaitMode(XCANFD_MODE_NORMAL) != 0) {
+                return -ETIMEDOUT;
+            }
             break;
         }
 
@@ -0,0 +1,138 @@
+/**
+ * @file CanFdTxQueue.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Device/CanFdTxQueue.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <cerrno>
+#include <span>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+namespace {
+constexpr int kStallPollMs = 10;    // 有事件 fd 时的兜底超时，防止丢失 TXOK 后队列停滞
+}
+
+CanFdTxQueue::CanFdTxQueue(CanFDDevice& dev, size_t depth, bool strict_order)
+    : dev_(dev), q_(depth), strict_order_(strict_order) {}
+
+CanFdTxQueue::~CanFdTxQueue() {
+    stop();
+}
+
+bool CanFdTxQueue::enqueue(const CanFrame& frame) {
+    if (!q_.push(frame)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
+    size_t d = q_.sizeApprox();
+    size_t hw = high_water_.load(std::memory_order_relaxed);
+    while (d > hw && !high_water_.compare_exchange_weak(hw, d, std::memory_order_relaxed)) {}
+
+    // 与泵线程的 idle_ 检查配对：要么泵线程看到本帧，要么本线程看到 idle_ 并唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle_.load(std::memory_order_relaxed) && idle_.exchange(false, std::memory_order_acq_rel)) waiter_.wake();
+    return true;
+}
+
+int CanFdTxQueue::service() {
+    std::lock_guard<std::mutex> lk(svc_mu_);
+    uint32_t trr = 0;
+    if (!dev_.tx_pending(trr)) return -EIO;
+
+    uint32_t usable = ~trr;
+    if (strict_order_ && trr != 0) {
+        // 只用高于最高待发缓冲号的缓冲，新帧排在所有在途帧之后
+        uint32_t top = 31u - static_cast<uint32_t>(__builtin_clz(trr));
+        usable = top == 31u ? 0u : ~((2u << top) - 1u);
+    }
+    const uint32_t avail = static_cast<uint32_t>(__builtin_popcount(usable));
+
+    uint32_t n = 0;
+    while (n < avail && q_.pop(staging_[n])) ++n;
+    if (n == 0) return 0;
+
+    // TRR 只会被硬件清零，读到的空闲缓冲在填充时仍然空闲
+    int32_t started = dev_.send_batch(std::span<const CanFrame>(staging_, n), usable);
+    if (started < 0) started = 0;
+    if (static_cast<uint32_t>(started) < n) {
+        // 已出队的帧无法退回队头，计为硬件错误丢弃
+        hw_errors_.fetch_add(n - static_cast<uint32_t>(started), std::memory_order_relaxed);
+        LOGW("canfd_txq", "service", -EIO, "started %d/%u", started, n);
+    }
+    sent_.fetch_add(static_cast<uint64_t>(started), std::memory_order_relaxed);
+    refills_.fetch_add(1, std::memory_order_relaxed);
+    return started;
+}
+
+bool CanFdTxQueue::start(EventHook on_event) {
+    if (running()) return true;
+    if (!waiter_.open(dev_.transport().getEventFd())) {
+        LOGE("canfd_txq", "start", errno, "eventfd failed");
+        return false;
+    }
+    on_event_ = std::move(on_event);
+    stop_.store(false, std::memory_order_relaxed);
+    idle_.store(false, std::memory_order_relaxed);
+    pump_ = std::thread([this]() { pump_loop(); });
+    LOGI("canfd_txq", "start", 0, "capacity=%zu event_fd=%d", q_.capacity(), dev_.transport().getEventFd());
+    return true;
+}
+
+void CanFdTxQueue::stop() {
+    if (pump_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        waiter_.wake();
+        pump_.join();
+    }
+    idle_.store(false, std::memory_order_relaxed);
+    waiter_.close();
+}
+
+void CanFdTxQueue::pump_loop() {
+    auto& tp = dev_.transport();
+    while (!stop_.load(std::memory_order_acquire)) {
+        (void)service();
+
+        int timeout_ms = waiter_.hasReadyFd() ? kStallPollMs : DDS::ReadyWaiter::kFallbackPollMs;
+        if (q_.sizeApprox() == 0) {
+            idle_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (q_.sizeApprox() != 0) {
+                // 置 idle_ 前后有帧入队：若生产者未取走唤醒权则直接继续
+                if (idle_.exchange(false, std::memory_order_acq_rel)) continue;
+            }
+            timeout_ms = -1;
+        }
+
+        auto res = waiter_.wait(timeout_ms);
+        if (res == DDS::ReadyWaiter::Result::Error) {
+            LOGE("canfd_txq", "poll", errno, "pump exit");
+            break;
+        }
+        if (res == DDS::ReadyWaiter::Result::Ready) {
+            uint32_t bitmap = 0;
+            if (tp.waitEvent(&bitmap, 0) > 0 && on_event_) on_event_(bitmap);
+        }
+        idle_.store(false, std::memory_order_relaxed);
+    }
+}
+
+CanFdTxQueue::Stats CanFdTxQueue::stats() const {
+    Stats s;
+    s.enqueued   = enqueued_.load(std::memory_order_relaxed);
+    s.sent       = sent_.load(std::memory_order_relaxed);
+    s.dropped    = dropped_.load(std::memory_order_relaxed);
+    s.hw_errors  = hw_errors_.load(std::memory_order_relaxed);
+    s.refills    = refills_.load(std::memory_order_relaxed);
+    s.depth      = q_.sizeApprox();
+    s.high_water = high_water_.load(std::memory_order_relaxed);
+    s.capacity   = q_.capacity();
+    return s;
+}
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
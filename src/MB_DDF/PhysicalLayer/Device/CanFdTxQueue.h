@@ -0,0 +1,97 @@
+/**
+ * @file CanFdTxQueue.h
+ * @brief CAN-FD 软件发送队列：无锁 MPSC 环形缓冲 + 硬件发送缓冲流水线
+ *
+ * 设计要点：
+ * - 任意线程 enqueue 入队（不加锁、不阻塞），队满计入 dropped 并返回 false。
+ * - service() 读一次 TRR 得到空闲硬件缓冲，出队同样数量的帧一次性填入并置位 TRR，
+ *   使硬件发送缓冲保持排满，总线上帧与帧之间无需等待用户线程。
+ * - 硬件在同 ID 的待发缓冲间按缓冲号从低到高发送：strict_order（默认）只向高于最高待发缓冲号的
+ *   空闲缓冲填充，保证入队次序即上线次序（代价是每轮 32 帧发完后才从缓冲 0 重新开始）；
+ *   关闭后使用全部空闲缓冲，适用于各帧 ID 不同、次序由总线仲裁决定的场景。
+ * - start() 启动泵线程独占传输层事件 fd：TX 完成（TXOK）中断到来即补充缓冲，
+ *   队列由空转非空时经内部 eventfd 唤醒；事件位图同时转发给 on_event（如排空 RX FIFO）。
+ *   不启动泵线程时，可由外部事件循环在收到中断后调用 service()。
+ * - 使用队列后，同一设备的其他发送路径（send/send_batch）不应并发使用。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/Device/CanFdDevice.h"
+#include "MB_DDF/DDS/ReadyWaiter.h"
+#include "MB_DDF/PhysicalLayer/Support/MpscQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+class CanFdTxQueue {
+public:
+    static constexpr size_t kHwTxBuffers = 32;  // AXI CAN-FD 发送缓冲数（TRR 位宽）
+
+    struct Stats {
+        uint64_t enqueued = 0;      // 成功入队帧数
+        uint64_t sent = 0;          // 已写入硬件缓冲并启动发送的帧数
+        uint64_t dropped = 0;       // 队满被拒绝的帧数
+        uint64_t hw_errors = 0;     // 出队后写硬件失败而丢失的帧数
+        uint64_t refills = 0;       // 实际写入硬件的 service 次数
+        size_t   depth = 0;         // 当前队列深度（近似）
+        size_t   high_water = 0;    // 历史最大深度
+        size_t   capacity = 0;
+    };
+
+    // 事件转发：泵线程消费传输层事件后回调（在泵线程中执行）
+    using EventHook = std::function<void(uint32_t bitmap)>;
+
+    // depth 向上取整为 2 的幂
+    explicit CanFdTxQueue(CanFDDevice& dev, size_t depth = 256, bool strict_order = true);
+    ~CanFdTxQueue();
+
+    CanFdTxQueue(const CanFdTxQueue&) = delete;
+    CanFdTxQueue& operator=(const CanFdTxQueue&) = delete;
+
+    // 多生产者入队（拷贝一帧）；队满返回 false
+    bool enqueue(const CanFrame& frame);
+
+    // 按空闲硬件缓冲数出队并启动发送；返回本次启动帧数，<0 表示读 TRR 失败
+    int service();
+
+    // 泵线程：传输层无事件 fd 时退化为 1ms 周期补充
+    bool start(EventHook on_event = {});
+    void stop();
+    bool running() const { return pump_.joinable(); }
+
+    size_t depth() const { return q_.sizeApprox(); }
+    Stats stats() const;
+
+private:
+    void pump_loop();
+
+    CanFDDevice& dev_;
+    Support::MpscQueue<CanFrame> q_;
+    bool strict_order_;
+    std::mutex svc_mu_;                         // service 串行：TRR 读-填-置位须原子
+    CanFrame staging_[kHwTxBuffers];            // 出队暂存，避免每次 service 占用大栈帧
+
+    std::thread pump_;
+    EventHook on_event_;
+    DDS::ReadyWaiter waiter_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> idle_{false};             // 泵线程已排空队列并将休眠：下一次入队需唤醒
+
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> hw_errors_{0};
+    std::atomic<uint64_t> refills_{0};
+    std::atomic<size_t> high_water_{0};
+};
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -38,15 +38,12 @@ int32_t DdrDevice::receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us)
         return receive(buf, buf_size);
     }
 
-    const uint32_t step_us = 100;
-    uint32_t waited = 0;
-    while (waited <= timeout_us) {
-        int32_t n = receive(buf, buf_size);
-        if (n != 0) return n;
-        usleep(step_us);
-        waited += step_us;
-    }
-    return 0;
+    int32_t n = 0;
+    int rc = pollUntil([&]() -> int {
+        n = receive(buf, buf_size);
+        return n != 0 ? 1 : 0;
+    }, timeout_us, 100);
+    return rc == 0 ? n : 0;
 }
 
 int DdrDevice::ioctl(uint32_t opcode, const void* in, size_t in_len, void* out, size_t out_len) {
@@ -0,0 +1,117 @@
+/**
+ * @file DmaTopicPublisher.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Device/DmaTopicPublisher.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <cerrno>
+#include <chrono>
+#include <poll.h>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+DmaTopicPublisher::DmaTopicPublisher(ControlPlane::IDeviceTransport& tp,
+                                     std::shared_ptr<DDS::Publisher> pub,
+                                     int channel,
+                                     size_t frame_size)
+    : tp_(tp), pub_(std::move(pub)), channel_(channel), frame_size_(frame_size) {}
+
+DmaTopicPublisher::~DmaTopicPublisher() {
+    // 在途 DMA 仍在写入写槽：必须等到完成。RingBuffer 在提交前不推进写位置，提前释放会让下一次
+    // 预留拿到同一区域、被迟到的 DMA 覆盖；完成回调也须保留到此时。xdma 驱动对超时的 DMA 会以错误完成，
+    // 因此等待有界；每 kTeardownWarnMs 告警一次
+    auto next_warn = std::chrono::steady_clock::now() + std::chrono::milliseconds(kTeardownWarnMs);
+    while (pending()) {
+        struct pollfd pfd{ tp_.getAioEventFd(), POLLIN, 0 };
+        if (pfd.fd >= 0) (void)::poll(&pfd, 1, 10);
+        (void)tp_.drainAioCompletions(64);
+        if (pending() && std::chrono::steady_clock::now() >= next_warn) {
+            LOGW("dma_topic", "destroy", ETIMEDOUT, "frame still in flight after %dms, waiting", kTeardownWarnMs);
+            next_warn += std::chrono::milliseconds(kTeardownWarnMs);
+        }
+    }
+    if (bound_) tp_.setOnAsyncComplete(nullptr);
+}
+
+bool DmaTopicPublisher::readFrame(uint64_t device_offset) {
+    if (!pub_ || pending()) return false;
+    auto msg = pub_->begin_message(frame_size_);
+    if (!msg.valid()) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        LOGE("dma_topic", "reserve", ENOSPC, "size=%zu", frame_size_);
+        return false;
+    }
+    if (!tp_.continuousReadAt(channel_, msg.data(), frame_size_, device_offset)) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;  // msg 析构时取消写槽
+    }
+    if (!msg.commit(frame_size_)) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool DmaTopicPublisher::readFrameAsync(uint64_t device_offset) {
+    if (!pub_) return false;
+    bool expected = false;
+    if (!pending_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return false;
+
+    inflight_.emplace(pub_->begin_message(frame_size_));
+    if (!inflight_->valid()) {
+        inflight_.reset();
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        pending_.store(false, std::memory_order_release);
+        LOGE("dma_topic", "reserve", ENOSPC, "size=%zu", frame_size_);
+        return false;
+    }
+
+    ControlPlane::AsyncRequest req;
+    req.channel = channel_;
+    req.buf = inflight_->data();
+    req.len = frame_size_;
+    req.device_offset = device_offset;
+    req.token = this;
+    if (!tp_.submitAsync(req)) {
+        inflight_.reset();
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        pending_.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void DmaTopicPublisher::bindCompletion() {
+    bound_ = true;
+    tp_.setOnAsyncComplete([this](void* token, bool is_write, ssize_t res) {
+        (void)onAsyncComplete(token, is_write, res);
+    });
+}
+
+bool DmaTopicPublisher::onAsyncComplete(void* token, bool is_write, ssize_t res) {
+    if (token != this || is_write) return false;
+    (void)finish(res);
+    return true;
+}
+
+bool DmaTopicPublisher::finish(ssize_t res) {
+    bool ok = false;
+    if (inflight_) {
+        if (res == static_cast<ssize_t>(frame_size_)) {
+            ok = inflight_->commit(frame_size_);
+        } else {
+            LOGW("dma_topic", "dma_read", res < 0 ? static_cast<int>(-res) : EIO, "res=%zd want=%zu", res, frame_size_);
+        }
+        inflight_.reset();  // 未提交时取消写槽
+    }
+    if (ok) frames_.fetch_add(1, std::memory_order_relaxed);
+    else failures_.fetch_add(1, std::memory_order_relaxed);
+    pending_.store(false, std::memory_order_release);
+    return ok;
+}
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
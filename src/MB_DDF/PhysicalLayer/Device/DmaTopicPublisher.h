@@ -0,0 +1,74 @@
+/**
+ * @file DmaTopicPublisher.h
+ * @brief C2H DMA 直达 DDS 环形缓冲：预留写槽 → DMA 写入槽位 → 完成后提交
+ *
+ * 设计要点：
+ * - 通过 Publisher::begin_message 预留共享内存写槽，DMA 目标直接指向 data()，全程无 CPU 拷贝。
+ * - RingBuffer 在提交前不推进写位置：在途帧期间本 Topic 只能有这一个写者，其他 Publisher 的
+ *   begin_message/publish 会拿到同一区域并被迟到的 DMA 覆盖（调用方保证，RingBuffer 不做检查）。
+ * - 析构时阻塞等待在途帧完成（不取消 DMA，xdma 驱动超时后以错误完成），之后才解除 bindCompletion 注册的回调。
+ * - 若 Topic 开启了校验和，提交时仍会对载荷做一次只读遍历；大帧建议关闭校验。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
+#include "MB_DDF/DDS/Publisher.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+class DmaTopicPublisher {
+public:
+    DmaTopicPublisher(ControlPlane::IDeviceTransport& tp,
+                      std::shared_ptr<DDS::Publisher> pub,
+                      int channel,
+                      size_t frame_size);
+    ~DmaTopicPublisher();
+
+    DmaTopicPublisher(const DmaTopicPublisher&) = delete;
+    DmaTopicPublisher& operator=(const DmaTopicPublisher&) = delete;
+
+    // 析构时等待在途帧完成：每隔该时长告警一次，直到完成
+    static constexpr int kTeardownWarnMs = 1000;
+
+    // 同步读取一帧：DMA 完成即提交到 Topic
+    bool readFrame(uint64_t device_offset);
+
+    // 异步读取一帧：提交 DMA 后立即返回，完成时由 onAsyncComplete 提交或取消写槽
+    // 已有在途帧时返回 false；在途期间 Topic 不得有其他写者
+    bool readFrameAsync(uint64_t device_offset);
+    bool pending() const { return pending_.load(std::memory_order_acquire); }
+
+    // 将本对象注册为传输层的带标记完成回调（传输层仅有一个完成回调，独占时使用）；析构时自动解除
+    void bindCompletion();
+    // 与其他使用者共享完成回调时，由外部回调转发；token 不属于本对象时返回 false
+    bool onAsyncComplete(void* token, bool is_write, ssize_t res);
+
+    uint64_t framesPublished() const { return frames_.load(std::memory_order_relaxed); }
+    uint64_t framesFailed() const { return failures_.load(std::memory_order_relaxed); }
+    size_t frameSize() const { return frame_size_; }
+
+private:
+    bool finish(ssize_t res);
+
+    ControlPlane::IDeviceTransport& tp_;
+    std::shared_ptr<DDS::Publisher> pub_;
+    int channel_;
+    size_t frame_size_;
+
+    std::optional<DDS::Publisher::WritableMessage> inflight_;
+    bool bound_ = false;
+    std::atomic<bool> pending_{false};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> failures_{0};
+};
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -20,8 +20,9 @@ static constexpr uint64_t ADDR_FILTER_ENABLE   = 0x4;          // AD 滤波寄
 static constexpr uint64_t ADDR_PARA_AD         = 0xA0 * 4;     // 参数寄存器起始（16位）
 static constexpr uint64_t ADDR_PARA_NUM_AD     = 0xA1 * 4;     // 参数数量（16位），参考值 44
 static constexpr uint64_t ADDR_OUT_ENABLE_AD   = 0xAF * 4;     // 输出使能位图（16位）
+static constexpr uint64_t ADDR_AD_FDB          = 0x4;          // AD 反馈起始偏移（16位），每路+4
 
-static constexpr int HELM_NUM = 4;
+static constexpr int HELM_NUM = HelmDevice::kChannels;
 }
 
 bool HelmDevice::open(const LinkConfig& cfg) {
@@ -47,24 +48,39 @@ bool HelmDevice::close() {
     return TransportLinkAdapter::close();
 }
 
+bool HelmDevice::write_pwm(const uint32_t (&duty)[kChannels]) {
+    // PWM 寄存器连续排列（addrOutputAd + i*4），小端 32 位占空比
+    if (!wr32n(ADDR_OUTPUT_PWM, std::span<const uint32_t>(duty, HELM_NUM))) {
+        LOGE("helm", "pwm", -1, "write pwm failed");
+        return false;
+    }
+    return true;
+}
+
+bool HelmDevice::read_ad(uint16_t (&ad)[kChannels]) {
+    // reference 驱动按 (i+1)*4 偏移读取 16 位：每路占一个 32 位字的低半字，整字突发读回后截取
+    uint32_t words[HELM_NUM];
+    if (!rd32n(ADDR_AD_FDB, words)) {
+        LOGE("helm", "ad", -1, "read ad failed");
+        return false;
+    }
+    for (int i = 0; i < HELM_NUM; ++i) ad[i] = static_cast<uint16_t>(words[i] & 0xFFFF);
+    return true;
+}
+
+bool HelmDevice::exchange(const uint32_t (&duty)[kChannels], uint16_t (&ad)[kChannels]) {
+    return write_pwm(duty) && read_ad(ad);
+}
+
 bool HelmDevice::send(const uint8_t* data, uint32_t len) {
     // 输入数据应为 4 路 32 位占空比，总长至少 16 字节
     if (!data || len < static_cast<uint32_t>(HELM_NUM * sizeof(uint32_t))) {
         LOGE("helm", "send", -1, "invalid pwm payload len=%u", len);
         return false;
     }
-
-    // 写入 PWM duty
-    for (int i = 0; i < HELM_NUM; ++i) {
-        uint32_t duty = 0;
-        std::memcpy(&duty, data + i * sizeof(uint32_t), sizeof(uint32_t));
-        // 与测试保持一致：驱动使用小端；写入 32 位值到 addrOutputAd + i*4
-        if (!wr32(ADDR_OUTPUT_PWM + i * 4, duty)) {
-            LOGE("helm", "send", -1, "write pwm[%d] failed", i);
-            return false;
-        }
-    }
-    return true;
+    uint32_t duty[HELM_NUM];
+    std::memcpy(duty, data, sizeof(duty));
+    return write_pwm(duty);
 }
 
 int32_t HelmDevice::receive(uint8_t* buf, uint32_t buf_size) {
@@ -72,17 +88,10 @@ int32_t HelmDevice::receive(uint8_t* buf, uint32_t buf_size) {
     if (!buf || buf_size < static_cast<uint32_t>(HELM_NUM * sizeof(uint16_t))) {
         return -1;
     }
-
-    for (int i = 0; i < HELM_NUM; ++i) {
-        uint16_t ad = 0;
-        // reference 驱动按 (i+1)*4 偏移读取 16 位
-        if (!rd16((i + 1) * 4, ad)) {
-            LOGE("helm", "receive", -1, "read ad[%d] failed", i);
-            return -1;
-        }
-        std::memcpy(buf + i * sizeof(uint16_t), &ad, sizeof(uint16_t));
-    }
-    return static_cast<int32_t>(HELM_NUM * sizeof(uint16_t));
+    uint16_t ad[HELM_NUM];
+    if (!read_ad(ad)) return -1;
+    std::memcpy(buf, ad, sizeof(ad));
+    return static_cast<int32_t>(sizeof(ad));
 }
 
 int32_t HelmDevice::receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us) {
@@ -16,6 +16,8 @@ namespace Device {
 
 class HelmDevice : public MB_DDF::PhysicalLayer::Device::TransportLinkAdapter {
 public:
+    static constexpr int kChannels = 4;            // 舵机通道数
+
     // DMA 通道不使用；MTU 可由上层配置传入（建议 >= 16 以容纳 4 路 PWM）
     explicit HelmDevice(MB_DDF::PhysicalLayer::ControlPlane::IDeviceTransport& tp, uint16_t mtu)
         : TransportLinkAdapter(tp, mtu) {}
@@ -44,6 +46,11 @@ public:
     // 带 timeout 的 receive 直接调用非阻塞 receive（按需求简化）
     int32_t receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us) override;
 
+    // 控制周期单次交换：4 路 PWM 一次突发写出，随后 4 路 AD 一次突发读回（各 1 次后端调用）
+    bool exchange(const uint32_t (&duty)[kChannels], uint16_t (&ad)[kChannels]);
+    bool write_pwm(const uint32_t (&duty)[kChannels]);
+    bool read_ad(uint16_t (&ad)[kChannels]);
+
     // ioctl: 实现 ioctlHelm —— 根据配置参数完成初始化与输出使能设置
     int ioctl(uint32_t opcode, const void* in, size_t in_len, void* out = nullptr, size_t out_len = 0) override;
 
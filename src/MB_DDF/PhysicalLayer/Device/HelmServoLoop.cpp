@@ -0,0 +1,135 @@
+/**
+ * @file HelmServoLoop.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Device/HelmServoLoop.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <string>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+HelmServoLoop::HelmServoLoop(HelmDevice& dev, Options opt) : dev_(dev), opt_(opt) {
+    if (opt_.period_us == 0) opt_.period_us = 1;
+}
+
+HelmServoLoop::~HelmServoLoop() {
+    stop();
+}
+
+void HelmServoLoop::setFeedbackTopic(std::shared_ptr<DDS::Publisher> pub, uint32_t decimation) {
+    pub_ = std::move(pub);
+    decimation_ = decimation ? decimation : 1;
+}
+
+void HelmServoLoop::setCommand(const HelmCommand& cmd) {
+    std::lock_guard<std::mutex> lk(cmd_mu_);
+    cmd_.write(cmd);
+}
+
+DDS::MessageCallback HelmServoLoop::commandHandler() {
+    return [this](const void* data, size_t size, uint64_t) {
+        if (!data || size != sizeof(HelmCommand)) {
+            LOGW("helm_loop", "command", -EINVAL, "bad command size=%zu", size);
+            return;
+        }
+        HelmCommand cmd;
+        std::memcpy(&cmd, data, sizeof(cmd));
+        setCommand(cmd);
+    };
+}
+
+uint64_t HelmServoLoop::feedback(HelmFeedback& out) const {
+    fb_.read(out);
+    return out.seq;
+}
+
+bool HelmServoLoop::start() {
+    if (running()) return true;
+    io_errors_ = 0; published_ = 0; publish_failed_ = 0;
+    xchg_sum_ns_ = 0; xchg_max_ns_ = 0;
+    for (auto& b : late_hist_) b.store(0, std::memory_order_relaxed);
+    fb_.read(cycle_fb_);
+
+    Timer::SystemTimerOptions topt;
+    topt.mode = Timer::SystemTimerMode::ThreadLoop;
+    topt.sched_policy = opt_.sched_policy;
+    topt.priority = opt_.priority;
+    topt.cpu = opt_.cpu;
+    start_ns_.store(static_cast<uint64_t>(Timer::SystemTimer::monoNowNs()), std::memory_order_relaxed);
+    last_ns_.store(0, std::memory_order_relaxed);
+    try {
+        timer_ = Timer::SystemTimer::start(std::to_string(opt_.period_us) + "us",
+                                           [this](long long release_ns) { cycle(static_cast<uint64_t>(release_ns)); },
+                                           topt);
+    } catch (const std::exception& e) {
+        LOGE("helm_loop", "start", -EINVAL, "timer: %s", e.what());
+        return false;
+    }
+    LOGI("helm_loop", "start", 0, "period=%uus policy=%d prio=%d cpu=%d", opt_.period_us, opt_.sched_policy,
+         opt_.priority, opt_.cpu);
+    return true;
+}
+
+void HelmServoLoop::stop() {
+    if (timer_) timer_->stop();
+}
+
+void HelmServoLoop::cycle(uint64_t release_ns) {
+    const uint64_t wake = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());
+    const uint64_t late = wake > release_ns ? wake - release_ns : 0;
+
+    cmd_.read(cycle_cmd_);
+    if (law_) law_(cycle_fb_, cycle_cmd_);
+    cycle_fb_.seq += 1;
+    cycle_fb_.ts_ns = wake;
+    std::memcpy(cycle_fb_.duty, cycle_cmd_.duty, sizeof(cycle_fb_.duty));
+    const bool ok = dev_.exchange(cycle_cmd_.duty, cycle_fb_.ad);
+    const uint64_t done = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());
+    if (ok) {
+        fb_.write(cycle_fb_);
+    } else {
+        io_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (ok && pub_ && cycle_fb_.seq % decimation_ == 0) {
+        if (pub_->publish(&cycle_fb_, sizeof(cycle_fb_))) published_.fetch_add(1, std::memory_order_relaxed);
+        else publish_failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    late_hist_[std::min<uint64_t>(late / 1000, kLateBuckets)].fetch_add(1, std::memory_order_relaxed);
+    xchg_sum_ns_.fetch_add(done - wake, std::memory_order_relaxed);
+    if (done - wake > xchg_max_ns_.load(std::memory_order_relaxed)) xchg_max_ns_.store(done - wake, std::memory_order_relaxed);
+    last_ns_.store(done, std::memory_order_relaxed);
+}
+
+HelmServoLoop::Stats HelmServoLoop::stats() const {
+    Stats s;
+    const Timer::SystemTimerStats ts = timer_ ? timer_->stats() : Timer::SystemTimerStats{};
+    s.cycles         = ts.cycles;
+    s.missed         = ts.overruns;
+    s.io_errors      = io_errors_.load(std::memory_order_relaxed);
+    s.published      = published_.load(std::memory_order_relaxed);
+    s.publish_failed = publish_failed_.load(std::memory_order_relaxed);
+    s.late_max_ns    = ts.wake_latency_ns_max;
+    s.exchange_max_ns = xchg_max_ns_.load(std::memory_order_relaxed);
+    if (s.cycles == 0) return s;
+    s.late_mean_ns     = ts.wake_latency_ns_total / s.cycles;
+    s.exchange_mean_ns = xchg_sum_ns_.load(std::memory_order_relaxed) / s.cycles;
+    uint64_t target = s.cycles - s.cycles / 100, acc = 0;
+    for (size_t i = 0; i <= kLateBuckets; ++i) {
+        acc += late_hist_[i].load(std::memory_order_relaxed);
+        if (acc >= target) { s.late_p99_ns = static_cast<uint64_t>(i + 1) * 1000; break; }
+    }
+    const uint64_t t0 = start_ns_.load(std::memory_order_relaxed);
+    const uint64_t t1 = last_ns_.load(std::memory_order_relaxed);
+    if (t1 > t0) s.rate_hz = static_cast<double>(s.cycles) * 1e9 / static_cast<double>(t1 - t0);
+    return s;
+}
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
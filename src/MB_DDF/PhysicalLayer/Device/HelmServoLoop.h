@@ -0,0 +1,128 @@
+/**
+ * @file HelmServoLoop.h
+ * @brief 舵机高速控制环：专用线程按绝对时刻周期唤醒，每周期一次 PWM/AD 突发交换，统计唤醒抖动
+ *
+ * 设计要点：
+ * - 控制线程为 SystemTimer 的 ThreadLoop 定时线程（按绝对时刻唤醒、错过的周期跳过），不经信号上下文；
+ *   可设调度策略与绑核。
+ * - 命令与反馈均为双缓冲（Support::DoubleBuffer）：任意线程 setCommand() 不阻塞控制环，
+ *   控制环每周期取最新完整命令；feedback() 读最新完整反馈。
+ * - 命令可直接来自 DDS Topic（commandHandler() 作为订阅回调），反馈可按抽取比发布到 DDS Topic，
+ *   线格式即 HelmCommand / HelmFeedback 结构本身。
+ * - 设置 ControlLaw 时在控制线程中以上一周期反馈计算本周期命令（写-读同一突发，固有一拍延迟）。
+ * - 统计：唤醒迟到（相对计划时刻）均值/P99/最大值、交换耗时、错过的周期数与实际频率。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/Device/HelmDevice.h"
+#include "MB_DDF/PhysicalLayer/Support/DoubleBuffer.h"
+#include "MB_DDF/DDS/Publisher.h"
+#include "MB_DDF/DDS/Subscriber.h"
+#include "MB_DDF/Timer/SystemTimer.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sched.h>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+struct HelmCommand {
+    uint32_t duty[HelmDevice::kChannels] = {0, 0, 0, 0};
+};
+
+struct HelmFeedback {
+    uint64_t seq = 0;                                 // 控制周期序号
+    uint64_t ts_ns = 0;                               // 本周期唤醒时刻（CLOCK_MONOTONIC）
+    uint16_t ad[HelmDevice::kChannels] = {0, 0, 0, 0};
+    uint32_t duty[HelmDevice::kChannels] = {0, 0, 0, 0};  // 本周期写出的占空比
+};
+
+class HelmServoLoop {
+public:
+    struct Options {
+        uint32_t period_us = 250;
+        int sched_policy = SCHED_OTHER;               // SCHED_FIFO/RR 需相应权限，失败时沿用默认调度
+        int priority = 0;
+        int cpu = -1;                                 // 绑核编号，-1 表示不绑核
+    };
+
+    struct Stats {
+        uint64_t cycles = 0;
+        uint64_t missed = 0;                          // 因超时跳过的周期数
+        uint64_t io_errors = 0;
+        uint64_t published = 0;
+        uint64_t publish_failed = 0;
+        uint64_t late_mean_ns = 0;                    // 唤醒迟到
+        uint64_t late_p99_ns = 0;                     // 按 1us 分桶统计，超出量程记为量程上限
+        uint64_t late_max_ns = 0;
+        uint64_t exchange_mean_ns = 0;                // PWM/AD 突发交换耗时
+        uint64_t exchange_max_ns = 0;
+        double   rate_hz = 0;                         // 实际控制频率
+    };
+
+    // 在控制线程中执行：fb 为上一周期反馈，cmd 入参为最新外部命令，可原地修改
+    using ControlLaw = std::function<void(const HelmFeedback& fb, HelmCommand& cmd)>;
+
+    explicit HelmServoLoop(HelmDevice& dev) : HelmServoLoop(dev, Options{}) {}
+    HelmServoLoop(HelmDevice& dev, Options opt);
+    ~HelmServoLoop();
+
+    HelmServoLoop(const HelmServoLoop&) = delete;
+    HelmServoLoop& operator=(const HelmServoLoop&) = delete;
+
+    // 以下两项须在 start() 前设置
+    void setControlLaw(ControlLaw law) { law_ = std::move(law); }
+    void setFeedbackTopic(std::shared_ptr<DDS::Publisher> pub, uint32_t decimation = 1);
+
+    // 任意线程更新命令（多个写者之间串行），不阻塞控制环
+    void setCommand(const HelmCommand& cmd);
+    // DDS 订阅回调：消息长度须等于 sizeof(HelmCommand)
+    DDS::MessageCallback commandHandler();
+
+    // 读最新反馈，返回周期序号（0 表示尚未运行）
+    uint64_t feedback(HelmFeedback& out) const;
+
+    bool start();
+    void stop();
+    bool running() const { return timer_ && timer_->isRunning(); }
+
+    Stats stats() const;
+
+private:
+    static constexpr size_t kLateBuckets = 1000;      // 迟到直方图量程 1ms（1us 分桶）
+
+    void cycle(uint64_t release_ns);
+
+    HelmDevice& dev_;
+    Options opt_;
+    ControlLaw law_;
+    std::shared_ptr<DDS::Publisher> pub_;
+    uint32_t decimation_ = 1;
+
+    Support::DoubleBuffer<HelmCommand> cmd_;
+    Support::DoubleBuffer<HelmFeedback> fb_;
+    std::mutex cmd_mu_;                               // 命令写者串行
+
+    std::unique_ptr<Timer::SystemTimer> timer_;       // 周期、迟到与跳过周期由定时器统计
+    HelmCommand cycle_cmd_;                           // 以下两项仅由控制线程访问
+    HelmFeedback cycle_fb_;
+
+    std::atomic<uint64_t> io_errors_{0};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> publish_failed_{0};
+    std::atomic<uint64_t> xchg_sum_ns_{0};
+    std::atomic<uint64_t> xchg_max_ns_{0};
+    std::atomic<uint64_t> start_ns_{0};
+    std::atomic<uint64_t> last_ns_{0};
+    std::array<std::atomic<uint32_t>, kLateBuckets + 1> late_hist_{};
+};
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -93,28 +93,12 @@ bool Rs422Device::send(const uint8_t* data, uint32_t len) {
     // 限制长度至 255（与参考实现一致）
     uint8_t sendlen = static_cast<uint8_t>(len > 255 ? 255 : len);
 
-    // 写入首 4 字节：长度 + 前 3 字节数据
-    uint8_t first4[4] = { sendlen, 0, 0, 0 };
-    if (sendlen >= 1) first4[1] = data[0];
-    if (sendlen >= 2) first4[2] = data[1];
-    if (sendlen >= 3) first4[3] = data[2];
-    uint32_t word0 = 0;
-    std::memcpy(&word0, first4, sizeof(word0));
+    // BRAM 布局：长度字节后紧跟数据，按 4 字节整字写入（尾部补零）。
+    // 首字 = 长度 + 前 3 字节单独拼装；其后 data[3..] 恰好落在字边界，直接从调用方缓冲突发写出，无需本地拼帧
+    uint32_t word0 = sendlen;
+    for (uint32_t i = 0; i < 3 && i < sendlen; ++i) word0 |= static_cast<uint32_t>(data[i]) << (8 * (i + 1));
     if (!wr32(SEND_BUF, word0)) return false;
-
-    // 写入余下数据：从 data[3] 开始，以 4 字节对齐写入到 SEND_BUF + 4, 8, ...
-    uint32_t bram_offset = 4;
-    while (bram_offset <= sendlen) {
-        uint32_t w = 0;
-        // 组装 4 字节（不足补零）
-        for (int i = 0; i < 4; ++i) {
-            uint32_t idx = bram_offset + i - 1; // 注意参考实现对齐方式（-1）
-            uint8_t b = (idx < sendlen) ? data[idx] : 0;
-            w |= (static_cast<uint32_t>(b) << (8 * i));
-        }
-        if (!wr32(SEND_BUF + bram_offset, w)) return false;
-        bram_offset += 4;
-    }
+    if (sendlen > 3 && !wrblk(SEND_BUF + 4, data + 3, sendlen - 3u)) return false;
 
     // 写入发送命令
     if (!wr32(CMD_reg, CMD_TX)) return false;
@@ -152,32 +136,19 @@ int32_t Rs422Device::receive(uint8_t* buf, uint32_t buf_size) {
     // 读取首 4 字节：长度 + 前 3 字节数据
     uint32_t word0 = 0;
     if (!rd32(RECV_BUF, word0)) return -1;
-    uint8_t first4[4];
-    std::memcpy(first4, &word0, sizeof(word0));
-    uint32_t reallen = first4[0];
+    uint32_t reallen = word0 & 0xFF;
     if (reallen == 0) return 0;
     uint32_t out_len = reallen < buf_size ? reallen : buf_size;
 
-    // 将前 3 字节数据写入到输出缓冲区（去除第一个长度字节）
-    uint32_t produced = 0;
-    if (out_len >= 1) { buf[0] = first4[1]; produced = 1; }
-    if (out_len >= 2) { buf[1] = first4[2]; produced = 2; }
-    if (out_len >= 3) { buf[2] = first4[3]; produced = 3; }
-
-    // 读取余下数据：以 4 字节为单位从 RECV_BUF + 4 开始，照参考实现对齐（-1）
-    uint32_t bram_offset = 4;
-    while (produced < out_len) {
-        uint32_t w = 0;
-        if (!rd32(RECV_BUF + bram_offset, w)) break;
-        uint8_t bytes[4];
-        std::memcpy(bytes, &w, sizeof(w));
-        // 按参考实现，将 4 字节写入到 buf[produced-1 ... produced+2]
-        for (int i = 0; i < 4 && produced < out_len; ++i) {
-            // 对齐偏移：第一个字节应写到 produced（已写 3 个字节后相当于 data[3] 开始）
-            buf[produced] = bytes[i];
-            ++produced;
-        }
-        bram_offset += 4;
+    // 将前 3 字节数据写入到输出缓冲区（去除第一个长度字节）；小端下即 word0 的高 3 字节
+    uint32_t produced = out_len < 3 ? out_len : 3;
+    word0 >>= 8;
+    std::memcpy(buf, &word0, produced);
+
+    // 余下数据紧随其后（RECV_BUF + 4 起），一次突发读出
+    if (produced < out_len) {
+        if (!rdblk(RECV_BUF + 4, buf + produced, out_len - produced)) return static_cast<int32_t>(produced);
+        produced = out_len;
     }
 
     return static_cast<int32_t>(produced);
@@ -202,19 +173,14 @@ int32_t Rs422Device::receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_u
         return receive(buf, buf_size);
     }
 
-    // 如果没有绑定 event 则轮询：每 100us 检查一次状态，直到超时或有数据
-    const uint32_t step_us = 100;
-    uint32_t waited = 0;
-    while (waited <= timeout_us) {
+    // 如果没有绑定 event 则轮询状态位：先连续检查数次，之后指数退避（单次不超过 100us），直到超时或有数据
+    int rc = pollUntil([&]() -> int {
         uint8_t stu = 0;
-        if (!rd8(STU_reg, stu)) return -1;
-        if ((stu & STU_RX_READY_MASK) != 0) {
-            return receive(buf, buf_size);
-        }
-        usleep(step_us);
-        waited += step_us;
-    }
-    return 0; // 超时
+        if (!rd8(STU_reg, stu)) return -EIO;
+        return (stu & STU_RX_READY_MASK) != 0 ? 1 : 0;
+    }, timeout_us, 100);
+    if (rc == 0) return receive(buf, buf_size);
+    return rc == -ETIMEDOUT ? 0 : -1; // 0 超时；-1 错误
 }
 
 int Rs422Device::ioctl(uint32_t opcode, const void* in, size_t in_len, void* out, size_t out_len) {
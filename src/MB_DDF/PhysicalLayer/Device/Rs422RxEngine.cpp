@@ -0,0 +1,217 @@
+/**
+ * @file Rs422RxEngine.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Device/Rs422RxEngine.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include "MB_DDF/Timer/SystemTimer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+Rs422RxEngine::Rs422RxEngine(Rs422Device& dev, size_t depth) : dev_(dev) {
+    size_t cap = 2;
+    while (cap < depth) cap <<= 1;
+    mask_ = cap - 1;
+    ring_.reset(new Frame[cap]);
+    data_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (data_fd_ < 0) {
+        LOGE("rs422_rx", "init", errno, "eventfd failed");
+    }
+}
+
+Rs422RxEngine::~Rs422RxEngine() {
+    stop();
+    if (data_fd_ >= 0) { ::close(data_fd_); data_fd_ = -1; }
+}
+
+int Rs422RxEngine::drain(uint64_t ts_ns) {
+    int total = 0;
+    int err_streak = 0;
+    for (;;) {
+        const size_t h = head_.load(std::memory_order_relaxed);
+        const size_t t = tail_.load(std::memory_order_acquire);
+        const bool full = h - t > mask_;
+        Frame& slot = full ? scratch_ : ring_[h & mask_];
+        int32_t n = dev_.receive(slot.data, kMaxPayload);
+        if (n < 0) {
+            // 设备已在 receive 中清除 ERR；连续出错则留待下次事件
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            if (++err_streak > 1) break;
+            continue;
+        }
+        if (n == 0) break;
+        err_streak = 0;
+        if (full) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        slot.len = static_cast<uint16_t>(n);
+        slot.ts_ns = ts_ns;
+        head_.store(h + 1, std::memory_order_release);
+        ++total;
+        size_t d = h + 1 - t;
+        if (d > high_water_.load(std::memory_order_relaxed)) high_water_.store(d, std::memory_order_relaxed);
+    }
+    if (total > 0) {
+        frames_.fetch_add(static_cast<uint64_t>(total), std::memory_order_relaxed);
+        uint64_t cnt = static_cast<uint64_t>(total);
+        ssize_t ret = ::write(data_fd_, &cnt, sizeof(cnt));
+        (void)ret;
+    }
+    return err_streak > 1 && total == 0 ? -EIO : total;
+}
+
+int Rs422RxEngine::onEvent(uint32_t bitmap) {
+    (void)bitmap;   // 接收状态以 STU 为准，位图仅用于唤醒
+    const uint64_t ts = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());
+    events_.fetch_add(1, std::memory_order_relaxed);
+    return drain(ts);
+}
+
+bool Rs422RxEngine::start() {
+    if (running()) return true;
+    if (data_fd_ < 0) return false;
+    if (!waiter_.open(dev_.transport().getEventFd())) {
+        LOGE("rs422_rx", "start", errno, "eventfd failed");
+        return false;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread([this]() { worker_loop(); });
+    LOGI("rs422_rx", "start", 0, "capacity=%zu event_fd=%d", mask_ + 1, dev_.transport().getEventFd());
+    return true;
+}
+
+void Rs422RxEngine::stop() {
+    if (worker_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        waiter_.wake();
+        worker_.join();
+    }
+    waiter_.close();
+}
+
+bool Rs422RxEngine::attach(EventMultiplexer& mux) {
+    auto& tp = dev_.transport();
+    const int ev_fd = tp.getEventFd();
+    if (ev_fd < 0 || data_fd_ < 0) return false;
+    bool ok = mux.add(ev_fd, EPOLLIN, [this, &tp](int, uint32_t) {
+        const uint64_t ts = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());
+        uint32_t bitmap = 0;
+        if (tp.waitEvent(&bitmap, 0) > 0) {
+            events_.fetch_add(1, std::memory_order_relaxed);
+            (void)drain(ts);
+        }
+    });
+    if (!ok) {
+        LOGE("rs422_rx", "attach", errno, "event_fd=%d", ev_fd);
+        return false;
+    }
+    attached_fd_ = ev_fd;
+    (void)onEvent(0);
+    return true;
+}
+
+void Rs422RxEngine::detach(EventMultiplexer& mux) {
+    if (attached_fd_ >= 0) {
+        mux.remove(attached_fd_);
+        attached_fd_ = -1;
+    }
+}
+
+void Rs422RxEngine::worker_loop() {
+    auto& tp = dev_.transport();
+    (void)onEvent(0);
+    while (!stop_.load(std::memory_order_acquire)) {
+        auto res = waiter_.wait();
+        const uint64_t ts = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());  // 先取时间戳，再读事件与寄存器
+        if (res == DDS::ReadyWaiter::Result::Error) {
+            LOGE("rs422_rx", "poll", errno, "worker exit");
+            break;
+        }
+        if (res == DDS::ReadyWaiter::Result::Ready) {
+            uint32_t bitmap = 0;
+            if (tp.waitEvent(&bitmap, 0) > 0) {
+                events_.fetch_add(1, std::memory_order_relaxed);
+                (void)drain(ts);
+            }
+        } else if (res == DDS::ReadyWaiter::Result::Timeout && !waiter_.hasReadyFd()) {
+            events_.fetch_add(1, std::memory_order_relaxed);
+            (void)drain(ts);
+        }
+    }
+}
+
+bool Rs422RxEngine::pop(Frame& out) {
+    const Frame* f = front();
+    if (!f) return false;
+    out.ts_ns = f->ts_ns;
+    out.len = f->len;
+    std::memcpy(out.data, f->data, f->len);
+    release();
+    return true;
+}
+
+const Rs422RxEngine::Frame* Rs422RxEngine::front() const {
+    const size_t t = tail_.load(std::memory_order_relaxed);
+    if (t == head_.load(std::memory_order_acquire)) return nullptr;
+    return &ring_[t & mask_];
+}
+
+void Rs422RxEngine::release() {
+    const size_t t = tail_.load(std::memory_order_relaxed);
+    if (t != head_.load(std::memory_order_acquire)) tail_.store(t + 1, std::memory_order_release);
+}
+
+int32_t Rs422RxEngine::read(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us, uint64_t* ts_ns) {
+    if (!buf || buf_size == 0) return -EINVAL;
+    const uint64_t deadline = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs()) + static_cast<uint64_t>(timeout_us) * 1000;
+    for (;;) {
+        if (const Frame* f = front()) {
+            uint32_t n = std::min<uint32_t>(f->len, buf_size);
+            std::memcpy(buf, f->data, n);
+            if (ts_ns) *ts_ns = f->ts_ns;
+            release();
+            return static_cast<int32_t>(n);
+        }
+        const uint64_t now = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());
+        if (now >= deadline) return 0;
+        const uint64_t left = deadline - now;
+        struct timespec to{static_cast<time_t>(left / 1000000000ull), static_cast<long>(left % 1000000000ull)};
+        struct pollfd pfd{data_fd_, POLLIN, 0};
+        int ret = ::ppoll(&pfd, 1, &to, nullptr);
+        if (ret < 0 && errno != EINTR) return -errno;
+        if (ret > 0) {
+            uint64_t cnt = 0;
+            ssize_t r = ::read(data_fd_, &cnt, sizeof(cnt));
+            (void)r;
+        }
+    }
+}
+
+size_t Rs422RxEngine::depth() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+Rs422RxEngine::Stats Rs422RxEngine::stats() const {
+    Stats s;
+    s.events     = events_.load(std::memory_order_relaxed);
+    s.frames     = frames_.load(std::memory_order_relaxed);
+    s.dropped    = dropped_.load(std::memory_order_relaxed);
+    s.errors     = errors_.load(std::memory_order_relaxed);
+    s.depth      = depth();
+    s.high_water = high_water_.load(std::memory_order_relaxed);
+    s.capacity   = mask_ + 1;
+    return s;
+}
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
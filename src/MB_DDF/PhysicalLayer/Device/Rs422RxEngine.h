@@ -0,0 +1,108 @@
+/**
+ * @file Rs422RxEngine.h
+ * @brief RS422 接收引擎：中断驱动排空接收 BRAM，帧连同唤醒时间戳写入预分配 SPSC 帧环
+ *
+ * 设计要点：
+ * - 生产者（接收线程或外部事件循环）在中断到来时立即记录 CLOCK_MONOTONIC 时间戳，随后循环
+ *   读帧直到 STU 无数据；帧直接读入环中槽位，热路径不分配内存、不拷贝。
+ * - 消费者只访问帧环：pop()/front()+release() 或带超时的 read()，不触碰寄存器；
+ *   getEventFd() 返回帧环的可读 eventfd，可注册到 epoll 与其他 fd 一同等待。
+ * - 环满时新帧仍从硬件读出（释放 BRAM），计入 dropped 后丢弃。
+ * - start() 启动独立接收线程独占传输层事件 fd；多个端口共用一个事件循环时改用 attach(mux)。
+ *   引擎运行期间不应再直接调用设备的 receive。
+ * - 单生产者单消费者：pop/front/release/read 只能在同一个消费者线程中调用。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/Device/Rs422Device.h"
+#include "MB_DDF/DDS/ReadyWaiter.h"
+#include "MB_DDF/PhysicalLayer/EventMultiplexer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+class Rs422RxEngine {
+public:
+    static constexpr uint32_t kMaxPayload = 255;    // 长度字节上限
+
+    struct Frame {
+        uint64_t ts_ns = 0;         // 中断唤醒时刻（CLOCK_MONOTONIC，同一次排空的帧共用）
+        uint16_t len = 0;
+        uint8_t  data[kMaxPayload];
+    };
+
+    struct Stats {
+        uint64_t events = 0;        // 处理的中断/轮询唤醒数
+        uint64_t frames = 0;        // 写入帧环的帧数
+        uint64_t dropped = 0;       // 环满丢弃的帧数
+        uint64_t errors = 0;        // 设备返回错误的次数
+        size_t   depth = 0;         // 当前环内帧数
+        size_t   high_water = 0;
+        size_t   capacity = 0;
+    };
+
+    // depth 向上取整为 2 的幂
+    explicit Rs422RxEngine(Rs422Device& dev, size_t depth = 64);
+    ~Rs422RxEngine();
+
+    Rs422RxEngine(const Rs422RxEngine&) = delete;
+    Rs422RxEngine& operator=(const Rs422RxEngine&) = delete;
+
+    // 独立接收线程：传输层无事件 fd 时退化为 1ms 周期排空
+    bool start();
+    void stop();
+    bool running() const { return worker_.joinable(); }
+
+    // 共用事件循环：注册传输层事件 fd，回调中消费事件并排空；返回 false 表示无事件 fd 或注册失败
+    bool attach(EventMultiplexer& mux);
+    void detach(EventMultiplexer& mux);
+
+    // 生产者入口（外部事件循环使用）：以当前时刻为时间戳排空接收 BRAM，返回入环帧数，<0 表示设备错误
+    int onEvent(uint32_t bitmap = 0);
+
+    // 消费者接口
+    bool pop(Frame& out);
+    const Frame* front() const;                   // 零拷贝查看队首，空返回 nullptr
+    void release();                               // 释放 front() 返回的帧
+    // 取一帧负载：返回字节数（超出 buf_size 截断），0 超时，<0 错误；ts_ns 可选输出时间戳
+    int32_t read(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us, uint64_t* ts_ns = nullptr);
+    // 帧环可读 eventfd（有新帧时可读；消费者读取前无需清零，read() 内部处理）
+    int getEventFd() const { return data_fd_; }
+
+    size_t depth() const;
+    Stats stats() const;
+
+private:
+    int drain(uint64_t ts_ns);
+    void worker_loop();
+
+    Rs422Device& dev_;
+    std::unique_ptr<Frame[]> ring_;
+    size_t mask_;
+    Frame scratch_;                                // 环满时的丢弃槽
+
+    alignas(64) std::atomic<size_t> head_{0};      // 生产者写位置
+    alignas(64) std::atomic<size_t> tail_{0};      // 消费者读位置
+
+    std::thread worker_;
+    DDS::ReadyWaiter waiter_;
+    int data_fd_{-1};
+    int attached_fd_{-1};
+    std::atomic<bool> stop_{false};
+
+    std::atomic<uint64_t> events_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<size_t> high_water_{0};
+};
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,408 @@
+/**
+ * @file SimDeviceModels.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Device/SimDeviceModels.h"
+#include "MB_DDF/PhysicalLayer/Device/CanFdDevice.h"
+#include "MB_DDF/PhysicalLayer/Hardware/pl_can.h"
+#include "MB_DDF/PhysicalLayer/Hardware/pl_canfd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+using ControlPlane::SimTransport;
+
+namespace {
+// RS422 寄存器（与 Rs422Device.cpp 一致）
+constexpr uint64_t RS422_RECV_BUF = 0x000;
+constexpr uint64_t RS422_SEND_BUF = 0x100;
+constexpr uint64_t RS422_CMD_reg  = 0x300;
+constexpr uint64_t RS422_ERR_reg  = 0x304;
+constexpr uint32_t RS422_STU_RX_READY = 0x01;
+constexpr uint32_t RS422_STU_TX_READY = 0x02;
+constexpr uint32_t RS422_CMD_TX = 0x81;
+constexpr uint32_t RS422_CMD_RX = 0x82;
+
+// 舵机寄存器（与 HelmDevice.cpp 一致）
+constexpr uint64_t HELM_OUTPUT_PWM = 0xBC * 4;
+constexpr int HELM_NUM = 4;
+
+// CAN 寄存器区清零范围
+constexpr uint64_t XCAN_REG_END = 0x84;
+constexpr uint64_t XCANFD_REG_END = 0x4100;
+} // namespace
+
+// ---------------------------------------------------------------------------
+// RS422
+// ---------------------------------------------------------------------------
+
+void Rs422LoopbackModel::reset(SimTransport& tp) {
+    rx_.clear();
+    rx_ready_ = false;
+    stats_ = Stats{};
+    tp.poke32(RS422_ERR_reg, 0);
+    update_status(tp, SimTransport::now_ns());
+}
+
+void Rs422LoopbackModel::update_status(SimTransport& tp, uint64_t now_ns) {
+    bool ready = !rx_.empty() && rx_.front().ready_ns <= now_ns;
+    uint32_t stu = RS422_STU_TX_READY | (ready ? RS422_STU_RX_READY : 0);
+    tp.poke32(RS422_CMD_reg, stu);
+    if (ready && !rx_ready_) tp.raiseEvent(0x1);
+    rx_ready_ = ready;
+}
+
+void Rs422LoopbackModel::push(SimTransport& tp, std::vector<uint8_t> bytes) {
+    uint64_t now = SimTransport::now_ns();
+    if (rx_.size() >= depth_) {
+        ++stats_.overflows;
+    } else {
+        rx_.push_back(Frame{now + latency_ns_, std::move(bytes)});
+    }
+    update_status(tp, now);
+}
+
+void Rs422LoopbackModel::inject(SimTransport& tp, const uint8_t* data, uint8_t len) {
+    std::vector<uint8_t> bytes(static_cast<size_t>(len) + 1);
+    bytes[0] = len;
+    if (len) std::memcpy(bytes.data() + 1, data, len);
+    push(tp, std::move(bytes));
+}
+
+void Rs422LoopbackModel::onWrite(SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) {
+    if (offset != RS422_CMD_reg || width != 4) return;
+    uint64_t now = SimTransport::now_ns();
+    if (value == RS422_CMD_TX) {
+        // 发送 BRAM：首字节为长度，其后为数据
+        uint8_t len = tp.peek8(RS422_SEND_BUF);
+        std::vector<uint8_t> bytes(static_cast<size_t>(len) + 1);
+        for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = tp.peek8(RS422_SEND_BUF + i);
+        ++stats_.tx_frames;
+        push(tp, std::move(bytes));
+        return;
+    }
+    if (value == RS422_CMD_RX) {
+        if (!rx_.empty() && rx_.front().ready_ns <= now) {
+            const auto& bytes = rx_.front().bytes;
+            size_t padded = (bytes.size() + 3) & ~static_cast<size_t>(3);
+            for (size_t i = 0; i < padded; ++i) tp.poke8(RS422_RECV_BUF + i, i < bytes.size() ? bytes[i] : 0);
+            rx_.pop_front();
+            ++stats_.rx_frames;
+        } else {
+            tp.poke8(RS422_RECV_BUF, 0);
+        }
+        rx_ready_ = false;  // 下一帧就绪时重新触发事件
+    }
+    update_status(tp, now);
+}
+
+void Rs422LoopbackModel::tick(SimTransport& tp, uint64_t now_ns) {
+    if (latency_ns_ == 0 || rx_.empty()) return;
+    update_status(tp, now_ns);
+}
+
+// ---------------------------------------------------------------------------
+// AXI CAN
+// ---------------------------------------------------------------------------
+
+void CanLoopbackModel::reset(SimTransport& tp) {
+    for (uint64_t off = 0; off < XCAN_REG_END; off += 4) tp.poke32(off, 0);
+    rx_head_ = 0;
+    rx_count_ = 0;
+    enabled_ = false;
+    stats_ = Stats{};
+    tp.poke32(XCAN_SR_OFFSET, XCAN_SR_CONFIG_MASK);
+}
+
+void CanLoopbackModel::update_mode(SimTransport& tp) {
+    uint32_t sr = tp.peek32(XCAN_SR_OFFSET) & ~(XCAN_SR_CONFIG_MASK | XCAN_SR_LBACK_MASK | XCAN_SR_SLEEP_MASK | XCAN_SR_NORMAL_MASK);
+    if (!enabled_) {
+        sr |= XCAN_SR_CONFIG_MASK;
+    } else {
+        uint32_t msr = tp.peek32(XCAN_MSR_OFFSET);
+        if (msr & XCAN_MSR_LBACK_MASK) sr |= XCAN_SR_LBACK_MASK;
+        else if (msr & XCAN_MSR_SLEEP_MASK) sr |= XCAN_SR_SLEEP_MASK;
+        else sr |= XCAN_SR_NORMAL_MASK;
+    }
+    tp.poke32(XCAN_SR_OFFSET, sr);
+}
+
+void CanLoopbackModel::update_tx_full(SimTransport& tp) {
+    uint32_t sr = tp.peek32(XCAN_SR_OFFSET) & ~XCAN_SR_TXFLL_MASK;
+    if (rx_count_ >= depth_) sr |= XCAN_SR_TXFLL_MASK;
+    tp.poke32(XCAN_SR_OFFSET, sr);
+}
+
+void CanLoopbackModel::load_head(SimTransport& tp) {
+    uint32_t isr = tp.peek32(XCAN_ISR_OFFSET);
+    if (rx_count_ == 0) {
+        tp.poke32(XCAN_ISR_OFFSET, isr & ~XCAN_ISR_RXOK_MASK);
+        return;
+    }
+    const Regs& r = rx_[rx_head_];
+    tp.poke32(XCAN_RX_ID_OFFSET, r[0]);
+    tp.poke32(XCAN_RX_DLC_OFFSET, r[1]);
+    tp.poke32(XCAN_RX_DW1_OFFSET, r[2]);
+    tp.poke32(XCAN_RX_DW2_OFFSET, r[3]);
+    tp.poke32(XCAN_ISR_OFFSET, isr | XCAN_ISR_RXOK_MASK);
+}
+
+void CanLoopbackModel::push(SimTransport& tp, const Regs& r) {
+    if (rx_count_ >= depth_) {
+        ++stats_.overflows;
+        return;
+    }
+    rx_[(rx_head_ + rx_count_) % depth_] = r;
+    if (++rx_count_ == 1) load_head(tp);
+    update_tx_full(tp);
+    if (tp.peek32(XCAN_IER_OFFSET) & XCAN_IER_RXOK_MASK) tp.raiseEvent(0x1);
+}
+
+void CanLoopbackModel::inject(SimTransport& tp, uint32_t id, uint8_t dlc, const uint8_t* data) {
+    Regs r{};
+    r[0] = (id & XCAN_ID_STD_MASK) << XCAN_ID_STD_SHIFT;
+    r[1] = static_cast<uint32_t>(dlc & XCAN_DLC_MASK) << XCAN_DLC_SHIFT;
+    for (int i = 0; i < 8 && i < dlc; ++i) {
+        r[2 + i / 4] |= static_cast<uint32_t>(data[i]) << (8 * (3 - (i % 4)));
+    }
+    push(tp, r);
+}
+
+void CanLoopbackModel::onWrite(SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) {
+    (void)width;
+    switch (offset) {
+    case XCAN_SRR_OFFSET:
+        if (value & XCAN_SRR_SRST_MASK) {
+            reset(tp);  // SRST 自动清零
+            return;
+        }
+        enabled_ = (value & XCAN_SRR_CEN_MASK) != 0;
+        update_mode(tp);
+        break;
+    case XCAN_MSR_OFFSET:
+        update_mode(tp);
+        break;
+    case XCAN_ICR_OFFSET: {
+        uint32_t isr = tp.peek32(XCAN_ISR_OFFSET) & ~value;
+        if (rx_count_ != 0) isr |= XCAN_ISR_RXOK_MASK;
+        tp.poke32(XCAN_ISR_OFFSET, isr);
+        tp.poke32(XCAN_ICR_OFFSET, 0);
+        break;
+    }
+    case XCAN_TX_DW2_OFFSET: {
+        // 写 DW2 即提交发送
+        Regs r{ tp.peek32(XCAN_TX_ID_OFFSET), tp.peek32(XCAN_TX_DLC_OFFSET), tp.peek32(XCAN_TX_DW1_OFFSET), value };
+        ++stats_.tx_frames;
+        tp.poke32(XCAN_ISR_OFFSET, tp.peek32(XCAN_ISR_OFFSET) | XCAN_ISR_TXOK_MASK);
+        bool loop = enabled_ && (tp.peek32(XCAN_MSR_OFFSET) & XCAN_MSR_LBACK_MASK);
+        if (loop || echo_always_) push(tp, r);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void CanLoopbackModel::onRead(SimTransport& tp, uint64_t offset, unsigned width) {
+    (void)width;
+    // 读 RX DW2 使 FIFO 读指针前进
+    if (offset != XCAN_RX_DW2_OFFSET || rx_count_ == 0) return;
+    rx_head_ = (rx_head_ + 1) % depth_;
+    --rx_count_;
+    ++stats_.rx_frames;
+    load_head(tp);
+    update_tx_full(tp);
+}
+
+// ---------------------------------------------------------------------------
+// AXI CAN-FD
+// ---------------------------------------------------------------------------
+
+void CanFdLoopbackModel::reset(SimTransport& tp) {
+    size_t end = std::min<size_t>(XCANFD_REG_END, tp.getMappedLength());
+    for (uint64_t off = 0; off + 4 <= end; off += 4) tp.poke32(off, 0);
+    enabled_ = false;
+    trr_pending_ = 0;
+    read_idx_ = 0;
+    fill_ = 0;
+    stats_ = Stats{};
+    tp.poke32(XCANFD_SR_OFFSET, XCANFD_SR_CONFIG_MASK);
+}
+
+void CanFdLoopbackModel::update_mode(SimTransport& tp) {
+    uint32_t sr = 0;
+    if (!enabled_) {
+        sr = XCANFD_SR_CONFIG_MASK;
+    } else {
+        uint32_t msr = tp.peek32(XCANFD_MSR_OFFSET);
+        if (msr & XCANFD_MSR_SLEEP_MASK) sr = XCANFD_SR_SLEEP_MASK;
+        else if (msr & XCANFD_MSR_LBACK_MASK) sr = XCANFD_SR_LBACK_MASK;
+        else if (msr & XCANFD_MSR_SNOOP_MASK) sr = XCANFD_SR_NORMAL_MASK | XCANFD_SR_SNOOP_MASK;
+        else sr = XCANFD_SR_NORMAL_MASK;
+    }
+    tp.poke32(XCANFD_SR_OFFSET, sr);
+}
+
+void CanFdLoopbackModel::update_fifo(SimTransport& tp) {
+    tp.poke32(XCANFD_FSR_OFFSET, ((fill_ << XCANFD_FSR_FL_0_SHIFT) & XCANFD_FSR_FL_MASK) | (read_idx_ & XCANFD_FSR_RI_MASK));
+    uint32_t isr = tp.peek32(XCANFD_ISR_OFFSET);
+    isr = fill_ ? (isr | XCANFD_IXR_RXOK_MASK) : (isr & ~XCANFD_IXR_RXOK_MASK);
+    tp.poke32(XCANFD_ISR_OFFSET, isr);
+}
+
+bool CanFdLoopbackModel::accept(SimTransport& tp, uint32_t id_reg) const {
+    uint32_t afr = tp.peek32(XCANFD_AFR_OFFSET);
+    if (afr == 0) return true;
+    for (uint32_t i = 0; i < MAX_FILTER_INDEX; ++i) {
+        if (!(afr & (1u << i))) continue;
+        uint32_t mask = tp.peek32(XCANFD_AFMR_OFFSET(i));
+        if ((id_reg & mask) == (tp.peek32(XCANFD_AFIDR_OFFSET(i)) & mask)) return true;
+    }
+    return false;
+}
+
+void CanFdLoopbackModel::push(SimTransport& tp, uint32_t id_reg, uint32_t dlc_reg, const uint32_t* words, uint32_t nwords) {
+    if (!accept(tp, id_reg)) {
+        ++stats_.filtered;
+        return;
+    }
+    if (fill_ >= kRxDepth) {
+        ++stats_.overflows;
+        return;
+    }
+    uint32_t slot = (read_idx_ + fill_) % kRxDepth;
+    tp.poke32(XCANFD_RXID_OFFSET(slot), id_reg);
+    tp.poke32(XCANFD_RXDLC_OFFSET(slot), dlc_reg);
+    for (uint32_t i = 0; i < nwords; ++i) tp.poke32(XCANFD_RXDW_OFFSET(slot) + i * XCANFD_DW_BYTES, words[i]);
+    ++fill_;
+    update_fifo(tp);
+    tp.raiseEvent(0x1);
+}
+
+void CanFdLoopbackModel::transmit(SimTransport& tp, uint32_t idx) {
+    uint32_t id_reg = tp.peek32(XCANFD_TXID_OFFSET(idx));
+    uint32_t dlc_reg = tp.peek32(XCANFD_TXDLC_OFFSET(idx));
+    uint8_t dlc = static_cast<uint8_t>((dlc_reg & XCANFD_DLCR_DLC_MASK) >> XCANFD_DLCR_DLC_SHIFT);
+    uint32_t nwords = (CanFDDevice::dlc_to_len(dlc) + 3) / 4;
+    uint32_t words[16];
+    for (uint32_t i = 0; i < nwords; ++i) words[i] = tp.peek32(XCANFD_TXDW_OFFSET(idx) + i * XCANFD_DW_BYTES);
+    ++stats_.tx_frames;
+    tp.poke32(XCANFD_ISR_OFFSET, tp.peek32(XCANFD_ISR_OFFSET) | XCANFD_IXR_TXOK_MASK);
+    if (enabled_) push(tp, id_reg, dlc_reg, words, nwords);
+}
+
+void CanFdLoopbackModel::tick(SimTransport& tp, uint64_t now_ns) {
+    if (frame_time_ns_ == 0) return;
+    uint32_t trr = trr_pending_;
+    if (trr == 0) return;
+    bool done = false;
+    while (trr != 0 && now_ns >= bus_free_ns_ + frame_time_ns_) {
+        uint32_t idx = static_cast<uint32_t>(__builtin_ctz(trr));
+        transmit(tp, idx);
+        trr &= trr - 1;
+        bus_free_ns_ += frame_time_ns_;
+        done = true;
+    }
+    trr_pending_ = trr;
+    tp.poke32(XCANFD_TRR_OFFSET, trr);
+    if (done) tp.raiseEvent(0x1);   // TXOK 与 RXOK 共用中断线
+}
+
+void CanFdLoopbackModel::inject(SimTransport& tp, uint32_t id_reg, uint32_t dlc_reg, const uint8_t* data) {
+    uint8_t dlc = static_cast<uint8_t>((dlc_reg & XCANFD_DLCR_DLC_MASK) >> XCANFD_DLCR_DLC_SHIFT);
+    uint32_t len = CanFDDevice::dlc_to_len(dlc);
+    uint32_t words[16] = {0};
+    for (uint32_t i = 0; i < len; ++i) words[i / 4] |= static_cast<uint32_t>(data[i]) << (24 - (i % 4) * 8);
+    push(tp, id_reg, dlc_reg, words, (len + 3) / 4);
+}
+
+void CanFdLoopbackModel::onWrite(SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) {
+    (void)width;
+    switch (offset) {
+    case XCANFD_SRR_OFFSET:
+        if (value & XCANFD_SRR_SRST_MASK) {
+            reset(tp);
+            return;
+        }
+        enabled_ = (value & XCANFD_SRR_CEN_MASK) != 0;
+        update_mode(tp);
+        break;
+    case XCANFD_MSR_OFFSET:
+        if (enabled_) update_mode(tp);
+        break;
+    case XCANFD_ICR_OFFSET: {
+        uint32_t isr = tp.peek32(XCANFD_ISR_OFFSET) & ~value;
+        if (fill_) isr |= XCANFD_IXR_RXOK_MASK;
+        tp.poke32(XCANFD_ISR_OFFSET, isr);
+        tp.poke32(XCANFD_ICR_OFFSET, 0);
+        break;
+    }
+    case XCANFD_TRR_OFFSET: {
+        if (frame_time_ns_ != 0) {
+            // 写 1 置位待发送缓冲（写 0 无效），由 tick 按总线时间逐帧完成；总线空闲时从当前时刻起算
+            if (trr_pending_ == 0) bus_free_ns_ = SimTransport::now_ns();
+            trr_pending_ |= value;
+            tp.poke32(XCANFD_TRR_OFFSET, trr_pending_);
+            break;
+        }
+        // 置位的发送缓冲立即完成：回环进 RX FIFO 0，TRR 位清零
+        for (uint32_t idx = 0; idx < MAX_BUFFER_INDEX; ++idx) {
+            if (value & (1u << idx)) transmit(tp, idx);
+        }
+        tp.poke32(XCANFD_TRR_OFFSET, 0);
+        break;
+    }
+    case XCANFD_TCR_OFFSET:
+        trr_pending_ = 0;
+        tp.poke32(XCANFD_TRR_OFFSET, 0);
+        tp.poke32(XCANFD_TCR_OFFSET, 0);
+        break;
+    case XCANFD_FSR_OFFSET:
+        if ((value & XCANFD_FSR_IRI_MASK) && fill_ > 0) {
+            read_idx_ = (read_idx_ + 1) % kRxDepth;
+            --fill_;
+            ++stats_.rx_frames;
+        }
+        update_fifo(tp);
+        break;
+    default:
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 舵机
+// ---------------------------------------------------------------------------
+
+void HelmServoModel::reset(SimTransport& tp) {
+    for (int i = 0; i < HELM_NUM; ++i) {
+        ad_[i] = 0;
+        tp.poke16(static_cast<uint64_t>(i + 1) * 4, 0);
+        tp.poke32(HELM_OUTPUT_PWM + static_cast<uint64_t>(i) * 4, 0);
+    }
+    last_ns_ = 0;
+    ticks_ = 0;
+}
+
+void HelmServoModel::tick(SimTransport& tp, uint64_t now_ns) {
+    if (last_ns_ == 0) {
+        last_ns_ = now_ns;
+        return;
+    }
+    double dt = static_cast<double>(now_ns - last_ns_);
+    last_ns_ = now_ns;
+    double alpha = tau_ns_ > 0 ? 1.0 - std::exp(-dt / tau_ns_) : 1.0;
+    for (int i = 0; i < HELM_NUM; ++i) {
+        double target = static_cast<double>(tp.peek32(HELM_OUTPUT_PWM + static_cast<uint64_t>(i) * 4) & 0xFFFF);
+        ad_[i] += (target - ad_[i]) * alpha;
+        tp.poke16(static_cast<uint64_t>(i + 1) * 4, static_cast<uint16_t>(std::lround(ad_[i])));
+    }
+    ++ticks_;
+}
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
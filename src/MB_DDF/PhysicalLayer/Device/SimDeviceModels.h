@@ -0,0 +1,160 @@
+/**
+ * @file SimDeviceModels.h
+ * @brief SimTransport 上的设备行为模型：RS422 BRAM 回环、AXI CAN / CAN-FD FIFO 回环、舵机 ADC 跟随
+ *
+ * 模型只覆盖驱动热路径与初始化流程实际依赖的寄存器语义，寄存器偏移与驱动保持一致；
+ * 模型状态在 SimTransport 的寄存器锁内访问，测试侧注入数据需经 SimTransport::withLock。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/ControlPlane/SimTransport.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Device {
+
+// RS422：CMD_TX 将发送 BRAM（长度字节 + 数据）送入接收队列（回环），CMD_RX 将队首帧装入接收 BRAM；
+// STU bit0 = 队首帧已就绪，bit1 = 发送可用；新帧就绪时触发事件 bit0
+class Rs422LoopbackModel : public ControlPlane::SimDeviceModel {
+public:
+    struct Stats {
+        uint64_t tx_frames = 0;
+        uint64_t rx_frames = 0;
+        uint64_t overflows = 0;     // 接收队列满时丢弃的帧
+    };
+
+    // latency_us：发送到对端可读的延迟（由 tick 推进，0 表示立即可读）；depth：接收队列深度
+    explicit Rs422LoopbackModel(uint32_t latency_us = 0, size_t depth = 64)
+        : latency_ns_(static_cast<uint64_t>(latency_us) * 1000), depth_(depth) {}
+
+    // 模拟对端发送一帧（需在 SimTransport::withLock 内调用）
+    void inject(ControlPlane::SimTransport& tp, const uint8_t* data, uint8_t len);
+
+    void reset(ControlPlane::SimTransport& tp) override;
+    void onWrite(ControlPlane::SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) override;
+    void tick(ControlPlane::SimTransport& tp, uint64_t now_ns) override;
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Frame {
+        uint64_t ready_ns = 0;
+        std::vector<uint8_t> bytes;     // [len][data...]
+    };
+    void push(ControlPlane::SimTransport& tp, std::vector<uint8_t> bytes);
+    void update_status(ControlPlane::SimTransport& tp, uint64_t now_ns);
+
+    uint64_t latency_ns_;
+    size_t depth_;
+    std::deque<Frame> rx_;
+    bool rx_ready_ = false;
+    Stats stats_{};
+};
+
+// AXI CAN（v1.03.a）：SRR/MSR 驱动 SR 模式位；写 TX DW2 即发送，回环模式（或 echo_always）下进入 RX FIFO；
+// 读 RX DW2 出队；RX FIFO 非空期间 ISR.RXOK 保持置位；回环帧无处可去（RX FIFO 满）时置 SR.TXFLL
+class CanLoopbackModel : public ControlPlane::SimDeviceModel {
+public:
+    struct Stats {
+        uint64_t tx_frames = 0;
+        uint64_t rx_frames = 0;
+        uint64_t overflows = 0;
+    };
+
+    explicit CanLoopbackModel(size_t depth = 64, bool echo_always = false)
+        : depth_(depth ? depth : 1), echo_always_(echo_always), rx_(depth_) {}
+
+    // 模拟总线上收到一帧标准帧（需在 SimTransport::withLock 内调用）
+    void inject(ControlPlane::SimTransport& tp, uint32_t id, uint8_t dlc, const uint8_t* data);
+
+    void reset(ControlPlane::SimTransport& tp) override;
+    void onWrite(ControlPlane::SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) override;
+    void onRead(ControlPlane::SimTransport& tp, uint64_t offset, unsigned width) override;
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    using Regs = std::array<uint32_t, 4>;   // ID / DLC / DW1 / DW2
+    void push(ControlPlane::SimTransport& tp, const Regs& r);
+    void load_head(ControlPlane::SimTransport& tp);
+    void update_mode(ControlPlane::SimTransport& tp);
+    void update_tx_full(ControlPlane::SimTransport& tp);
+
+    size_t depth_;
+    bool echo_always_;
+    bool enabled_ = false;
+    std::vector<Regs> rx_;      // 定长环形 RX FIFO（构造时分配，收发路径不再分配）
+    size_t rx_head_ = 0;
+    size_t rx_count_ = 0;
+    Stats stats_{};
+};
+
+// AXI CAN-FD：SRR/MSR 驱动 SR 模式位；写 TRR 即发送对应缓冲，完成后 TRR 位清零、置 TXOK 并回环进 RX FIFO 0；
+// FSR 维护 FL/RI，写 IRI 出队；RX FIFO 非空期间 ISR.RXOK 保持置位；
+// AFR 非 0 时按已启用的 AFMR/AFIDR 对接收帧做验收过滤（全部禁用时接收所有帧）
+class CanFdLoopbackModel : public ControlPlane::SimDeviceModel {
+public:
+    struct Stats {
+        uint64_t tx_frames = 0;
+        uint64_t rx_frames = 0;
+        uint64_t overflows = 0;
+        uint64_t filtered = 0;      // 被验收过滤器拒绝的帧
+    };
+
+    static constexpr uint32_t kRxDepth = 32;
+
+    // frame_time_us：每帧占用总线时间（由 tick 推进，按缓冲号从低到高逐帧完成并触发事件）；0 表示写 TRR 立即完成
+    explicit CanFdLoopbackModel(uint32_t frame_time_us = 0)
+        : frame_time_ns_(static_cast<uint64_t>(frame_time_us) * 1000) {}
+
+    // 模拟总线上收到一帧（id/dlc 按寄存器编码写入，data 长度由 dlc 决定；需在 withLock 内调用）
+    void inject(ControlPlane::SimTransport& tp, uint32_t id_reg, uint32_t dlc_reg, const uint8_t* data);
+
+    void reset(ControlPlane::SimTransport& tp) override;
+    void onWrite(ControlPlane::SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) override;
+    void tick(ControlPlane::SimTransport& tp, uint64_t now_ns) override;
+
+    const Stats& stats() const { return stats_; }
+    uint32_t fillLevel() const { return fill_; }
+
+private:
+    void push(ControlPlane::SimTransport& tp, uint32_t id_reg, uint32_t dlc_reg, const uint32_t* words, uint32_t nwords);
+    void transmit(ControlPlane::SimTransport& tp, uint32_t idx);
+    bool accept(ControlPlane::SimTransport& tp, uint32_t id_reg) const;
+    void update_mode(ControlPlane::SimTransport& tp);
+    void update_fifo(ControlPlane::SimTransport& tp);
+
+    uint64_t frame_time_ns_;
+    uint64_t bus_free_ns_ = 0;      // 上一帧发送完成时刻（总线空闲起点）
+    uint32_t trr_pending_ = 0;      // 已请求、尚未完成的发送缓冲
+    bool enabled_ = false;
+    uint32_t read_idx_ = 0;
+    uint32_t fill_ = 0;
+    Stats stats_{};
+};
+
+// 舵机：4 路 PWM 占空比（32 位）驱动 4 路 16 位 ADC 反馈按一阶惯性跟随；目标值取占空比低 16 位
+class HelmServoModel : public ControlPlane::SimDeviceModel {
+public:
+    explicit HelmServoModel(uint32_t time_constant_us = 2000) : tau_ns_(time_constant_us * 1000.0) {}
+
+    void reset(ControlPlane::SimTransport& tp) override;
+    void tick(ControlPlane::SimTransport& tp, uint64_t now_ns) override;
+
+    uint64_t ticks() const { return ticks_; }
+
+private:
+    double tau_ns_;
+    double ad_[4] = {0, 0, 0, 0};
+    uint64_t last_ns_ = 0;
+    uint64_t ticks_ = 0;
+};
+
+} // namespace Device
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -10,8 +10,13 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <thread>
 
 #include "MB_DDF/PhysicalLayer/DataPlane/ILink.h"
 #include "MB_DDF/PhysicalLayer/ControlPlane/IDeviceTransport.h"
@@ -60,6 +65,44 @@ public:
     inline bool wr16(uint64_t off, uint16_t v) { return tp_.writeReg16(off, v); }
     inline bool rd32(uint64_t off, uint32_t& v) { return tp_.readReg32(off, v); }
     inline bool wr32(uint64_t off, uint32_t v) { return tp_.writeReg32(off, v); }
+    // 突发访问：连续 32 位寄存器 / BRAM 字节块（一次边界检查，由控制面选择最优访问方式）
+    inline bool rd32n(uint64_t off, std::span<uint32_t> v) { return tp_.readRegs32(off, v); }
+    inline bool wr32n(uint64_t off, std::span<const uint32_t> v) { return tp_.writeRegs32(off, v); }
+    inline bool rdblk(uint64_t off, void* dst, size_t len) { return tp_.copyFromDevice(off, dst, len); }
+    inline bool wrblk(uint64_t off, const void* src, size_t len) { return tp_.copyToDevice(off, src, len); }
+
+    // 带截止时间的轮询：先连续检查 spin 次（模式切换通常在数次寄存器访问内完成），
+    // 之后按 1us 起指数退避休眠，单次不超过 max_sleep_us 且不越过截止时间。
+    // done() 返回 >0 条件满足、0 继续等待、<0 错误（原样返回）；超时返回 -ETIMEDOUT，成功返回 0
+    static constexpr uint32_t kRegPollTimeoutUs = 100000;
+    template <typename Pred>
+    static int pollUntil(Pred&& done, uint32_t timeout_us = kRegPollTimeoutUs,
+                         uint32_t max_sleep_us = 1000, uint32_t spin = 8) {
+        using clock = std::chrono::steady_clock;
+        const auto deadline = clock::now() + std::chrono::microseconds(timeout_us);
+        uint32_t sleep_us = 1;
+        for (uint32_t i = 0;; ++i) {
+            int r = done();
+            if (r != 0) return r > 0 ? 0 : r;
+            const auto now = clock::now();
+            if (now >= deadline) return -ETIMEDOUT;
+            if (i < spin) continue;
+            auto left = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+            std::this_thread::sleep_for(std::chrono::microseconds(std::min<int64_t>(sleep_us, left)));
+            sleep_us = std::min(sleep_us * 2, max_sleep_us);
+        }
+    }
+    // 轮询 32 位寄存器直到 (值 & mask) == expect；last 返回最后一次读到的值
+    int pollReg32(uint64_t off, uint32_t mask, uint32_t expect,
+                  uint32_t timeout_us = kRegPollTimeoutUs, uint32_t* last = nullptr) {
+        uint32_t v = 0;
+        int r = pollUntil([&]() -> int {
+            if (!tp_.readReg32(off, v)) return -EIO;
+            return (v & mask) == expect ? 1 : 0;
+        }, timeout_us);
+        if (last) *last = v;
+        return r;
+    }
 
 private:
     ControlPlane::IDeviceTransport& tp_;
@@ -2,65 +2,269 @@
  * @file EventMultiplexer.cpp
  */
 #include "MB_DDF/PhysicalLayer/EventMultiplexer.h"
+#include <algorithm>
 #include <cerrno>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 
 namespace MB_DDF {
 namespace PhysicalLayer {
 
-EventMultiplexer::EventMultiplexer() {
-    epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+EventMultiplexer::EventMultiplexer(Options opt) {
+    const unsigned n = std::max(opt.shards, 1u);
+    const size_t batch = std::max<size_t>(opt.max_events, 1);
+    for (unsigned i = 0; i < n; ++i) {
+        auto s = std::make_unique<Shard>();
+        s->epfd = ::epoll_create1(EPOLL_CLOEXEC);
+        s->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        s->wake.kind = Handler::Kind::Wake;
+        s->wake.fd = s->wake_fd;
+        if (s->epfd >= 0 && s->wake_fd >= 0) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = &s->wake;
+            ::epoll_ctl(s->epfd, EPOLL_CTL_ADD, s->wake_fd, &ev);
+        }
+        s->evs.resize(batch);
+        shards_.push_back(std::move(s));
+    }
 }
 
 EventMultiplexer::~EventMultiplexer() {
-    if (epfd_ >= 0) {
-        ::close(epfd_);
-        epfd_ = -1;
+    stop();
+    for (auto& s : shards_) {
+        for (auto& kv : s->handlers) {
+            if (kv.second->kind == Handler::Kind::Timer) ::close(kv.second->fd);
+        }
+        if (s->wake_fd >= 0) ::close(s->wake_fd);
+        if (s->epfd >= 0) ::close(s->epfd);
     }
 }
 
-bool EventMultiplexer::add(int fd, uint32_t events, Callback cb) {
-    if (fd < 0 || epfd_ < 0) return false;
+bool EventMultiplexer::add_to(Shard& s, int fd, uint32_t events, std::unique_ptr<Handler> h) {
+    if (s.epfd < 0) return false;
     epoll_event ev{};
     ev.events = events;
-    ev.data.fd = fd;
-    int op = cbs_.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
-    if (::epoll_ctl(epfd_, op, fd, &ev) < 0) return false;
-    cbs_[fd] = std::move(cb);
+    ev.data.ptr = h.get();
+    std::lock_guard<std::mutex> lk(s.mu);
+    auto it = s.handlers.find(fd);
+    int op = it != s.handlers.end() ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (::epoll_ctl(s.epfd, op, fd, &ev) < 0) return false;
+    if (it != s.handlers.end()) {
+        // 旧处理器可能仍在本批次事件中：标记失效，批次结束后释放
+        it->second->dead.store(true, std::memory_order_release);
+        s.retired.push_back(std::move(it->second));
+        s.has_retired.store(true, std::memory_order_release);
+        it->second = std::move(h);
+    } else {
+        s.handlers.emplace(fd, std::move(h));
+    }
+    return true;
+}
+
+void EventMultiplexer::retire_locked(Shard& s, std::unordered_map<int, std::unique_ptr<Handler>>::iterator it) {
+    auto& h = it->second;
+    ::epoll_ctl(s.epfd, EPOLL_CTL_DEL, h->fd, nullptr);
+    h->dead.store(true, std::memory_order_release);
+    if (h->kind == Handler::Kind::Timer) ::close(h->fd);
+    s.retired.push_back(std::move(h));
+    s.has_retired.store(true, std::memory_order_release);
+    s.handlers.erase(it);
+}
+
+bool EventMultiplexer::add(int fd, uint32_t events, Callback cb) {
+    if (fd < 0) return false;
+    auto h = std::make_unique<Handler>();
+    h->fd = fd;
+    h->cb = std::move(cb);
+    return add_to(shard_of(fd), fd, events, std::move(h));
+}
+
+bool EventMultiplexer::add_shared(int fd, uint32_t events, Callback cb) {
+    if (fd < 0) return false;
+    for (auto& s : shards_) {
+        auto h = std::make_unique<Handler>();
+        h->fd = fd;
+        h->cb = cb;
+        if (!add_to(*s, fd, events | EPOLLEXCLUSIVE, std::move(h))) {
+            int err = errno;
+            remove(fd);
+            errno = err;
+            return false;
+        }
+    }
     return true;
 }
 
 bool EventMultiplexer::remove(int fd) {
-    if (fd < 0 || epfd_ < 0) return false;
-    ::epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
-    cbs_.erase(fd);
+    if (fd < 0) return false;
+    bool found = false;
+    for (auto& s : shards_) {
+        std::lock_guard<std::mutex> lk(s->mu);
+        auto it = s->handlers.find(fd);
+        if (it == s->handlers.end() || it->second->kind != Handler::Kind::Fd) continue;
+        retire_locked(*s, it);
+        found = true;
+    }
+    return found;
+}
+
+EventMultiplexer::TimerId EventMultiplexer::add_timer(uint64_t delay_us, uint64_t period_us, TimerCallback cb) {
+    if (!cb) return 0;
+    int tfd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) return 0;
+    auto h = std::make_unique<Handler>();
+    h->kind = Handler::Kind::Timer;
+    h->fd = tfd;
+    h->tcb = std::move(cb);
+    h->periodic = period_us != 0;
+    h->timer_id = next_timer_.fetch_add(1, std::memory_order_relaxed);
+    const TimerId id = h->timer_id;
+
+    itimerspec its{};
+    const uint64_t first_ns = delay_us ? delay_us * 1000 : 1;     // it_value 为 0 表示解除，尽快到期取 1ns
+    its.it_value.tv_sec = static_cast<time_t>(first_ns / 1000000000ull);
+    its.it_value.tv_nsec = static_cast<long>(first_ns % 1000000000ull);
+    its.it_interval.tv_sec = static_cast<time_t>(period_us / 1000000ull);
+    its.it_interval.tv_nsec = static_cast<long>((period_us % 1000000ull) * 1000);
+    if (!add_to(shard_of(tfd), tfd, EPOLLIN, std::move(h))) {
+        ::close(tfd);
+        return 0;
+    }
+    if (::timerfd_settime(tfd, 0, &its, nullptr) < 0) {
+        cancel_timer(id);
+        return 0;
+    }
+    return id;
+}
+
+bool EventMultiplexer::cancel_timer(TimerId id) {
+    if (id == 0) return false;
+    for (auto& s : shards_) {
+        std::lock_guard<std::mutex> lk(s->mu);
+        for (auto it = s->handlers.begin(); it != s->handlers.end(); ++it) {
+            if (it->second->kind == Handler::Kind::Timer && it->second->timer_id == id) {
+                retire_locked(*s, it);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool EventMultiplexer::post(Task task) {
+    if (!task) return false;
+    Shard& s = *shards_[next_post_.fetch_add(1, std::memory_order_relaxed) % shards_.size()];
+    if (s.wake_fd < 0) return false;
+    {
+        std::lock_guard<std::mutex> lk(s.mu);
+        s.tasks.push_back(std::move(task));
+    }
+    uint64_t one = 1;
+    ssize_t ret = ::write(s.wake_fd, &one, sizeof(one));
+    (void)ret;
     return true;
 }
 
-int EventMultiplexer::wait_once(int timeout_ms) {
-    if (epfd_ < 0) return -1;
-    epoll_event evs[32];
-    int n = ::epoll_wait(epfd_, evs, 32, timeout_ms);
-    if (n <= 0) return n; // 0 超时；<0 错误
+void EventMultiplexer::wakeup() {
+    for (auto& s : shards_) {
+        if (s->wake_fd < 0) continue;
+        uint64_t one = 1;
+        ssize_t ret = ::write(s->wake_fd, &one, sizeof(one));
+        (void)ret;
+    }
+}
+
+void EventMultiplexer::run_tasks(Shard& s) {
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lk(s.mu);
+        tasks.swap(s.tasks);
+    }
+    for (auto& t : tasks) t();
+}
+
+void EventMultiplexer::dispatch_timer(Shard& s, Handler& h) {
+    uint64_t expirations = 0;
+    if (::read(h.fd, &expirations, sizeof(expirations)) != static_cast<ssize_t>(sizeof(expirations))) return;
+    h.tcb(expirations);
+    if (h.periodic) return;
+    std::lock_guard<std::mutex> lk(s.mu);
+    auto it = s.handlers.find(h.fd);
+    if (it != s.handlers.end() && it->second.get() == &h) retire_locked(s, it);
+}
+
+int EventMultiplexer::wait_shard(Shard& s, int timeout_ms) {
+    if (s.epfd < 0) return -1;
+    int n = ::epoll_wait(s.epfd, s.evs.data(), static_cast<int>(s.evs.size()), timeout_ms);
+    if (n < 0) return n; // <0 错误
     for (int i = 0; i < n; ++i) {
-        int fd = evs[i].data.fd;
-        auto it = cbs_.find(fd);
-        if (it != cbs_.end() && it->second) {
-            it->second(fd, evs[i].events);
+        auto* h = static_cast<Handler*>(s.evs[i].data.ptr);
+        if (h->dead.load(std::memory_order_acquire)) continue;
+        switch (h->kind) {
+        case Handler::Kind::Wake: {
+            uint64_t cnt = 0;
+            ssize_t ret = ::read(h->fd, &cnt, sizeof(cnt));
+            (void)ret;
+            run_tasks(s);
+            break;
         }
+        case Handler::Kind::Timer:
+            dispatch_timer(s, *h);
+            break;
+        case Handler::Kind::Fd:
+            if (h->cb) h->cb(h->fd, s.evs[i].events);
+            break;
+        }
+    }
+    // 本批次已不再引用任何处理器指针，此时释放期间移除的处理器
+    if (s.has_retired.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lk(s.mu);
+        s.retired.clear();
+        s.has_retired.store(false, std::memory_order_relaxed);
     }
     return n;
 }
 
+int EventMultiplexer::wait_once(int timeout_ms) {
+    return wait_shard(*shards_[0], timeout_ms);
+}
+
 void EventMultiplexer::run_loop(int timeout_ms) {
-    running_ = true;
-    while (running_) {
-        int r = wait_once(timeout_ms);
+    stop_.store(false, std::memory_order_relaxed);
+    while (!stop_.load(std::memory_order_acquire)) {
+        int r = wait_shard(*shards_[0], timeout_ms);
         if (r < 0 && errno == EINTR) continue; // 中断重试
         // 其他错误/超时无需特殊处理，继续循环
     }
 }
 
-void EventMultiplexer::stop() { running_ = false; }
+bool EventMultiplexer::start() {
+    if (running()) return true;
+    for (auto& s : shards_) {
+        if (s->epfd < 0 || s->wake_fd < 0) return false;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    for (auto& s : shards_) {
+        Shard* sp = s.get();
+        threads_.emplace_back([this, sp]() {
+            while (!stop_.load(std::memory_order_acquire)) {
+                int r = wait_shard(*sp, -1);
+                if (r < 0 && errno != EINTR) break;
+            }
+        });
+    }
+    return true;
+}
+
+void EventMultiplexer::stop() {
+    stop_.store(true, std::memory_order_release);
+    wakeup();
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+    threads_.clear();
+}
 
 } // namespace PhysicalLayer
-} // namespace MB_DDF
\ No newline at end of file
+} // namespace MB_DDF
@@ -6,14 +6,30 @@
  * 设计要点：
  * - 统一接入 Linux epoll，注册来自数据面/控制面的事件 fd。
  * - 提供回调签名与分发机制，不持有对象所有权，仅保存 fd 与回调。
- * - 支持添加/移除、单次等待与循环驱动。
+ * - 处理器指针直接存入 epoll_event.data，分发时不查表；每次 epoll_wait 最多取 max_events 个事件。
+ * - 事件掩码原样交给内核：可使用 EPOLLET（边沿触发，回调须读尽）；
+ *   add_shared() 将同一 fd 以 EPOLLEXCLUSIVE 注册到所有分片，就绪时只唤醒其中一个线程。
+ * - 分片：shards 个独立 epoll 实例，fd 按 fd % shards 固定归属一个分片（类似 SO_REUSEPORT 分流），
+ *   start() 为每个分片启动一个循环线程，同一 fd 的回调总在同一线程中串行执行。
+ * - 定时器：timerfd（CLOCK_MONOTONIC）实现单次/周期定时，回调在所属分片线程中执行，
+ *   参数为自上次回调以来的到期次数（>1 表示错过周期）。
+ * - 每个分片内置唤醒 eventfd：stop() 立即唤醒阻塞中的等待；post(task) 将任务投递到循环线程执行。
+ * - 移除的处理器延迟到所属分片当前批次分发结束后释放，回调中移除自身或其他 fd 是安全的；
+ *   但 remove() 返回时其他线程中正在执行的该回调可能尚未结束，需同步析构的调用方应先 stop()。
  */
 #pragma once
 
 #include <sys/epoll.h>
 #include <unistd.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace MB_DDF {
 namespace PhysicalLayer {
@@ -22,33 +38,99 @@ namespace PhysicalLayer {
 //   EventMultiplexer mux;
 //   mux.add(link.getEventFd(), EPOLLIN, [&](int fd, uint32_t ev){ /* 拉取数据并处理 */ });
 //   mux.add(tp.getEventFd(), EPOLLIN, [&](int fd, uint32_t ev){ /* 读取事件并触发收取 */ });
-//   mux.run_loop(100); // 100ms 超时循环
+//   mux.add_timer(0, 1000, [&](uint64_t expirations){ /* 1ms 周期任务 */ });
+//   mux.run_loop(100); // 在当前线程循环，直到其他线程调用 stop()
+//
+//   EventMultiplexer pool(EventMultiplexer::Options{64, 4}); // 4 个分片
+//   pool.add(...); pool.start();                            // 每个分片一个循环线程
+//   pool.post([]{ /* 在循环线程中执行 */ });
+//   pool.stop();
 class EventMultiplexer {
 public:
     using Callback = std::function<void(int fd, uint32_t events)>; // events: EPOLL* flags
+    using TimerCallback = std::function<void(uint64_t expirations)>;
+    using Task = std::function<void()>;
+    using TimerId = uint64_t;                                      // 0 表示无效
 
-    EventMultiplexer();
+    struct Options {
+        size_t max_events = 64;                                    // 每次 epoll_wait 的批大小
+        unsigned shards = 1;                                       // 分片数（start() 的线程数）
+    };
+
+    EventMultiplexer() : EventMultiplexer(Options{}) {}
+    explicit EventMultiplexer(Options opt);
     ~EventMultiplexer();
 
+    EventMultiplexer(const EventMultiplexer&) = delete;
+    EventMultiplexer& operator=(const EventMultiplexer&) = delete;
+
     // 注册一个 fd 与其事件掩码与回调；重复注册将更新掩码与回调
     bool add(int fd, uint32_t events, Callback cb);
+    // 将 fd 以 EPOLLEXCLUSIVE 注册到所有分片：就绪时只唤醒一个分片线程（不可再次更新）
+    bool add_shared(int fd, uint32_t events, Callback cb);
     // 从 epoll 中移除一个 fd，并删除回调
     bool remove(int fd);
 
-    // 阻塞等待一次事件并分发；返回触发事件数量（>=0）
+    // 单次/周期定时器：delay_us 后首次到期（0 表示尽快），period_us 为 0 时为单次定时；失败返回 0
+    TimerId add_timer(uint64_t delay_us, uint64_t period_us, TimerCallback cb);
+    bool cancel_timer(TimerId id);
+
+    // 投递任务到循环线程执行（多分片时轮流分配）；未运行时在下一次 wait_once 中执行
+    bool post(Task task);
+    // 唤醒所有分片中阻塞的等待（不停止循环）
+    void wakeup();
+
+    // 阻塞等待一次事件并分发（仅分片 0，不可与 start() 并用）；返回触发事件数量（>=0）
     int wait_once(int timeout_ms);
 
     // 循环运行，直到 stop() 被调用；每次 wait_once 以 timeout_ms 为超时
     void run_loop(int timeout_ms);
+    // 为每个分片启动一个循环线程
+    bool start();
+    // 停止 run_loop 与循环线程并等待其退出
     void stop();
+    bool running() const { return !threads_.empty(); }
 
-    int epoll_fd() const { return epfd_; }
+    unsigned shards() const { return static_cast<unsigned>(shards_.size()); }
+    int epoll_fd() const { return shards_.empty() ? -1 : shards_[0]->epfd; }
 
 private:
-    int epfd_{-1};
-    bool running_{false};
-    std::unordered_map<int, Callback> cbs_{};
+    struct Handler {
+        enum class Kind { Fd, Timer, Wake };
+        Kind kind = Kind::Fd;
+        int fd = -1;
+        Callback cb;
+        TimerCallback tcb;
+        TimerId timer_id = 0;
+        bool periodic = false;
+        std::atomic<bool> dead{false};
+    };
+
+    struct Shard {
+        int epfd = -1;
+        int wake_fd = -1;
+        Handler wake;
+        std::mutex mu;                                             // 保护 handlers/retired/tasks
+        std::unordered_map<int, std::unique_ptr<Handler>> handlers;
+        std::vector<std::unique_ptr<Handler>> retired;
+        std::atomic<bool> has_retired{false};
+        std::vector<Task> tasks;
+        std::vector<epoll_event> evs;
+    };
+
+    Shard& shard_of(int fd) { return *shards_[static_cast<size_t>(fd) % shards_.size()]; }
+    bool add_to(Shard& s, int fd, uint32_t events, std::unique_ptr<Handler> h);
+    void retire_locked(Shard& s, std::unordered_map<int, std::unique_ptr<Handler>>::iterator it);
+    int wait_shard(Shard& s, int timeout_ms);
+    void dispatch_timer(Shard& s, Handler& h);
+    void run_tasks(Shard& s);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> next_timer_{1};
+    std::atomic<size_t> next_post_{0};
 };
 
 } // namespace PhysicalLayer
-} // namespace MB_DDF
\ No newline at end of file
+} // namespace MB_DDF
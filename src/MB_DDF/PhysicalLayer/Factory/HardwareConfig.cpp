@@ -0,0 +1,249 @@
+/**
+ * @file HardwareConfig.cpp
+ */
+#include "MB_DDF/PhysicalLayer/Factory/HardwareConfig.h"
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Factory {
+
+namespace {
+constexpr const char* kSectionPrefix = "device.";
+
+std::string trim(const std::string& s) {
+    const char* ws = " \t\r\n";
+    size_t b = s.find_first_not_of(ws);
+    if (b == std::string::npos) return {};
+    size_t e = s.find_last_not_of(ws);
+    return s.substr(b, e - b + 1);
+}
+
+bool to_u64(const std::string& s, uint64_t& v) {
+    if (s.empty()) return false;
+    errno = 0;
+    char* end = nullptr;
+    unsigned long long r = std::strtoull(s.c_str(), &end, 0);
+    if (errno != 0 || end == s.c_str() || *end != '\0') return false;
+    v = r;
+    return true;
+}
+
+bool to_int(const std::string& s, int& v) {
+    if (s.empty()) return false;
+    errno = 0;
+    char* end = nullptr;
+    long r = std::strtol(s.c_str(), &end, 0);
+    if (errno != 0 || end == s.c_str() || *end != '\0') return false;
+    v = static_cast<int>(r);
+    return true;
+}
+
+// 通用键写入 DeviceSpec；返回 false 表示数值格式错误
+bool apply_key(DeviceSpec& d, const std::string& key, const std::string& val) {
+    uint64_t u = 0;
+    if (key == "type")      { d.type = val; return true; }
+    if (key == "transport") { d.transport = val; return true; }
+    if (key == "model")     { d.model = val; return true; }
+    if (key == "path")      { d.tc.device_path = val; return true; }
+    if (key == "rx_topic")  { d.rx_topic = val; return true; }
+    if (key == "tx_topic")  { d.tx_topic = val; return true; }
+    if (key == "event")     return to_int(val, d.tc.event_number);
+    if (key == "h2c")       return to_int(val, d.tc.dma_h2c_channel);
+    if (key == "c2h")       return to_int(val, d.tc.dma_c2h_channel);
+    if (key == "offset") {
+        if (!to_u64(val, u)) return false;
+        d.tc.device_offset = static_cast<__off_t>(u);
+        return true;
+    }
+    if (key == "window") {
+        if (!to_u64(val, u)) return false;
+        d.tc.register_window = static_cast<size_t>(u);
+        return true;
+    }
+    if (key == "mtu") {
+        if (!to_u64(val, u) || u == 0 || u > UINT32_MAX) return false;
+        d.mtu = static_cast<uint32_t>(u);
+        return true;
+    }
+    d.params[key] = val;
+    return true;
+}
+
+const char* kDefaultText = R"ini(
+; 内置默认设备表：全部位于 /dev/xdma0
+[device.can]
+type     = can
+offset   = 0x50000
+event    = 5
+mtu      = 8
+loopback = 0
+baud     = 500000
+
+[device.helm]
+type       = helm
+offset     = 0x60000
+mtu        = 16
+pwm_freq   = 8000
+out_enable = 0xF
+ad_filter  = 1
+
+[device.imu]
+type       = rs422
+offset     = 0x10000
+event      = 1
+mtu        = 255
+ucr        = 0x30
+mcr        = 0x20
+brsr       = 0x0A
+icr        = 0x01
+tx_head_lo = 0xAA
+tx_head_hi = 0x1A
+rx_head_lo = 0xAA
+rx_head_hi = 0x1A
+lpb        = 0x00
+intr       = 0xAE
+evt        = 1250
+
+[device.dyt]
+type       = rs422
+offset     = 0x20000
+event      = 2
+mtu        = 255
+ucr        = 0x30
+mcr        = 0x20
+brsr       = 0x0A
+icr        = 0x01
+tx_head_lo = 0xAA
+tx_head_hi = 0x1A
+rx_head_lo = 0xAA
+rx_head_hi = 0x1A
+lpb        = 0x00
+intr       = 0xAE
+evt        = 1250
+
+[device.ddr]
+type   = ddr
+offset = 0x0
+event  = 6
+h2c    = 0
+c2h    = 0
+mtu    = 655360
+
+[device.udp]
+type      = udp
+transport = none
+mtu       = 60000
+name      = 12345
+)ini";
+}
+
+uint64_t DeviceSpec::num(const std::string& key, uint64_t def) const {
+    auto it = params.find(key);
+    uint64_t v = 0;
+    if (it == params.end() || !to_u64(it->second, v)) return def;
+    return v;
+}
+
+std::string DeviceSpec::str(const std::string& key, const std::string& def) const {
+    auto it = params.find(key);
+    return it == params.end() ? def : it->second;
+}
+
+std::string DeviceSpec::transportKey() const {
+    std::ostringstream os;
+    os << transport << '|' << tc.device_path << '|' << tc.dma_h2c_channel << '|' << tc.dma_c2h_channel;
+    // 仿真传输层本身即设备模型实例：模型与寄存器偏移决定实例身份
+    if (transport == "sim") os << '|' << (model.empty() ? type : model) << '@' << std::hex << tc.device_offset;
+    return os.str();
+}
+
+bool HardwareConfig::parse(const std::string& text, HardwareConfig& out, std::string* err) {
+    auto fail = [&](size_t line, const std::string& why) {
+        if (err) *err = "line " + std::to_string(line) + ": " + why;
+        return false;
+    };
+
+    HardwareConfig cfg;
+    DeviceSpec* cur = nullptr;
+    bool in_other = false;                 // 非 device.* 段：忽略其内容，便于与其他配置共用文件
+    std::istringstream is(text);
+    std::string raw;
+    size_t line = 0;
+    while (std::getline(is, raw)) {
+        ++line;
+        size_t c = raw.find_first_of(";#");
+        std::string s = trim(c == std::string::npos ? raw : raw.substr(0, c));
+        if (s.empty()) continue;
+
+        if (s.front() == '[') {
+            if (s.back() != ']') return fail(line, "unterminated section");
+            std::string sec = trim(s.substr(1, s.size() - 2));
+            if (sec.rfind(kSectionPrefix, 0) != 0) {
+                cur = nullptr;
+                in_other = true;
+                continue;
+            }
+            std::string name = trim(sec.substr(std::char_traits<char>::length(kSectionPrefix)));
+            if (name.empty()) return fail(line, "empty device name");
+            if (cfg.find(name)) return fail(line, "duplicate device '" + name + "'");
+            cfg.devices.emplace_back();
+            cur = &cfg.devices.back();
+            cur->name = name;
+            in_other = false;
+            continue;
+        }
+
+        size_t eq = s.find('=');
+        if (eq == std::string::npos) return fail(line, "expected key = value");
+        if (in_other) continue;
+        if (!cur) return fail(line, "key outside of [device.<name>] section");
+        std::string key = trim(s.substr(0, eq));
+        std::string val = trim(s.substr(eq + 1));
+        if (key.empty()) return fail(line, "empty key");
+        if (!apply_key(*cur, key, val)) return fail(line, "bad value for '" + key + "': " + val);
+    }
+
+    for (const auto& d : cfg.devices) {
+        if (d.type.empty()) return fail(line, "device '" + d.name + "' has no type");
+        if (d.mtu == 0) return fail(line, "device '" + d.name + "' has no mtu");
+        if (d.transport != "xdma" && d.transport != "sim" && d.transport != "none") {
+            return fail(line, "device '" + d.name + "' has unknown transport '" + d.transport + "'");
+        }
+    }
+    out = std::move(cfg);
+    return true;
+}
+
+bool HardwareConfig::load(const std::string& path, HardwareConfig& out, std::string* err) {
+    std::ifstream f(path);
+    if (!f) {
+        if (err) *err = "cannot open " + path;
+        return false;
+    }
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    if (!parse(ss.str(), out, err)) {
+        if (err) *err = path + ": " + *err;
+        return false;
+    }
+    return true;
+}
+
+const char* HardwareConfig::defaultText() {
+    return kDefaultText;
+}
+
+const DeviceSpec* HardwareConfig::find(const std::string& name) const {
+    for (const auto& d : devices) {
+        if (d.name == name) return &d;
+    }
+    return nullptr;
+}
+
+} // namespace Factory
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,64 @@
+/**
+ * @file HardwareConfig.h
+ * @brief 设备图配置：INI 文本描述设备类型、传输层（路径/偏移/事件号/DMA 通道）、MTU、类型参数与 Topic 绑定
+ *
+ * 格式：
+ *   ; 或 # 起始为注释；每个设备一个 [device.<name>] 段，<name> 即 HardwareFactory::create/get 的名称
+ *   [device.imu]
+ *   type      = rs422          ; can | canfd | helm | rs422 | ddr | udp
+ *   transport = xdma           ; xdma（默认）| sim（仿真，model 选设备模型）| none（无控制面，如 udp）
+ *   path      = /dev/xdma0
+ *   offset    = 0x10000
+ *   event     = 1              ; -1 表示不使用事件
+ *   mtu       = 255
+ *   rx_topic  = local://imu    ; 可选：设备接收帧发布到的 Topic
+ *   tx_topic  = local://imu_tx ; 可选：订阅后转发到设备 send 的 Topic
+ *   brsr      = 0x0A           ; 其余键为设备类型参数，见 HardwareFactory.cpp
+ * 数值按 strtoull(base=0) 解析，支持十进制/0x 十六进制。
+ */
+#pragma once
+
+#include "MB_DDF/PhysicalLayer/Types.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Factory {
+
+struct DeviceSpec {
+    std::string name;
+    std::string type;
+    std::string transport{"xdma"};
+    std::string model;                             // transport=sim 时的设备模型，默认与 type 相同
+    TransportConfig tc;
+    uint32_t mtu{0};
+    std::string rx_topic;
+    std::string tx_topic;
+    std::map<std::string, std::string> params;     // 设备类型参数（原样保存）
+
+    // 取数值参数；缺省或格式错误时返回 def
+    uint64_t num(const std::string& key, uint64_t def) const;
+    std::string str(const std::string& key, const std::string& def) const;
+    // 共享传输层的键：设备路径 + DMA 通道（sim 另加模型与偏移）；同一键的设备共用一个已打开的传输层实例，
+    // 寄存器偏移/窗口与事件号按设备各自生效
+    std::string transportKey() const;
+};
+
+struct HardwareConfig {
+    std::vector<DeviceSpec> devices;
+
+    // 解析 INI 文本；失败时 err 给出行号与原因
+    static bool parse(const std::string& text, HardwareConfig& out, std::string* err = nullptr);
+    static bool load(const std::string& path, HardwareConfig& out, std::string* err = nullptr);
+    // 内置默认设备表（与原硬编码工厂一致）
+    static const char* defaultText();
+
+    const DeviceSpec* find(const std::string& name) const;
+};
+
+} // namespace Factory
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -1,156 +1,414 @@
 #include "MB_DDF/PhysicalLayer/Factory/HardwareFactory.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/SharedDmaTransport.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/SimTransport.h"
 #include "MB_DDF/PhysicalLayer/ControlPlane/XdmaTransport.h"
 #include "MB_DDF/PhysicalLayer/DataPlane/UdpLink.h"
 #include "MB_DDF/PhysicalLayer/Device/CanDevice.h"
+#include "MB_DDF/PhysicalLayer/Device/CanFdDevice.h"
 #include "MB_DDF/PhysicalLayer/Device/HelmDevice.h"
 #include "MB_DDF/PhysicalLayer/Device/Rs422Device.h"
 #include "MB_DDF/PhysicalLayer/Device/DdrDevice.h"
+#include "MB_DDF/PhysicalLayer/Device/SimDeviceModels.h"
+#include "MB_DDF/PhysicalLayer/Hardware/pl_canfd.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace MB_DDF {
 namespace PhysicalLayer {
 namespace Factory {
 
 namespace {
+constexpr const char* kConfigEnv = "MB_DDF_HW_CONFIG";
+
 struct HandleImpl : public DDS::Handle {
-    ControlPlane::XdmaTransport tp;
+    std::shared_ptr<ControlPlane::IDeviceTransport> tp;     // 先于 dev 声明：dev 先析构
     std::unique_ptr<DataPlane::ILink> dev = nullptr;
     uint32_t mtu{1500};
+    uint32_t burst{64};
 
     bool send(const uint8_t* data, uint32_t len) override { return dev->send(data, len); }
     int32_t receive(uint8_t* buf, uint32_t buf_size) override { return dev->receive(buf, buf_size); }
-    int32_t receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us) override { return dev->receive(buf, buf_size, timeout_us); }   
+    int32_t receive(uint8_t* buf, uint32_t buf_size, uint32_t timeout_us) override { return dev->receive(buf, buf_size, timeout_us); }
     uint32_t getMTU() const override { return mtu; }
+    uint32_t framesPerEvent() const override { return burst; }
+    int getEventFd() const override { return dev->getEventFd(); }
+    void ackEvent() override {
+        uint32_t bitmap = 0;
+        if (tp) (void)tp->waitEvent(&bitmap, 0);      // UDP 等无控制面的链路：fd 即数据 fd，无需消费
+    }
+};
+
+// 共享传输层：首个使用者在 mu 内打开，其余使用者等待并复用
+struct TransportSlot {
+    std::mutex mu;
+    std::shared_ptr<ControlPlane::IDeviceTransport> tp;
 };
+
+struct Entry {
+    DeviceSpec spec;
+    std::mutex mu;                                   // 串行化同一设备的初始化/重配置
+    std::shared_ptr<HandleImpl> handle;
+};
+
+struct Registry {
+    std::mutex mu;                                   // 保护 loaded/cfg/entries/transports 本身
+    bool loaded = false;
+    HardwareConfig cfg;
+    std::map<std::string, std::shared_ptr<Entry>> entries;
+    std::map<std::string, std::shared_ptr<TransportSlot>> transports;
+
+    void reset(HardwareConfig c) {
+        cfg = std::move(c);
+        entries.clear();
+        transports.clear();
+        for (const auto& d : cfg.devices) {
+            auto e = std::make_shared<Entry>();
+            e->spec = d;
+            entries[d.name] = std::move(e);
+        }
+        loaded = true;
+    }
+
+    // 需持有 mu
+    void ensure_loaded() {
+        if (loaded) return;
+        HardwareConfig c;
+        std::string err;
+        const char* path = std::getenv(kConfigEnv);
+        if (path && *path) {
+            if (HardwareConfig::load(path, c, &err)) {
+                LOGI("factory", "config", 0, "loaded %zu devices from %s", c.devices.size(), path);
+                reset(std::move(c));
+                return;
+            }
+            LOGE("factory", "config", -EINVAL, "%s; falling back to built-in table", err.c_str());
+        }
+        if (!HardwareConfig::parse(HardwareConfig::defaultText(), c, &err)) {
+            LOGE("factory", "config", -EINVAL, "built-in table: %s", err.c_str());
+        }
+        reset(std::move(c));
+    }
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
 }
 
-std::shared_ptr<DDS::Handle> HardwareFactory::create(const std::string& name, void* param) {
-    auto h = std::make_unique<HandleImpl>();
-    TransportConfig tc;
-    tc.device_path = "/dev/xdma0";
-
-    if (name == "can") {
-        tc.device_offset = 0x50000;
-        tc.event_number = 5;
-        h->tp.open(tc);
-        h->mtu = 8;
-        h->dev = std::make_unique<Device::CanDevice>(h->tp, h->mtu);
-        LinkConfig lc; 
-        h->dev->open(lc);
-        uint32_t off = 0; 
-        h->dev->ioctl(Device::CanDevice::IOCTL_SET_LOOPBACK, &off, sizeof(off));
-        if (param != nullptr) {
-            h->dev->ioctl(Device::CanDevice::IOCTL_SET_BIT_TIMING, param, sizeof(Device::CanDevice::BitTiming));
-        } else {
-            uint32_t baud = 500000;
-            h->dev->ioctl(Device::CanDevice::IOCTL_SET_BIT_TIMING, &baud, sizeof(baud));
+std::shared_ptr<ControlPlane::SimDeviceModel> make_sim_model(const std::string& model) {
+    if (model == "rs422") return std::make_shared<Device::Rs422LoopbackModel>();
+    if (model == "can")   return std::make_shared<Device::CanLoopbackModel>();
+    if (model == "canfd") return std::make_shared<Device::CanFdLoopbackModel>();
+    if (model == "helm")  return std::make_shared<Device::HelmServoModel>();
+    return nullptr;                                  // none：寄存器不响应
+}
+
+// 按 transportKey() 取共享实例：首个使用者以 tc 打开，其余使用者复用
+std::shared_ptr<ControlPlane::IDeviceTransport> open_shared(const DeviceSpec& spec, const TransportConfig& tc,
+                                                            std::string& err) {
+    std::shared_ptr<TransportSlot> slot;
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lk(r.mu);
+        auto& s = r.transports[spec.transportKey()];
+        if (!s) s = std::make_shared<TransportSlot>();
+        slot = s;
+    }
+    std::lock_guard<std::mutex> lk(slot->mu);
+    if (slot->tp) return slot->tp;
+
+    std::shared_ptr<ControlPlane::IDeviceTransport> tp;
+    if (spec.transport == "sim") {
+        auto sim = std::make_shared<ControlPlane::SimTransport>(make_sim_model(spec.model.empty() ? spec.type : spec.model));
+        ControlPlane::SimOptions opt;
+        opt.tick_us = static_cast<uint32_t>(spec.num("tick_us", opt.tick_us));
+        sim->setOptions(opt);
+        tp = std::move(sim);
+    } else {
+        tp = std::make_shared<ControlPlane::XdmaTransport>();
+    }
+    if (!tp->open(tc)) {
+        err = "transport open failed: " + tc.device_path;
+        return nullptr;
+    }
+    slot->tp = tp;
+    return tp;
+}
+
+// 设备的控制面：sim 整体共享；xdma 的寄存器窗口与事件按设备打开（BAR 映射进程内共享），
+// 仅 DMA 通道与异步后端按 路径 + 通道 共享
+std::shared_ptr<ControlPlane::IDeviceTransport> open_transport(const DeviceSpec& spec, std::string& err) {
+    if (spec.transport == "sim") return open_shared(spec, spec.tc, err);
+
+    const bool has_dma = spec.tc.dma_h2c_channel >= 0 || spec.tc.dma_c2h_channel >= 0;
+    std::shared_ptr<ControlPlane::IDeviceTransport> tp;
+    if (has_dma) {
+        TransportConfig dc;
+        dc.device_path = spec.tc.device_path;
+        dc.dma_h2c_channel = spec.tc.dma_h2c_channel;
+        dc.dma_c2h_channel = spec.tc.dma_c2h_channel;
+        auto dma = open_shared(spec, dc, err);
+        if (!dma) return nullptr;
+        tp = std::make_shared<ControlPlane::SharedDmaTransport>(std::make_unique<ControlPlane::XdmaTransport>(),
+                                                                std::move(dma));
+    } else {
+        tp = std::make_shared<ControlPlane::XdmaTransport>();
+    }
+    if (!tp->open(spec.tc)) {
+        err = "transport open failed: " + spec.tc.device_path;
+        return nullptr;
+    }
+    return tp;
+}
+
+Device::Rs422Device::Config rs422_config(const DeviceSpec& s) {
+    Device::Rs422Device::Config c;
+    c.ucr        = static_cast<uint8_t>(s.num("ucr", c.ucr));
+    c.mcr        = static_cast<uint8_t>(s.num("mcr", c.mcr));
+    c.brsr       = static_cast<uint8_t>(s.num("brsr", c.brsr));
+    c.icr        = static_cast<uint8_t>(s.num("icr", c.icr));
+    c.tx_head_lo = static_cast<uint8_t>(s.num("tx_head_lo", c.tx_head_lo));
+    c.tx_head_hi = static_cast<uint8_t>(s.num("tx_head_hi", c.tx_head_hi));
+    c.rx_head_lo = static_cast<uint8_t>(s.num("rx_head_lo", c.rx_head_lo));
+    c.rx_head_hi = static_cast<uint8_t>(s.num("rx_head_hi", c.rx_head_hi));
+    c.lpb        = static_cast<uint8_t>(s.num("lpb", c.lpb));
+    c.intr       = static_cast<uint8_t>(s.num("intr", c.intr));
+    c.evt        = static_cast<uint16_t>(s.num("evt", c.evt));
+    return c;
+}
+
+// 按类型下发配置：param 非空时覆盖配置中的对应参数；返回 false 时 err 给出失败步骤
+bool configure(const DeviceSpec& s, DataPlane::ILink& dev, void* param, std::string& err) {
+    int ret = 0;
+    if (s.type == "can") {
+        uint32_t loopback = static_cast<uint32_t>(s.num("loopback", 0));
+        if ((ret = dev.ioctl(Device::CanDevice::IOCTL_SET_LOOPBACK, &loopback, sizeof(loopback))) != 0) {
+            err = "set loopback failed: " + std::to_string(ret);
+            return false;
         }
-    } else if (name == "helm") {
-        tc.device_offset = 0x60000;
-        h->tp.open(tc);
-        h->mtu = 16;
-        h->dev = std::make_unique<Device::HelmDevice>(h->tp, h->mtu);
-        LinkConfig lc; 
-        h->dev->open(lc);
-        if (param != nullptr) {
-            h->dev->ioctl(Device::HelmDevice::IOCTL_HELM, param, sizeof(Device::HelmDevice::Config));
-        } else {
-            Device::HelmDevice::Config ctl_helm = {
-                .pwm_freq = 8000,
-                .out_enable = 0xF,
-                .ad_filter = 1,
-            };
-            h->dev->ioctl(Device::HelmDevice::IOCTL_HELM, &ctl_helm, sizeof(ctl_helm));
+        uint32_t baud = param ? *static_cast<const uint32_t*>(param) : static_cast<uint32_t>(s.num("baud", 500000));
+        if ((ret = dev.ioctl(Device::CanDevice::IOCTL_SET_BIT_TIMING, &baud, sizeof(baud))) != 0) {
+            err = "set baud " + std::to_string(baud) + " failed: " + std::to_string(ret);
+            return false;
         }
-    } else if (name == "imu") {
-        tc.device_offset = 0x10000;
-        tc.event_number = 1;
-        h->tp.open(tc);
-        h->mtu = 255;
-        h->dev = std::make_unique<Device::Rs422Device>(h->tp, h->mtu);
-        LinkConfig lc; 
-        h->dev->open(lc);
-        Device::Rs422Device::Config cfg_return;
-        if (param != nullptr) {
-            h->dev->ioctl(Device::Rs422Device::IOCTL_CONFIG, 
-                param, sizeof(Device::Rs422Device::Config), 
-                &cfg_return, sizeof(Device::Rs422Device::Config)); 
+    } else if (s.type == "canfd") {
+        uint32_t baud = param ? *static_cast<const uint32_t*>(param) : static_cast<uint32_t>(s.num("baud", 0));
+        if (baud && (ret = dev.ioctl(CAN_DEV_SET_BAUD, &baud, sizeof(baud))) != 0) {
+            err = "set baud " + std::to_string(baud) + " failed: " + std::to_string(ret);
+            return false;
+        }
+        uint32_t data_baud = static_cast<uint32_t>(s.num("data_baud", 0));
+        if (data_baud && (ret = dev.ioctl(CAN_DEV_SET_DATA_BAUD, &data_baud, sizeof(data_baud))) != 0) {
+            err = "set data baud " + std::to_string(data_baud) + " failed: " + std::to_string(ret);
+            return false;
+        }
+    } else if (s.type == "helm") {
+        Device::HelmDevice::Config cfg{};
+        if (param) {
+            cfg = *static_cast<const Device::HelmDevice::Config*>(param);
         } else {
-            Device::Rs422Device::Config cfg = {
-                .ucr = 0x30,
-                .mcr = 0x20,
-                .brsr = 0x0A,
-                .icr = 0x01,
-                .tx_head_lo = 0xAA,
-                .tx_head_hi = 0x1A,
-                .rx_head_lo = 0xAA,
-                .rx_head_hi = 0x1A,
-                .lpb = 0x00,    // AF = 回环
-                .intr = 0xAE,   // AE = 自控中断
-                .evt = 1250,    // 125 = 脉冲宽度 1us
-            };
-            h->dev->ioctl(Device::Rs422Device::IOCTL_CONFIG, 
-                &cfg, sizeof(cfg), 
-                &cfg_return, sizeof(cfg_return)); 
+            cfg.pwm_freq   = static_cast<uint16_t>(s.num("pwm_freq", 8000));
+            cfg.out_enable = static_cast<uint16_t>(s.num("out_enable", 0xF));
+            cfg.ad_filter  = static_cast<uint16_t>(s.num("ad_filter", 1));
+        }
+        if ((ret = dev.ioctl(Device::HelmDevice::IOCTL_HELM, &cfg, sizeof(cfg))) != 0) {
+            err = "helm config failed: " + std::to_string(ret);
+            return false;
         }
-    }  else if (name == "dyt") {
-        tc.device_offset = 0x20000;
-        tc.event_number = 2;
-        h->tp.open(tc);
-        h->mtu = 255;
-        h->dev = std::make_unique<Device::Rs422Device>(h->tp, h->mtu);
-        LinkConfig lc; 
-        h->dev->open(lc);
+    } else if (s.type == "rs422") {
+        Device::Rs422Device::Config cfg = param ? *static_cast<const Device::Rs422Device::Config*>(param) : rs422_config(s);
         Device::Rs422Device::Config cfg_return;
-        if (param != nullptr) {
-            h->dev->ioctl(Device::Rs422Device::IOCTL_CONFIG, 
-                param, sizeof(Device::Rs422Device::Config), 
-                &cfg_return, sizeof(Device::Rs422Device::Config)); 
-        } else {
-            Device::Rs422Device::Config cfg = {
-                .ucr = 0x30,
-                .mcr = 0x20,
-                .brsr = 0x0A,
-                .icr = 0x01,
-                .tx_head_lo = 0xAA,
-                .tx_head_hi = 0x1A,
-                .rx_head_lo = 0xAA,
-                .rx_head_hi = 0x1A,
-                .lpb = 0x00,    // AF = 回环
-                .intr = 0xAE,   // AE = 自控中断
-                .evt = 1250,    // 125 = 脉冲宽度 1us
-            };
-            h->dev->ioctl(Device::Rs422Device::IOCTL_CONFIG, 
-                &cfg, sizeof(cfg), 
-                &cfg_return, sizeof(cfg_return)); 
+        if ((ret = dev.ioctl(Device::Rs422Device::IOCTL_CONFIG, &cfg, sizeof(cfg), &cfg_return, sizeof(cfg_return))) != 0) {
+            err = "rs422 config failed: " + std::to_string(ret);
+            return false;
         }
-    } else if (name == "ddr") {
-        tc.dma_h2c_channel = 0;
-        tc.dma_c2h_channel = 0;
-        tc.device_offset = 0x0;
-        tc.event_number = 6;
-        h->tp.open(tc);
-        h->mtu = 640 * 1024;
-        h->dev = std::make_unique<Device::DdrDevice>(h->tp, h->mtu);
-        LinkConfig lc; 
-        h->dev->open(lc);
-    } else if (name == "udp") {
-        h->mtu = 60000;
+    }
+    return true;
+}
+
+std::shared_ptr<HandleImpl> build(const DeviceSpec& s, void* param, std::string& err) {
+    auto h = std::make_shared<HandleImpl>();
+    h->mtu = s.mtu;
+    h->burst = static_cast<uint32_t>(s.num("rx_burst", s.type == "ddr" ? 1 : h->burst));
+    if (h->burst == 0) h->burst = 1;
+    LinkConfig lc;
+    if (s.type == "udp") {
         h->dev = std::make_unique<DataPlane::UdpLink>();
-        LinkConfig lc; 
-        if (param != nullptr) {
-            lc.name = std::string((const char*)param);
-        } else {
-            lc.name = std::string("12345");
-        }
+        lc.name = param ? std::string(static_cast<const char*>(param)) : s.str("name", "12345");
         lc.mtu = h->mtu;
-        h->dev->open(lc);
-    } else {
+        if (!h->dev->open(lc)) {
+            err = "udp open failed: " + lc.name;
+            return nullptr;
+        }
+        return h;
+    }
+
+    if (s.type != "can" && s.type != "canfd" && s.type != "helm" && s.type != "rs422" && s.type != "ddr") {
+        err = "unknown type '" + s.type + "'";
         return nullptr;
     }
+    if (s.transport == "none") {
+        err = "type '" + s.type + "' requires a transport";
+        return nullptr;
+    }
+    h->tp = open_transport(s, err);
+    if (!h->tp) return nullptr;
+
+    auto& tp = *h->tp;
+    const uint16_t mtu = static_cast<uint16_t>(h->mtu);
+    if (s.type == "can")        h->dev = std::make_unique<Device::CanDevice>(tp, mtu);
+    else if (s.type == "canfd") h->dev = std::make_unique<Device::CanFDDevice>(tp, mtu);
+    else if (s.type == "helm")  h->dev = std::make_unique<Device::HelmDevice>(tp, mtu);
+    else if (s.type == "rs422") h->dev = std::make_unique<Device::Rs422Device>(tp, mtu);
+    else                        h->dev = std::make_unique<Device::DdrDevice>(tp, mtu);
+
+    if (!h->dev->open(lc)) {
+        err = "device open failed";
+        return nullptr;
+    }
+    if (!configure(s, *h->dev, param, err)) return nullptr;
     return h;
 }
 
+std::shared_ptr<Entry> find_entry(const std::string& name) {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.ensure_loaded();
+    auto it = r.entries.find(name);
+    return it == r.entries.end() ? nullptr : it->second;
+}
+
+// 按配置打开一个设备并缓存；已缓存时直接返回。失败时 err 非空
+std::shared_ptr<HandleImpl> open_entry(Entry& e, std::string& err) {
+    std::lock_guard<std::mutex> lk(e.mu);
+    if (!e.handle) e.handle = build(e.spec, nullptr, err);
+    return e.handle;
+}
+
+uint64_t elapsed_us(std::chrono::steady_clock::time_point t0) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count());
+}
+}
+
+bool HardwareFactory::loadConfig(const std::string& path, std::string* err) {
+    HardwareConfig c;
+    std::string e;
+    if (!HardwareConfig::load(path, c, &e)) {
+        LOGE("factory", "config", -EINVAL, "%s", e.c_str());
+        if (err) *err = e;
+        return false;
+    }
+    auto& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    LOGI("factory", "config", 0, "loaded %zu devices from %s", c.devices.size(), path.c_str());
+    r.reset(std::move(c));
+    return true;
+}
+
+bool HardwareFactory::loadConfigText(const std::string& text, std::string* err) {
+    HardwareConfig c;
+    std::string e;
+    if (!HardwareConfig::parse(text, c, &e)) {
+        LOGE("factory", "config", -EINVAL, "%s", e.c_str());
+        if (err) *err = e;
+        return false;
+    }
+    auto& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.reset(std::move(c));
+    return true;
+}
+
+HardwareConfig HardwareFactory::config() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    r.ensure_loaded();
+    return r.cfg;
+}
+
+std::shared_ptr<DDS::Handle> HardwareFactory::create(const std::string& name, void* param) {
+    auto e = find_entry(name);
+    if (!e) {
+        LOGE("factory", "create", -ENOENT, "unknown device '%s'", name.c_str());
+        return nullptr;
+    }
+    std::string err;
+    auto h = build(e->spec, param, err);
+    if (!h) {
+        LOGE("factory", "create", -EIO, "%s: %s", name.c_str(), err.c_str());
+        return nullptr;
+    }
+    return h;
+}
+
+std::shared_ptr<DDS::Handle> HardwareFactory::get(const std::string& name) {
+    auto e = find_entry(name);
+    if (!e) {
+        LOGE("factory", "get", -ENOENT, "unknown device '%s'", name.c_str());
+        return nullptr;
+    }
+    std::string err;
+    auto h = open_entry(*e, err);
+    if (!h) {
+        LOGE("factory", "get", -EIO, "%s: %s", name.c_str(), err.c_str());
+        return nullptr;
+    }
+    return h;
+}
+
+std::vector<HardwareFactory::OpenReport> HardwareFactory::openAll(const std::vector<std::string>& names) {
+    std::vector<std::string> list = names;
+    if (list.empty()) {
+        for (const auto& d : config().devices) list.push_back(d.name);
+    }
+
+    std::vector<OpenReport> reports(list.size());
+    std::vector<std::thread> workers;
+    workers.reserve(list.size());
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < list.size(); ++i) {
+        reports[i].name = list[i];
+        workers.emplace_back([&rep = reports[i], t0]() {
+            auto e = find_entry(rep.name);
+            if (!e) {
+                rep.error = "unknown device";
+            } else {
+                rep.ok = open_entry(*e, rep.error) != nullptr;
+            }
+            rep.elapsed_us = elapsed_us(t0);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    size_t failed = 0;
+    for (const auto& rep : reports) {
+        if (rep.ok) continue;
+        ++failed;
+        LOGE("factory", "open", -EIO, "%s: %s (%lluus)", rep.name.c_str(), rep.error.c_str(),
+             static_cast<unsigned long long>(rep.elapsed_us));
+    }
+    LOGI("factory", "open", 0, "%zu devices, %zu failed, %zu transports, %lluus", reports.size(), failed,
+         transportCount(), static_cast<unsigned long long>(elapsed_us(t0)));
+    return reports;
+}
+
+size_t HardwareFactory::transportCount() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lk(r.mu);
+    size_t n = 0;
+    for (const auto& kv : r.transports) {
+        std::lock_guard<std::mutex> sl(kv.second->mu);
+        if (kv.second->tp) ++n;
+    }
+    return n;
+}
+
 } // namespace Factory
 } // namespace PhysicalLayer
-} // namespace MB_DDF
\ No newline at end of file
+} // namespace MB_DDF
@@ -1,7 +1,23 @@
+/**
+ * @file HardwareFactory.h
+ * @brief 硬件句柄工厂：按设备图配置（HardwareConfig）创建设备句柄，并为已配置设备提供缓存句柄
+ *
+ * 设计要点：
+ * - 配置只加载一次：loadConfig()/loadConfigText() 显式指定；否则首次使用时读取环境变量
+ *   MB_DDF_HW_CONFIG 指向的 INI 文件，未设置或加载失败时使用内置默认设备表。
+ * - 传输层按 DeviceSpec::transportKey()（设备路径 + DMA 通道）共享：同一键的 DMA 通道与异步后端只打开一次；
+ *   寄存器偏移/窗口与事件号按设备各自打开（xdma 的 BAR 映射本身进程内共享，见 UserBarMapping）。
+ * - create(name) 每次调用都新建句柄（传输层仍按上条共享）；get(name) 按配置打开并缓存，之后返回同一句柄。
+ *   openAll() 并行初始化多个设备的缓存句柄并逐一报告结果（失败原因与耗时）。
+ * - 任何一步打开/配置失败都返回 nullptr 并记录日志，不返回半初始化的句柄。
+ */
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include "MB_DDF/DDS/DDSHandle.h"
+#include "MB_DDF/PhysicalLayer/Factory/HardwareConfig.h"
 
 namespace MB_DDF {
 namespace PhysicalLayer {
@@ -9,9 +25,33 @@ namespace Factory {
 
 class HardwareFactory {
 public:
+    struct OpenReport {
+        std::string name;
+        bool ok = false;
+        std::string error;              // 失败原因
+        uint64_t elapsed_us = 0;        // 本设备初始化耗时（含等待共享传输层）
+    };
+
+    // 替换设备图：已创建的句柄与传输层全部释放（调用方仍持有的句柄在释放前保持有效）
+    static bool loadConfig(const std::string& path, std::string* err = nullptr);
+    static bool loadConfigText(const std::string& text, std::string* err = nullptr);
+    static HardwareConfig config();
+
+    // param 非空时按设备类型解释（can: uint32_t 波特率；helm: HelmDevice::Config；
+    // rs422: Rs422Device::Config；udp: const char* 链路名），覆盖配置中的对应参数
+    // 每次调用都新建句柄
     static std::shared_ptr<DDS::Handle> create(const std::string& name, void* param = nullptr);
+
+    // 缓存句柄：首次调用按配置打开，之后返回同一句柄（与 openAll() 共用缓存）
+    static std::shared_ptr<DDS::Handle> get(const std::string& name);
+
+    // 并行初始化 names 中设备的缓存句柄（空表示配置中的全部设备），按输入顺序返回结果
+    static std::vector<OpenReport> openAll(const std::vector<std::string>& names = {});
+
+    // 当前打开的共享传输层数量（sim 设备模型实例 + xdma DMA 通道组）
+    static size_t transportCount();
 };
 
+} // namespace Factory
 } // namespace PhysicalLayer
 } // namespace MB_DDF
-} // namespace Factory
@@ -90,6 +90,7 @@ namespace Device {
 #define XCAN_SR_BBSY_MASK          0x00000020  /* 总线忙 */
 #define XCAN_SR_ERRWRN_MASK        0x00000040  /* 错误警告 */
 #define XCAN_SR_ESTAT_MASK         0x00000180  /* 错误状态（两位） */
+#define XCAN_SR_TXFLL_MASK         0x00000400  /* 发送 FIFO 满 */
 #define XCAN_SR_ACFBSY_MASK        0x00000800  /* 验收滤波器忙（Test 使用 0x00000800） */
 
 /*********************************************************************************************************
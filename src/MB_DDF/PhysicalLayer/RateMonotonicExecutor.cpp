@@ -0,0 +1,189 @@
+/**
+ * @file RateMonotonicExecutor.cpp
+ */
+#include "MB_DDF/PhysicalLayer/RateMonotonicExecutor.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <algorithm>
+#include <cerrno>
+#include <exception>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+
+RateMonotonicExecutor::RateMonotonicExecutor(Options opt) : opt_(opt) {}
+
+RateMonotonicExecutor::~RateMonotonicExecutor() {
+    stop();
+}
+
+RateMonotonicExecutor::GroupId RateMonotonicExecutor::addGroup(const GroupOptions& opt) {
+    if (running_ || opt.period_us == 0) return kInvalidId;
+    auto g = std::make_unique<Group>();
+    g->opt = opt;
+    if (g->opt.name.empty()) g->opt.name = "group" + std::to_string(groups_.size());
+    groups_.push_back(std::move(g));
+    return static_cast<GroupId>(groups_.size() - 1);
+}
+
+RateMonotonicExecutor::ChainId RateMonotonicExecutor::addChain(GroupId group, const std::string& name,
+                                                               std::vector<Step> steps) {
+    if (running_ || group >= groups_.size()) return kInvalidId;
+    auto c = std::make_unique<Chain>();
+    c->name = name;
+    for (auto& s : steps) {
+        if (s) c->steps.push_back(std::move(s));
+    }
+    auto& chains = groups_[group]->chains;
+    chains.push_back(std::move(c));
+    return static_cast<ChainId>(chains.size() - 1);
+}
+
+RateMonotonicExecutor::Step RateMonotonicExecutor::readDevice(std::shared_ptr<DDS::Handle> handle, Frame& f) {
+    return [handle = std::move(handle), &f]() {
+        const int32_t got = handle->receive(f.data.data(), static_cast<uint32_t>(f.data.size()));
+        f.size = got > 0 ? static_cast<uint32_t>(got) : 0;
+        return got >= 0;
+    };
+}
+
+RateMonotonicExecutor::Step RateMonotonicExecutor::readTopic(std::shared_ptr<DDS::Subscriber> sub, Frame& f) {
+    return [sub = std::move(sub), &f]() {
+        f.size = static_cast<uint32_t>(sub->read(f.data.data(), f.data.size(), true));
+        return true;
+    };
+}
+
+RateMonotonicExecutor::Step RateMonotonicExecutor::publish(std::shared_ptr<DDS::Publisher> pub, const Frame& f) {
+    return [pub = std::move(pub), &f]() { return f.size == 0 || pub->publish(f.data.data(), f.size); };
+}
+
+RateMonotonicExecutor::Step RateMonotonicExecutor::writeDevice(std::shared_ptr<DDS::Handle> handle, const Frame& f) {
+    return [handle = std::move(handle), &f]() { return f.size == 0 || handle->send(f.data.data(), f.size); };
+}
+
+int RateMonotonicExecutor::rate_priority(const Group& g) const {
+    if (g.opt.priority >= 0) return g.opt.priority;
+    if (opt_.sched_policy != SCHED_FIFO && opt_.sched_policy != SCHED_RR) return 0;
+    // 速率单调：优先级按更短的不同周期个数递减
+    std::vector<uint32_t> shorter;
+    for (const auto& o : groups_) {
+        if (o->opt.period_us < g.opt.period_us) shorter.push_back(o->opt.period_us);
+    }
+    std::sort(shorter.begin(), shorter.end());
+    const int rank = static_cast<int>(std::unique(shorter.begin(), shorter.end()) - shorter.begin());
+    return std::max(opt_.max_priority - rank, sched_get_priority_min(opt_.sched_policy));
+}
+
+int RateMonotonicExecutor::priorityOf(GroupId group) const {
+    if (group >= groups_.size()) return -1;
+    return running_ ? groups_[group]->priority : rate_priority(*groups_[group]);
+}
+
+bool RateMonotonicExecutor::start() {
+    if (running_) return true;
+    if (groups_.empty()) return false;
+    for (auto& g : groups_) {
+        g->priority = rate_priority(*g);
+        for (auto& c : g->chains) {
+            c->runs = 0; c->aborted = 0; c->deadline_misses = 0;
+            c->latency_last = 0; c->latency_max = 0; c->latency_total = 0;
+        }
+    }
+    running_ = true;
+    for (auto& g : groups_) {
+        Group* gp = g.get();
+        Timer::SystemTimerOptions topt;
+        topt.mode = Timer::SystemTimerMode::ThreadLoop;
+        topt.sched_policy = opt_.sched_policy;
+        topt.priority = gp->priority;
+        topt.cpu = gp->opt.cpu;
+        try {
+            gp->timer = Timer::SystemTimer::start(
+                std::to_string(gp->opt.period_us) + "us",
+                [this, gp](long long release_ns) { run_cycle(*gp, static_cast<uint64_t>(release_ns)); }, topt);
+        } catch (const std::exception& e) {
+            LOGE("rm_exec", "start", -EINVAL, "group=%s timer: %s", gp->opt.name.c_str(), e.what());
+            stop();
+            return false;
+        }
+        LOGI("rm_exec", "start", 0, "group=%s period=%uus prio=%d cpu=%d chains=%zu", gp->opt.name.c_str(),
+             gp->opt.period_us, gp->priority, gp->opt.cpu, gp->chains.size());
+    }
+    return true;
+}
+
+void RateMonotonicExecutor::stop() {
+    if (!running_) return;
+    for (auto& g : groups_) {
+        if (g->timer) g->timer->stop();
+    }
+    running_ = false;
+}
+
+// 各链按加入顺序执行；链完成时刻相对本周期释放时刻计时
+void RateMonotonicExecutor::run_cycle(Group& g, uint64_t release_ns) {
+    const uint64_t deadline = static_cast<uint64_t>(g.opt.deadline_us ? g.opt.deadline_us : g.opt.period_us) * 1000;
+    for (auto& c : g.chains) {
+        bool completed = true;
+        for (auto& step : c->steps) {
+            if (!step()) {
+                completed = false;
+                break;
+            }
+        }
+        const uint64_t now = static_cast<uint64_t>(Timer::SystemTimer::monoNowNs());
+        const uint64_t latency = now > release_ns ? now - release_ns : 0;
+        c->runs.fetch_add(1, std::memory_order_relaxed);
+        if (!completed) c->aborted.fetch_add(1, std::memory_order_relaxed);
+        if (latency > deadline) c->deadline_misses.fetch_add(1, std::memory_order_relaxed);
+        c->latency_last.store(latency, std::memory_order_relaxed);
+        c->latency_total.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > c->latency_max.load(std::memory_order_relaxed)) c->latency_max.store(latency, std::memory_order_relaxed);
+    }
+}
+
+std::vector<RateMonotonicExecutor::GroupStats> RateMonotonicExecutor::groupStats() const {
+    std::vector<GroupStats> out;
+    out.reserve(groups_.size());
+    for (size_t i = 0; i < groups_.size(); ++i) {
+        const auto& g = *groups_[i];
+        GroupStats s;
+        s.name = g.opt.name;
+        s.period_us = g.opt.period_us;
+        s.priority = priorityOf(static_cast<GroupId>(i));
+        s.cpu = g.opt.cpu;
+        if (g.timer) {
+            const Timer::SystemTimerStats ts = g.timer->stats();
+            s.cycles = ts.cycles;
+            s.overruns = ts.overruns;
+            s.late_ns_max = ts.wake_latency_ns_max;
+            s.late_ns_total = ts.wake_latency_ns_total;
+            s.busy_ns_max = ts.exec_ns_max;
+            s.busy_ns_total = ts.exec_ns_total;
+        }
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+std::vector<RateMonotonicExecutor::ChainStats> RateMonotonicExecutor::chainStats() const {
+    std::vector<ChainStats> out;
+    for (const auto& g : groups_) {
+        for (const auto& c : g->chains) {
+            ChainStats s;
+            s.name = c->name;
+            s.group = g->opt.name;
+            s.runs = c->runs.load(std::memory_order_relaxed);
+            s.aborted = c->aborted.load(std::memory_order_relaxed);
+            s.deadline_misses = c->deadline_misses.load(std::memory_order_relaxed);
+            s.latency_ns_last = c->latency_last.load(std::memory_order_relaxed);
+            s.latency_ns_max = c->latency_max.load(std::memory_order_relaxed);
+            s.latency_ns_total = c->latency_total.load(std::memory_order_relaxed);
+            out.push_back(std::move(s));
+        }
+    }
+    return out;
+}
+
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,160 @@
+/**
+ * @file RateMonotonicExecutor.h
+ * @brief 速率单调执行器：按速率组在绑核线程上周期执行有序任务链（读设备 -> 发布 -> 计算 -> 写设备）
+ *
+ * 设计要点：
+ * - 速率组：每组一个 SystemTimer ThreadLoop 定时线程，按绝对时刻周期唤醒（错过的周期跳过），可绑核；
+ *   未指定优先级的组在 start() 时按速率单调分配：周期越短优先级越高（同周期同优先级），
+ *   最短周期取 Options::max_priority，依次递减。
+ * - 任务链：组内各链按加入顺序在同一线程中串行执行，链内步骤按顺序执行；步骤返回 false 时结束该链本周期。
+ *   控制路径上没有跨线程交接：设备读写、Topic 读取与发布都在组线程内同步完成。
+ * - 输入非阻塞：readDevice 使用句柄的非阻塞 receive，readTopic 以 Subscriber::read 取最新消息
+ *   （订阅者不得绑定回调）；无新数据时 Frame::size 置 0，链继续执行，后续 publish/writeDevice 跳过该帧。
+ * - 数据经调用方预分配的 Frame 在步骤间传递，周期内不分配内存；Frame 须在 stop() 前保持有效。
+ * - 统计：链端到端时延（链完成时刻 - 本周期计划释放时刻，含唤醒延迟与同组前序链耗时）末次/最大/累计、
+ *   截止时间错过、中止次数；组唤醒迟到、忙碌时长与跳过周期取自组定时器遥测。均为原子计数，可跨线程读取。
+ * - 执行器内部不在组线程之间共享锁；各组之间的数据交换经 DDS Topic（共享内存环）完成。
+ * - addGroup/addChain 须在 start() 前完成。
+ */
+#pragma once
+
+#include "MB_DDF/DDS/DDSHandle.h"
+#include "MB_DDF/DDS/Publisher.h"
+#include "MB_DDF/DDS/Subscriber.h"
+#include "MB_DDF/Timer/SystemTimer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <sched.h>
+#include <string>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+
+// 用法示例：
+//   RateMonotonicExecutor exec;
+//   auto fast = exec.addGroup({"helm", 250, 6});               // 250us，绑核 6
+//   RateMonotonicExecutor::Frame ad(64), cmd(64);
+//   exec.addChain(fast, "servo", {
+//       RateMonotonicExecutor::readDevice(helm, ad),
+//       RateMonotonicExecutor::publish(ad_pub, ad),
+//       [&]() { /* 由 ad 计算 cmd */ return true; },
+//       RateMonotonicExecutor::writeDevice(helm, cmd)});
+//   exec.start();
+class RateMonotonicExecutor {
+public:
+    using GroupId = uint32_t;
+    using ChainId = uint32_t;
+    static constexpr uint32_t kInvalidId = UINT32_MAX;
+
+    // 步骤：在组线程中执行，返回 false 结束所在链的本周期
+    using Step = std::function<bool()>;
+
+    // 步骤间传递的数据：data 为预分配缓冲，size 为有效长度（0 表示本周期无新数据）
+    struct Frame {
+        std::vector<uint8_t> data;
+        uint32_t size = 0;
+        explicit Frame(size_t capacity = 0) : data(capacity) {}
+    };
+
+    struct Options {
+        int sched_policy = SCHED_FIFO;                // 各组线程的调度策略
+        int max_priority = 80;                        // 最短周期组的优先级
+    };
+
+    struct GroupOptions {
+        std::string name;
+        uint32_t period_us = 1000;
+        int cpu = -1;                                 // 绑核编号，-1 表示不绑核
+        int priority = -1;                            // <0 按速率单调分配
+        uint32_t deadline_us = 0;                     // 链相对释放时刻的截止时间；0 取周期
+    };
+
+    struct GroupStats {
+        std::string name;
+        uint32_t period_us = 0;
+        int priority = 0;                             // 实际采用的优先级
+        int cpu = -1;
+        uint64_t cycles = 0;
+        uint64_t overruns = 0;                        // 因超时跳过的周期数
+        uint64_t late_ns_max = 0;                     // 唤醒迟到（相对计划释放时刻）
+        uint64_t late_ns_total = 0;
+        uint64_t busy_ns_max = 0;                     // 一个周期内执行全部链的耗时
+        uint64_t busy_ns_total = 0;
+    };
+
+    struct ChainStats {
+        std::string name;
+        std::string group;
+        uint64_t runs = 0;
+        uint64_t aborted = 0;                         // 步骤返回 false 提前结束的次数
+        uint64_t deadline_misses = 0;
+        uint64_t latency_ns_last = 0;                 // 链完成时刻 - 本周期计划释放时刻
+        uint64_t latency_ns_max = 0;
+        uint64_t latency_ns_total = 0;
+    };
+
+    RateMonotonicExecutor() : RateMonotonicExecutor(Options{}) {}
+    explicit RateMonotonicExecutor(Options opt);
+    ~RateMonotonicExecutor();
+
+    RateMonotonicExecutor(const RateMonotonicExecutor&) = delete;
+    RateMonotonicExecutor& operator=(const RateMonotonicExecutor&) = delete;
+
+    // 失败（运行中或周期为 0）返回 kInvalidId
+    GroupId addGroup(const GroupOptions& opt);
+    ChainId addChain(GroupId group, const std::string& name, std::vector<Step> steps);
+
+    // 常用步骤：
+    // 非阻塞读设备一帧到 f（无数据时 size=0；接收出错时结束链）
+    static Step readDevice(std::shared_ptr<DDS::Handle> handle, Frame& f);
+    // 非阻塞读 Topic 最新消息到 f（无新消息时 size=0）
+    static Step readTopic(std::shared_ptr<DDS::Subscriber> sub, Frame& f);
+    // 发布 f 到 Topic（size=0 时跳过；发布失败时结束链）
+    static Step publish(std::shared_ptr<DDS::Publisher> pub, const Frame& f);
+    // 将 f 写到设备（size=0 时跳过；发送失败时结束链）
+    static Step writeDevice(std::shared_ptr<DDS::Handle> handle, const Frame& f);
+
+    bool start();
+    void stop();
+    bool running() const { return running_; }
+
+    size_t groups() const { return groups_.size(); }
+    // start() 后为实际采用的优先级；未启动时为按当前各组计算的值
+    int priorityOf(GroupId group) const;
+
+    std::vector<GroupStats> groupStats() const;
+    std::vector<ChainStats> chainStats() const;
+
+private:
+    struct Chain {
+        std::string name;
+        std::vector<Step> steps;
+        std::atomic<uint64_t> runs{0};
+        std::atomic<uint64_t> aborted{0};
+        std::atomic<uint64_t> deadline_misses{0};
+        std::atomic<uint64_t> latency_last{0};
+        std::atomic<uint64_t> latency_max{0};
+        std::atomic<uint64_t> latency_total{0};
+    };
+
+    struct Group {
+        GroupOptions opt;
+        int priority = 0;
+        std::vector<std::unique_ptr<Chain>> chains;
+        std::unique_ptr<Timer::SystemTimer> timer;
+    };
+
+    int rate_priority(const Group& g) const;
+    void run_cycle(Group& g, uint64_t release_ns);
+
+    Options opt_;
+    std::vector<std::unique_ptr<Group>> groups_;
+    bool running_ = false;
+};
+
+} // namespace PhysicalLayer
+} // namespace MB_DDF
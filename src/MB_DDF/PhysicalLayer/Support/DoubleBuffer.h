@@ -0,0 +1,59 @@
+/**
+ * @file DoubleBuffer.h
+ * @brief 单写者双缓冲：写者交替写两个槽位后发布版本号，读者无锁取最新完整值
+ *
+ * 写者写入"非当前"槽位：写前版本号置奇数（写入中），写完置偶数使其成为当前槽位；读者按版本取当前槽位拷贝，
+ * 拷贝后确认写者尚未开始改写该槽位（即其后第二次写入未开始），否则重试。
+ * 适用于周期控制环与外部线程之间交换小型 POD 结构（命令/反馈），读写双方均不阻塞。
+ * 多个写者需由调用方串行。
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Support {
+
+template <typename T>
+class DoubleBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "DoubleBuffer requires a trivially copyable type");
+
+public:
+    DoubleBuffer() = default;
+    explicit DoubleBuffer(const T& init) { slots_[0] = init; slots_[1] = init; }
+
+    DoubleBuffer(const DoubleBuffer&) = delete;
+    DoubleBuffer& operator=(const DoubleBuffer&) = delete;
+
+    void write(const T& v) {
+        const uint64_t ver = version_.load(std::memory_order_relaxed);
+        version_.store(ver + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slots_[((ver >> 1) + 1) & 1] = v;
+        version_.store(ver + 2, std::memory_order_release);
+    }
+
+    // 返回读到值的写入序号（0 表示从未写入）
+    uint64_t read(T& out) const {
+        for (;;) {
+            const uint64_t v1 = version_.load(std::memory_order_acquire);
+            out = slots_[(v1 >> 1) & 1];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t v2 = version_.load(std::memory_order_relaxed);
+            if (v2 <= (v1 & ~uint64_t{1}) + 2) return v1 >> 1;
+        }
+    }
+
+    uint64_t version() const { return version_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    T slots_[2]{};
+    std::atomic<uint64_t> version_{0};
+};
+
+} // namespace Support
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,99 @@
+/**
+ * @file MpscQueue.h
+ * @brief 有界无锁队列（Vyukov 环形序号算法）：多生产者 push、消费者 pop，均不加锁、不阻塞
+ *
+ * 每个槽位携带序号：生产者以 CAS 抢占写位置、写入后发布序号；消费者按序号判断槽位是否就绪。
+ * 算法本身支持多消费者，常用于"多个控制线程提交 -> 单个工作线程执行"。
+ * 队列满时 push 返回 false，由调用方决定丢弃或重试；元素类型需可默认构造与移动赋值。
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+namespace Support {
+
+template <typename T>
+class MpscQueue {
+public:
+    // capacity 向上取整为 2 的幂（至少 2）
+    explicit MpscQueue(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        cells_.reset(new Cell[cap]);
+        for (size_t i = 0; i < cap; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    bool push(T v) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // 满
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(v);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // 空
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->data);
+        cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // 近似元素数（并发下仅供统计）
+    size_t sizeApprox() const {
+        size_t e = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t d = dequeue_pos_.load(std::memory_order_relaxed);
+        return e >= d ? e - d : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq{0};
+        T data{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_{0};
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+} // namespace Support
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,189 @@
+/**
+ * @file TopicRouter.cpp
+ */
+#include "MB_DDF/PhysicalLayer/TopicRouter.h"
+#include "MB_DDF/DDS/DDSCore.h"
+#include "MB_DDF/PhysicalLayer/Factory/HardwareFactory.h"
+#include "MB_DDF/PhysicalLayer/Support/Log.h"
+#include <algorithm>
+#include <cerrno>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+
+TopicRouter::TopicRouter(uint32_t poll_interval_ms) : poll_interval_ms_(poll_interval_ms ? poll_interval_ms : 1) {}
+
+TopicRouter::~TopicRouter() {
+    stop();
+    for (auto& r : routes_) {
+        if (r->fd >= 0) mux_.remove(r->fd);
+    }
+    routes_.clear();                                  // 先停订阅者线程，再释放句柄
+}
+
+bool TopicRouter::attach(const std::string& name, std::shared_ptr<DDS::Handle> handle, const std::string& rx_topic,
+                         const std::string& tx_topic, RouteOptions opt) {
+    if (running()) {
+        LOGE("router", "attach", -EBUSY, "%s: attach after start", name.c_str());
+        return false;
+    }
+    if (!handle || (rx_topic.empty() && tx_topic.empty()) || rx_topic == tx_topic) {
+        LOGE("router", "attach", -EINVAL, "%s: rx=%s tx=%s", name.c_str(), rx_topic.c_str(), tx_topic.c_str());
+        return false;
+    }
+
+    auto r = std::make_unique<Route>();
+    r->name = name;
+    r->handle = std::move(handle);
+    r->opt = opt;
+    if (r->opt.max_frame == 0) r->opt.max_frame = r->handle->getMTU();
+    if (r->opt.burst == 0) r->opt.burst = std::max<uint32_t>(r->handle->framesPerEvent(), 1);
+
+    auto& dds = DDS::DDSCore::instance();
+    if (!rx_topic.empty()) {
+        r->pub = dds.create_publisher(rx_topic);
+        if (!r->pub) {
+            LOGE("router", "attach", -EIO, "%s: cannot publish %s", name.c_str(), rx_topic.c_str());
+            return false;
+        }
+        r->fd = r->handle->getEventFd();
+        if (r->fd >= 0) {
+            Route* rp = r.get();
+            bool ok = mux_.add(r->fd, EPOLLIN, [this, rp](int, uint32_t) {
+                rp->handle->ackEvent();
+                service(*rp);
+            });
+            if (!ok) {
+                LOGE("router", "attach", errno, "%s: event_fd=%d", name.c_str(), r->fd);
+                return false;
+            }
+        }
+    }
+    if (!tx_topic.empty()) {
+        Route* rp = r.get();
+        // 转发到设备的每条消息都要送达：按序投递
+        r->sub = dds.create_subscriber(tx_topic, true, [rp](const void* data, size_t size, uint64_t) {
+            if (rp->handle->send(static_cast<const uint8_t*>(data), static_cast<uint32_t>(size))) {
+                rp->tx_frames.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                rp->tx_failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }, true);
+        if (!r->sub) {
+            if (r->fd >= 0) mux_.remove(r->fd);
+            LOGE("router", "attach", -EIO, "%s: cannot subscribe %s", name.c_str(), tx_topic.c_str());
+            return false;
+        }
+    }
+    LOGI("router", "attach", 0, "%s rx=%s tx=%s event_fd=%d max_frame=%u burst=%u", name.c_str(), rx_topic.c_str(),
+         tx_topic.c_str(), r->fd, r->opt.max_frame, r->opt.burst);
+    routes_.push_back(std::move(r));
+    return true;
+}
+
+size_t TopicRouter::attachConfigured() {
+    size_t n = 0;
+    for (const auto& d : Factory::HardwareFactory::config().devices) {
+        if (d.rx_topic.empty() && d.tx_topic.empty()) continue;
+        auto h = Factory::HardwareFactory::get(d.name);
+        if (!h) continue;
+        RouteOptions opt;
+        opt.max_frame = static_cast<uint32_t>(d.num("rx_max_frame", 0));
+        if (attach(d.name, std::move(h), d.rx_topic, d.tx_topic, opt)) ++n;
+    }
+    return n;
+}
+
+void TopicRouter::service(Route& r) {
+    r.events.fetch_add(1, std::memory_order_relaxed);
+    uint32_t n = 0;
+    for (; n < r.opt.burst; ++n) {
+        int32_t got = 0;
+        auto msg = r.pub->begin_message(r.opt.max_frame);
+        if (msg.valid()) {
+            got = r.handle->receive(static_cast<uint8_t*>(msg.data()), r.opt.max_frame);
+            if (got > 0) {
+                if (msg.commit(static_cast<size_t>(got))) {
+                    r.zero_copy.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    r.publish_failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else {
+                msg.cancel();
+            }
+        } else {
+            if (r.scratch.size() < r.opt.max_frame) r.scratch.resize(r.opt.max_frame);
+            got = r.handle->receive(r.scratch.data(), r.opt.max_frame);
+            if (got > 0 && !r.pub->publish(r.scratch.data(), static_cast<size_t>(got))) {
+                r.publish_failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (got < 0) {
+            r.rx_errors.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        if (got == 0) break;
+        r.frames.fetch_add(1, std::memory_order_relaxed);
+        r.bytes.fetch_add(static_cast<uint64_t>(got), std::memory_order_relaxed);
+    }
+    r.pending = n == r.opt.burst;
+}
+
+bool TopicRouter::start() {
+    if (running()) return true;
+    stop_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread([this]() { loop(); });
+    LOGI("router", "start", 0, "routes=%zu poll_interval=%ums", routes_.size(), poll_interval_ms_);
+    return true;
+}
+
+void TopicRouter::stop() {
+    if (worker_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        mux_.wakeup();                                // 反应线程阻塞在 wait_once 中，经多路复用器内置 eventfd 唤醒
+        worker_.join();
+    }
+}
+
+void TopicRouter::loop() {
+    bool has_polled = false;
+    for (auto& r : routes_) {
+        if (!r->pub) continue;
+        if (r->fd < 0) has_polled = true;
+        service(*r);
+    }
+    while (!stop_.load(std::memory_order_acquire)) {
+        bool pending = false;
+        for (auto& r : routes_) pending = pending || r->pending;
+        int timeout = pending ? 0 : (has_polled ? static_cast<int>(poll_interval_ms_) : -1);
+        int n = mux_.wait_once(timeout);
+        if (n < 0 && errno != EINTR) {
+            LOGE("router", "wait", errno, "reactor exit");
+            break;
+        }
+        for (auto& r : routes_) {
+            if (!r->pub) continue;
+            if (r->fd < 0 || r->pending) service(*r);
+        }
+    }
+}
+
+TopicRouter::Stats TopicRouter::stats(const std::string& name) const {
+    Stats s;
+    for (const auto& r : routes_) {
+        if (r->name != name) continue;
+        s.events         = r->events.load(std::memory_order_relaxed);
+        s.frames         = r->frames.load(std::memory_order_relaxed);
+        s.bytes          = r->bytes.load(std::memory_order_relaxed);
+        s.zero_copy      = r->zero_copy.load(std::memory_order_relaxed);
+        s.publish_failed = r->publish_failed.load(std::memory_order_relaxed);
+        s.rx_errors      = r->rx_errors.load(std::memory_order_relaxed);
+        s.tx_frames      = r->tx_frames.load(std::memory_order_relaxed);
+        s.tx_failed      = r->tx_failed.load(std::memory_order_relaxed);
+        break;
+    }
+    return s;
+}
+
+} // namespace PhysicalLayer
+} // namespace MB_DDF
@@ -0,0 +1,107 @@
+/**
+ * @file TopicRouter.h
+ * @brief 设备-Topic 路由服务：多个设备句柄共用一个事件循环线程，接收帧直接发布到 DDS Topic，
+ *        Topic 消息转发到设备 send
+ *
+ * 设计要点：
+ * - 接收方向：各设备的就绪 fd（DDS::Handle::getEventFd）注册到同一个 EventMultiplexer，单个反应线程
+ *   在事件到来时消费事件通知并以非阻塞 receive 排空设备；无就绪 fd 的设备按 poll_interval_ms 周期排空。
+ * - 零拷贝：先在 Topic 环形缓冲区预留 max_frame 字节的写槽，设备直接 receive 进写槽后提交；
+ *   预留失败（如帧上限超过环容量）时退回经内部缓冲 publish。
+ * - 每次事件最多排空 burst 帧，未排空的设备下一轮立即继续，避免单设备饿死其他设备；
+ *   burst 默认取句柄的 framesPerEvent()（工厂句柄由配置 rx_burst 指定，DDR 默认为 1）。
+ * - 发送方向：为 tx_topic 创建带回调的 DDS 订阅者，消息在订阅者线程中直接调用设备 send
+ *   （阻塞于 Topic 通知，不轮询）。
+ * - attach 须在 start() 前完成；stop() 经 EventMultiplexer::wakeup() 唤醒反应线程后立即返回。
+ */
+#pragma once
+
+#include "MB_DDF/DDS/DDSHandle.h"
+#include "MB_DDF/DDS/Publisher.h"
+#include "MB_DDF/DDS/Subscriber.h"
+#include "MB_DDF/PhysicalLayer/EventMultiplexer.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MB_DDF {
+namespace PhysicalLayer {
+
+class TopicRouter {
+public:
+    struct RouteOptions {
+        uint32_t max_frame = 0;                       // 单帧最大长度；0 取句柄 MTU
+        uint32_t burst = 0;                           // 每次事件最多排空的帧数；0 取句柄 framesPerEvent()
+    };
+
+    struct Stats {
+        uint64_t events = 0;                          // 处理的就绪事件/轮询次数
+        uint64_t frames = 0;                          // 发布到 rx_topic 的帧数
+        uint64_t bytes = 0;
+        uint64_t zero_copy = 0;                       // 其中直接接收进写槽的帧数
+        uint64_t publish_failed = 0;
+        uint64_t rx_errors = 0;
+        uint64_t tx_frames = 0;                       // 从 tx_topic 转发到设备的帧数
+        uint64_t tx_failed = 0;
+    };
+
+    explicit TopicRouter(uint32_t poll_interval_ms = 1);
+    ~TopicRouter();
+
+    TopicRouter(const TopicRouter&) = delete;
+    TopicRouter& operator=(const TopicRouter&) = delete;
+
+    // rx_topic / tx_topic 可为空（单向路由）；需已初始化 DDSCore
+    bool attach(const std::string& name, std::shared_ptr<DDS::Handle> handle, const std::string& rx_topic,
+                const std::string& tx_topic) {
+        return attach(name, std::move(handle), rx_topic, tx_topic, RouteOptions{});
+    }
+    bool attach(const std::string& name, std::shared_ptr<DDS::Handle> handle, const std::string& rx_topic,
+                const std::string& tx_topic, RouteOptions opt);
+    // 按 HardwareFactory 设备图中配置了 rx_topic/tx_topic 的设备建立路由（使用 get() 的缓存句柄），返回建立的路由数
+    size_t attachConfigured();
+
+    bool start();
+    void stop();
+    bool running() const { return worker_.joinable(); }
+
+    size_t size() const { return routes_.size(); }
+    // 按名称取统计；未找到时返回全零
+    Stats stats(const std::string& name) const;
+
+private:
+    struct Route {
+        std::string name;
+        std::shared_ptr<DDS::Handle> handle;
+        std::shared_ptr<DDS::Publisher> pub;
+        std::shared_ptr<DDS::Subscriber> sub;
+        RouteOptions opt;
+        int fd = -1;
+        bool pending = false;                         // 上次排空达到 burst，仍可能有数据
+        std::vector<uint8_t> scratch;                 // 预留失败时的退回缓冲（首次使用时分配）
+
+        std::atomic<uint64_t> events{0};
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> zero_copy{0};
+        std::atomic<uint64_t> publish_failed{0};
+        std::atomic<uint64_t> rx_errors{0};
+        std::atomic<uint64_t> tx_frames{0};
+        std::atomic<uint64_t> tx_failed{0};
+    };
+
+    void service(Route& r);
+    void loop();
+
+    uint32_t poll_interval_ms_;
+    EventMultiplexer mux_;
+    std::vector<std::unique_ptr<Route>> routes_;
+    std::thread worker_;
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace PhysicalLayer
+} // namespace MB_DDF
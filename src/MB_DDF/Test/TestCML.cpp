@@ -12,6 +12,7 @@
 #include "MB_DDF/Debug/LoggerExtensions.h"
 #include "MB_DDF/DDS/DDSCore.h"
 #include "MB_DDF/PhysicalLayer/Factory/HardwareFactory.h"
+#include "MB_DDF/PhysicalLayer/TopicRouter.h"
 
 // --- 主函数 ---
 int main() {
@@ -26,19 +27,24 @@ int main() {
 
     auto& dds = MB_DDF::DDS::DDSCore::instance();
     dds.initialize(128 * 1024 * 1024);
-    auto cml = MB_DDF::PhysicalLayer::Factory::HardwareFactory::create("ddr");
-    MB_DDF::DDS::PubAndSub cml_operator(cml, [](const void* data, size_t size, uint64_t timestamp) {
+
+    // 两个设备共用一个路由反应线程：接收帧发布到 rx Topic，tx Topic 的消息转发到设备
+    MB_DDF::PhysicalLayer::TopicRouter router;
+    router.attach("ddr", MB_DDF::PhysicalLayer::Factory::HardwareFactory::create("ddr"), "local://cml_rx", "");
+    router.attach("dyt", MB_DDF::PhysicalLayer::Factory::HardwareFactory::create("dyt"), "local://dyt_rx", "local://dyt_tx");
+
+    auto cml_sub = dds.create_subscriber("local://cml_rx", true, [](const void*, size_t size, uint64_t timestamp) {
         LOG_INFO << "CML data received: " << size << " bytes at " << timestamp;
     });
-
-    auto dyt = MB_DDF::PhysicalLayer::Factory::HardwareFactory::create("dyt");
-    MB_DDF::DDS::PubAndSub dyt_rs422(dyt, [](const void* data, size_t size, uint64_t timestamp) {
+    auto dyt_sub = dds.create_subscriber("local://dyt_rx", true, [](const void*, size_t size, uint64_t timestamp) {
         LOG_INFO << "DYT Rs422 data received: " << size << " bytes at " << timestamp;
     });
+    auto dyt_pub = dds.create_publisher("local://dyt_tx");
+    router.start();
 
     // 导引头串口发数据
     const char* dyt_data = "DYT_RS422_TEST";
-    dyt_rs422.write(dyt_data, strlen(dyt_data));
+    dyt_pub->publish(dyt_data, strlen(dyt_data));
 
     const uint32_t sleep_us = 500000;
     while(1) {     
@@ -0,0 +1,369 @@
+/**
+ * @file TestDmaBench.cpp
+ * @brief XdmaTransport DMA 路径基准：同步 / 异步 / 注册缓冲 / SQPOLL
+ *
+ * 使用普通文件作为 XDMA 设备替身：<base>_h2c_0 与 <base>_c2h_0，
+ * 无需硬件即可比较各提交路径的单次开销。未启用 io_uring 的构建中，
+ * 注册缓冲与 SQPOLL 用例会自动退化为普通异步路径。
+ *
+ * 随后测量流式读取（DmaStreamReader）在不同在途深度下的持续吞吐与反压行为。
+ * 末尾比较设备 → Topic 的两种路径：读入用户缓冲后 publish，与 DMA 直达环形缓冲写槽。
+ * 最后以 FIFO 替身 c2h（数据延迟到达，读返回 EAGAIN）测量同步读等待期间的线程 CPU 时间：
+ * poll 路径与退避休眠路径（模拟未实现 poll 的 xdma 驱动）。
+ *
+ * 用法：TestDmaBench [base_path] [iterations]
+ */
+#include "MB_DDF/Debug/Logger.h"
+#include "MB_DDF/Debug/LoggerExtensions.h"
+#include "MB_DDF/DDS/DDSCore.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/XdmaTransport.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/DmaStreamReader.h"
+#include "MB_DDF/PhysicalLayer/Device/DmaTopicPublisher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace MB_DDF::PhysicalLayer;
+
+namespace {
+
+constexpr size_t kFrameSize = 64 * 1024;   // CML 单次读取大小
+constexpr size_t kRegionSize = 16 * 1024 * 1024;
+constexpr size_t kImageFrameSize = 640 * 1024; // 图像帧大小
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool make_standin(const std::string& path, size_t size) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    std::vector<uint8_t> chunk(kFrameSize);
+    for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = static_cast<uint8_t>(i * 7);
+    bool ok = true;
+    for (size_t off = 0; off < size && ok; off += chunk.size()) {
+        ok = ::pwrite(fd, chunk.data(), chunk.size(), static_cast<off_t>(off)) == static_cast<ssize_t>(chunk.size());
+    }
+    ::close(fd);
+    return ok;
+}
+
+bool open_transport(ControlPlane::XdmaTransport& tp, const std::string& base, const ControlPlane::XdmaAsyncOptions& opt) {
+    TransportConfig cfg;
+    cfg.device_path = base;
+    cfg.dma_h2c_channel = 0;
+    cfg.dma_c2h_channel = 0;
+    tp.setAsyncOptions(opt);
+    return tp.open(cfg);
+}
+
+// 异步往返：提交一个请求，等待完成 eventfd，收割
+double bench_async(ControlPlane::XdmaTransport& tp, bool is_write, uint8_t* buf, size_t iters) {
+    size_t completed = 0;
+    tp.setOnAsyncComplete([&](void*, bool, ssize_t res) {
+        if (res == static_cast<ssize_t>(kFrameSize)) ++completed;
+    });
+    struct pollfd pfd{ tp.getAioEventFd(), POLLIN, 0 };
+    ControlPlane::AsyncRequest req;
+    req.is_write = is_write;
+    req.buf = buf;
+    req.len = kFrameSize;
+
+    uint64_t t0 = now_ns();
+    for (size_t i = 0; i < iters; ++i) {
+        req.device_offset = (i * kFrameSize) % kRegionSize;
+        size_t target = completed + 1;
+        if (!tp.submitAsync(req)) {
+            LOG_ERROR << "submitAsync failed at iteration " << i;
+            break;
+        }
+        while (completed < target) {
+            if (::poll(&pfd, 1, 1000) <= 0) break;
+            tp.drainAioCompletions(8);
+        }
+    }
+    uint64_t t1 = now_ns();
+    if (completed != iters) LOG_WARN << "completed " << completed << "/" << iters;
+    return (t1 - t0) / 1000.0 / iters;
+}
+
+// 流式读取：推模式持续采集 frames 帧，返回 MB/s
+double bench_stream(ControlPlane::XdmaTransport& tp, uint32_t depth, size_t frames) {
+    ControlPlane::DmaStreamReader reader(tp);
+    ControlPlane::DmaStreamConfig cfg;
+    cfg.frame_size = kFrameSize;
+    cfg.depth = depth;
+    cfg.device_stride = kFrameSize;
+    cfg.device_slots = static_cast<uint32_t>(kRegionSize / kFrameSize);
+    size_t got = 0;
+    uint64_t t0 = now_ns();
+    if (!reader.start(cfg, [&](const ControlPlane::DmaStreamReader::Frame& f) {
+            if (f.status == static_cast<ssize_t>(kFrameSize)) ++got;
+        })) {
+        return 0.0;
+    }
+    struct pollfd pfd{ reader.getEventFd(), POLLIN, 0 };
+    while (got < frames) {
+        if (::poll(&pfd, 1, 1000) <= 0) break;
+        reader.poll();
+    }
+    uint64_t t1 = now_ns();
+    reader.stop();
+    return static_cast<double>(got * kFrameSize) / (1024.0 * 1024.0) / ((t1 - t0) / 1e9);
+}
+
+// 批量吞吐：保持 depth 个读请求在途
+double bench_async_batch(ControlPlane::XdmaTransport& tp, uint8_t* buf, size_t depth, size_t iters) {
+    size_t completed = 0;
+    tp.setOnAsyncComplete([&](void*, bool, ssize_t) { ++completed; });
+    struct pollfd pfd{ tp.getAioEventFd(), POLLIN, 0 };
+    std::vector<ControlPlane::AsyncRequest> reqs(depth);
+    for (size_t i = 0; i < depth; ++i) {
+        reqs[i].buf = buf + i * kFrameSize;
+        reqs[i].len = kFrameSize;
+        reqs[i].device_offset = i * kFrameSize;
+    }
+    uint64_t t0 = now_ns();
+    size_t rounds = iters / depth;
+    for (size_t r = 0; r < rounds; ++r) {
+        size_t target = completed + depth;
+        if (tp.submitAsyncBatch(reqs.data(), depth) != static_cast<int>(depth)) {
+            LOG_ERROR << "submitAsyncBatch failed at round " << r;
+            break;
+        }
+        while (completed < target) {
+            if (::poll(&pfd, 1, 1000) <= 0) break;
+            tp.drainAioCompletions(static_cast<int>(depth));
+        }
+    }
+    uint64_t t1 = now_ns();
+    double mb = static_cast<double>(rounds * depth * kFrameSize) / (1024.0 * 1024.0);
+    return mb / ((t1 - t0) / 1e9);
+}
+
+// 同步读等待 CPU 占用：c2h 为 FIFO，delay_ms 后写入一帧；返回等待期间本线程 CPU 时间占墙钟时间的比例
+double bench_wait_cpu(const std::string& base, bool use_poll, uint32_t delay_ms, double* wall_ms) {
+    const std::string c2h = ControlPlane::XdmaTransport::make_c2h_path(base, 0);
+    ::unlink(c2h.c_str());
+    if (::mkfifo(c2h.c_str(), 0600) != 0) return -1.0;
+    // 先以读写方式打开保持写端存在，传输层的只读 open 不会阻塞，空读返回 EAGAIN
+    int wfd = ::open(c2h.c_str(), O_RDWR | O_CLOEXEC);
+    if (wfd < 0) return -1.0;
+
+    ControlPlane::XdmaTransport tp;
+    TransportConfig cfg;
+    cfg.device_path = base;
+    cfg.dma_c2h_channel = 0;
+    ControlPlane::XdmaWaitOptions wopt;
+    wopt.use_poll = use_poll;
+    tp.setWaitOptions(wopt);
+    if (!tp.open(cfg)) {
+        ::close(wfd);
+        return -1.0;
+    }
+
+    const size_t len = 4096;
+    std::vector<uint8_t> frame(len, 0xA5), got(len);
+    std::thread writer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        ssize_t n = ::write(wfd, frame.data(), frame.size());
+        (void)n;
+    });
+    struct timespec c0, c1;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c0);
+    uint64_t t0 = now_ns();
+    bool ok = tp.continuousRead(0, got.data(), len);
+    uint64_t t1 = now_ns();
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c1);
+    writer.join();
+    tp.close();
+    ::close(wfd);
+    ::unlink(c2h.c_str());
+    if (!ok || got != frame) return -1.0;
+
+    double cpu_ns = (c1.tv_sec - c0.tv_sec) * 1e9 + (c1.tv_nsec - c0.tv_nsec);
+    *wall_ms = (t1 - t0) / 1e6;
+    return cpu_ns / static_cast<double>(t1 - t0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LOG_SET_LEVEL_INFO();
+    LOG_DISABLE_TIMESTAMP();
+    LOG_DISABLE_FUNCTION_LINE();
+
+    const std::string base = argc > 1 ? argv[1] : "/tmp/mb_ddf_dma_bench";
+    const size_t iters = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 5000;
+    const size_t depth = 8;
+
+    LOG_TITLE("DMA Bench (regular file stand-in)");
+#if MB_DDF_HAS_IOURING
+    LOG_INFO << "async backend: io_uring";
+#elif MB_DDF_HAS_LIBAIO
+    LOG_INFO << "async backend: libaio (registered buffers / SQPOLL unavailable)";
+#else
+    LOG_INFO << "async backend: none (async requests complete synchronously)";
+#endif
+    if (!make_standin(ControlPlane::XdmaTransport::make_h2c_path(base, 0), kRegionSize) ||
+        !make_standin(ControlPlane::XdmaTransport::make_c2h_path(base, 0), kRegionSize)) {
+        LOG_ERROR << "failed to create stand-in files under " << base;
+        return -1;
+    }
+
+    // 按页对齐的 DMA 缓冲池，供注册缓冲用例使用
+    void* mem = nullptr;
+    if (::posix_memalign(&mem, 4096, kFrameSize * depth) != 0) return -1;
+    uint8_t* buf = static_cast<uint8_t*>(mem);
+    std::memset(buf, 0x5A, kFrameSize * depth);
+
+    // 1. 同步路径
+    {
+        ControlPlane::XdmaTransport tp;
+        if (!open_transport(tp, base, {})) return -1;
+        uint64_t t0 = now_ns();
+        for (size_t i = 0; i < iters; ++i) tp.continuousReadAt(0, buf, kFrameSize, (i * kFrameSize) % kRegionSize);
+        uint64_t t1 = now_ns();
+        LOG_INFO << "sync read  64KB: " << (t1 - t0) / 1000.0 / iters << " us/op";
+        t0 = now_ns();
+        for (size_t i = 0; i < iters; ++i) tp.continuousWriteAt(0, buf, kFrameSize, (i * kFrameSize) % kRegionSize);
+        t1 = now_ns();
+        LOG_INFO << "sync write 64KB: " << (t1 - t0) / 1000.0 / iters << " us/op";
+    }
+
+    // 2. 异步路径：普通 fd / 未注册缓冲（原实现）
+    {
+        ControlPlane::XdmaAsyncOptions opt;
+        opt.fixed_files = false;
+        ControlPlane::XdmaTransport tp;
+        if (!open_transport(tp, base, opt)) return -1;
+        LOG_INFO << "async read  64KB (plain):           " << bench_async(tp, false, buf, iters) << " us/op";
+        LOG_INFO << "async write 64KB (plain):           " << bench_async(tp, true, buf, iters) << " us/op";
+        LOG_INFO << "async read  batch x" << depth << " (plain):     " << bench_async_batch(tp, buf, depth, iters) << " MB/s";
+    }
+
+    // 3. 固定文件 + 注册缓冲（READ_FIXED / WRITE_FIXED）
+    {
+        ControlPlane::XdmaTransport tp;
+        if (!open_transport(tp, base, {})) return -1;
+        struct iovec iov{ buf, kFrameSize * depth };
+        bool reg = tp.registerDmaBuffers(&iov, 1);
+        LOG_INFO << "registered buffers: " << (reg ? "yes" : "no");
+        LOG_INFO << "async read  64KB (fixed):           " << bench_async(tp, false, buf, iters) << " us/op";
+        LOG_INFO << "async write 64KB (fixed):           " << bench_async(tp, true, buf, iters) << " us/op";
+        LOG_INFO << "async read  batch x" << depth << " (fixed):     " << bench_async_batch(tp, buf, depth, iters) << " MB/s";
+    }
+
+    // 4. 固定文件 + 注册缓冲 + SQPOLL
+    {
+        ControlPlane::XdmaAsyncOptions opt;
+        opt.sqpoll = true;
+        ControlPlane::XdmaTransport tp;
+        if (!open_transport(tp, base, opt)) return -1;
+        struct iovec iov{ buf, kFrameSize * depth };
+        (void)tp.registerDmaBuffers(&iov, 1);
+        LOG_INFO << "async read  64KB (fixed+sqpoll):    " << bench_async(tp, false, buf, iters) << " us/op";
+        LOG_INFO << "async write 64KB (fixed+sqpoll):    " << bench_async(tp, true, buf, iters) << " us/op";
+        LOG_INFO << "async read  batch x" << depth << " (fixed+sqpoll): " << bench_async_batch(tp, buf, depth, iters) << " MB/s";
+    }
+
+    // 5. 流式读取：在途深度对持续吞吐的影响；拉模式下慢消费者触发反压
+    {
+        ControlPlane::XdmaTransport tp;
+        if (!open_transport(tp, base, {})) return -1;
+        for (uint32_t d : {1u, 2u, 4u, 8u}) {
+            LOG_INFO << "stream read depth " << d << ":                " << bench_stream(tp, d, iters) << " MB/s";
+        }
+
+        ControlPlane::DmaStreamReader reader(tp);
+        ControlPlane::DmaStreamConfig cfg;
+        cfg.frame_size = kFrameSize;
+        cfg.depth = 4;
+        if (reader.start(cfg)) {
+            struct pollfd pfd{ reader.getEventFd(), POLLIN, 0 };
+            size_t consumed = 0;
+            for (size_t round = 0; round < 200; ++round) {
+                if (::poll(&pfd, 1, 10) < 0) break;
+                reader.poll();
+                // 每 4 轮才消费一帧，模拟落后的消费者
+                if (round % 4 == 0 && reader.acquire()) {
+                    reader.release();
+                    ++consumed;
+                }
+            }
+            reader.stop();
+            const auto& st = reader.stats();
+            LOG_INFO << "stream backpressure: consumed=" << consumed << " submitted=" << st.submitted
+                     << " stalls=" << st.stalls << " dropped=" << st.dropped;
+        }
+    }
+
+    // 6. 设备 → Topic：先读入用户缓冲再 publish（两次遍历） vs DMA 直达写槽（零拷贝）
+    {
+        auto& dds = MB_DDF::DDS::DDSCore::instance();
+        dds.initialize(64 * 1024 * 1024);
+        auto pub = dds.create_publisher("local://dma_bench_frame", false);
+        ControlPlane::XdmaTransport tp;
+        if (!pub || !open_transport(tp, base, {})) return -1;
+        const size_t frames = std::max<size_t>(iters / 10, 1);
+        std::vector<uint8_t> user_buf(kImageFrameSize);
+
+        uint64_t t0 = now_ns();
+        for (size_t i = 0; i < frames; ++i) {
+            tp.continuousReadAt(0, user_buf.data(), kImageFrameSize, 0);
+            pub->publish(user_buf.data(), kImageFrameSize);
+        }
+        uint64_t t1 = now_ns();
+        LOG_INFO << "topic 640KB read+publish (copy):    " << (t1 - t0) / 1000.0 / frames << " us/frame";
+
+        Device::DmaTopicPublisher zc(tp, pub, 0, kImageFrameSize);
+        t0 = now_ns();
+        for (size_t i = 0; i < frames; ++i) zc.readFrame(0);
+        t1 = now_ns();
+        LOG_INFO << "topic 640KB DMA into slot (sync):   " << (t1 - t0) / 1000.0 / frames << " us/frame";
+
+        zc.bindCompletion();
+        struct pollfd pfd{ tp.getAioEventFd(), POLLIN, 0 };
+        t0 = now_ns();
+        for (size_t i = 0; i < frames; ++i) {
+            if (!zc.readFrameAsync(0)) break;
+            while (zc.pending()) {
+                if (::poll(&pfd, 1, 1000) <= 0) break;
+                tp.drainAioCompletions(4);
+            }
+        }
+        t1 = now_ns();
+        LOG_INFO << "topic 640KB DMA into slot (async):  " << (t1 - t0) / 1000.0 / frames << " us/frame";
+        LOG_INFO << "zero-copy frames published=" << zc.framesPublished() << " failed=" << zc.framesFailed();
+    }
+
+    // 7. 同步读等待期间的 CPU 占用：poll 休眠 vs 退避休眠（驱动未实现 poll 时自动切换到后者）
+    for (bool use_poll : {true, false}) {
+        double wall_ms = 0.0;
+        double ratio = bench_wait_cpu(base + "_wait", use_poll, 50, &wall_ms);
+        if (ratio < 0) {
+            LOG_WARN << "wait cpu (" << (use_poll ? "poll" : "backoff") << "): stand-in unavailable";
+            continue;
+        }
+        LOG_INFO << "sync read wait cpu (" << (use_poll ? "poll   " : "backoff") << "):  " << ratio * 100.0
+                 << "% of " << wall_ms << " ms";
+        if (ratio > 0.2) LOG_WARN << "sync read wait is burning CPU";
+    }
+
+    ::free(mem);
+    ::unlink(ControlPlane::XdmaTransport::make_h2c_path(base, 0).c_str());
+    ::unlink(ControlPlane::XdmaTransport::make_c2h_path(base, 0).c_str());
+    return 0;
+}
@@ -82,8 +82,17 @@ int main() {
     auto helm_timer 
     = SystemTimer::start("250us", helm_callback, opt_helm);
 
+    // 定时器遥测：每 0.5s 输出一次，并发布到本地主题供监控程序查看
+    auto telemetry_pub = dds.create_publisher("local://helm_timer_stats", false);
+
     const uint32_t sleep_us = 500000;
     while(1) {     
+        const SystemTimerStats st = helm_timer->stats();
+        if (telemetry_pub) telemetry_pub->publish(&st, sizeof(st));
+        LOG_INFO << "Helm timer: cycles " << st.cycles << ", overruns " << st.overruns
+        << ", deadline misses " << st.deadline_misses
+        << ", wake latency max " << st.wake_latency_ns_max / 1000.0 << " us"
+        << ", exec max " << st.exec_ns_max / 1000.0 << " us";
         LOG_INFO << "Helm ins is: " << ins;
         LOG_INFO << "Helm degree is: " << K_IN_OUT_1 * static_cast<short>(fdb[0]) 
         << " " << K_IN_OUT_1 * static_cast<short>(fdb[1]) 
@@ -379,6 +379,7 @@ void test_can_transport() {
         tx.ide = false;
         tx.rtr = false;
         tx.dlc = 8;
+        tx.len = 8;
         tx.data = {
             static_cast<uint8_t>(i & 0xFF), static_cast<uint8_t>((i+1) & 0xFF),
             static_cast<uint8_t>((i+2) & 0xFF), static_cast<uint8_t>((i+3) & 0xFF),
@@ -404,7 +405,7 @@ void test_can_transport() {
             return;
         }
 
-        bool ok = (rx.id == tx.id) && (rx.dlc == tx.dlc) && (rx.data == tx.data);
+        bool ok = (rx.id == tx.id) && (rx.dlc == tx.dlc) && std::ranges::equal(rx.payload(), tx.payload());
         if (!ok) {
             LOG_ERROR << "mismatch at round " << i
                       << " id tx=0x" << std::hex << tx.id << " rx=0x" << rx.id << std::dec
@@ -540,6 +541,35 @@ void test_ddr_transport() {
         LOG_INFO << "DMA read data matches written data.";
     }
 
+    // 带标记的批量异步读：4 个 16KB 分段一次提交，按 token 区分完成
+    LOG_INFO << "Testing tagged batch async read (4 x 16KB):";
+    std::fill(back.begin(), back.end(), 0);
+    const size_t SEG = DATA_SIZE / 4;
+    int seg_done = 0;
+    ddr.setOnAsyncComplete([&](void* token, bool is_write, ssize_t res) {
+        (void)is_write;
+        LOG_INFO << "segment " << reinterpret_cast<uintptr_t>(token) << " done, res=" << res;
+        ++seg_done;
+    });
+    ControlPlane::AsyncRequest reqs[4];
+    for (size_t i = 0; i < 4; ++i) {
+        reqs[i].channel = 0;
+        reqs[i].buf = back.data() + i * SEG;
+        reqs[i].len = SEG;
+        reqs[i].device_offset = i * SEG;
+        reqs[i].token = reinterpret_cast<void*>(i);
+    }
+    int queued = ddr.submitAsyncBatch(reqs, 4);
+    for (int tries = 0; seg_done < queued && tries < 50; ++tries) {
+        if (::poll(&pfd, 1, 100) < 0) break;
+        ddr.drainAioCompletions(4);
+    }
+    if (data != back) {
+        LOG_ERROR << "DMA batch read data does not match written data.";
+    } else {
+        LOG_INFO << "DMA batch read data matches written data.";
+    }
+
     ddr.close();
     LOG_INFO << "DDR transport closed.";
 }
@@ -2,7 +2,11 @@
 #include "MB_DDF/Timer/ChronoHelper.h"
 #include "MB_DDF/PhysicalLayer/Device/HelmDevice.h"
 #include "MB_DDF/PhysicalLayer/ControlPlane/XdmaTransport.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/DmaStreamReader.h"
+#include "MB_DDF/PhysicalLayer/EventMultiplexer.h"
+#include <atomic>
 #include <cstdint>
+#include <thread>
 
 // 测试实时定时器
 using namespace MB_DDF::Timer;
@@ -22,18 +26,8 @@ void helm_callback(void* para) {
     ChronoHelper::record(0);
 }
 
-void cml_callback(void* para) {
-    static const size_t DATA_SIZE = 64 * 1024;
-    static std::vector<uint8_t> data(DATA_SIZE);
-
-    static bool hardware_enabled = true;
-    if (hardware_enabled) {
-        auto cml = (MB_DDF::PhysicalLayer::ControlPlane::XdmaTransport*)para;
-        hardware_enabled = cml->continuousReadAsync(0, data.data(), DATA_SIZE, 0);
-    }
-
-    // ChronoHelper::record(1);
-}
+// 图像帧计数（流式读取回调中累加）
+static std::atomic<uint64_t> cml_frames{0};
 
 // 测试主函数，设置实时定时器
 int main(int argc, char* argv[]) {
@@ -58,7 +52,6 @@ int main(int argc, char* argv[]) {
     cfg_ddr.dma_c2h_channel = 0;
     cfg_ddr.device_offset = 0x80000000;
     ddr.open(cfg_ddr);
-    void* cml_para = (void*)&ddr;
 
     // 配置舵机定时器选项
     SystemTimerOptions opt_helm;
@@ -71,27 +64,43 @@ int main(int argc, char* argv[]) {
     auto helm_timer 
     = SystemTimer::start("250us", helm_callback, opt_helm);
 
-    // 配置图像定时器选项
-    SystemTimerOptions opt_cml;
-    opt_cml.sched_policy = SCHED_FIFO;             // 新线程调度策略：FIFO
-    opt_cml.priority = sched_get_priority_max(SCHED_FIFO); // 优先级设为最高
-    opt_cml.cpu = 7;                               // 绑核
-    opt_cml.signal_no = SIGRTMIN;                  // 使用实时信号
-    opt_cml.user_data = cml_para;                  // 回调函数用户数据指针
+    // 图像流式读取：4 个 64KB 缓冲轮转在途，完成 eventfd 驱动，不再依赖定时器逐次发起
+    MB_DDF::PhysicalLayer::ControlPlane::DmaStreamReader cml_stream(ddr);
+    MB_DDF::PhysicalLayer::EventMultiplexer cml_mux;
+    std::thread cml_thread;
 
-    // 根据程序传入参数决定是否开启 cml_timer
-    std::shared_ptr<SystemTimer> cml_timer;
+    // 根据程序传入参数决定是否开启图像读取
     if (argc > 1) {
-        cml_timer = SystemTimer::start("12ms", cml_callback, opt_cml);
+        MB_DDF::PhysicalLayer::ControlPlane::DmaStreamConfig scfg;
+        scfg.channel = 0;
+        scfg.frame_size = 64 * 1024;
+        scfg.depth = 4;
+        bool ok = cml_stream.start(scfg, [](const MB_DDF::PhysicalLayer::ControlPlane::DmaStreamReader::Frame& f) {
+            if (f.status > 0) cml_frames.fetch_add(1, std::memory_order_relaxed);
+        });
+        if (ok) {
+            cml_mux.add(cml_stream.getEventFd(), EPOLLIN, [&](int, uint32_t) { cml_stream.poll(); });
+            cml_thread = std::thread([&]() {
+                SystemTimer::configureThread(pthread_self(), SCHED_FIFO, sched_get_priority_max(SCHED_FIFO), 7);
+                cml_mux.run_loop(100);
+            });
+        } else {
+            std::cout << "cml stream start failed." << std::endl;
+        }
     } else {
-        std::cout << "cml_timer is not started." << std::endl;
+        std::cout << "cml stream is not started." << std::endl;
     }
 
     std::cout << "press enter to stop" << std::endl;
     std::cin.get();
     helm_timer->stop();
-    if (cml_timer) {
-        cml_timer->stop();
+    if (cml_thread.joinable()) {
+        cml_mux.stop();
+        cml_thread.join();
+        cml_stream.stop();
+        const auto& st = cml_stream.stats();
+        std::cout << "cml frames=" << cml_frames.load() << " errors=" << st.errors
+                  << " stalls=" << st.stalls << std::endl;
     }
 
     return 0;
@@ -0,0 +1,334 @@
+/**
+ * @file TestRegBench.cpp
+ * @brief 寄存器突发访问基准：逐字 readReg32/writeReg32 与 readRegs32/writeRegs32/copy* 对比
+ *
+ * 使用普通文件作为 XDMA user BAR 替身（<base>_user，可 mmap），无需硬件即可
+ * 比较逐字访问（每字一次虚调用 + 边界检查）与突发访问（一次检查 + volatile 整字）的开销。
+ * 同时以 RS422 发送缓冲的旧拼字循环为基线，校验新块拷贝写出的 BRAM 内容逐字节一致，
+ * 并测量 Rs422Device::send/receive 端到端耗时。
+ * 另校验同一 user 节点上区间重叠的传输共用一个 BAR 映射、不重叠的窗口各自映射且只映射自身区间。
+ * 指定 spidev 路径时（可为 MOSI/MISO 短接的回环设备），另比较 SpiTransport 逐寄存器访问与
+ * Transaction 批量提交的寄存器访问速率与消息（系统调用）条数。
+ *
+ * 用法：TestRegBench [base_path] [iterations] [spidev_path]
+ */
+#include "MB_DDF/Debug/Logger.h"
+#include "MB_DDF/Debug/LoggerExtensions.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/SpiTransport.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/XdmaTransport.h"
+#include "MB_DDF/PhysicalLayer/Device/Rs422Device.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace MB_DDF::PhysicalLayer;
+
+namespace {
+
+constexpr size_t kBarSize = 64 * 1024;
+constexpr size_t kWords = 256;              // 单次突发字数（1KB）
+constexpr uint64_t kRs422Base = 0x1000;     // RS422 寄存器窗口在替身 BAR 中的偏移
+constexpr uint64_t kSendBuf = 0x100;
+constexpr uint64_t kRecvBuf = 0x000;
+constexpr uint64_t kStuReg = 0x300;
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool make_bar(const std::string& path, size_t size = kBarSize) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+    ::close(fd);
+    return ok;
+}
+
+// 旧 Rs422Device::send 的 BRAM 写法：首字 = 长度 + 3 字节数据，其后逐字拼装写入
+bool legacy_rs422_fill(ControlPlane::IDeviceTransport& tp, uint64_t base, const uint8_t* data, uint8_t sendlen) {
+    uint8_t first4[4] = { sendlen, 0, 0, 0 };
+    if (sendlen >= 1) first4[1] = data[0];
+    if (sendlen >= 2) first4[2] = data[1];
+    if (sendlen >= 3) first4[3] = data[2];
+    uint32_t word0 = 0;
+    std::memcpy(&word0, first4, sizeof(word0));
+    if (!tp.writeReg32(base, word0)) return false;
+    uint32_t bram_offset = 4;
+    while (bram_offset <= sendlen) {
+        uint32_t w = 0;
+        for (int i = 0; i < 4; ++i) {
+            uint32_t idx = bram_offset + i - 1;
+            uint8_t b = (idx < sendlen) ? data[idx] : 0;
+            w |= (static_cast<uint32_t>(b) << (8 * i));
+        }
+        if (!tp.writeReg32(base + bram_offset, w)) return false;
+        bram_offset += 4;
+    }
+    return true;
+}
+
+void report(const char* name, uint64_t t0, uint64_t t1, size_t iters, size_t bytes) {
+    double ns = static_cast<double>(t1 - t0) / static_cast<double>(iters);
+    LOG_INFO << name << ": " << ns << " ns/op, " << (bytes * 1e3 / ns) << " MB/s";
+}
+
+// 共享 BAR 映射：同一 user 节点上区间重叠的窗口（2MB 大窗口 + 落在其中的 4KB 小窗口）共用一个映射，
+// 经一方写入的寄存器经另一方可见；不重叠的高偏移单页窗口只映射自身一页，越界窗口被拒绝
+bool check_shared_bar(const std::string& base) {
+    constexpr size_t kBigBar = 8 * 1024 * 1024;
+    constexpr uint64_t kBigOffset = 0x200000;
+    constexpr uint64_t kInnerOffset = 0x300000;
+    const std::string user = ControlPlane::XdmaTransport::make_user_path(base);
+    if (!make_bar(user, kBigBar)) return false;
+
+    ControlPlane::XdmaTransport big, inner, far, beyond;
+    TransportConfig cb, ci, cf, cx;
+    cb.device_path = ci.device_path = cf.device_path = cx.device_path = base;
+    cb.device_offset = kBigOffset;
+    cb.register_window = 2 * 1024 * 1024;
+    ci.device_offset = kInnerOffset;
+    ci.register_window = 0x1000;
+    cf.device_offset = kBigBar - 0x1000;
+    cf.register_window = 0x1000;
+    cx.device_offset = kBigBar;
+    cx.register_window = 0x1000;
+    bool ok = big.open(cb) && inner.open(ci) && far.open(cf);
+    ok = ok && big.usesSharedBar() && inner.usesSharedBar() && far.usesSharedBar();
+    const uint8_t* big_base = static_cast<const uint8_t*>(big.getMappedBase());
+    ok = ok && static_cast<const uint8_t*>(inner.getMappedBase()) == big_base + (kInnerOffset - kBigOffset);
+    ok = ok && big.writeReg32(kInnerOffset - kBigOffset + 0x10, 0xC0FFEE01u);
+    uint32_t seen = 0;
+    ok = ok && inner.readReg32(0x10, seen) && seen == 0xC0FFEE01u;
+    // 不重叠的窗口各自映射：far 不落在 big 的映射内
+    const uint8_t* far_base = static_cast<const uint8_t*>(far.getMappedBase());
+    ok = ok && (far_base < big_base || far_base >= big_base + cb.register_window);
+    ok = ok && far.writeReg32(0, 0xC0FFEE02u);
+    ok = ok && !(beyond.open(cx) && beyond.usesSharedBar());
+    LOG_INFO << "shared BAR mapping (overlapping 2MB + 4KB, disjoint page, out-of-range rejected): "
+             << (ok ? "matches" : "MISMATCH");
+    big.close();
+    inner.close();
+    far.close();
+    beyond.close();
+    ::unlink(user.c_str());
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LOG_SET_LEVEL_INFO();
+    LOG_DISABLE_TIMESTAMP();
+    LOG_DISABLE_FUNCTION_LINE();
+
+    const std::string base = argc > 1 ? argv[1] : "/tmp/mb_ddf_reg_bench";
+    const size_t iters = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 20000;
+
+    LOG_TITLE("Register Burst Bench (regular file stand-in)");
+    if (!make_bar(ControlPlane::XdmaTransport::make_user_path(base))) {
+        LOG_ERROR << "failed to create stand-in " << ControlPlane::XdmaTransport::make_user_path(base);
+        return -1;
+    }
+
+    ControlPlane::XdmaTransport tp;
+    TransportConfig cfg;
+    cfg.device_path = base;
+    cfg.register_window = kBarSize;
+    if (!tp.open(cfg)) return -1;
+
+    std::vector<uint32_t> words(kWords), back(kWords);
+    for (size_t i = 0; i < kWords; ++i) words[i] = static_cast<uint32_t>(i * 0x01010101u);
+
+    // 0. 共享 BAR 映射
+    LOG_SEPARATOR();
+    (void)check_shared_bar(base + "_shared");
+
+    // 1. 连续 32 位寄存器：逐字 vs 突发
+    LOG_SEPARATOR();
+    {
+        uint64_t t0 = now_ns();
+        for (size_t n = 0; n < iters; ++n) {
+            for (size_t i = 0; i < kWords; ++i) tp.writeReg32(i * 4, words[i]);
+        }
+        uint64_t t1 = now_ns();
+        report("write 256 words, per-word ", t0, t1, iters, kWords * 4);
+
+        t0 = now_ns();
+        for (size_t n = 0; n < iters; ++n) tp.writeRegs32(0, words);
+        t1 = now_ns();
+        report("write 256 words, burst    ", t0, t1, iters, kWords * 4);
+
+        t0 = now_ns();
+        for (size_t n = 0; n < iters; ++n) {
+            for (size_t i = 0; i < kWords; ++i) tp.readReg32(i * 4, back[i]);
+        }
+        t1 = now_ns();
+        report("read  256 words, per-word ", t0, t1, iters, kWords * 4);
+
+        t0 = now_ns();
+        for (size_t n = 0; n < iters; ++n) tp.readRegs32(0, back);
+        t1 = now_ns();
+        report("read  256 words, burst    ", t0, t1, iters, kWords * 4);
+        LOG_INFO << "burst read-back " << (back == words ? "matches" : "MISMATCH");
+    }
+
+    // 2. 字节块拷贝：32 位 vs 64 位访问
+    LOG_SEPARATOR();
+    {
+        std::vector<uint8_t> src(kWords * 4 - 3), dst(src.size());
+        for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<uint8_t>(i * 13 + 1);
+        for (bool wide : {false, true}) {
+            tp.setWideMmio(wide);
+            uint64_t t0 = now_ns();
+            for (size_t n = 0; n < iters; ++n) tp.copyToDevice(0x800, src.data(), src.size());
+            uint64_t t1 = now_ns();
+            report(wide ? "copyToDevice   1021B, 64-bit" : "copyToDevice   1021B, 32-bit", t0, t1, iters, src.size());
+            t0 = now_ns();
+            for (size_t n = 0; n < iters; ++n) tp.copyFromDevice(0x800, dst.data(), dst.size());
+            t1 = now_ns();
+            report(wide ? "copyFromDevice 1021B, 64-bit" : "copyFromDevice 1021B, 32-bit", t0, t1, iters, dst.size());
+            LOG_INFO << "block round-trip " << (src == dst ? "matches" : "MISMATCH");
+        }
+        tp.setWideMmio(false);
+    }
+
+    // 3. RS422 发送缓冲：旧逐字拼装 vs 块拷贝，校验 BRAM 内容逐字节一致
+    LOG_SEPARATOR();
+    {
+        ControlPlane::XdmaTransport tp422;
+        TransportConfig cfg422;
+        cfg422.device_path = base;
+        cfg422.device_offset = kRs422Base;
+        if (!tp422.open(cfg422)) return -1;
+        Device::Rs422Device rs422(tp422, 255);
+        rs422.open(LinkConfig{});
+
+        uint8_t payload[255];
+        for (size_t i = 0; i < sizeof(payload); ++i) payload[i] = static_cast<uint8_t>(0xA0 ^ i);
+
+        bool all_equal = true;
+        uint8_t legacy_img[260], burst_img[260];
+        for (uint32_t len = 1; len <= 255; ++len) {
+            std::memset(tp422.getMappedBase(), 0xEE, 0x200);
+            legacy_rs422_fill(tp422, kSendBuf, payload, static_cast<uint8_t>(len));
+            std::memcpy(legacy_img, static_cast<uint8_t*>(tp422.getMappedBase()) + kSendBuf, sizeof(legacy_img));
+
+            std::memset(tp422.getMappedBase(), 0xEE, 0x200);
+            tp422.writeReg32(kStuReg, 0x03);
+            rs422.send(payload, len);
+            std::memcpy(burst_img, static_cast<uint8_t*>(tp422.getMappedBase()) + kSendBuf, sizeof(burst_img));
+            if (std::memcmp(legacy_img, burst_img, sizeof(legacy_img)) != 0) {
+                LOG_ERROR << "rs422 BRAM image differs at len=" << len;
+                all_equal = false;
+            }
+        }
+        LOG_INFO << "rs422 send BRAM image (len 1..255): " << (all_equal ? "byte-identical" : "MISMATCH");
+
+        uint64_t t0 = now_ns();
+        for (size_t n = 0; n < iters; ++n) legacy_rs422_fill(tp422, kSendBuf, payload, 255);
+        uint64_t t1 = now_ns();
+        report("rs422 fill 255B, per-word (old)", t0, t1, iters, 256);
+
+        t0 = now_ns();
+        for (size_t n = 0; n < iters; ++n) {
+            tp422.writeReg32(kStuReg, 0x03);
+            rs422.send(payload, 255);
+        }
+        t1 = now_ns();
+        report("rs422 send 255B, burst (new)   ", t0, t1, iters, 256);
+
+        // 接收：将发送缓冲内容搬到接收缓冲，状态置为有数据
+        uint8_t frame[256];
+        frame[0] = 255;
+        std::memcpy(frame + 1, payload, 255);
+        std::memcpy(static_cast<uint8_t*>(tp422.getMappedBase()) + kRecvBuf, frame, sizeof(frame));
+        uint8_t rx[255];
+        t0 = now_ns();
+        int32_t got = 0;
+        for (size_t n = 0; n < iters; ++n) {
+            tp422.writeReg32(kStuReg, 0x03);
+            got = rs422.receive(rx, sizeof(rx));
+        }
+        t1 = now_ns();
+        report("rs422 recv 255B, burst (new)   ", t0, t1, iters, 256);
+        LOG_INFO << "rs422 receive " << got << " bytes, "
+                 << (got == 255 && std::memcmp(rx, payload, 255) == 0 ? "matches" : "MISMATCH");
+    }
+
+    // 4. SPI：逐寄存器（每次访问一条消息）vs Transaction（整段配置序列合并提交）
+    if (argc > 3) {
+        LOG_SEPARATOR();
+        ControlPlane::SpiTransport spi;
+        TransportConfig scfg;
+        scfg.device_path = argv[3];
+        if (!spi.open(scfg)) {
+            LOG_ERROR << "spidev open failed: " << argv[3];
+        } else {
+            constexpr size_t kSeq = 16;     // 模拟一次设备配置：16 次写 + 16 次回读
+            const size_t spi_iters = std::max<size_t>(iters / 100, 10);
+            uint32_t rd[kSeq];
+            uint64_t m0 = spi.messageCount();
+            uint64_t t0 = now_ns();
+            for (size_t n = 0; n < spi_iters; ++n) {
+                for (size_t i = 0; i < kSeq; ++i) spi.writeReg32(i * 4, words[i]);
+                for (size_t i = 0; i < kSeq; ++i) spi.readReg32(i * 4, rd[i]);
+            }
+            uint64_t t1 = now_ns();
+            uint64_t m1 = spi.messageCount();
+            report("spi 32 reg ops, per-register ", t0, t1, spi_iters * kSeq * 2, 4);
+            LOG_INFO << "  messages per sequence: " << (m1 - m0) / spi_iters;
+
+            auto txn = spi.transaction();
+            t0 = now_ns();
+            for (size_t n = 0; n < spi_iters; ++n) {
+                txn.clear();
+                for (size_t i = 0; i < kSeq; ++i) txn.write32(i * 4, words[i]);
+                for (size_t i = 0; i < kSeq; ++i) txn.read32(i * 4, &rd[i]);
+                if (!txn.submit()) break;
+            }
+            t1 = now_ns();
+            uint64_t m2 = spi.messageCount();
+            report("spi 32 reg ops, transaction  ", t0, t1, spi_iters * kSeq * 2, 4);
+            LOG_INFO << "  messages per sequence: " << (m2 - m1) / spi_iters;
+
+            // 大块传输：同步调用阻塞至总线传输完成；异步仅入队，由 SPI 工作线程执行
+            constexpr size_t kBulk = 16 * 1024;
+            constexpr size_t kBulkCount = 16;
+            std::vector<uint8_t> bulk(kBulk, 0x5A);
+            t0 = now_ns();
+            for (size_t n = 0; n < kBulkCount; ++n) spi.continuousWriteAt(0, bulk.data(), bulk.size(), 0);
+            t1 = now_ns();
+            report("spi 16KB write, sync (caller blocked) ", t0, t1, kBulkCount, kBulk);
+
+            size_t done = 0, failed = 0;
+            spi.setOnContinuousWriteComplete([&](ssize_t res) { ++done; if (res < 0) ++failed; });
+            t0 = now_ns();
+            size_t submitted = 0;
+            for (size_t n = 0; n < kBulkCount; ++n) submitted += spi.continuousWriteAsync(0, bulk.data(), bulk.size(), 0) ? 1 : 0;
+            t1 = now_ns();
+            report("spi 16KB write, async submit only     ", t0, t1, kBulkCount, kBulk);
+            while (done < submitted) {
+                struct pollfd pfd{ spi.getAioEventFd(), POLLIN, 0 };
+                if (::poll(&pfd, 1, 5000) <= 0) break;
+                spi.drainAioCompletions(static_cast<int>(kBulkCount));
+            }
+            uint64_t t2 = now_ns();
+            report("spi 16KB write, async until completed ", t0, t2, kBulkCount, kBulk);
+            LOG_INFO << "  async completions " << done << "/" << submitted << ", failed " << failed;
+            spi.close();
+        }
+    }
+
+    tp.close();
+    ::unlink(ControlPlane::XdmaTransport::make_user_path(base).c_str());
+    return 0;
+}
@@ -0,0 +1,1572 @@
+/**
+ * @file TestSimDevices.cpp
+ * @brief 基于 SimTransport 的设备驱动基准：无需硬件测量各驱动收发吞吐与延迟
+ *
+ * 每个设备使用独立的 SimTransport + 设备模型（见 Device/SimDeviceModels.h）：
+ * - RS422：BRAM 回环，send -> receive 往返（BRAM 镜像与逐字节参考实现逐字节比对）；另测事件驱动接收（waitEvent）
+ *   与接收引擎突发排空（帧环 + 时间戳）
+ * - CAN / CAN-FD：FIFO 回环，帧级 send -> receive 往返，校验内容一致；另测 send_batch/receive_batch
+ *   批量收发，并统计收发热路径上的堆分配次数（应为 0）
+ * - CAN-FD 接收分发：总线注入全 ID 空间流量，对比硬件验收过滤开启/关闭时到达 CPU 的帧数与路由正确性；
+ *   无订阅时硬件拒收全部帧，运行中订阅/退订即时重编程过滤器
+ * - CAN-FD 发送队列：模型按帧占用总线时间，多线程入队、泵线程由 TXOK 事件补充硬件缓冲，测量总线利用率
+ * - 模式切换：CAN/CAN-FD 配置-工作模式往返耗时；寄存器不响应时初始化须在轮询超时后失败返回
+ * - 舵机：写 PWM 后 ADC 一阶跟随，测量 send/receive 单次耗时与阶跃跟随时间；控制环 4kHz/10kHz 持续运行的实际频率与抖动
+ * - DDR：DMA 落在 memfd，测量同步读写与异步写（aio eventfd 收割）吞吐
+ * - DMA 直达 Topic：帧在途时析构发布器，校验析构等待 DMA 完成、帧完整发布且完成回调已解除
+ * - 设备图工厂：INI 描述的仿真设备并行打开，校验传输层共享、句柄缓存与打开失败报告
+ * - Topic 路由：两路 RS422 共用一个反应线程，tx_topic -> 设备回环 -> rx_topic，校验逐帧顺序、内容与零拷贝发布
+ * - 设备句柄订阅者：就绪 fd 驱动回调，校验逐帧内容、空闲时不借用缓冲与取消订阅耗时
+ * - 事件多路复用器：两分片线程边沿触发分发（fd 不跨线程迁移）、回调中移除自身、EPOLLEXCLUSIVE 共享 fd、
+ *   timerfd 单次/周期定时、post 任务延迟与 stop 唤醒耗时
+ * - 速率单调执行器：1ms/10ms 两个速率组，命令 Topic -> 设备回环 -> 反馈 Topic 的任务链在组线程内执行，
+ *   校验优先级按速率分配、逐帧内容，报告链端到端时延与唤醒迟到
+ *
+ * 用法：TestSimDevices [iterations]
+ */
+#include "MB_DDF/Debug/Logger.h"
+#include "MB_DDF/Debug/LoggerExtensions.h"
+#include "MB_DDF/PhysicalLayer/ControlPlane/SimTransport.h"
+#include "MB_DDF/PhysicalLayer/Device/CanDevice.h"
+#include "MB_DDF/PhysicalLayer/Device/CanDispatcher.h"
+#include "MB_DDF/PhysicalLayer/Device/CanFdDevice.h"
+#include "MB_DDF/PhysicalLayer/Device/CanFdTxQueue.h"
+#include "MB_DDF/PhysicalLayer/Device/DdrDevice.h"
+#include "MB_DDF/PhysicalLayer/Device/DmaTopicPublisher.h"
+#include "MB_DDF/PhysicalLayer/Device/HelmDevice.h"
+#include "MB_DDF/PhysicalLayer/Device/HelmServoLoop.h"
+#include "MB_DDF/PhysicalLayer/Device/Rs422Device.h"
+#include "MB_DDF/PhysicalLayer/Device/Rs422RxEngine.h"
+#include "MB_DDF/PhysicalLayer/Device/SimDeviceModels.h"
+#include "MB_DDF/PhysicalLayer/EventMultiplexer.h"
+#include "MB_DDF/PhysicalLayer/Factory/HardwareFactory.h"
+#include "MB_DDF/PhysicalLayer/RateMonotonicExecutor.h"
+#include "MB_DDF/PhysicalLayer/TopicRouter.h"
+#include "MB_DDF/DDS/BufferPool.h"
+#include "MB_DDF/DDS/DDSCore.h"
+#include "MB_DDF/DDS/Subscriber.h"
+#include "MB_DDF/PhysicalLayer/Hardware/pl_canfd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <vector>
+
+// 全局 operator new 计数：用于确认帧收发热路径不触发堆分配
+static std::atomic<uint64_t> g_alloc_count{0};
+
+void* operator new(std::size_t n) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace MB_DDF::PhysicalLayer;
+using ControlPlane::SimTransport;
+
+namespace {
+
+uint64_t now_ns() { return SimTransport::now_ns(); }
+
+// 汇总单次耗时样本：均值 / P50 / P99 / 最大值，以及按 bytes 折算的吞吐
+void report(const char* name, std::vector<uint64_t>& samples, size_t bytes) {
+    if (samples.empty()) {
+        LOG_ERROR << name << ": no samples";
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    uint64_t sum = 0;
+    for (uint64_t s : samples) sum += s;
+    double mean = static_cast<double>(sum) / static_cast<double>(samples.size());
+    uint64_t p50 = samples[samples.size() / 2];
+    uint64_t p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    LOG_INFO << name << ": mean " << mean << " ns, p50 " << p50 << " ns, p99 " << p99
+             << " ns, max " << samples.back() << " ns, " << (1e9 / mean) << " ops/s, "
+             << (bytes * 1e3 / mean) << " MB/s";
+}
+
+bool open_sim(SimTransport& tp, std::shared_ptr<ControlPlane::SimDeviceModel> model, uint32_t tick_us = 100) {
+    ControlPlane::SimOptions opt;
+    opt.tick_us = tick_us;
+    tp.setOptions(opt);
+    tp.setModel(std::move(model));
+    TransportConfig cfg;
+    cfg.device_path = "sim";
+    if (!tp.open(cfg)) {
+        LOG_ERROR << "SimTransport open failed";
+        return false;
+    }
+    return true;
+}
+
+// RS422 BRAM 布局（与 Rs422Device 一致）
+constexpr uint64_t kRs422RecvBuf = 0x000;
+constexpr uint64_t kRs422SendBuf = 0x100;
+
+// 逐字节参考实现（整字突发路径之前的驱动写法）：长度字节 + 数据，bram_offset<=len 的字逐个拼装，尾部补零
+std::vector<uint8_t> rs422_legacy_image(const uint8_t* data, uint8_t len) {
+    std::vector<uint8_t> img;
+    uint8_t first4[4] = {len, 0, 0, 0};
+    if (len >= 1) first4[1] = data[0];
+    if (len >= 2) first4[2] = data[1];
+    if (len >= 3) first4[3] = data[2];
+    img.insert(img.end(), first4, first4 + 4);
+    for (uint32_t off = 4; off <= len; off += 4) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            uint32_t idx = off + i - 1;
+            img.push_back(idx < len ? data[idx] : 0);
+        }
+    }
+    return img;
+}
+
+// 逐字节参考解包：自接收 BRAM 镜像取 min(len, buf_size) 字节
+int32_t rs422_legacy_decode(const uint8_t* img, uint8_t* buf, uint32_t buf_size) {
+    uint32_t reallen = img[0];
+    uint32_t out_len = reallen < buf_size ? reallen : buf_size;
+    for (uint32_t i = 0; i < out_len; ++i) buf[i] = img[1 + i];
+    return static_cast<int32_t>(out_len);
+}
+
+// 整字突发路径与参考实现逐字节一致：全部长度、非对齐源缓冲、截断接收，且不越界写 BRAM / 输出缓冲
+bool check_rs422_layout(SimTransport& tp, Device::Rs422Device& dev) {
+    uint8_t src[260], rx[260], ref[260], img[260];
+    for (size_t i = 0; i < sizeof(src); ++i) src[i] = static_cast<uint8_t>(i * 13 + 5);
+    size_t cases = 0;
+    for (uint32_t len = 1; len <= 255; ++len) {
+        for (uint32_t align = 0; align < 4; ++align) {
+            const uint8_t* data = src + align;
+            tp.withLock([&] { for (uint64_t i = 0; i < 256; ++i) tp.poke8(kRs422SendBuf + i, 0xEE); });
+            if (!dev.send(data, len)) return false;
+            auto expect = rs422_legacy_image(data, static_cast<uint8_t>(len));
+            bool same = true;
+            tp.withLock([&] {
+                for (size_t i = 0; i < 256; ++i) {
+                    uint8_t b = tp.peek8(kRs422SendBuf + i);
+                    if (b != (i < expect.size() ? expect[i] : 0xEE)) same = false;
+                }
+            });
+            if (!same) {
+                LOG_ERROR << "rs422 send image differs from byte-wise reference, len=" << len << " align=" << align;
+                return false;
+            }
+            // 回环帧按不同输出缓冲长度接收（含截断），与参考解包对比
+            uint32_t buf_size = (align == 3 && len > 2) ? len - 2 : len + align;
+            std::memset(rx, 0xCD, sizeof(rx));
+            std::memset(ref, 0xCD, sizeof(ref));
+            int32_t got = dev.receive(rx, buf_size);
+            tp.withLock([&] { for (uint64_t i = 0; i < 256; ++i) img[i] = tp.peek8(kRs422RecvBuf + i); });
+            int32_t want = rs422_legacy_decode(img, ref, buf_size);
+            if (got != want || std::memcmp(rx, ref, sizeof(rx)) != 0) {
+                LOG_ERROR << "rs422 receive differs from byte-wise reference, len=" << len << " buf=" << buf_size
+                          << " got=" << got << " want=" << want;
+                return false;
+            }
+            ++cases;
+        }
+    }
+    LOG_INFO << "rs422 word-wise BRAM path byte-exact vs reference: " << cases << " cases";
+    return true;
+}
+
+bool bench_rs422(size_t iters) {
+    LOG_SEPARATOR();
+    auto model = std::make_shared<Device::Rs422LoopbackModel>();
+    SimTransport tp;
+    if (!open_sim(tp, model)) return false;
+    Device::Rs422Device dev(tp, 255);
+    if (!dev.open(LinkConfig{})) return false;
+
+    uint8_t tx[255], rx[255];
+    for (size_t i = 0; i < sizeof(tx); ++i) tx[i] = static_cast<uint8_t>(i * 7 + 3);
+
+    bool ok = true;
+    std::vector<uint64_t> send_ns, rtt_ns;
+    send_ns.reserve(iters);
+    rtt_ns.reserve(iters);
+    for (size_t n = 0; n < iters; ++n) {
+        uint8_t len = static_cast<uint8_t>(1 + n % 255);
+        uint64_t t0 = now_ns();
+        if (!dev.send(tx, len)) { ok = false; break; }
+        uint64_t t1 = now_ns();
+        int32_t got = dev.receive(rx, sizeof(rx));
+        uint64_t t2 = now_ns();
+        if (got != len || std::memcmp(rx, tx, len) != 0) {
+            LOG_ERROR << "rs422 loopback mismatch at n=" << n << " len=" << static_cast<int>(len) << " got=" << got;
+            ok = false;
+            break;
+        }
+        send_ns.push_back(t1 - t0);
+        rtt_ns.push_back(t2 - t0);
+    }
+    report("rs422 send       (avg 128B)", send_ns, 128);
+    report("rs422 send+recv  (avg 128B)", rtt_ns, 128);
+    if (ok) ok = check_rs422_layout(tp, dev);
+
+    // 事件驱动：对端注入 -> waitEvent 唤醒 -> receive（先消费上面轮询阶段残留的事件）
+    uint32_t stale = 0;
+    tp.waitEvent(&stale, 0);
+    std::vector<uint64_t> ev_ns;
+    ev_ns.reserve(iters / 10 + 1);
+    for (size_t n = 0; n < iters / 10 && ok; ++n) {
+        uint64_t t0 = 0;
+        std::thread peer([&] {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            tp.withLock([&] {
+                t0 = now_ns();
+                model->inject(tp, tx, 64);
+            });
+        });
+        int32_t got = dev.receive(rx, sizeof(rx), 100000);
+        uint64_t t1 = now_ns();
+        peer.join();
+        if (got != 64 || std::memcmp(rx, tx, 64) != 0) {
+            LOG_ERROR << "rs422 event receive mismatch got=" << got;
+            ok = false;
+            break;
+        }
+        ev_ns.push_back(t1 - t0);
+    }
+    report("rs422 inject->event recv (64B)", ev_ns, 64);
+
+    // 接收引擎：对端突发注入，引擎线程在中断中排空入环，消费者只读帧环（不访问寄存器）
+    {
+        constexpr size_t kBurst = 32;
+        Device::Rs422RxEngine eng(dev, 128);
+        if (!eng.start()) return false;
+        std::vector<uint64_t> burst_ns, stamp_ns;
+        burst_ns.reserve(iters / 100 + 1);
+        stamp_ns.reserve((iters / 100 + 1) * kBurst);
+        for (size_t n = 0; n < iters / 100 + 1 && ok; ++n) {
+            uint64_t t0 = 0;
+            std::thread peer([&] {
+                tp.withLock([&] {
+                    t0 = now_ns();
+                    for (size_t k = 0; k < kBurst; ++k) model->inject(tp, tx + k, static_cast<uint8_t>(16 + k));
+                });
+            });
+            for (size_t k = 0; k < kBurst && ok; ++k) {
+                uint64_t ts = 0;
+                int32_t got = eng.read(rx, sizeof(rx), 100000, &ts);
+                uint64_t t1 = now_ns();
+                if (got != static_cast<int32_t>(16 + k) || std::memcmp(rx, tx + k, static_cast<size_t>(got)) != 0) {
+                    LOG_ERROR << "rs422 engine mismatch at burst " << n << " frame " << k << " got=" << got;
+                    ok = false;
+                    break;
+                }
+                stamp_ns.push_back(t1 - ts);
+                if (k + 1 == kBurst) burst_ns.push_back((t1 - t0) / kBurst);
+            }
+            peer.join();
+        }
+        eng.stop();
+        auto st = eng.stats();
+        report("rs422 engine burst x32 per frame", burst_ns, 32);
+        report("rs422 engine irq stamp->consumer", stamp_ns, 32);
+        LOG_INFO << "rs422 engine: events " << st.events << ", frames " << st.frames << ", dropped " << st.dropped
+                 << ", errors " << st.errors << ", high water " << st.high_water << "/" << st.capacity;
+        if (st.dropped != 0 || st.errors != 0) ok = false;
+    }
+
+    tp.withLock([&] {
+        LOG_INFO << "rs422 model: tx " << model->stats().tx_frames << ", rx " << model->stats().rx_frames
+                 << ", overflows " << model->stats().overflows;
+    });
+    LOG_INFO << "rs422 loopback " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+bool bench_can(size_t iters) {
+    LOG_SEPARATOR();
+    auto model = std::make_shared<Device::CanLoopbackModel>();
+    SimTransport tp;
+    if (!open_sim(tp, model)) return false;
+    Device::CanDevice dev(tp, 16);
+    if (!dev.open(LinkConfig{})) {
+        LOG_ERROR << "can open failed";
+        return false;
+    }
+
+    bool ok = true;
+    std::vector<uint64_t> send_ns, rtt_ns;
+    send_ns.reserve(iters);
+    rtt_ns.reserve(iters);
+    Device::CanFrame tx, rx;
+    tx.dlc = 8;
+    tx.len = 8;
+    uint64_t allocs0 = g_alloc_count.load();
+    for (size_t n = 0; n < iters; ++n) {
+        tx.id = static_cast<uint32_t>(n & 0x7FF);
+        for (int i = 0; i < 8; ++i) tx.data[i] = static_cast<uint8_t>(n + i);
+        uint64_t t0 = now_ns();
+        if (!dev.send(tx)) { ok = false; break; }
+        uint64_t t1 = now_ns();
+        int32_t got = dev.receive(rx);
+        uint64_t t2 = now_ns();
+        if (got != 14 || rx.id != tx.id || !std::ranges::equal(rx.payload(), tx.payload())) {
+            LOG_ERROR << "can loopback mismatch at n=" << n << " got=" << got;
+            ok = false;
+            break;
+        }
+        send_ns.push_back(t1 - t0);
+        rtt_ns.push_back(t2 - t0);
+    }
+    uint64_t allocs = g_alloc_count.load() - allocs0;
+    report("can send         (8B)", send_ns, 8);
+    report("can send+recv    (8B)", rtt_ns, 8);
+    LOG_INFO << "can heap allocations in send/recv loop: " << allocs;
+    if (allocs != 0) ok = false;
+
+    // 突发：连续发送填满 RX FIFO 后一次性收完
+    const size_t burst = 32;
+    std::vector<uint64_t> burst_ns;
+    for (size_t n = 0; n < iters / burst && ok; ++n) {
+        uint64_t t0 = now_ns();
+        for (size_t i = 0; i < burst; ++i) dev.send(tx);
+        size_t got = 0;
+        while (dev.receive(rx) > 0) ++got;
+        burst_ns.push_back((now_ns() - t0) / burst);
+        if (got != burst) {
+            LOG_ERROR << "can burst received " << got << "/" << burst;
+            ok = false;
+        }
+    }
+    report("can burst x32 per frame (8B)", burst_ns, 8);
+
+    // 批量：send_batch 一次写入 32 帧，receive_batch 一次排空
+    Device::CanFrame txs[burst], rxs[burst];
+    for (size_t i = 0; i < burst; ++i) {
+        txs[i] = tx;
+        txs[i].id = static_cast<uint32_t>(i);
+    }
+    std::vector<uint64_t> batch_ns;
+    batch_ns.reserve(iters / burst);
+    allocs0 = g_alloc_count.load();
+    for (size_t n = 0; n < iters / burst && ok; ++n) {
+        uint64_t t0 = now_ns();
+        int32_t sent = dev.send_batch(txs);
+        int32_t got = dev.receive_batch(rxs);
+        uint64_t t1 = now_ns();
+        if (sent != static_cast<int32_t>(burst) || got != static_cast<int32_t>(burst) ||
+            rxs[burst - 1].id != txs[burst - 1].id) {
+            LOG_ERROR << "can batch sent " << sent << " received " << got << "/" << burst;
+            ok = false;
+            break;
+        }
+        batch_ns.push_back(t1 - t0);
+    }
+    allocs = g_alloc_count.load() - allocs0;
+    for (uint64_t& v : batch_ns) v /= burst;
+    report("can batch x32 per frame (8B)", batch_ns, 8);
+    LOG_INFO << "can heap allocations in batch loop: " << allocs;
+    if (allocs != 0) ok = false;
+
+    // 超过 FIFO 深度的批量：只入队到 TXFLL 为止，返回实际入队数，不丢帧
+    {
+        constexpr size_t kOver = 80;
+        Device::CanFrame over[kOver], drain[kOver];
+        for (size_t i = 0; i < kOver; ++i) {
+            over[i] = tx;
+            over[i].id = static_cast<uint32_t>(i);
+        }
+        const uint64_t overflows0 = model->stats().overflows;
+        int32_t queued = dev.send_batch(over);
+        int32_t full_again = dev.send_batch(std::span<const Device::CanFrame>(over, 1));
+        int32_t drained = dev.receive_batch(drain);
+        LOG_INFO << "can batch x" << kOver << " into full FIFO: queued " << queued << ", drained " << drained;
+        if (queued <= 0 || queued >= static_cast<int32_t>(kOver) || full_again != 0 || drained != queued ||
+            model->stats().overflows != overflows0) {
+            ok = false;
+        }
+    }
+    LOG_INFO << "can loopback " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+bool bench_canfd(size_t iters) {
+    LOG_SEPARATOR();
+    auto model = std::make_shared<Device::CanFdLoopbackModel>();
+    SimTransport tp;
+    if (!open_sim(tp, model)) return false;
+    Device::CanFDDevice dev(tp, 72);
+    if (!dev.open(LinkConfig{})) {
+        LOG_ERROR << "canfd open failed";
+        return false;
+    }
+
+    bool ok = true;
+    for (uint8_t dlc : {static_cast<uint8_t>(8), static_cast<uint8_t>(15)}) {
+        uint8_t len = Device::CanFDDevice::dlc_to_len(dlc);
+        std::vector<uint64_t> send_ns, rtt_ns;
+        send_ns.reserve(iters);
+        rtt_ns.reserve(iters);
+        Device::CanFrame tx, rx;
+        tx.fdf = true;
+        tx.dlc = dlc;
+        tx.len = len;
+        uint64_t allocs0 = g_alloc_count.load();
+        for (size_t n = 0; n < iters; ++n) {
+            tx.id = static_cast<uint32_t>(n & 0x7FF);
+            for (uint8_t i = 0; i < len; ++i) tx.data[i] = static_cast<uint8_t>(n * 3 + i);
+            uint64_t t0 = now_ns();
+            if (!dev.send(tx)) { ok = false; break; }
+            uint64_t t1 = now_ns();
+            int32_t got = dev.receive(rx);
+            uint64_t t2 = now_ns();
+            if (got != 1 || rx.id != tx.id || rx.len != len ||
+                !std::ranges::equal(rx.payload(), tx.payload())) {
+                LOG_ERROR << "canfd loopback mismatch at n=" << n << " got=" << got;
+                ok = false;
+                break;
+            }
+            send_ns.push_back(t1 - t0);
+            rtt_ns.push_back(t2 - t0);
+        }
+        uint64_t allocs = g_alloc_count.load() - allocs0;
+        report(dlc == 8 ? "canfd send       (8B) " : "canfd send       (64B)", send_ns, len);
+        report(dlc == 8 ? "canfd send+recv  (8B) " : "canfd send+recv  (64B)", rtt_ns, len);
+        LOG_INFO << "canfd heap allocations in send/recv loop: " << allocs;
+        if (allocs != 0) ok = false;
+    }
+
+    // 批量：一次读 TRR 填满 32 个 TX 缓冲，RX FIFO 一次排空
+    const size_t burst = 32;
+    Device::CanFrame txs[burst], rxs[burst];
+    for (size_t i = 0; i < burst; ++i) {
+        txs[i].fdf = true;
+        txs[i].dlc = 15;
+        txs[i].len = 64;
+        txs[i].id = static_cast<uint32_t>(i);
+        for (uint8_t k = 0; k < 64; ++k) txs[i].data[k] = static_cast<uint8_t>(i + k);
+    }
+    std::vector<uint64_t> batch_ns;
+    batch_ns.reserve(iters / burst);
+    uint64_t allocs0 = g_alloc_count.load();
+    for (size_t n = 0; n < iters / burst && ok; ++n) {
+        uint64_t t0 = now_ns();
+        int32_t sent = dev.send_batch(txs);
+        int32_t got = dev.receive_batch(rxs);
+        uint64_t t1 = now_ns();
+        bool same = sent == static_cast<int32_t>(burst) && got == static_cast<int32_t>(burst);
+        for (size_t i = 0; same && i < burst; ++i) {
+            same = rxs[i].id == txs[i].id && std::ranges::equal(rxs[i].payload(), txs[i].payload());
+        }
+        if (!same) {
+            LOG_ERROR << "canfd batch mismatch: sent " << sent << " received " << got << "/" << burst;
+            ok = false;
+            break;
+        }
+        batch_ns.push_back(t1 - t0);
+    }
+    uint64_t allocs = g_alloc_count.load() - allocs0;
+    for (uint64_t& v : batch_ns) v /= burst;
+    report("canfd batch x32 per frame (64B)", batch_ns, 64);
+    LOG_INFO << "canfd heap allocations in batch loop: " << allocs;
+    if (allocs != 0) ok = false;
+    LOG_INFO << "canfd loopback " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+// 接收分发：订阅 40 个离散标准 ID（超过 32 个过滤器，需掩码合并）与 1 个扩展 ID，注入覆盖全部标准 ID 的流量；
+// hw_filter=false 时设置默认处理者使过滤关闭，作为对照
+bool run_can_dispatch(size_t iters, bool hw_filter) {
+    auto model = std::make_shared<Device::CanFdLoopbackModel>();
+    SimTransport tp;
+    if (!open_sim(tp, model)) return false;
+    Device::CanFDDevice dev(tp, 72);
+    if (!dev.open(LinkConfig{})) {
+        LOG_ERROR << "canfd open failed";
+        return false;
+    }
+
+    constexpr uint32_t kSubs = 40;
+    constexpr uint32_t kExtId = 0x1ABCDE0;
+    std::vector<uint32_t> ids;
+    std::vector<uint64_t> hits(2048, 0), want(2048, 0);
+    std::vector<bool> subscribed(2048, false);
+    for (uint32_t k = 0; k < kSubs; ++k) {
+        uint32_t id = (0x100 + 37 * k) & 0x7FF;
+        ids.push_back(id);
+        subscribed[id] = true;
+    }
+    uint64_t ext_hits = 0, default_hits = 0;
+
+    Device::CanDispatcher disp(dev);
+    for (uint32_t id : ids) {
+        disp.subscribe(id, false, [&hits](const Device::CanFrame& f) { ++hits[f.id]; });
+    }
+    disp.subscribe(kExtId, true, [&ext_hits](const Device::CanFrame&) { ++ext_hits; });
+    if (!hw_filter) disp.setDefaultHandler([&default_hits](const Device::CanFrame&) { ++default_hits; });
+    disp.start();
+
+    // 总线流量：标准 ID 轮询 0..2047，每 64 帧插入一帧扩展帧；每批 16 帧，待模型处理完（接收/过滤）再注入下一批
+    const size_t total = std::max<size_t>(iters, 4096);
+    const uint32_t dlc_reg = (8u << XCANFD_DLCR_DLC_SHIFT) | XCANFD_DLCR_EDL_MASK;
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint64_t want_ext = 0;
+    uint64_t t0 = now_ns();
+    for (size_t n = 0; n < total;) {
+        size_t batch = std::min<size_t>(16, total - n);
+        tp.withLock([&] {
+            for (size_t i = 0; i < batch; ++i, ++n) {
+                if (n % 64 == 63) {
+                    model->inject(tp, Device::CanFDDevice::filter_id(kExtId, true), dlc_reg, payload);
+                    ++want_ext;
+                } else {
+                    uint32_t id = static_cast<uint32_t>(n % 2048);
+                    model->inject(tp, Device::CanFDDevice::filter_id(id, false), dlc_reg, payload);
+                    ++want[id];
+                }
+            }
+        });
+        for (;;) {
+            uint64_t done = 0;
+            tp.withLock([&] { done = model->stats().rx_frames + model->stats().filtered + model->stats().overflows; });
+            if (done >= n) break;
+            std::this_thread::yield();
+        }
+    }
+    uint64_t elapsed = now_ns() - t0;
+    disp.stop();
+
+    auto st = disp.stats();
+    Device::CanFdLoopbackModel::Stats ms;
+    tp.withLock([&] { ms = model->stats(); });
+    bool ok = ms.overflows == 0 && ext_hits == want_ext;
+    for (uint32_t id : ids) ok = ok && hits[id] == want[id];
+    if (!hw_filter) ok = ok && default_hits == st.unmatched && ms.filtered == 0;
+
+    const char* mode = hw_filter ? "can dispatch (hw filter)" : "can dispatch (no filter)";
+    LOG_INFO << mode << ": " << total << " bus frames, " << st.frames << " reached CPU, " << ms.filtered
+             << " filtered in hw, routed " << st.routed << ", unmatched " << st.unmatched << ", events " << st.events;
+    LOG_INFO << mode << ": filters " << st.filters << (st.filters == 0 ? " (off)" : st.exact_filters ? " (exact)" : " (merged masks)")
+             << ", " << (elapsed / static_cast<double>(total)) << " ns per bus frame, "
+             << (st.frames ? elapsed / static_cast<double>(st.frames) : 0.0) << " ns per delivered frame";
+    if (!ok) LOG_ERROR << mode << ": routing mismatch (ext " << ext_hits << "/" << want_ext << ", overflows " << ms.overflows << ")";
+    return ok;
+}
+
+// 无订阅时硬件拒收全部帧；运行中订阅/退订即时重编程过滤器
+bool check_can_reject_all() {
+    auto model = std::make_shared<Device::CanFdLoopbackModel>();
+    SimTransport tp;
+    if (!open_sim(tp, model)) return false;
+    Device::CanFDDevice dev(tp, 72);
+    if (!dev.open(LinkConfig{})) {
+        LOG_ERROR << "canfd open failed";
+        return false;
+    }
+
+    const uint32_t dlc_reg = (8u << XCANFD_DLCR_DLC_SHIFT) | XCANFD_DLCR_EDL_MASK;
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::atomic<uint64_t> hits{0};
+    auto inject = [&](uint32_t id, bool ide, size_t n) {
+        tp.withLock([&] {
+            for (size_t i = 0; i < n; ++i) model->inject(tp, Device::CanFDDevice::filter_id(id, ide), dlc_reg, payload);
+        });
+    };
+    auto settle = [&](uint64_t want_hits) {
+        for (int i = 0; i < 1000 && hits.load() < want_hits; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    };
+
+    Device::CanDispatcher disp(dev);
+    disp.start();
+    inject(0x123, false, 8);
+    inject(0x1ABCDE0, true, 8);
+    settle(0);
+    auto st_idle = disp.stats();
+    Device::CanFdLoopbackModel::Stats ms_idle;
+    tp.withLock([&] { ms_idle = model->stats(); });
+
+    int token = disp.subscribe(0x123, false, [&hits](const Device::CanFrame&) { ++hits; });
+    inject(0x123, false, 8);
+    inject(0x124, false, 8);
+    settle(8);
+    auto st_sub = disp.stats();
+
+    disp.unsubscribe(token);
+    inject(0x123, false, 8);
+    settle(8);
+    disp.stop();
+    auto st_end = disp.stats();
+    Device::CanFdLoopbackModel::Stats ms_end;
+    tp.withLock([&] { ms_end = model->stats(); });
+
+    bool ok = st_idle.frames == 0 && ms_idle.filtered == 16 && st_idle.filters == 1 &&
+              hits.load() == 8 && st_sub.frames == 8 && st_sub.unmatched == 0 &&
+              st_end.frames == 8 && ms_end.filtered == 32 && st_end.filters == 1;
+    LOG_INFO << "can reject-all: idle filtered " << ms_idle.filtered << "/16, subscribed hits " << hits.load()
+             << "/8, after unsubscribe filtered " << ms_end.filtered << "/32, frames " << st_end.frames;
+    if (!ok) LOG_ERROR << "can reject-all MISMATCH";
+    return ok;
+}
+
+// 每次写 AFR 后立即从总线收到一帧未订阅的 ID，覆盖重编程过程中的每个中间状态
+class CanFdAfrProbeModel : public Device::CanFdLoopbackModel {
+public:
+    void onWrite(ControlPlane::SimTransport& tp, uint64_t offset, uint32_t value, unsigned width) override {
+        Device::CanFdLoopbackModel::onWrite(tp, offset, value, width);
+        if (offset != XCANFD_AFR_OFFSET || !probe) return;
+        const uint8_t payload[8] = {};
+        inject(tp, Device::CanFDDevice::filter_id(0x7F0, false), (8u << XCANFD_DLCR_DLC_SHIFT) | XCANFD_DLCR_EDL_MASK, payload);
+        ++probes;
+    }
+    bool probe = false;
+    uint64_t probes = 0;
+};
+
+// 运行中反复订阅/退订：重编程的任何中间状态都不得放行未订阅的 ID（无接收全部的窗口）；
+// 随后逐个订阅 40 个 ID（增量追加并合并），每个 ID 都须命中
+bool check_can_filter_churn() {
+    auto model = std::make_shared<CanFdAfrProbeModel>();
+    SimTransport tp;
+    if (!open_sim(tp, model)) return false;
+    Device::CanFDDevice dev(tp, 72);
+    if (!dev.open(LinkConfig{})) {
+        LOG_ERROR << "canfd open failed";
+        return false;
+    }
+
+    const uint32_t dlc_reg = (8u << XCANFD_DLCR_DLC_SHIFT) | XCANFD_DLCR_EDL_MASK;
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::atomic<uint64_t> hits{0};
+    Device::CanDispatcher disp(dev);
+    disp.start();
+
+    auto handler = [&hits](const Device::CanFrame&) { ++hits; };
+    tp.withLock([&] { model->probe = true; });
+    for (int round = 0; round < 50; ++round) {
+        int a = disp.subscribe(0x123, false, handler);
+        int b = disp.subscribe(0x1ABCDE0, true, handler);
+        disp.unsubscribe(a);
+        disp.unsubscribe(b);
+    }
+    uint64_t probes = 0, leaked = 0;
+    tp.withLock([&] {
+        model->probe = false;
+        probes = model->probes;
+        leaked = model->stats().rx_frames + model->stats().overflows;
+    });
+
+    std::vector<uint32_t> ids;
+    for (uint32_t k = 0; k < 40; ++k) {
+        ids.push_back((0x100 + 37 * k) & 0x7FF);
+        disp.subscribe(ids.back(), false, handler);
+    }
+    for (size_t k = 0; k < ids.size(); k += 8) {   // 每批不超过 RX FIFO 深度
+        tp.withLock([&] {
+            for (size_t i = k; i < std::min(k + 8, ids.size()); ++i) {
+                model->inject(tp, Device::CanFDDevice::filter_id(ids[i], false), dlc_reg, payload);
+            }
+        });
+        for (int i = 0; i < 1000 && hits.load() < std::min(k + 8, ids.size()); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    disp.stop();
+    auto st = disp.stats();
+
+    bool ok = leaked == 0 && probes > 0 && hits.load() == ids.size() && st.filters <= Device::CanFDDevice::kMaxAcceptFilters && !st.exact_filters;
+    LOG_INFO << "can filter churn: " << probes << " unsubscribed frames injected across 200 reprogrammings, "
+             << leaked << " accepted; live subscribe of " << ids.size() << " ids hit " << hits.load() << " with "
+             << st.filters << " filters";
+    if (!ok) LOG_ERROR << "can filter churn MISMATCH";
+    return ok;
+}
+
+bool bench_can_dispatch(size_t iters) {
+    LOG_SEPARATOR();
+    bool ok = run_can_dispatch(iters, true);
+    ok = run_can_dispatch(iters, false) && ok;
+    ok = check_can_reject_all() && ok;
+    ok = check_can_filter_churn() && ok;
+    LOG_INFO << "can dispatch " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+// 发送队列：strict_order 校验每个生产者的帧按入队次序回环；关闭时仅统计（各缓冲按号仲裁，次序不保证）
+bool run_canfd_txq(size_t iters, bool strict_order) {
+    constexpr uint32_t kFrameUs = 20;
+    auto model = std::make_shared<Device::CanFdLoopbackModel>(kFrameUs);
+    SimTransport tp;
+    if (!open_sim(tp, model, 10)) return false;
+    Device::CanFDDevice dev(tp, 72);
+    if (!dev.open(LinkConfig{})) {
+        LOG_ERROR << "canfd open failed";
+        return false;
+    }
+
+    const size_t producers = 2;
+    const size_t total = std::min<size_t>(iters, 4000) / producers * producers;
+    Device::CanFdTxQueue txq(dev, 256, strict_order);
+
+    // 泵线程独占事件 fd：TXOK 补充发送缓冲，同一事件顺带排空 RX FIFO 并校验回环序号
+    std::atomic<size_t> received{0};
+    std::atomic<bool> order_ok{true};
+    std::vector<uint32_t> next_seq(producers, 0);
+    Device::CanFrame rxs[32];
+    txq.start([&](uint32_t) {
+        int32_t n;
+        while ((n = dev.receive_batch(rxs)) > 0) {
+            for (int32_t i = 0; i < n; ++i) {
+                uint32_t p = rxs[i].id >> 8;
+                uint32_t seq = static_cast<uint32_t>(rxs[i].data[0]) | (static_cast<uint32_t>(rxs[i].data[1]) << 8);
+                if (p >= producers || seq != next_seq[p]) order_ok.store(false, std::memory_order_relaxed);
+                next_seq[p % producers] = seq + 1;
+            }
+            received.fetch_add(static_cast<size_t>(n), std::memory_order_relaxed);
+        }
+    });
+
+    uint64_t t0 = now_ns();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            Device::CanFrame f;
+            f.fdf = true;
+            f.dlc = 15;
+            f.len = 64;
+            f.id = static_cast<uint32_t>(p << 8);
+            for (uint32_t seq = 0; seq < total / producers; ++seq) {
+                f.data[0] = static_cast<uint8_t>(seq);
+                f.data[1] = static_cast<uint8_t>(seq >> 8);
+                while (!txq.enqueue(f)) std::this_thread::yield();    // 队满：生产者退避重试
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    uint64_t deadline = now_ns() + 5'000'000'000ull;
+    while (received.load() < total && now_ns() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    uint64_t elapsed = now_ns() - t0;
+    txq.stop();
+
+    const char* mode = strict_order ? "canfd txq (strict order)" : "canfd txq (all buffers) ";
+    auto st = txq.stats();
+    double util = static_cast<double>(st.sent) * kFrameUs * 1000.0 / static_cast<double>(elapsed);
+    LOG_INFO << mode << ": " << received.load() << "/" << total << " frames in " << elapsed / 1000
+             << " us, bus utilisation " << util * 100.0 << "% (frame " << kFrameUs << " us)";
+    LOG_INFO << mode << ": enqueued " << st.enqueued << ", sent " << st.sent << ", rejected(full) " << st.dropped
+             << ", hw_errors " << st.hw_errors << ", refills " << st.refills << ", high water " << st.high_water
+             << "/" << st.capacity << ", rx overflows " << model->stats().overflows;
+    bool ok = received.load() == total && st.hw_errors == 0 && (!strict_order || order_ok.load());
+    if (!strict_order) LOG_INFO << mode << ": in-order " << (order_ok.load() ? "yes" : "no (buffer arbitration)");
+    return ok;
+}
+
+bool bench_canfd_txq(size_t iters) {
+    LOG_SEPARATOR();
+    bool ok = run_canfd_txq(iters, true);
+    ok = run_canfd_txq(iters, false) && ok;
+    LOG_INFO << "canfd txq " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+// 模式切换：配置/工作模式往返耗时（有界轮询，模型立即切换）；无模型时寄存器不响应，初始化应在超时后失败返回
+bool bench_mode_switch(size_t iters) {
+    LOG_SEPARATOR();
+    const size_t rounds = std::min<size_t>(iters, 200);
+    bool ok = true;
+    {
+        SimTransport tp;
+        if (!open_sim(tp, std::make_shared<Device::CanLoopbackModel>())) return false;
+        Device::CanDevice dev(tp, 16);
+        if (!dev.open(LinkConfig{})) {
+            LOG_ERROR << "can open failed";
+            return false;
+        }
+        std::vector<uint64_t> ns;
+        ns.reserve(rounds);
+        uint32_t on = 1;
+        for (size_t n = 0; n < rounds && ok; ++n) {
+            uint64_t t0 = now_ns();
+            ok = dev.ioctl(Device::CanDevice::IOCTL_SET_LOOPBACK, &on, sizeof(on)) == 0;
+            ns.push_back(now_ns() - t0);
+        }
+        report("can config->normal  ", ns, 0);
+    }
+    {
+        SimTransport tp;
+        if (!open_sim(tp, std::make_shared<Device::CanFdLoopbackModel>())) return false;
+        Device::CanFDDevice dev(tp, 72);
+        if (!dev.open(LinkConfig{})) {
+            LOG_ERROR << "canfd open failed";
+            return false;
+        }
+        std::vector<uint64_t> ns;
+        ns.reserve(rounds);
+        for (size_t n = 0; n < rounds && ok; ++n) {
+            uint32_t baud = (n & 1) ? 500000 : 1000000;
+            uint64_t t0 = now_ns();
+            ok = dev.ioctl(CAN_DEV_SET_BAUD, &baud, sizeof(baud)) == 0;
+            ns.push_back(now_ns() - t0);
+        }
+        report("canfd set baud      ", ns, 0);
+    }
+
+    // 无模型：SRST 不自清零、SR 模式位不变化，open 应在 kRegPollTimeoutUs 左右失败而非挂死
+    const uint64_t bound_ns = 10ull * Device::TransportLinkAdapter::kRegPollTimeoutUs * 1000;
+    {
+        SimTransport tp;
+        if (!open_sim(tp, nullptr)) return false;
+        Device::CanDevice dev(tp, 16);
+        uint64_t t0 = now_ns();
+        bool opened = dev.open(LinkConfig{});
+        uint64_t dt = now_ns() - t0;
+        LOG_INFO << "can wedged core: open " << (opened ? "succeeded" : "failed") << " after " << dt / 1000 << " us";
+        if (opened || dt > bound_ns) ok = false;
+    }
+    {
+        SimTransport tp;
+        if (!open_sim(tp, nullptr)) return false;
+        Device::CanFDDevice dev(tp, 72);
+        uint64_t t0 = now_ns();
+        bool opened = dev.open(LinkConfig{});
+        uint64_t dt = now_ns() - t0;
+        LOG_INFO << "canfd wedged core: open " << (opened ? "succeeded" : "failed") << " after " << dt / 1000 << " us";
+        if (opened || dt > bound_ns) ok = false;
+    }
+    LOG_INFO << "mode switch " << (ok ? "bounded" : "FAILED");
+    return ok;
+}
+
+bool bench_helm(size_t iters) {
+    LOG_SEPARATOR();
+    auto model = std::make_shared<Device::HelmServoModel>(2000);
+    SimTransport tp;
+    if (!open_sim(tp, model, 50)) return false;
+    Device::HelmDevice dev(tp, 16);
+    if (!dev.open(LinkConfig{})) return false;
+
+    uint32_t duty[4] = {0, 0, 0, 0};
+    uint16_t ad[4] = {0, 0, 0, 0};
+    std::vector<uint64_t> send_ns, recv_ns;
+    send_ns.reserve(iters);
+    recv_ns.reserve(iters);
+    for (size_t n = 0; n < iters; ++n) {
+        uint64_t t0 = now_ns();
+        dev.send(reinterpret_cast<const uint8_t*>(duty), sizeof(duty));
+        uint64_t t1 = now_ns();
+        dev.receive(reinterpret_cast<uint8_t*>(ad), sizeof(ad));
+        uint64_t t2 = now_ns();
+        send_ns.push_back(t1 - t0);
+        recv_ns.push_back(t2 - t1);
+    }
+    report("helm send pwm    (16B)", send_ns, sizeof(duty));
+    report("helm recv ad     (8B) ", recv_ns, sizeof(ad));
+
+    // 阶跃：PWM 0 -> 10000，测量 ADC 到达目标 95% 的时间（一阶惯性约 3τ）
+    for (auto& d : duty) d = 10000;
+    uint64_t t0 = now_ns();
+    dev.send(reinterpret_cast<const uint8_t*>(duty), sizeof(duty));
+    bool reached = false;
+    while (now_ns() - t0 < 100'000'000ULL) {
+        dev.receive(reinterpret_cast<uint8_t*>(ad), sizeof(ad));
+        if (ad[0] >= 9500 && ad[3] >= 9500) {
+            reached = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    uint64_t dt = now_ns() - t0;
+    LOG_INFO << "helm step 0->10000: " << (reached ? "95% reached in " : "NOT reached after ")
+             << dt / 1000 << " us (tau 2000 us), ad = " << ad[0] << "/" << ad[1] << "/" << ad[2] << "/" << ad[3];
+
+    // 控制环：4kHz / 10kHz 持续运行，命令经双缓冲下发，反馈跟随；统计实际频率与唤醒抖动
+    bool loop_ok = true;
+    for (uint32_t period_us : {250u, 100u}) {
+        Device::HelmServoLoop::Options opt;
+        opt.period_us = period_us;
+        Device::HelmServoLoop loop(dev, opt);
+        Device::HelmCommand cmd;
+        for (auto& d : cmd.duty) d = 0;
+        loop.setCommand(cmd);
+        if (!loop.start()) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        for (auto& d : cmd.duty) d = period_us * 20;
+        loop.setCommand(cmd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        loop.stop();
+        Device::HelmFeedback fb;
+        loop.feedback(fb);
+        auto st = loop.stats();
+        const double target_hz = 1e6 / period_us;
+        LOG_INFO << "helm loop " << period_us << "us: " << st.rate_hz << " Hz over " << st.cycles << " cycles, missed "
+                 << st.missed << ", io errors " << st.io_errors << ", wake late mean " << st.late_mean_ns
+                 << " ns p99 <" << st.late_p99_ns << " ns max " << st.late_max_ns << " ns, exchange mean "
+                 << st.exchange_mean_ns << " ns max " << st.exchange_max_ns << " ns, ad[0] " << fb.ad[0] << "/"
+                 << cmd.duty[0];
+        if (st.rate_hz < target_hz * 0.9 || st.io_errors != 0 || fb.duty[0] != cmd.duty[0] ||
+            fb.ad[0] < cmd.duty[0] * 9 / 10) {
+            loop_ok = false;
+        }
+    }
+    return reached && loop_ok;
+}
+
+bool bench_ddr(size_t iters) {
+    LOG_SEPARATOR();
+    SimTransport tp;
+    if (!open_sim(tp, nullptr, 0)) return false;
+    Device::DdrDevice dev(tp, 1500);
+    if (!dev.open(LinkConfig{})) return false;
+
+    bool ok = true;
+    const size_t block = 64 * 1024;
+    std::vector<uint8_t> src(block), dst(block);
+    for (size_t i = 0; i < block; ++i) src[i] = static_cast<uint8_t>(i * 11 + 5);
+
+    // 同步：直接写后备文件再读回
+    std::vector<uint64_t> wr_ns, rd_ns;
+    for (size_t n = 0; n < iters / 10 + 1; ++n) {
+        uint64_t t0 = now_ns();
+        tp.continuousWrite(0, src.data(), block);
+        uint64_t t1 = now_ns();
+        dev.receive(dst.data(), static_cast<uint32_t>(block));
+        uint64_t t2 = now_ns();
+        wr_ns.push_back(t1 - t0);
+        rd_ns.push_back(t2 - t1);
+    }
+    report("ddr sync write   (64KB)", wr_ns, block);
+    report("ddr sync read    (64KB)", rd_ns, block);
+    if (src != dst) {
+        LOG_ERROR << "ddr sync read-back mismatch";
+        ok = false;
+    }
+
+    // 异步：DdrDevice::send 走 continuousWriteAsync，经 aio eventfd 收割完成
+    size_t completed = 0;
+    ssize_t last_res = 0;
+    tp.setOnContinuousWriteComplete([&](ssize_t res) { ++completed; last_res = res; });
+    std::vector<uint64_t> async_ns;
+    for (size_t n = 0; n < iters / 10 + 1; ++n) {
+        size_t before = completed;
+        uint64_t t0 = now_ns();
+        dev.send(src.data(), static_cast<uint32_t>(block));
+        while (completed == before) {
+            struct pollfd pfd{ tp.getAioEventFd(), POLLIN, 0 };
+            if (::poll(&pfd, 1, 1000) <= 0) break;
+            tp.drainAioCompletions(16);
+        }
+        async_ns.push_back(now_ns() - t0);
+        if (completed == before || last_res != static_cast<ssize_t>(block)) {
+            LOG_ERROR << "ddr async write not completed, res=" << last_res;
+            ok = false;
+            break;
+        }
+    }
+    report("ddr async write  (64KB)", async_ns, block);
+    std::fill(dst.begin(), dst.end(), 0);
+    dev.receive(dst.data(), static_cast<uint32_t>(block));
+    LOG_INFO << "ddr round-trip " << (ok && src == dst ? "matches" : "MISMATCH");
+    return ok && src == dst;
+}
+
+// DMA 直达 Topic：帧仍在途时析构发布器，须等待 DMA 完成后再释放写槽，并解除传输层完成回调
+bool check_dma_topic_teardown() {
+    LOG_SEPARATOR();
+    auto& dds = MB_DDF::DDS::DDSCore::instance();
+    if (!dds.initialize(128 * 1024 * 1024)) {
+        LOG_WARN << "dma topic teardown: DDS shared memory unavailable, skipped";
+        return true;
+    }
+    SimTransport tp;
+    ControlPlane::SimOptions opt;
+    opt.tick_us = 0;
+    opt.dma_delay_us = 20000;  // 每个异步 DMA 在后台线程上耗时 20ms
+    tp.setOptions(opt);
+    TransportConfig cfg;
+    cfg.device_path = "sim";
+    if (!tp.open(cfg)) return false;
+
+    const size_t frame = 4096;
+    std::vector<uint8_t> src(frame), dst(frame);
+    for (size_t i = 0; i < frame; ++i) src[i] = static_cast<uint8_t>(i * 13 + 1);
+    tp.continuousWrite(0, src.data(), frame);
+
+    auto pub = dds.create_publisher("local://sim_dma_teardown", false);
+    auto sub = dds.create_subscriber("local://sim_dma_teardown", false);
+    if (!pub || !sub) return false;
+    sub->read(dst.data(), dst.size(), true);
+
+    bool ok = true;
+    uint64_t t0 = now_ns();
+    {
+        Device::DmaTopicPublisher zc(tp, pub, 0, frame);
+        zc.bindCompletion();
+        if (!zc.readFrameAsync(0) || !zc.pending()) {
+            LOG_ERROR << "dma topic async submit failed";
+            return false;
+        }
+        // 立即析构：DMA 仍在途
+    }
+    uint64_t teardown_ns = now_ns() - t0;
+
+    std::fill(dst.begin(), dst.end(), 0);
+    size_t got = sub->read(dst.data(), dst.size(), false);
+    if (got != frame || dst != src) {
+        LOG_ERROR << "dma topic teardown: in-flight frame lost, got=" << got;
+        ok = false;
+    }
+    if (teardown_ns < opt.dma_delay_us * 1000ull / 2) {
+        LOG_ERROR << "dma topic teardown returned before DMA completed: " << teardown_ns / 1000 << " us";
+        ok = false;
+    }
+
+    // 析构后的完成不得再回调到已释放的发布器
+    ControlPlane::AsyncRequest req;
+    req.buf = dst.data();
+    req.len = frame;
+    req.token = &req;
+    if (!tp.submitAsync(req)) return false;
+    struct pollfd pfd{ tp.getAioEventFd(), POLLIN, 0 };
+    int drained = 0;
+    for (int i = 0; i < 100 && drained == 0; ++i) {
+        if (::poll(&pfd, 1, 10) > 0) drained = tp.drainAioCompletions(16);
+    }
+    if (drained != 1) {
+        LOG_ERROR << "dma topic teardown: follow-up completion not drained";
+        ok = false;
+    }
+    LOG_INFO << "dma topic teardown with frame in flight: " << teardown_ns / 1000 << " us, frame "
+             << (got == frame ? "published" : "LOST");
+    return ok;
+}
+
+// 设备图工厂：sim 传输层上并行打开；xdma 按路径 + DMA 通道分组；同键设备共享传输层，寄存器无响应的设备单独报告失败且不拖慢其余设备
+bool bench_factory() {
+    LOG_SEPARATOR();
+    using Factory::HardwareFactory;
+    const char* text = R"ini(
+[device.port_a]
+type      = rs422
+transport = sim
+offset    = 0x10000
+mtu       = 255
+[device.port_a_mon]       ; 与 port_a 同一传输层键
+type      = rs422
+transport = sim
+offset    = 0x10000
+mtu       = 255
+[device.bus]
+type      = can
+transport = sim
+mtu       = 8
+loopback  = 1
+baud      = 500000
+[device.fd]
+type      = canfd
+transport = sim
+mtu       = 72
+baud      = 1000000
+data_baud = 1000000
+[device.servo]
+type      = helm
+transport = sim
+mtu       = 16
+[device.wedged]
+type      = can
+transport = sim
+model     = none
+offset    = 0x90000
+mtu       = 8
+)ini";
+    std::string err;
+    bool ok = true;
+    // 内置表：同一 xdma 节点上偏移/事件号不同的设备共用一个键，带 DMA 通道的设备另成一组
+    Factory::HardwareConfig def;
+    Factory::HardwareConfig::parse(Factory::HardwareConfig::defaultText(), def);
+    const auto* imu = def.find("imu");
+    const auto* dyt = def.find("dyt");
+    const auto* ddr = def.find("ddr");
+    if (!imu || !dyt || !ddr || imu->transportKey() != dyt->transportKey() || imu->transportKey() == ddr->transportKey()) {
+        LOG_ERROR << "factory transport keys: xdma devices not grouped by path + DMA channels";
+        ok = false;
+    }
+    if (HardwareFactory::loadConfigText("[device.x]\ntype = can\nmtu = eight\n", &err)) ok = false;
+    LOG_INFO << "factory bad config rejected: " << err;
+    if (!HardwareFactory::loadConfigText(text, &err)) {
+        LOG_ERROR << "factory config: " << err;
+        return false;
+    }
+
+    uint64_t t0 = now_ns();
+    auto reports = HardwareFactory::openAll();
+    uint64_t dt = now_ns() - t0;
+    for (const auto& r : reports) {
+        LOG_INFO << "  " << r.name << ": " << (r.ok ? "ok" : "FAILED " + r.error) << " (" << r.elapsed_us << " us)";
+        if (r.ok == (r.name == "wedged")) ok = false;
+    }
+    const size_t transports = HardwareFactory::transportCount();
+    LOG_INFO << "factory openAll: " << reports.size() << " devices in " << dt / 1000 << " us, "
+             << transports << " transports";
+    if (transports != reports.size() - 1) ok = false;
+    // 并行打开：总耗时由最慢的设备（轮询超时）决定
+    if (dt > 2ull * Device::TransportLinkAdapter::kRegPollTimeoutUs * 1000) ok = false;
+
+    auto a = HardwareFactory::get("port_a");
+    auto mon = HardwareFactory::get("port_a_mon");
+    if (!a || !mon || a != HardwareFactory::get("port_a")) ok = false;
+    if (HardwareFactory::create("no_such_device") || HardwareFactory::get("no_such_device")) ok = false;
+    if (a && mon) {
+        // 共享传输层：经一个句柄发送，另一个句柄收到同一帧
+        const uint8_t tx[5] = {1, 2, 3, 4, 5};
+        uint8_t rx[255] = {};
+        bool sent = a->send(tx, sizeof(tx));
+        int32_t got = mon->receive(rx, sizeof(rx), 10000);
+        if (!sent || got != 5 || std::memcmp(rx, tx, sizeof(tx)) != 0) ok = false;
+    }
+    // create 每次新建句柄，不返回缓存
+    auto fresh = HardwareFactory::create("port_a");
+    if (!fresh || fresh == a) ok = false;
+    fresh.reset();
+    a.reset();
+    mon.reset();
+    HardwareFactory::loadConfigText(Factory::HardwareConfig::defaultText());
+    LOG_INFO << "factory " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+// Topic 路由：发布到 tx_topic 的帧经设备回环后出现在 rx_topic；两路设备共用一个反应线程
+bool bench_router(size_t iters) {
+    LOG_SEPARATOR();
+    using Factory::HardwareFactory;
+    auto& dds = MB_DDF::DDS::DDSCore::instance();
+    // 共享内存段按名称复用：已被其他测试以不同大小创建时无法初始化，跳过而不判失败
+    if (!dds.initialize(128 * 1024 * 1024)) {
+        LOG_WARN << "router: DDS shared memory unavailable, skipped";
+        return true;
+    }
+    const char* text = R"ini(
+[device.route_a]
+type      = rs422
+transport = sim
+offset    = 0x10000
+mtu       = 255
+rx_topic  = local://sim_route_a_rx
+tx_topic  = local://sim_route_a_tx
+[device.route_b]
+type      = rs422
+transport = sim
+offset    = 0x20000
+mtu       = 255
+rx_topic  = local://sim_route_b_rx
+tx_topic  = local://sim_route_b_tx
+)ini";
+    std::string err;
+    if (!HardwareFactory::loadConfigText(text, &err)) {
+        LOG_ERROR << "router config: " << err;
+        return false;
+    }
+
+    bool ok = true;
+    {
+        TopicRouter router;
+        auto rx_a = dds.create_subscriber("local://sim_route_a_rx");
+        auto rx_b = dds.create_subscriber("local://sim_route_b_rx");
+        if (router.attachConfigured() != 2 || !rx_a || !rx_b || !router.start()) {
+            LOG_ERROR << "router setup failed";
+            return false;
+        }
+        auto tx_a = dds.create_publisher("local://sim_route_a_tx");
+        auto tx_b = dds.create_publisher("local://sim_route_b_tx");
+
+        const size_t frames = std::min<size_t>(iters, 2000);
+        uint8_t tx[255], rx[255];
+        // 共享内存中的 Topic 跨进程保留：先同步到最新消息，之后按序读取本次运行的帧
+        rx_a->read(rx, sizeof(rx), true);
+        rx_b->read(rx, sizeof(rx), true);
+        std::vector<uint64_t> rtt_ns;
+        rtt_ns.reserve(frames);
+        for (size_t n = 0; n < frames && ok; ++n) {
+            const bool port_a = (n & 1) == 0;
+            const uint8_t len = static_cast<uint8_t>(1 + n % 255);
+            for (uint8_t i = 0; i < len; ++i) tx[i] = static_cast<uint8_t>(n + i);
+            auto& pub = port_a ? tx_a : tx_b;
+            auto& sub = port_a ? rx_a : rx_b;
+            uint64_t t0 = now_ns();
+            if (!pub->publish(tx, len)) { ok = false; break; }
+            size_t got = 0;
+            while ((got = sub->read(rx, sizeof(rx), false)) == 0) {
+                if (now_ns() - t0 > 100000000ull) break;
+                std::this_thread::yield();
+            }
+            rtt_ns.push_back(now_ns() - t0);
+            if (got != len || std::memcmp(rx, tx, len) != 0) {
+                LOG_ERROR << "router mismatch at n=" << n << " len=" << static_cast<int>(len) << " got=" << got;
+                ok = false;
+            }
+        }
+        report("router topic->dev->topic (avg 128B)", rtt_ns, 128);
+        router.stop();
+        auto sa = router.stats("route_a");
+        auto sb = router.stats("route_b");
+        LOG_INFO << "router route_a: tx " << sa.tx_frames << ", rx " << sa.frames << " (zero-copy " << sa.zero_copy
+                 << "), events " << sa.events << "; route_b: tx " << sb.tx_frames << ", rx " << sb.frames
+                 << " (zero-copy " << sb.zero_copy << "), events " << sb.events;
+        if (sa.tx_frames + sb.tx_frames != frames || sa.zero_copy + sb.zero_copy != frames ||
+            sa.rx_errors + sb.rx_errors + sa.publish_failed + sb.publish_failed != 0) {
+            ok = false;
+        }
+    }
+    HardwareFactory::loadConfigText(Factory::HardwareConfig::defaultText());
+    LOG_INFO << "router " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+// 设备句柄订阅者：设备就绪 fd 驱动回调，空闲时不借用缓冲，取消订阅经 eventfd 立即返回
+bool bench_handle_subscriber(size_t iters) {
+    LOG_SEPARATOR();
+    using Factory::HardwareFactory;
+    const char* text = R"ini(
+[device.sub_tx]
+type      = rs422
+transport = sim
+offset    = 0x10000
+mtu       = 255
+[device.sub_rx]           ; 与 sub_tx 共用传输层，接收其回环帧
+type      = rs422
+transport = sim
+offset    = 0x10000
+mtu       = 255
+)ini";
+    std::string err;
+    if (!HardwareFactory::loadConfigText(text, &err)) {
+        LOG_ERROR << "handle subscriber config: " << err;
+        return false;
+    }
+
+    bool ok = true;
+    auto tx = HardwareFactory::create("sub_tx");
+    auto rx = HardwareFactory::create("sub_rx");
+    if (!tx || !rx) {
+        LOG_ERROR << "handle subscriber open failed";
+        ok = false;
+    } else {
+        auto& pool = MB_DDF::DDS::BufferPool::instance();
+        const auto p0 = pool.stats();
+        std::atomic<uint32_t> received{0};
+        std::atomic<uint32_t> bad{0};
+        std::atomic<uint32_t> expect_len{0};
+        auto sub = std::make_shared<MB_DDF::DDS::Subscriber>(nullptr, nullptr, "sim_handle_sub", rx);
+        sub->subscribe([&](const void* data, size_t size, uint64_t ts) {
+            const auto* p = static_cast<const uint8_t*>(data);
+            const uint32_t n = received.load(std::memory_order_relaxed);
+            bool good = size == expect_len.load(std::memory_order_relaxed) && ts != 0;
+            for (size_t i = 0; good && i < size; ++i) good = p[i] == static_cast<uint8_t>(n + i);
+            if (!good) bad.fetch_add(1, std::memory_order_relaxed);
+            received.fetch_add(1, std::memory_order_release);
+        });
+
+        const size_t frames = std::min<size_t>(iters, 2000);
+        uint8_t buf[255];
+        std::vector<uint64_t> rtt_ns;
+        rtt_ns.reserve(frames);
+        for (size_t n = 0; n < frames && ok; ++n) {
+            const uint8_t len = static_cast<uint8_t>(1 + n % 255);
+            for (uint8_t i = 0; i < len; ++i) buf[i] = static_cast<uint8_t>(n + i);
+            expect_len.store(len, std::memory_order_relaxed);
+            uint64_t t0 = now_ns();
+            if (!tx->send(buf, len)) { ok = false; break; }
+            while (received.load(std::memory_order_acquire) != n + 1) {
+                if (now_ns() - t0 > 100000000ull) break;
+                std::this_thread::yield();
+            }
+            rtt_ns.push_back(now_ns() - t0);
+            if (received.load(std::memory_order_acquire) != n + 1) {
+                LOG_ERROR << "handle subscriber timeout at n=" << n;
+                ok = false;
+            }
+        }
+        report("handle subscriber send->callback (avg 128B)", rtt_ns, 128);
+
+        // 空闲期间工作线程阻塞在 poll 上：不借用缓冲、不回调
+        const auto p1 = pool.stats();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const auto p2 = pool.stats();
+        const bool evented = rx->getEventFd() >= 0;
+        if (evented && p2.acquired != p1.acquired) ok = false;
+
+        uint64_t t0 = now_ns();
+        sub->unsubscribe();
+        const uint64_t stop_us = (now_ns() - t0) / 1000;
+        sub.reset();
+
+        LOG_INFO << "handle subscriber: " << received.load() << "/" << frames << " frames, " << bad.load()
+                 << " bad, pool acquired " << (p1.acquired - p0.acquired) << " (reused " << (p1.reused - p0.reused)
+                 << "), idle acquires " << (p2.acquired - p1.acquired) << (evented ? "" : " (polled)")
+                 << ", cached " << p2.cached_bytes << " B, unsubscribe " << stop_us << " us";
+        if (received.load() != frames || bad.load() != 0 || stop_us > 10000) ok = false;
+        if (p1.acquired > p0.acquired && p1.reused == p0.reused) ok = false;
+    }
+    tx.reset();
+    rx.reset();
+    HardwareFactory::loadConfigText(Factory::HardwareConfig::defaultText());
+    LOG_INFO << "handle subscriber " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+// 事件多路复用器：分片线程边沿触发分发、定时器、任务投递与停止延迟
+bool bench_mux(size_t iters) {
+    LOG_SEPARATOR();
+    constexpr int kFds = 8;
+    EventMultiplexer::Options opt;
+    opt.shards = 2;
+    opt.max_events = 16;
+    EventMultiplexer mux(opt);
+    bool ok = true;
+
+    int fds[kFds];
+    std::atomic<uint64_t> counts[kFds];
+    std::atomic<uint64_t> owner[kFds];                // 每个 fd 的回调线程（须固定为同一分片线程）
+    std::atomic<uint32_t> migrated{0};
+    for (int i = 0; i < kFds; ++i) {
+        counts[i].store(0);
+        owner[i].store(0);
+        fds[i] = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fds[i] < 0) return false;
+        ok = mux.add(fds[i], EPOLLIN | EPOLLET, [&, i](int fd, uint32_t) {
+            uint64_t v = 0;
+            while (::read(fd, &v, sizeof(v)) == static_cast<ssize_t>(sizeof(v))) counts[i].fetch_add(v);
+            uint64_t self = static_cast<uint64_t>(::pthread_self());
+            uint64_t expect = 0;
+            if (!owner[i].compare_exchange_strong(expect, self) && expect != self) migrated.fetch_add(1);
+        }) && ok;
+    }
+    // 回调中移除自身：后续写入不再分发
+    int self_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    std::atomic<uint32_t> self_calls{0};
+    ok = mux.add(self_fd, EPOLLIN, [&](int fd, uint32_t) {
+        self_calls.fetch_add(1);
+        mux.remove(fd);
+    }) && ok;
+    // 共享 fd：EPOLLEXCLUSIVE 注册到两个分片，值只被读走一次
+    int shared_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    std::atomic<uint64_t> shared_total{0};
+    ok = mux.add_shared(shared_fd, EPOLLIN, [&](int fd, uint32_t) {
+        uint64_t v = 0;
+        if (::read(fd, &v, sizeof(v)) == static_cast<ssize_t>(sizeof(v))) shared_total.fetch_add(v);
+    }) && ok;
+
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint32_t> oneshot{0};
+    auto periodic = mux.add_timer(1000, 1000, [&](uint64_t exp) { ticks.fetch_add(exp); });
+    auto single = mux.add_timer(5000, 0, [&](uint64_t) { oneshot.fetch_add(1); });
+    if (!ok || !periodic || !single || !mux.start()) {
+        LOG_ERROR << "mux setup failed";
+        ok = false;
+    }
+
+    const uint64_t writes = std::min<size_t>(iters, 20000);
+    uint64_t t0 = now_ns();
+    for (uint64_t n = 0; n < writes; ++n) {
+        uint64_t one = 1;
+        if (::write(fds[n % kFds], &one, sizeof(one)) != static_cast<ssize_t>(sizeof(one))) ok = false;
+    }
+    for (int k = 0; k < 3; ++k) {
+        uint64_t one = 1;
+        if (::write(self_fd, &one, sizeof(one)) < 0) ok = false;
+        if (::write(shared_fd, &one, sizeof(one)) < 0) ok = false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto total = [&]() {
+        uint64_t t = 0;
+        for (int i = 0; i < kFds; ++i) t += counts[i].load();
+        return t;
+    };
+    while (total() != writes && now_ns() - t0 < 1000000000ull) std::this_thread::yield();
+    const uint64_t dispatch_ns = now_ns() - t0;
+
+    // 投递任务：测量投递到执行的延迟
+    std::vector<uint64_t> post_ns;
+    post_ns.reserve(1000);
+    for (int n = 0; n < 1000 && ok; ++n) {
+        std::atomic<bool> done{false};
+        uint64_t p0 = now_ns();
+        mux.post([&]() { done.store(true, std::memory_order_release); });
+        while (!done.load(std::memory_order_acquire)) {
+            if (now_ns() - p0 > 100000000ull) { ok = false; break; }
+        }
+        post_ns.push_back(now_ns() - p0);
+    }
+    report("mux post->run", post_ns, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const bool single_gone = !mux.cancel_timer(single);
+    uint64_t s0 = now_ns();
+    mux.stop();
+    const uint64_t stop_us = (now_ns() - s0) / 1000;
+    const uint64_t tick_count = ticks.load();
+
+    LOG_INFO << "mux: " << total() << "/" << writes << " edge-triggered counts over " << kFds << " fds on "
+             << mux.shards() << " shards in " << dispatch_ns / 1000 << " us, migrated " << migrated.load()
+             << "; self-remove calls " << self_calls.load() << ", shared total " << shared_total.load()
+             << "; periodic 1ms ticks " << tick_count << ", one-shot " << oneshot.load()
+             << (single_gone ? " (released)" : " (LEAKED)") << "; stop " << stop_us << " us";
+    if (total() != writes || migrated.load() != 0 || self_calls.load() != 1 || shared_total.load() != 3) ok = false;
+    // 约 50ms+ 运行时间内的 1ms 周期：下限宽松以容忍调度抖动
+    if (tick_count < 20 || oneshot.load() != 1 || !single_gone || stop_us > 10000) ok = false;
+
+    mux.cancel_timer(periodic);
+    for (int i = 0; i < kFds; ++i) {
+        mux.remove(fds[i]);
+        ::close(fds[i]);
+    }
+    mux.remove(shared_fd);
+    ::close(shared_fd);
+    ::close(self_fd);
+    LOG_INFO << "mux " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+} // namespace
+
+// 速率单调执行器：1ms 组（读命令 Topic -> 写设备 -> 读回环 -> 校验 -> 发布反馈）与 10ms 组（读反馈 Topic），
+// 校验优先级按速率分配、周期数、逐帧内容与链中止次数，报告链端到端时延
+bool bench_rm_executor(size_t iters) {
+    LOG_SEPARATOR();
+    using Factory::HardwareFactory;
+    auto& dds = MB_DDF::DDS::DDSCore::instance();
+    if (!dds.initialize(128 * 1024 * 1024)) {
+        LOG_WARN << "rm executor: DDS shared memory unavailable, skipped";
+        return true;
+    }
+    const char* text = R"ini(
+[device.rm_dev]
+type      = rs422
+transport = sim
+offset    = 0x10000
+mtu       = 255
+)ini";
+    std::string err;
+    if (!HardwareFactory::loadConfigText(text, &err)) {
+        LOG_ERROR << "rm executor config: " << err;
+        return false;
+    }
+
+    bool ok = true;
+    auto dev = HardwareFactory::create("rm_dev");
+    auto cmd_pub = dds.create_publisher("local://sim_rm_cmd");
+    auto cmd_sub = dds.create_subscriber("local://sim_rm_cmd");
+    auto fb_pub = dds.create_publisher("local://sim_rm_fb");
+    auto fb_sub = dds.create_subscriber("local://sim_rm_fb");
+    if (!dev || !cmd_pub || !cmd_sub || !fb_pub || !fb_sub) {
+        LOG_ERROR << "rm executor setup failed";
+        ok = false;
+    } else {
+        constexpr uint32_t kLen = 32;
+        RateMonotonicExecutor::Frame cmd(255), fb(255), mon(255);
+        // 共享内存中的 Topic 跨进程保留：先同步到最新消息
+        cmd_sub->read(cmd.data.data(), cmd.data.size(), true);
+        fb_sub->read(mon.data.data(), mon.data.size(), true);
+
+        // 帧内容为递增序列：data[i] = data[0] + i
+        auto well_formed = [](const RateMonotonicExecutor::Frame& f) {
+            if (f.size != kLen) return false;
+            for (uint32_t i = 1; i < f.size; ++i) {
+                if (f.data[i] != static_cast<uint8_t>(f.data[0] + i)) return false;
+            }
+            return true;
+        };
+        std::atomic<uint64_t> fb_frames{0}, mon_frames{0}, bad{0};
+
+        RateMonotonicExecutor exec;
+        auto slow = exec.addGroup({"slow", 10000});
+        auto fast = exec.addGroup({"fast", 1000});
+        exec.addChain(fast, "cmd->dev->fb", {
+            RateMonotonicExecutor::readTopic(cmd_sub, cmd),
+            RateMonotonicExecutor::writeDevice(dev, cmd),
+            RateMonotonicExecutor::readDevice(dev, fb),
+            [&]() {
+                if (fb.size == 0) return true;
+                if (!well_formed(fb)) bad.fetch_add(1, std::memory_order_relaxed);
+                fb_frames.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            },
+            RateMonotonicExecutor::publish(fb_pub, fb)});
+        exec.addChain(slow, "fb->monitor", {
+            RateMonotonicExecutor::readTopic(fb_sub, mon),
+            [&]() {
+                if (mon.size == 0) return true;
+                if (!well_formed(mon)) bad.fetch_add(1, std::memory_order_relaxed);
+                mon_frames.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }});
+        const bool rm_order = exec.priorityOf(fast) > exec.priorityOf(slow);
+
+        const size_t commands = std::clamp<size_t>(iters / 20, 50, 500);
+        uint8_t tx[kLen];
+        const uint64_t t0 = now_ns();
+        if (!exec.start()) ok = false;
+        for (size_t n = 0; n < commands && ok; ++n) {
+            for (uint32_t i = 0; i < kLen; ++i) tx[i] = static_cast<uint8_t>(n + i);
+            if (!cmd_pub->publish(tx, kLen)) ok = false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        exec.stop();
+        const uint64_t elapsed_us = (now_ns() - t0) / 1000;
+
+        for (const auto& g : exec.groupStats()) {
+            const uint64_t expected = elapsed_us / g.period_us;
+            LOG_INFO << "rm group " << g.name << ": period " << g.period_us << " us, prio " << g.priority
+                     << ", cycles " << g.cycles << "/" << expected << ", overruns " << g.overruns << ", late mean "
+                     << (g.cycles ? g.late_ns_total / g.cycles : 0) << " ns max " << g.late_ns_max << " ns, busy max "
+                     << g.busy_ns_max << " ns";
+            if (g.cycles + g.overruns + 1 < expected * 9 / 10) ok = false;
+        }
+        for (const auto& c : exec.chainStats()) {
+            LOG_INFO << "rm chain " << c.group << "/" << c.name << ": runs " << c.runs << ", aborted " << c.aborted
+                     << ", deadline misses " << c.deadline_misses << ", latency mean "
+                     << (c.runs ? c.latency_ns_total / c.runs : 0) << " ns max " << c.latency_ns_max << " ns";
+            if (c.aborted != 0) ok = false;
+        }
+        LOG_INFO << "rm executor: " << commands << " commands, " << fb_frames.load() << " device frames, "
+                 << mon_frames.load() << " monitored, " << bad.load() << " bad, priority fast "
+                 << exec.priorityOf(fast) << " > slow " << exec.priorityOf(slow);
+        if (!rm_order || bad.load() != 0 || fb_frames.load() < commands / 4 || mon_frames.load() == 0) ok = false;
+    }
+    dev.reset();
+    HardwareFactory::loadConfigText(Factory::HardwareConfig::defaultText());
+    LOG_INFO << "rm executor " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    LOG_SET_LEVEL_INFO();
+    LOG_DISABLE_TIMESTAMP();
+    LOG_DISABLE_FUNCTION_LINE();
+
+    const size_t iters = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 20000;
+
+    LOG_TITLE("Simulated Device Driver Bench");
+    bool ok = true;
+    ok = bench_rs422(iters) && ok;
+    ok = bench_can(iters) && ok;
+    ok = bench_canfd(iters) && ok;
+    ok = bench_can_dispatch(iters) && ok;
+    ok = bench_canfd_txq(iters) && ok;
+    ok = bench_mode_switch(iters) && ok;
+    ok = bench_helm(iters) && ok;
+    ok = bench_ddr(iters) && ok;
+    ok = check_dma_topic_teardown() && ok;
+    ok = bench_factory() && ok;
+    ok = bench_router(iters) && ok;
+    ok = bench_handle_subscriber(iters) && ok;
+    ok = bench_mux(iters) && ok;
+    ok = bench_rm_executor(iters) && ok;
+    LOG_SEPARATOR();
+    LOG_INFO << "result: " << (ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file TestTimerBench.cpp
+ * @brief SystemTimer 各运行模式的周期抖动对比
+ *
+ * 依次以同一周期运行：
+ * - Signal：实时信号触发，回调在信号处理函数中执行（现有用法）
+ * - ThreadLoop + clock_nanosleep(TIMER_ABSTIME)
+ * - ThreadLoop + timerfd 绝对定时
+ * - ThreadLoop + clock_nanosleep，截止前 spin_us 自旋
+ * 每次回调调用 ChronoHelper::record（每秒打印 Max/P99.9/P95/P70 抖动），并记录时间戳，
+ * 运行结束后汇总相邻回调间隔相对周期的偏差（P50/P99/最大值）、回调次数与跳过周期数，
+ * 并输出定时器遥测（唤醒延迟均值/最大值、执行耗时最大值与直方图、截止时间错过次数）。
+ * 最后以 CyclicScheduler 在一个线程上运行 300 个 1ms~100ms 周期任务与若干单次任务，
+ * 按周期汇总执行次数、截止时间错过、跳过释放、最大执行耗时与启动延迟，并校验自动相位的负载分散。
+ *
+ * 用法：TestTimerBench [period_us] [seconds] [spin_us]
+ */
+#include "MB_DDF/Debug/Logger.h"
+#include "MB_DDF/Debug/LoggerExtensions.h"
+#include "MB_DDF/Timer/ChronoHelper.h"
+#include "MB_DDF/Timer/CyclicScheduler.h"
+#include "MB_DDF/Timer/SystemTimer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+using namespace MB_DDF::Timer;
+
+namespace {
+
+// 回调记录：时间戳缓冲预先分配，回调中不为记录时间戳分配内存
+struct Recorder {
+    std::vector<long long> stamps;
+    std::atomic<size_t> count{0};
+    int counter_id = 0;
+    long long period_us = 0;
+};
+
+long long mono_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void on_tick(void* para) {
+    auto* rec = static_cast<Recorder*>(para);
+    size_t i = rec->count.fetch_add(1, std::memory_order_relaxed);
+    if (i < rec->stamps.size()) rec->stamps[i] = mono_ns();
+    ChronoHelper::record(rec->counter_id, rec->period_us);
+}
+
+bool run_mode(const char* name, int counter_id, long long period_us, int seconds, SystemTimerOptions opt) {
+    LOG_SEPARATOR();
+    LOG_INFO << name << ": period " << period_us << " us, " << seconds << " s";
+    const size_t expected = static_cast<size_t>(seconds * 1000000LL / period_us);
+    Recorder rec;
+    rec.stamps.assign(expected + expected / 4 + 16, 0);
+    rec.counter_id = counter_id;
+    rec.period_us = period_us;
+    opt.user_data = &rec;
+
+    auto timer = SystemTimer::start(std::to_string(period_us) + "us", on_tick, opt);
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    timer->stop();
+    ChronoHelper::reset(counter_id);                  // 避免残留统计混入下一模式的每秒报告
+    const uint64_t cycles = timer->cycles();
+    const uint64_t overruns = timer->overruns();
+    const SystemTimerStats st = timer->stats();
+
+    const size_t n = std::min(rec.count.load(), rec.stamps.size());
+    std::vector<long long> dev;
+    dev.reserve(n);
+    for (size_t i = 1; i < n; ++i) {
+        long long interval = rec.stamps[i] - rec.stamps[i - 1];
+        dev.push_back(std::llabs(interval - period_us * 1000));
+    }
+    std::sort(dev.begin(), dev.end());
+    auto pct = [&](double p) -> double {
+        if (dev.empty()) return 0.0;
+        return static_cast<double>(dev[std::min(dev.size() - 1, static_cast<size_t>(p * dev.size()))]) / 1000.0;
+    };
+    LOG_INFO << name << " summary: cycles " << cycles << "/" << expected << ", overruns " << overruns
+             << ", |interval - period| p50 " << pct(0.50) << " us, p99 " << pct(0.99) << " us, max "
+             << (dev.empty() ? 0.0 : static_cast<double>(dev.back()) / 1000.0) << " us";
+    uint64_t hist_sum = 0;
+    std::string hist;
+    for (int i = 0; i < SystemTimerStats::kExecBins; ++i) {
+        hist_sum += st.exec_hist[i];
+        if (st.exec_hist[i] == 0) continue;
+        hist += " [" + (i == 0 ? std::string("<1") : "<" + std::to_string(1u << i)) + "us]=" + std::to_string(st.exec_hist[i]);
+    }
+    LOG_INFO << name << " telemetry: wake latency mean "
+             << (st.cycles ? st.wake_latency_ns_total / st.cycles / 1000.0 : 0.0) << " us, max "
+             << st.wake_latency_ns_max / 1000.0 << " us, exec max " << st.exec_ns_max / 1000.0
+             << " us, deadline misses " << st.deadline_misses << ", exec histogram" << hist;
+    // 回调次数 + 跳过周期数应覆盖运行时长（宽松下限以容忍启动/停止边界）；直方图应覆盖每次回调
+    return cycles + overruns >= expected * 9 / 10 && hist_sum == st.cycles && st.cycles == cycles;
+}
+
+// 单线程时间轮调度：数百个不同周期的任务 + 单次任务，校验释放计数、自动相位分散、运行中增删
+bool run_scheduler(int seconds) {
+    LOG_SEPARATOR();
+    constexpr size_t kTasks = 300;
+    const uint64_t periods_us[] = {1000, 2000, 5000, 10000, 20000, 50000, 100000};
+    constexpr size_t kClasses = sizeof(periods_us) / sizeof(periods_us[0]);
+
+    CyclicScheduler::Options sopt;
+    sopt.tick_us = 100;
+    sopt.priority = sched_get_priority_max(SCHED_FIFO);
+    CyclicScheduler sched(sopt);
+
+    std::vector<std::atomic<uint64_t>> runs(kTasks + 1);
+    std::vector<CyclicScheduler::TaskId> ids;
+    for (size_t i = 0; i < kTasks; ++i) {
+        ids.push_back(sched.addPeriodic("task" + std::to_string(i), periods_us[i % kClasses], [&runs, i]() {
+            runs[i].fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+    std::atomic<int> oneshot[3] = {0, 0, 0};
+    const uint64_t oneshot_us[3] = {10000, 50000, 200000};
+    for (int k = 0; k < 3; ++k) {
+        sched.addOneShot("oneshot" + std::to_string(k), oneshot_us[k], [&oneshot, k]() { oneshot[k].fetch_add(1); });
+    }
+
+    // 自动相位：统计一个窗口内每个 tick 上的释放数（全部取相位 0 时为 kTasks）
+    std::vector<uint32_t> per_tick(1000, 0);
+    for (const auto& st : sched.stats()) {
+        if (st.period_us == 0) continue;
+        const uint64_t p = st.period_us / sopt.tick_us;
+        for (uint64_t t = st.phase_ticks % p; t < per_tick.size(); t += p) ++per_tick[t];
+    }
+    const uint32_t max_per_tick = *std::max_element(per_tick.begin(), per_tick.end());
+
+    const uint64_t t0 = mono_ns();
+    if (!sched.start()) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(seconds * 500));
+    // 运行中增删：取消一个 1ms 任务，新增一个 1ms 任务
+    sched.cancel(ids[0]);
+    const uint64_t t_add = mono_ns();
+    ids.push_back(sched.addPeriodic("late", 1000, [&runs]() { runs[kTasks].fetch_add(1, std::memory_order_relaxed); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const uint64_t cancelled_runs = runs[0].load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(seconds * 500));
+    sched.stop();
+    const uint64_t t_stop = mono_ns();
+    const uint64_t elapsed_ns = t_stop - t0;
+
+    bool ok = true;
+    if (runs[0].load() != cancelled_runs) ok = false;
+    for (int k = 0; k < 3; ++k) {
+        if (oneshot[k].load() != 1) ok = false;
+    }
+
+    struct ClassSum {
+        uint64_t runs = 0, releases = 0, misses = 0, skipped = 0, exec_max = 0, delay_max = 0;
+        size_t tasks = 0;
+    } sums[kClasses];
+    for (const auto& st : sched.stats()) {
+        if (st.id == ids[kTasks]) continue;           // 运行中新增的任务单独检查
+        size_t c = 0;
+        while (c < kClasses && periods_us[c] != st.period_us) ++c;
+        if (c == kClasses) continue;
+        auto& s = sums[c];
+        ++s.tasks;
+        s.runs += st.runs;
+        s.releases += st.releases;
+        s.misses += st.deadline_misses;
+        s.skipped += st.skipped;
+        s.exec_max = std::max(s.exec_max, st.exec_ns_max);
+        s.delay_max = std::max(s.delay_max, st.start_delay_ns_max);
+        // 释放计数（含跳过）应覆盖运行时长
+        const uint64_t expected = elapsed_ns / (st.period_us * 1000);
+        if (st.releases + 1 < expected * 9 / 10) ok = false;
+    }
+    for (size_t c = 0; c < kClasses; ++c) {
+        const auto& s = sums[c];
+        LOG_INFO << "scheduler " << periods_us[c] / 1000 << "ms x" << s.tasks << ": runs " << s.runs << ", releases "
+                 << s.releases << ", skipped " << s.skipped << ", deadline misses " << s.misses << ", exec max "
+                 << s.exec_max / 1000.0 << " us, start delay max " << s.delay_max / 1000.0 << " us";
+    }
+    CyclicScheduler::TaskStats late;
+    // 运行中新增的任务在下一个节拍生效（相位最多一个周期）
+    if (!sched.stats(ids[kTasks], late) || (late.releases + 2) * 10 < (t_stop - t_add) / 1000000 * 9) ok = false;
+    LOG_INFO << "scheduler: " << kTasks << " periodic tasks on 1 thread, tick " << sched.tickUs() << " us, "
+             << sched.ticks() << " ticks (" << sched.lateTicks() << " late), max releases per tick "
+             << max_per_tick << " (all-in-phase " << kTasks << "), one-shots " << oneshot[0].load() << "/"
+             << oneshot[1].load() << "/" << oneshot[2].load() << ", cancelled task stopped at " << cancelled_runs
+             << ", added task runs " << late.runs;
+    if (max_per_tick * 4 > kTasks) ok = false;
+    LOG_INFO << "scheduler " << (ok ? "matches" : "MISMATCH");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LOG_SET_LEVEL_INFO();
+    LOG_DISABLE_TIMESTAMP();
+    LOG_DISABLE_FUNCTION_LINE();
+
+    const long long period_us = argc > 1 ? std::max(std::atoll(argv[1]), 50LL) : 1000;
+    const int seconds = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 2;
+    const long long spin_us = argc > 3 ? std::max(std::atoll(argv[3]), 0LL) : 20;
+
+    LOG_TITLE("SystemTimer Jitter Bench");
+    SystemTimerOptions base;
+    base.sched_policy = SCHED_FIFO;
+    base.priority = sched_get_priority_max(SCHED_FIFO);
+
+    bool ok = true;
+    SystemTimerOptions sig = base;
+    sig.mode = SystemTimerMode::Signal;
+    ok = run_mode("signal", 0, period_us, seconds, sig) && ok;
+
+    SystemTimerOptions sleep = base;
+    sleep.mode = SystemTimerMode::ThreadLoop;
+    sleep.wait = SystemTimerWait::Nanosleep;
+    ok = run_mode("thread-loop nanosleep", 1, period_us, seconds, sleep) && ok;
+
+    SystemTimerOptions tfd = base;
+    tfd.mode = SystemTimerMode::ThreadLoop;
+    tfd.wait = SystemTimerWait::TimerFd;
+    ok = run_mode("thread-loop timerfd", 2, period_us, seconds, tfd) && ok;
+
+    SystemTimerOptions spin = sleep;
+    spin.spin_ns = spin_us * 1000;
+    ok = run_mode(("thread-loop nanosleep + " + std::to_string(spin_us) + "us spin").c_str(), 3, period_us,
+                  seconds, spin) && ok;
+
+    ok = run_scheduler(seconds) && ok;
+
+    LOG_SEPARATOR();
+    LOG_INFO << "result: " << (ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,343 @@
+/**
+ * @file CyclicScheduler.cpp
+ * @brief 单线程周期任务调度器实现
+ */
+
+#include "MB_DDF/Timer/CyclicScheduler.h"
+#include "MB_DDF/Timer/SystemTimer.h"
+#include <algorithm>
+#include <cerrno>
+#include <time.h>
+
+namespace MB_DDF {
+namespace Timer {
+
+namespace {
+void atomic_max(std::atomic<uint64_t>& a, uint64_t v) {
+    uint64_t cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+    }
+}
+}
+
+CyclicScheduler::CyclicScheduler(Options opt)
+    : opt_(opt), tick_ns_(static_cast<uint64_t>(std::max<uint32_t>(opt.tick_us, 1)) * 1000), load_(kPhaseWindow, 0) {}
+
+CyclicScheduler::~CyclicScheduler() {
+    stop();
+}
+
+// ---------------- 时间轮 ----------------
+
+void CyclicScheduler::insert(Task* t) {
+    const uint64_t e = t->expiry;
+    Task** head = &overflow_;
+    for (unsigned l = 0; l < kLevels; ++l) {
+        const unsigned shift = kBits * (l + 1);
+        if ((e >> shift) == (now_tick_ >> shift)) {
+            head = &wheel_[l][(e >> (kBits * l)) & (kSlots - 1)];
+            break;
+        }
+    }
+    t->prev = nullptr;
+    t->next = *head;
+    if (*head) (*head)->prev = t;
+    *head = t;
+    t->head = head;
+}
+
+void CyclicScheduler::unlink(Task* t) {
+    if (!t->head) return;
+    if (t->prev) t->prev->next = t->next;
+    else *t->head = t->next;
+    if (t->next) t->next->prev = t->prev;
+    t->prev = t->next = nullptr;
+    t->head = nullptr;
+}
+
+void CyclicScheduler::advance() {
+    ++now_tick_;
+    auto reinsert = [this](Task* list) {
+        while (list) {
+            Task* nx = list->next;
+            list->head = nullptr;
+            insert(list);
+            list = nx;
+        }
+    };
+    // 由高到低下放：上层槽中的任务按新的当前 tick 重新定位，可能直接落入本 tick 的 0 级槽
+    if ((now_tick_ & ((1ull << (kBits * kLevels)) - 1)) == 0) {
+        Task* list = overflow_;
+        overflow_ = nullptr;
+        reinsert(list);
+    }
+    for (unsigned l = kLevels - 1; l >= 1; --l) {
+        if ((now_tick_ & ((1ull << (kBits * l)) - 1)) != 0) continue;
+        Task*& slot = wheel_[l][(now_tick_ >> (kBits * l)) & (kSlots - 1)];
+        Task* list = slot;
+        slot = nullptr;
+        reinsert(list);
+    }
+
+    Task*& slot = wheel_[0][now_tick_ & (kSlots - 1)];
+    Task* list = slot;
+    slot = nullptr;
+    while (list) {
+        Task* nx = list->next;
+        list->prev = list->next = nullptr;
+        list->head = nullptr;
+        run_task(list);                               // 可能重新插入或移除 list，之后不再访问
+        list = nx;
+    }
+}
+
+// ---------------- 任务执行 ----------------
+
+void CyclicScheduler::run_task(Task* t) {
+    if (t->cancelled.load(std::memory_order_acquire)) return;     // 等待 apply_pending 移除
+
+    const uint64_t release_ns = t0_ns_ + t->expiry * tick_ns_;
+    const uint64_t start = static_cast<uint64_t>(SystemTimer::monoNowNs());
+    t->fn();
+    const uint64_t end = static_cast<uint64_t>(SystemTimer::monoNowNs());
+
+    const uint64_t exec = end - start;
+    t->releases.fetch_add(1, std::memory_order_relaxed);
+    t->runs.fetch_add(1, std::memory_order_relaxed);
+    t->exec_ns_last.store(exec, std::memory_order_relaxed);
+    t->exec_ns_total.fetch_add(exec, std::memory_order_relaxed);
+    atomic_max(t->exec_ns_max, exec);
+    if (start > release_ns) atomic_max(t->start_delay_ns_max, start - release_ns);
+    if (end > release_ns + t->deadline_ns) t->deadline_misses.fetch_add(1, std::memory_order_relaxed);
+
+    if (t->period_ticks == 0) {
+        std::lock_guard<std::mutex> lk(mu_);
+        remove_locked(t->id);
+        return;
+    }
+    // 调度线程落后时不连续补发：跳到追赶目标之后的第一个释放时刻
+    uint64_t next = t->expiry + t->period_ticks;
+    if (next < target_tick_) {
+        const uint64_t skip = (target_tick_ - next + t->period_ticks - 1) / t->period_ticks;
+        next += skip * t->period_ticks;
+        t->skipped.fetch_add(skip, std::memory_order_relaxed);
+        t->releases.fetch_add(skip, std::memory_order_relaxed);
+    }
+    t->expiry = next;
+    insert(t);
+}
+
+// ---------------- 相位选择 ----------------
+
+uint64_t CyclicScheduler::choose_phase(uint64_t period_ticks) const {
+    const uint64_t base = now_tick_ + 1;
+    const uint64_t candidates = std::min<uint64_t>(period_ticks, kPhaseWindow);
+    const uint64_t releases = std::max<uint64_t>(kPhaseWindow / period_ticks, 1);
+    uint64_t best = 0;
+    uint32_t best_cost = UINT32_MAX;
+    for (uint64_t o = 0; o < candidates; ++o) {
+        uint32_t cost = 0;
+        for (uint64_t k = 0; k < releases; ++k) {
+            cost = std::max<uint32_t>(cost, load_[(base + o + k * period_ticks) % kPhaseWindow]);
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = o;
+            if (cost == 0) break;
+        }
+    }
+    return best;
+}
+
+void CyclicScheduler::account_load(const Task* t, int delta) {
+    const uint64_t releases = std::max<uint64_t>(kPhaseWindow / t->period_ticks, 1);
+    for (uint64_t k = 0; k < releases; ++k) {
+        uint16_t& v = load_[(t->load_base + k * t->period_ticks) % kPhaseWindow];
+        if (delta > 0) ++v;
+        else if (v > 0) --v;
+    }
+}
+
+void CyclicScheduler::schedule_locked(Task* t) {
+    if (t->period_ticks == 0) {
+        const uint64_t delay = t->phase_req_us > 0 ? static_cast<uint64_t>(t->phase_req_us) * 1000 / tick_ns_ : 0;
+        t->phase_ticks = std::max<uint64_t>(delay, 1);
+    } else if (t->phase_req_us < 0) {
+        t->phase_ticks = 1 + choose_phase(t->period_ticks);
+    } else {
+        t->phase_ticks = std::max<uint64_t>(static_cast<uint64_t>(t->phase_req_us) * 1000 / tick_ns_, 1);
+    }
+    t->expiry = now_tick_ + t->phase_ticks;
+    t->load_base = t->expiry;
+    insert(t);
+    t->scheduled = true;
+    if (t->period_ticks) account_load(t, +1);
+}
+
+void CyclicScheduler::remove_locked(TaskId id) {
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) return;
+    Task* t = it->second.get();
+    unlink(t);
+    if (t->scheduled && t->period_ticks) account_load(t, -1);
+    tasks_.erase(it);
+}
+
+void CyclicScheduler::apply_pending_locked() {
+    for (TaskId id : pending_cancel_) remove_locked(id);
+    for (TaskId id : pending_add_) {
+        auto it = tasks_.find(id);
+        if (it != tasks_.end() && !it->second->scheduled) schedule_locked(it->second.get());
+    }
+    pending_cancel_.clear();
+    pending_add_.clear();
+    has_pending_.store(false, std::memory_order_relaxed);
+}
+
+// ---------------- 公共接口 ----------------
+
+CyclicScheduler::TaskId CyclicScheduler::add(const TaskOptions& opt, TaskFn fn) {
+    if (!fn) return 0;
+    auto t = std::make_unique<Task>();
+    t->name = opt.name;
+    t->fn = std::move(fn);
+    t->period_us = opt.period_us;
+    t->period_ticks = opt.period_us ? std::max<uint64_t>((opt.period_us * 1000 + tick_ns_ / 2) / tick_ns_, 1) : 0;
+    t->phase_req_us = opt.phase_us;
+    t->deadline_ns = opt.deadline_us ? opt.deadline_us * 1000 : (t->period_ticks ? t->period_ticks * tick_ns_ : tick_ns_);
+
+    std::lock_guard<std::mutex> lk(mu_);
+    const TaskId id = next_id_++;
+    t->id = id;
+    Task* raw = t.get();
+    tasks_.emplace(id, std::move(t));
+    if (started_) {
+        pending_add_.push_back(id);
+        has_pending_.store(true, std::memory_order_release);
+    } else {
+        schedule_locked(raw);
+    }
+    return id;
+}
+
+CyclicScheduler::TaskId CyclicScheduler::addPeriodic(const std::string& name, uint64_t period_us, TaskFn fn,
+                                                     int64_t phase_us) {
+    if (period_us == 0) return 0;
+    TaskOptions opt;
+    opt.name = name;
+    opt.period_us = period_us;
+    opt.phase_us = phase_us;
+    return add(opt, std::move(fn));
+}
+
+CyclicScheduler::TaskId CyclicScheduler::addOneShot(const std::string& name, uint64_t delay_us, TaskFn fn) {
+    TaskOptions opt;
+    opt.name = name;
+    opt.phase_us = static_cast<int64_t>(delay_us);
+    return add(opt, std::move(fn));
+}
+
+bool CyclicScheduler::cancel(TaskId id) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) return false;
+    it->second->cancelled.store(true, std::memory_order_release);
+    if (started_) {
+        pending_cancel_.push_back(id);
+        has_pending_.store(true, std::memory_order_release);
+    } else {
+        remove_locked(id);
+    }
+    return true;
+}
+
+bool CyclicScheduler::start() {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (started_) return true;
+    // 从当前 tick 继续：t0 使 now_tick_ 对应当前时刻
+    t0_ns_ = static_cast<uint64_t>(SystemTimer::monoNowNs()) - now_tick_ * tick_ns_;
+    target_tick_ = now_tick_;
+    stop_.store(false, std::memory_order_relaxed);
+    started_ = true;
+    worker_ = std::thread([this]() {
+        SystemTimer::configureThread(pthread_self(), opt_.sched_policy, opt_.priority, opt_.cpu);
+        loop();
+    });
+    return true;
+}
+
+void CyclicScheduler::stop() {
+    if (!worker_.joinable()) return;
+    stop_.store(true, std::memory_order_release);
+    worker_.join();
+    std::lock_guard<std::mutex> lk(mu_);
+    started_ = false;
+    apply_pending_locked();
+}
+
+void CyclicScheduler::loop() {
+    while (!stop_.load(std::memory_order_acquire)) {
+        const uint64_t wake = t0_ns_ + (now_tick_ + 1) * tick_ns_;
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(wake / 1000000000ull);
+        ts.tv_nsec = static_cast<long>(wake % 1000000000ull);
+        int rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        if (rc != 0 && rc != EINTR) break;
+
+        const uint64_t target = (static_cast<uint64_t>(SystemTimer::monoNowNs()) - t0_ns_) / tick_ns_;
+        if (target <= now_tick_) continue;
+        if (target - now_tick_ > 1) late_ticks_.fetch_add(target - now_tick_ - 1, std::memory_order_relaxed);
+        target_tick_ = target;
+        while (now_tick_ < target && !stop_.load(std::memory_order_relaxed)) {
+            if (has_pending_.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lk(mu_);
+                apply_pending_locked();
+            }
+            advance();
+            ticks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t CyclicScheduler::size() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return tasks_.size();
+}
+
+void CyclicScheduler::fill(const Task& t, TaskStats& s) {
+    s.id = t.id;
+    s.name = t.name;
+    s.period_us = t.period_us;
+    s.phase_ticks = t.phase_ticks;
+    s.releases = t.releases.load(std::memory_order_relaxed);
+    s.runs = t.runs.load(std::memory_order_relaxed);
+    s.deadline_misses = t.deadline_misses.load(std::memory_order_relaxed);
+    s.skipped = t.skipped.load(std::memory_order_relaxed);
+    s.exec_ns_last = t.exec_ns_last.load(std::memory_order_relaxed);
+    s.exec_ns_max = t.exec_ns_max.load(std::memory_order_relaxed);
+    s.exec_ns_total = t.exec_ns_total.load(std::memory_order_relaxed);
+    s.start_delay_ns_max = t.start_delay_ns_max.load(std::memory_order_relaxed);
+}
+
+std::vector<CyclicScheduler::TaskStats> CyclicScheduler::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<TaskStats> out;
+    out.reserve(tasks_.size());
+    for (const auto& kv : tasks_) {
+        out.emplace_back();
+        fill(*kv.second, out.back());
+    }
+    std::sort(out.begin(), out.end(), [](const TaskStats& a, const TaskStats& b) { return a.id < b.id; });
+    return out;
+}
+
+bool CyclicScheduler::stats(TaskId id, TaskStats& out) const {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end()) return false;
+    fill(*it->second, out);
+    return true;
+}
+
+} // namespace Timer
+} // namespace MB_DDF
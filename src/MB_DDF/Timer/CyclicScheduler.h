@@ -0,0 +1,163 @@
+/**
+ * @file CyclicScheduler.h
+ * @brief 单线程周期任务调度器：分层时间轮复用大量周期/单次任务
+ *
+ * 设计要点：
+ * - 一个调度线程（可绑核、SCHED_FIFO）按 tick_us 节拍以绝对时间休眠，不占用实时信号与额外内核定时器。
+ * - 4 级 x 256 槽分层时间轮：插入按到期 tick 与当前 tick 的高位差选择层级，O(1)；
+ *   每个 tick 只处理 0 级一个槽，低位回绕时把上一级对应槽下放（cascade），到期处理摊还 O(1)。
+ * - 相位偏移：phase_us < 0 时自动选择相位，使任务的释放时刻落在当前负载最低的 tick 上，
+ *   避免不同周期的任务堆积在同一节拍。
+ * - 每任务统计：释放次数、执行次数、截止时间错过次数（完成时刻晚于 释放 + deadline）、
+ *   因调度线程落后而跳过的释放次数、执行耗时（末次/最大/累计）与最大启动延迟；原子计数，可跨线程读取。
+ * - 任务在调度线程中串行执行，回调内可加锁、分配内存与写日志，但执行时间计入后续任务的启动延迟。
+ * - 运行中 add/cancel 由调度线程在下一个 tick 生效；单次任务执行后自动移除。
+ */
+#pragma once
+
+#include <sched.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MB_DDF {
+namespace Timer {
+
+class CyclicScheduler {
+public:
+    using TaskId = uint64_t;                    // 0 表示无效
+    using TaskFn = std::function<void()>;
+
+    struct Options {
+        uint32_t tick_us = 100;                 // 节拍（任务周期/相位按节拍取整）
+        int sched_policy = SCHED_FIFO;          // 调度线程策略
+        int priority = 80;                      // 调度线程优先级
+        int cpu = -1;                           // 绑核编号，-1 表示不绑核
+    };
+
+    struct TaskOptions {
+        std::string name;
+        uint64_t period_us = 0;                 // 0 表示单次任务
+        int64_t phase_us = -1;                  // 周期任务：首次释放相对加入时刻的偏移；<0 自动选择
+                                                // 单次任务：延迟（<0 视为 0）
+        uint64_t deadline_us = 0;               // 相对释放时刻的截止时间；0 取周期（单次任务为 1 个节拍）
+    };
+
+    struct TaskStats {
+        TaskId id = 0;
+        std::string name;
+        uint64_t period_us = 0;
+        uint64_t phase_ticks = 0;               // 实际采用的相位（节拍）
+        uint64_t releases = 0;                  // 到期次数（含跳过）
+        uint64_t runs = 0;
+        uint64_t deadline_misses = 0;
+        uint64_t skipped = 0;                   // 调度线程落后时合并跳过的释放
+        uint64_t exec_ns_last = 0;
+        uint64_t exec_ns_max = 0;
+        uint64_t exec_ns_total = 0;
+        uint64_t start_delay_ns_max = 0;        // 开始执行时刻 - 释放时刻 的最大值
+    };
+
+    CyclicScheduler() : CyclicScheduler(Options{}) {}
+    explicit CyclicScheduler(Options opt);
+    ~CyclicScheduler();
+
+    CyclicScheduler(const CyclicScheduler&) = delete;
+    CyclicScheduler& operator=(const CyclicScheduler&) = delete;
+
+    TaskId add(const TaskOptions& opt, TaskFn fn);
+    TaskId addPeriodic(const std::string& name, uint64_t period_us, TaskFn fn, int64_t phase_us = -1);
+    TaskId addOneShot(const std::string& name, uint64_t delay_us, TaskFn fn);
+    bool cancel(TaskId id);
+
+    bool start();
+    void stop();
+    bool running() const { return worker_.joinable(); }
+
+    size_t size() const;
+    uint32_t tickUs() const { return static_cast<uint32_t>(tick_ns_ / 1000); }
+    // 调度线程处理过的节拍数与落后补处理的节拍数
+    uint64_t ticks() const { return ticks_.load(std::memory_order_relaxed); }
+    uint64_t lateTicks() const { return late_ticks_.load(std::memory_order_relaxed); }
+
+    std::vector<TaskStats> stats() const;
+    bool stats(TaskId id, TaskStats& out) const;
+
+private:
+    static constexpr unsigned kLevels = 4;
+    static constexpr unsigned kBits = 8;
+    static constexpr unsigned kSlots = 1u << kBits;
+    static constexpr size_t kPhaseWindow = 1024;      // 相位选择的负载统计窗口（节拍）
+
+    struct Task {
+        TaskId id = 0;
+        std::string name;
+        TaskFn fn;
+        uint64_t period_ticks = 0;
+        uint64_t period_us = 0;
+        int64_t phase_req_us = -1;
+        uint64_t phase_ticks = 0;
+        uint64_t deadline_ns = 0;
+        uint64_t expiry = 0;                          // 下次释放的 tick
+        uint64_t load_base = 0;                       // 首次释放的 tick（相位负载按此登记与扣除）
+        bool scheduled = false;                       // 已放入时间轮（周期任务同时计入相位负载）
+        std::atomic<bool> cancelled{false};
+
+        // 时间轮槽内的侵入式双向链表
+        Task* prev = nullptr;
+        Task* next = nullptr;
+        Task** head = nullptr;
+
+        std::atomic<uint64_t> releases{0};
+        std::atomic<uint64_t> runs{0};
+        std::atomic<uint64_t> deadline_misses{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> exec_ns_last{0};
+        std::atomic<uint64_t> exec_ns_max{0};
+        std::atomic<uint64_t> exec_ns_total{0};
+        std::atomic<uint64_t> start_delay_ns_max{0};
+    };
+
+    void insert(Task* t);                             // 按 t->expiry 放入时间轮
+    static void unlink(Task* t);
+    void schedule_locked(Task* t);                    // 计算相位并首次放入时间轮
+    void remove_locked(TaskId id);
+    void apply_pending_locked();
+    void advance();                                   // 推进一个 tick：下放上层槽并执行到期任务
+    void run_task(Task* t);
+    void loop();
+    uint64_t choose_phase(uint64_t period_ticks) const;
+    void account_load(const Task* t, int delta);
+    static void fill(const Task& t, TaskStats& s);
+
+    Options opt_;
+    uint64_t tick_ns_;
+    uint64_t t0_ns_ = 0;                              // tick 0 对应的时刻
+    uint64_t now_tick_ = 0;
+    Task* wheel_[kLevels][kSlots] = {};
+    Task* overflow_ = nullptr;                        // 超出时间轮范围的任务
+    std::vector<uint16_t> load_;                      // 各 tick（模窗口）上的周期任务释放数
+
+    mutable std::mutex mu_;                           // 保护 tasks_ 与 pending_（运行中仅由调度线程改动时间轮）
+    std::unordered_map<TaskId, std::unique_ptr<Task>> tasks_;
+    std::vector<TaskId> pending_add_;
+    std::vector<TaskId> pending_cancel_;
+    std::atomic<bool> has_pending_{false};
+    bool started_ = false;                            // 受 mu_ 保护：运行中的增删延迟到调度线程
+    TaskId next_id_ = 1;
+    uint64_t target_tick_ = 0;                        // 本轮追赶的目标 tick（调度线程）
+
+    std::thread worker_;
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> ticks_{0};
+    std::atomic<uint64_t> late_ticks_{0};
+};
+
+} // namespace Timer
+} // namespace MB_DDF
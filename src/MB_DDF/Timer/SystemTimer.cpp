@@ -12,6 +12,10 @@
 #include <unordered_set>
 #include <mutex>
 #include <cctype>
+#include <algorithm>
+#include <bit>
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
 
 namespace MB_DDF {
 namespace Timer {
@@ -19,10 +23,17 @@ namespace Timer {
 namespace {
 std::unordered_set<int> g_installed_signals;
 std::mutex g_install_mtx;
+
+// 遥测计数在信号处理函数中更新，必须是无锁原子量
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<long long>::is_always_lock_free);
 }
 
 SystemTimer::SystemTimer(std::function<void(void*)> cb, const SystemTimerOptions& opt)
-    : signal_no_(opt.signal_no),
+    : mode_(opt.mode),
+      wait_(opt.wait),
+      spin_ns_(std::max(opt.spin_ns, 0LL)),
+      signal_no_(opt.signal_no),
       user_data_(opt.user_data),
       callback_(std::move(cb)) {}
 
@@ -34,15 +45,43 @@ std::unique_ptr<SystemTimer> SystemTimer::start(const std::string& period_str,
                                                 std::function<void(void*)> callback,
                                                 const SystemTimerOptions& opt) {
     if (!callback) throw std::invalid_argument("callback must not be empty");
+    return launch(std::unique_ptr<SystemTimer>(new SystemTimer(std::move(callback), opt)), period_str, opt);
+}
 
-    auto timer = std::unique_ptr<SystemTimer>(new SystemTimer(std::move(callback), opt));
+std::unique_ptr<SystemTimer> SystemTimer::start(const std::string& period_str,
+                                                CycleCallback callback,
+                                                const SystemTimerOptions& opt) {
+    if (!callback) throw std::invalid_argument("callback must not be empty");
+    auto timer = std::unique_ptr<SystemTimer>(new SystemTimer(nullptr, opt));
+    timer->cycle_callback_ = std::move(callback);
+    return launch(std::move(timer), period_str, opt);
+}
 
+std::unique_ptr<SystemTimer> SystemTimer::launch(std::unique_ptr<SystemTimer> timer, const std::string& period_str,
+                                                 const SystemTimerOptions& opt) {
     // 解析周期字符串
     timer->period_ns_ = parsePeriodNs(period_str);
     if (timer->period_ns_ <= 0) {
         throw std::invalid_argument("invalid period string: " + period_str);
     }
 
+    if (timer->mode_ == SystemTimerMode::ThreadLoop) {
+        if (timer->wait_ == SystemTimerWait::TimerFd) {
+            timer->timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+            if (timer->timer_fd_ < 0) {
+                throw std::runtime_error(std::string("timerfd_create failed: ") + std::strerror(errno));
+            }
+        }
+        timer->running_ = true;
+        timer->worker_.emplace([timer_ptr = timer.get(), policy = opt.sched_policy, prio = opt.priority, cpu = opt.cpu]() {
+            configureThread(pthread_self(), policy, prio, cpu);
+            timer_ptr->threadLoop();
+        });
+        timer->worker_handle_ = timer->worker_->native_handle();
+        timer->worker_handle_valid_ = true;
+        return timer;
+    }
+
     // 在当前线程先阻塞该实时信号，确保后续只由定时线程接收
     {
         sigset_t sigset;
@@ -79,12 +118,13 @@ std::unique_ptr<SystemTimer> SystemTimer::start(const std::string& period_str,
             return;
         }
 
-        // 设置定时参数
-        timespec ts = nsToTimespec(timer_ptr->period_ns_);
+        // 设置定时参数：首次到期取绝对时间，作为唤醒延迟的计划时刻基准
+        const long long first = monoNowNs() + timer_ptr->period_ns_;
+        timer_ptr->next_due_ns_.store(first, std::memory_order_relaxed);
         itimerspec its{};
-        its.it_value = ts;     // 首次到期
-        its.it_interval = ts;  // 周期
-        if (timer_settime(timer_ptr->timer_id_, 0, &its, nullptr) != 0) {
+        its.it_value = nsToTimespec(first);                   // 首次到期
+        its.it_interval = nsToTimespec(timer_ptr->period_ns_); // 周期
+        if (timer_settime(timer_ptr->timer_id_, TIMER_ABSTIME, &its, nullptr) != 0) {
             // 设置失败，删除定时器并返回
             timer_delete(timer_ptr->timer_id_);
             return;
@@ -107,6 +147,25 @@ std::unique_ptr<SystemTimer> SystemTimer::start(const std::string& period_str,
 }
 
 void SystemTimer::stop() {
+    if (mode_ == SystemTimerMode::ThreadLoop) {
+        if (running_.exchange(false) && timer_fd_ >= 0) {
+            // 立即到期以唤醒阻塞在 read 上的定时线程
+            itimerspec its{};
+            its.it_value.tv_nsec = 1;
+            timerfd_settime(timer_fd_, 0, &its, nullptr);
+        }
+        if (worker_.has_value()) {
+            if (worker_->joinable()) worker_->join();
+            worker_.reset();
+            worker_handle_valid_ = false;
+        }
+        if (timer_fd_ >= 0) {
+            ::close(timer_fd_);
+            timer_fd_ = -1;
+        }
+        return;
+    }
+
     if (!running_) {
         // 即便未运行，也要安全地回收线程资源
         if (worker_.has_value()) {
@@ -138,13 +197,20 @@ void SystemTimer::stop() {
 void SystemTimer::reset() {
     if (!running_) return;
 
+    if (mode_ == SystemTimerMode::ThreadLoop) {
+        // 由定时线程在下次醒来时重新计时（当前等待结束后不触发回调）
+        rebase_ns_.store(monoNowNs(), std::memory_order_release);
+        return;
+    }
+
     // 重置定时器
+    const long long first = monoNowNs() + period_ns_;
+    next_due_ns_.store(first, std::memory_order_relaxed);
     itimerspec its{};
     memset(&its, 0, sizeof(its));
-    timespec ts = nsToTimespec(period_ns_);
-    its.it_value = ts;     // 首次到期
-    its.it_interval = ts;  // 周期
-    timer_settime(timer_id_, 0, &its, nullptr);
+    its.it_value = nsToTimespec(first);         // 首次到期
+    its.it_interval = nsToTimespec(period_ns_); // 周期
+    timer_settime(timer_id_, TIMER_ABSTIME, &its, nullptr);
 }
 
 std::optional<pthread_t> SystemTimer::workerHandle() const {
@@ -212,9 +278,133 @@ void SystemTimer::signalHandler(int /*signo*/, siginfo_t* info, void* /*ucontext
     self->invokeFromSignal();
 }
 
+void SystemTimer::invokeCallback(long long scheduled_ns) {
+    if (cycle_callback_) cycle_callback_(scheduled_ns);
+    else if (callback_) callback_(user_data_);
+}
+
 void SystemTimer::invokeFromSignal() {
-    if (callback_) {
-        callback_(user_data_);
+    if (!callback_ && !cycle_callback_) return;
+    const long long start = monoNowNs();
+    // 信号挂起期间又到期的次数：这些周期被合并，本次回调对应最后一次到期
+    long long scheduled = next_due_ns_.load(std::memory_order_relaxed);
+    const int missed = timer_getoverrun(timer_id_);
+    if (missed > 0) {
+        overruns_.fetch_add(static_cast<uint64_t>(missed), std::memory_order_relaxed);
+        scheduled += missed * period_ns_;
+    }
+    invokeCallback(scheduled);
+    cycles_.fetch_add(1, std::memory_order_relaxed);
+    next_due_ns_.store(scheduled + period_ns_, std::memory_order_relaxed);
+    record(scheduled, start, monoNowNs());
+}
+
+void SystemTimer::record(long long scheduled_ns, long long start_ns, long long end_ns) {
+    // 单一写者（定时线程或其信号处理函数），最大值无需 CAS
+    const uint64_t latency = start_ns > scheduled_ns ? static_cast<uint64_t>(start_ns - scheduled_ns) : 0;
+    const uint64_t exec = end_ns > start_ns ? static_cast<uint64_t>(end_ns - start_ns) : 0;
+    latency_last_.store(latency, std::memory_order_relaxed);
+    latency_total_.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > latency_max_.load(std::memory_order_relaxed)) latency_max_.store(latency, std::memory_order_relaxed);
+    exec_last_.store(exec, std::memory_order_relaxed);
+    exec_total_.fetch_add(exec, std::memory_order_relaxed);
+    if (exec > exec_max_.load(std::memory_order_relaxed)) exec_max_.store(exec, std::memory_order_relaxed);
+    const int bin = std::min(static_cast<int>(std::bit_width(exec / 1000)), SystemTimerStats::kExecBins - 1);
+    exec_hist_[bin].fetch_add(1, std::memory_order_relaxed);
+    if (end_ns > scheduled_ns + period_ns_) deadline_misses_.fetch_add(1, std::memory_order_relaxed);
+}
+
+SystemTimerStats SystemTimer::stats() const {
+    SystemTimerStats s;
+    s.period_ns = static_cast<uint64_t>(period_ns_);
+    s.cycles = cycles_.load(std::memory_order_relaxed);
+    s.overruns = overruns_.load(std::memory_order_relaxed);
+    s.deadline_misses = deadline_misses_.load(std::memory_order_relaxed);
+    s.wake_latency_ns_last = latency_last_.load(std::memory_order_relaxed);
+    s.wake_latency_ns_max = latency_max_.load(std::memory_order_relaxed);
+    s.wake_latency_ns_total = latency_total_.load(std::memory_order_relaxed);
+    s.exec_ns_last = exec_last_.load(std::memory_order_relaxed);
+    s.exec_ns_max = exec_max_.load(std::memory_order_relaxed);
+    s.exec_ns_total = exec_total_.load(std::memory_order_relaxed);
+    for (int i = 0; i < SystemTimerStats::kExecBins; ++i) {
+        s.exec_hist[i] = exec_hist_[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void SystemTimer::resetStats() {
+    cycles_.store(0, std::memory_order_relaxed);
+    overruns_.store(0, std::memory_order_relaxed);
+    deadline_misses_.store(0, std::memory_order_relaxed);
+    latency_last_.store(0, std::memory_order_relaxed);
+    latency_max_.store(0, std::memory_order_relaxed);
+    latency_total_.store(0, std::memory_order_relaxed);
+    exec_last_.store(0, std::memory_order_relaxed);
+    exec_max_.store(0, std::memory_order_relaxed);
+    exec_total_.store(0, std::memory_order_relaxed);
+    for (auto& b : exec_hist_) b.store(0, std::memory_order_relaxed);
+}
+
+long long SystemTimer::monoNowNs() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void SystemTimer::sleepUntil(long long deadline_ns) {
+    if (wait_ == SystemTimerWait::TimerFd) {
+        itimerspec its{};
+        its.it_value = nsToTimespec(deadline_ns);
+        if (timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &its, nullptr) != 0 || !running_) return;
+        uint64_t expirations = 0;
+        while (::read(timer_fd_, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+        }
+        return;
+    }
+    // 分段休眠（每段至多 100ms），使长周期定时器也能及时响应 stop()
+    constexpr long long kMaxSliceNs = 100000000LL;
+    while (running_) {
+        long long now = monoNowNs();
+        if (now >= deadline_ns) return;
+        timespec ts = nsToTimespec(std::min(deadline_ns, now + kMaxSliceNs));
+        int rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        if (rc != 0 && rc != EINTR) return;
+    }
+}
+
+void SystemTimer::threadLoop() {
+    // 普通调度线程默认 50us 定时器松弛，会直接计入唤醒抖动；收紧为 1ns（实时调度策略下内核本就忽略松弛）
+    (void)::prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+    long long next = monoNowNs() + period_ns_;
+    while (running_) {
+        sleepUntil(next - spin_ns_);
+        if (!running_) break;
+
+        long long rebase = rebase_ns_.exchange(0, std::memory_order_acq_rel);
+        if (rebase != 0) {
+            next = rebase + period_ns_;
+            continue;
+        }
+
+        // 最后 spin_ns 自旋到截止时间，避开调度器唤醒延迟
+        if (spin_ns_ > 0) {
+            while (monoNowNs() < next) {
+            }
+        }
+
+        const long long start = monoNowNs();
+        invokeCallback(next);
+        cycles_.fetch_add(1, std::memory_order_relaxed);
+        long long now = monoNowNs();
+        record(next, start, now);
+
+        // 按绝对时间推进，不累积回调耗时；已错过的周期跳过并计数
+        next += period_ns_;
+        if (now >= next) {
+            long long missed = (now - next) / period_ns_ + 1;
+            overruns_.fetch_add(static_cast<uint64_t>(missed), std::memory_order_relaxed);
+            next += missed * period_ns_;
+        }
     }
 }
 
@@ -3,6 +3,19 @@
  * @brief 高精度系统定时器类
  * @date 2025-10-19
  * @author Jiangkai
+ *
+ * 两种运行模式：
+ * - Signal：POSIX timer_create + SIGEV_THREAD_ID，回调在信号处理上下文中执行，
+ *   回调内只能调用异步信号安全的函数（不可加锁、分配内存或写日志）。
+ * - ThreadLoop：定时线程按绝对截止时间休眠（clock_nanosleep(TIMER_ABSTIME) 或 timerfd），
+ *   回调在普通线程上下文中执行；可在截止时间前 spin_ns 提前醒来自旋等待以降低抖动。
+ *   醒来时若已错过后续周期，则跳过这些周期并计入 overruns()，不连续补发回调。
+ *   定时线程将定时器松弛收紧为 1ns。周期性控制环（舵机控制环、速率单调执行器等）均基于此模式，
+ *   经 CycleCallback 取得本周期计划释放时刻。
+ *
+ * 遥测（两种模式均有）：每次回调记录唤醒延迟（实际开始 - 计划到期）、回调执行耗时（末次/最大/累计
+ * 与对数直方图）、截止时间错过（回调结束晚于下一周期到期）与跳过周期（Signal 模式取 timer_getoverrun）。
+ * 计数均为无锁原子量，仅由定时线程/信号处理函数写入，其他线程可随时通过 stats() 读取快照。
  */
 
 #pragma once
@@ -17,24 +30,64 @@
 #include <thread>
 #include <optional>
 #include <memory>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
 
 namespace MB_DDF {
 namespace Timer {
 
+enum class SystemTimerMode {
+    Signal,                               // 实时信号触发，回调运行于信号处理函数
+    ThreadLoop,                           // 定时线程按绝对截止时间休眠后直接回调
+};
+
+enum class SystemTimerWait {
+    Nanosleep,                            // clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)
+    TimerFd,                              // timerfd 绝对时间单次定时，read 阻塞等待
+};
+
 struct SystemTimerOptions {
     int sched_policy = SCHED_FIFO;        // 定时线程调度策略
     int priority = 50;                    // 定时线程优先级（SCHED_FIFO/RR 范围内有效）
     int cpu = -1;                         // 绑核编号，-1 表示不绑核
     int signal_no = SIGRTMIN;             // 使用的实时信号编号
     void* user_data = nullptr;            // 回调函数用户数据指针
+    SystemTimerMode mode = SystemTimerMode::Signal; // 运行模式
+    SystemTimerWait wait = SystemTimerWait::Nanosleep; // ThreadLoop 模式的等待方式
+    long long spin_ns = 0;                // ThreadLoop 模式：截止前提前醒来自旋的时长（0 不自旋）
 };
 
+// 定时器遥测快照：定长 POD，可直接作为 DDS 消息发布或交给监控程序
+struct SystemTimerStats {
+    static constexpr int kExecBins = 16;  // 执行耗时直方图：桶 0 为 <1us，桶 i 为 [2^(i-1), 2^i) us，末桶含更长耗时
+    uint64_t period_ns = 0;
+    uint64_t cycles = 0;                  // 已执行的回调次数
+    uint64_t overruns = 0;                // 跳过的周期数
+    uint64_t deadline_misses = 0;         // 回调结束晚于下一周期到期时刻的次数
+    uint64_t wake_latency_ns_last = 0;    // 实际开始 - 计划到期
+    uint64_t wake_latency_ns_max = 0;
+    uint64_t wake_latency_ns_total = 0;
+    uint64_t exec_ns_last = 0;
+    uint64_t exec_ns_max = 0;
+    uint64_t exec_ns_total = 0;
+    uint64_t exec_hist[kExecBins] = {};
+};
+static_assert(std::is_trivially_copyable_v<SystemTimerStats>);
+
 class SystemTimer {
 public:
+    // 周期回调：参数为本周期计划到期时刻（CLOCK_MONOTONIC 纳秒），用于相对释放时刻计算时延
+    using CycleCallback = std::function<void(long long release_ns)>;
+
     // 一次性接口：解析周期字符串、安装信号、创建并启动高精度周期定时器
     static std::unique_ptr<SystemTimer> start(const std::string& period_str,
                                               std::function<void(void*)> callback,
                                               const SystemTimerOptions& opt = {});
+    // 同上，回调接收计划到期时刻（opt.user_data 不使用）
+    static std::unique_ptr<SystemTimer> start(const std::string& period_str,
+                                              CycleCallback callback,
+                                              const SystemTimerOptions& opt = {});
 
     ~SystemTimer();
 
@@ -47,15 +100,34 @@ public:
     // 是否正在运行
     bool isRunning() const { return running_; }
 
+    // 已执行的回调次数
+    uint64_t cycles() const { return cycles_.load(std::memory_order_relaxed); }
+
+    // 因回调/唤醒过迟而跳过的周期数（Signal 模式累计 timer_getoverrun）
+    uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+    // 读取遥测快照（可在任意线程调用；各字段分别原子读取，彼此间不保证同一时刻）
+    SystemTimerStats stats() const;
+    // 清零遥测计数（与回调并发时可能丢失当次记录）
+    void resetStats();
+
     // 获取定时线程的线程句柄（如使用）
     std::optional<pthread_t> workerHandle() const;
 
     // 设定线程调度与绑核
     static void configureThread(pthread_t th, int policy, int priority, int cpu);
 
+    // CLOCK_MONOTONIC 当前时刻（纳秒）
+    static long long monoNowNs();
+
 private:
     explicit SystemTimer(std::function<void(void*)> cb, const SystemTimerOptions& opt);
 
+    // 解析周期并按模式启动定时线程
+    static std::unique_ptr<SystemTimer> launch(std::unique_ptr<SystemTimer> timer, const std::string& period_str,
+                                               const SystemTimerOptions& opt);
+    void invokeCallback(long long scheduled_ns);
+
     // 解析周期字符串（支持 s/ms/us/ns），返回纳秒
     static long long parsePeriodNs(const std::string& period);
     static timespec nsToTimespec(long long ns);
@@ -66,14 +138,38 @@ private:
 
     // 在信号处理上下文中触发回调
     void invokeFromSignal();
+    // 记录一次回调的唤醒延迟与执行耗时（异步信号安全）
+    void record(long long scheduled_ns, long long start_ns, long long end_ns);
+
+    // ThreadLoop 模式的定时线程主循环
+    void threadLoop();
+    // 休眠至绝对时间 deadline_ns（CLOCK_MONOTONIC）；stop() 时提前返回
+    void sleepUntil(long long deadline_ns);
 
 private:
     timer_t timer_id_{};
-    bool running_ = false;
+    std::atomic<bool> running_{false};
+    SystemTimerMode mode_ = SystemTimerMode::Signal;
+    SystemTimerWait wait_ = SystemTimerWait::Nanosleep;
+    long long spin_ns_ = 0;
+    int timer_fd_ = -1;                 // ThreadLoop + TimerFd 模式使用
+    std::atomic<long long> rebase_ns_{0}; // reset() 请求的新起点（0 表示无）
+    std::atomic<uint64_t> cycles_{0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<long long> next_due_ns_{0}; // Signal 模式：下一次计划到期时刻
+    std::atomic<uint64_t> deadline_misses_{0};
+    std::atomic<uint64_t> latency_last_{0};
+    std::atomic<uint64_t> latency_max_{0};
+    std::atomic<uint64_t> latency_total_{0};
+    std::atomic<uint64_t> exec_last_{0};
+    std::atomic<uint64_t> exec_max_{0};
+    std::atomic<uint64_t> exec_total_{0};
+    std::atomic<uint64_t> exec_hist_[SystemTimerStats::kExecBins] = {};
     int signal_no_ = SIGRTMIN;
     void* user_data_ = nullptr;          // 回调函数用户数据指针
 
     std::function<void(void*)> callback_;
+    CycleCallback cycle_callback_;
 
     std::optional<std::thread> worker_;
     pthread_t worker_handle_{};         // 缓存原生句柄以支持 const 访问